@@ -0,0 +1,27 @@
+message(STATUS "Setting up the SIMD dispatch")
+
+# The translation units of the SIMD kernels, one per instruction set
+set(SIMD_KERNEL_DIR "${PROJECT_SOURCE_DIR}/src/polyhedralGravity/calculation/simd")
+
+if (POLYHEDRAL_GRAVITY_SIMD_DISPATCH)
+    if (CMAKE_SYSTEM_PROCESSOR MATCHES "x86_64|AMD64|amd64" AND CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+        message(STATUS "Compiling the SIMD kernels for SSE4.2, AVX2+FMA and AVX-512")
+        add_compile_definitions(POLYHEDRAL_GRAVITY_SIMD_DISPATCH)
+    else ()
+        message(STATUS "The SIMD dispatch requires GCC or Clang on x86-64, using the instruction set of the target")
+        set(POLYHEDRAL_GRAVITY_SIMD_DISPATCH OFF)
+    endif ()
+endif ()
+
+# Sets the instruction set of the SIMD kernels, source file properties are scoped to the directory, hence this
+# must be called in every directory which creates a target from the sources
+macro(set_simd_kernel_flags)
+    if (POLYHEDRAL_GRAVITY_SIMD_DISPATCH)
+        set_source_files_properties("${SIMD_KERNEL_DIR}/SimdKernelsSse42.cpp"
+                PROPERTIES COMPILE_OPTIONS "-msse4.2")
+        set_source_files_properties("${SIMD_KERNEL_DIR}/SimdKernelsAvx2.cpp"
+                PROPERTIES COMPILE_OPTIONS "-mavx2;-mfma")
+        set_source_files_properties("${SIMD_KERNEL_DIR}/SimdKernelsAvx512.cpp"
+                PROPERTIES COMPILE_OPTIONS "-mavx512f;-mavx2;-mfma")
+    endif ()
+endmacro()
@@ -1,4 +1,6 @@
 #include <tuple>
+#include <iterator>
+#include <stdexcept>
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 
@@ -6,6 +8,7 @@
 #include "polyhedralGravity/model/GravityModelData.h"
 #include "polyhedralGravity/calculation/GravityModel.h"
 #include "polyhedralGravity/calculation/MeshChecking.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
 #include "polyhedralGravity/input/TetgenAdapter.h"
 
 
@@ -82,6 +85,129 @@ PYBIND11_MODULE(polyhedral_gravity, m) {
           )mydelimiter",
           py::arg("vertices"), py::arg("faces"), py::arg("density"), py::arg("computation_points"));
 
+    m.def("evaluate",
+          [](const std::vector<std::array<double, 3>> &vertices, const std::vector<std::array<size_t, 3>> &faces,
+             double density, const std::vector<std::array<double, 3>> &computationPoints,
+             const std::array<std::array<double, 3>, 3> &rotation, const std::array<double, 3> &translation) {
+              return convertToTupleVector(GravityModel::evaluate({vertices, faces}, density, computationPoints,
+                                                                 FrameTransformation{rotation, translation}));
+          }, R"mydelimiter(
+            Evaluate the full gravity tensor for a given constant density polyhedron which consists of some vertices
+            and triangular faces at multiple given computation points given in another frame, e.g. an inertial frame
+            in which the body rotates. The points are transformed into the body-fixed frame and the results back
+            into the outer frame during the evaluation.
+
+            Args:
+                vertices (2-D array-like): (N, 3) array of vertex coordinates (floats).
+                faces (2-D array-like): (N, 3) array of faces, vertex-indices (ints).
+                density (float): the constant density of the polyhedron.
+                computation_points (2-D array-like): (N, 3) cartesian points in the outer frame.
+                rotation (2-D array-like): (3, 3) rotation matrix R from the body-fixed to the outer frame.
+                translation (array-like): position of the body-fixed origin in the outer frame.
+            Returns:
+                array of tuples of potential, acceleration and second derivative gravity tensor in the outer frame.
+
+          )mydelimiter",
+          py::arg("vertices"), py::arg("faces"), py::arg("density"), py::arg("computation_points"),
+          py::arg("rotation"), py::arg("translation") = std::array<double, 3>{0.0, 0.0, 0.0});
+
+    m.def("evaluate",
+          [](const std::vector<std::array<double, 3>> &vertices, const std::vector<std::array<size_t, 3>> &faces,
+             double density, const std::vector<std::array<double, 3>> &computationPoints,
+             const std::vector<std::array<std::array<double, 3>, 3>> &rotations,
+             const std::vector<std::array<double, 3>> &translations) {
+              if (rotations.size() != translations.size()) {
+                  throw std::invalid_argument{"The number of rotations and translations must be equal!"};
+              }
+              std::vector<FrameTransformation> frames{};
+              frames.reserve(rotations.size());
+              std::transform(rotations.cbegin(), rotations.cend(), translations.cbegin(), std::back_inserter(frames),
+                             [](const auto &rotation, const auto &translation) {
+                                 return FrameTransformation{rotation, translation};
+                             });
+              return convertToTupleVector(GravityModel::evaluate({vertices, faces}, density, computationPoints,
+                                                                 frames));
+          }, R"mydelimiter(
+            Evaluate the full gravity tensor for a given constant density polyhedron which consists of some vertices
+            and triangular faces at multiple given computation points, each given in its own frame, e.g. the points
+            of a trajectory around a rotating body.
+
+            Args:
+                vertices (2-D array-like): (N, 3) array of vertex coordinates (floats).
+                faces (2-D array-like): (N, 3) array of faces, vertex-indices (ints).
+                density (float): the constant density of the polyhedron.
+                computation_points (2-D array-like): (N, 3) cartesian points in the outer frames.
+                rotations (3-D array-like): (N, 3, 3) rotation matrices from the body-fixed to the outer frames.
+                translations (2-D array-like): (N, 3) positions of the body-fixed origin in the outer frames.
+            Returns:
+                array of tuples of potential, acceleration and second derivative gravity tensor in the outer frames.
+
+          )mydelimiter",
+          py::arg("vertices"), py::arg("faces"), py::arg("density"), py::arg("computation_points"),
+          py::arg("rotations"), py::arg("translations"));
+
+    m.def("evaluate",
+          [](const std::vector<std::array<double, 3>> &vertices, const std::vector<std::array<size_t, 3>> &faces,
+             double density, const std::vector<std::array<double, 3>> &computationPoints,
+             const std::array<double, 4> &quaternion, const std::array<double, 3> &translation) {
+              return convertToTupleVector(GravityModel::evaluate({vertices, faces}, density, computationPoints,
+                                                                 FrameTransformation::fromQuaternion(quaternion,
+                                                                                                     translation)));
+          }, R"mydelimiter(
+            Evaluate the full gravity tensor for a given constant density polyhedron which consists of some vertices
+            and triangular faces at multiple given computation points given in another frame, whose rotation is
+            given as quaternion.
+
+            Args:
+                vertices (2-D array-like): (N, 3) array of vertex coordinates (floats).
+                faces (2-D array-like): (N, 3) array of faces, vertex-indices (ints).
+                density (float): the constant density of the polyhedron.
+                computation_points (2-D array-like): (N, 3) cartesian points in the outer frame.
+                quaternion (array-like): (w, x, y, z) rotation from the body-fixed to the outer frame, it is
+                    normalized before usage.
+                translation (array-like): position of the body-fixed origin in the outer frame.
+            Returns:
+                array of tuples of potential, acceleration and second derivative gravity tensor in the outer frame.
+
+          )mydelimiter",
+          py::arg("vertices"), py::arg("faces"), py::arg("density"), py::arg("computation_points"),
+          py::arg("quaternion"), py::arg("translation") = std::array<double, 3>{0.0, 0.0, 0.0});
+
+    m.def("evaluate",
+          [](const std::vector<std::array<double, 3>> &vertices, const std::vector<std::array<size_t, 3>> &faces,
+             double density, const std::vector<std::array<double, 3>> &computationPoints,
+             const std::vector<std::array<double, 4>> &quaternions,
+             const std::vector<std::array<double, 3>> &translations) {
+              if (quaternions.size() != translations.size()) {
+                  throw std::invalid_argument{"The number of quaternions and translations must be equal!"};
+              }
+              std::vector<FrameTransformation> frames{};
+              frames.reserve(quaternions.size());
+              std::transform(quaternions.cbegin(), quaternions.cend(), translations.cbegin(),
+                             std::back_inserter(frames), [](const auto &quaternion, const auto &translation) {
+                                 return FrameTransformation::fromQuaternion(quaternion, translation);
+                             });
+              return convertToTupleVector(GravityModel::evaluate({vertices, faces}, density, computationPoints,
+                                                                 frames));
+          }, R"mydelimiter(
+            Evaluate the full gravity tensor for a given constant density polyhedron which consists of some vertices
+            and triangular faces at multiple given computation points, each given in its own frame, whose rotation
+            is given as quaternion.
+
+            Args:
+                vertices (2-D array-like): (N, 3) array of vertex coordinates (floats).
+                faces (2-D array-like): (N, 3) array of faces, vertex-indices (ints).
+                density (float): the constant density of the polyhedron.
+                computation_points (2-D array-like): (N, 3) cartesian points in the outer frames.
+                quaternions (2-D array-like): (N, 4) rotations (w, x, y, z) from the body-fixed to the outer frames.
+                translations (2-D array-like): (N, 3) positions of the body-fixed origin in the outer frames.
+            Returns:
+                array of tuples of potential, acceleration and second derivative gravity tensor in the outer frames.
+
+          )mydelimiter",
+          py::arg("vertices"), py::arg("faces"), py::arg("density"), py::arg("computation_points"),
+          py::arg("quaternions"), py::arg("translations"));
+
     /*
      * Methods for vertices and faces from files via TetgenAdapter
      */
@@ -185,4 +311,57 @@ PYBIND11_MODULE(polyhedral_gravity, m) {
                     True if no triangle is degenerated and the polyhedron's plane unit normals are all pointing outwards.
           )mydelimiter",
                 py::arg("input_files"));
+
+    utility.def("set_parallelization",
+                [](const std::string &backend, size_t threads, size_t grainSize) {
+                    EvaluationSettings::setParallelBackend(EvaluationSettings::parseParallelBackend(backend));
+                    EvaluationSettings::setThreadCount(threads);
+                    EvaluationSettings::setGrainSize(grainSize);
+                }, R"mydelimiter(
+                Selects the parallelization of all following evaluations at runtime, i.e. without rebuilding.
+                The THREADS backend is always available, so even a serially built package can use all cores.
+
+                Args:
+                    backend (str): DEFAULT (the backend chosen when building), SERIAL, THREADS, OPENMP or TBB.
+                    threads (int): the number of threads, 0 uses all hardware threads.
+                    grain_size (int): the number of loop iterations per task, 0 chooses it automatically.
+                Raises:
+                    ValueError: if the backend is unknown or not compiled into this package.
+          )mydelimiter",
+                py::arg("backend") = "DEFAULT", py::arg("threads") = 0, py::arg("grain_size") = 0);
+
+    utility.def("get_parallelization",
+                []() {
+                    return std::make_tuple(EvaluationSettings::toString(EvaluationSettings::getParallelBackend()),
+                                           EvaluationSettings::getThreadCount(), EvaluationSettings::getGrainSize());
+                }, R"mydelimiter(
+                Returns the current parallelization of the evaluations.
+
+                Returns:
+                    tuple of the backend name, the number of threads and the grain size (0 meaning automatic).
+          )mydelimiter");
+
+    utility.def("set_simd_architecture",
+                [](const std::string &architecture) {
+                    EvaluationSettings::setSimdArchitecture(EvaluationSettings::parseSimdArchitecture(architecture));
+                }, R"mydelimiter(
+                Selects the instruction set of the SIMD kernels. Per default, the best one of the machine is detected
+                via CPUID.
+
+                Args:
+                    architecture (str): AUTO, GENERIC, SSE4_2, AVX2_FMA or AVX512F.
+                Raises:
+                    ValueError: if the architecture is unknown or not supported by this machine.
+          )mydelimiter",
+                py::arg("architecture") = "AUTO");
+
+    utility.def("get_simd_architecture",
+                []() {
+                    return EvaluationSettings::toString(EvaluationSettings::getSimdArchitecture());
+                }, R"mydelimiter(
+                Returns the instruction set used by the SIMD kernels.
+
+                Returns:
+                    the name of the architecture, e.g. AVX2_FMA.
+          )mydelimiter");
 }
@@ -18,6 +18,11 @@ CMAKE_OPTIONS = {
     "CMAKE_BUILD_TYPE": "Release",
     # Modify to change the parallelization (Default value: CPP)
     "POLYHEDRAL_GRAVITY_PARALLELIZATION": "CPP",
+    # Runtime selectable backends next to the always available THREADS backend (Default value: OFF)
+    "POLYHEDRAL_GRAVITY_RUNTIME_OMP": "OFF",
+    "POLYHEDRAL_GRAVITY_RUNTIME_TBB": "OFF",
+    # SIMD kernels for SSE4.2, AVX2+FMA and AVX-512 in one portable package (Default value: ON)
+    "POLYHEDRAL_GRAVITY_SIMD_DISPATCH": "ON",
     # Default value (INFO=2)
     "LOGGING_LEVEL": 2,
     # Default value (OFF)
@@ -2,6 +2,8 @@
 #include "polyhedralGravity/input/ConfigSource.h"
 #include "polyhedralGravity/input/YAMLConfigReader.h"
 #include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/Autotuner.h"
 #include "polyhedralGravity/calculation/MeshChecking.h"
 #include "polyhedralGravity/output/Logging.h"
 #include "polyhedralGravity/output/CSVWriter.h"
@@ -23,6 +25,17 @@ int main(int argc, char *argv[]) {
         auto computationPoints = config->getPointsOfInterest();
         auto outputFileName = config->getOutputFileName();
         bool checkPolyhedralInput = config->getMeshInputCheckStatus();
+        EvaluationSettings::setReductionMode(config->getReductionMode());
+        EvaluationSettings::setMathBackend(config->getMathBackend());
+        EvaluationSettings::setFarFieldAccuracy(config->getFarFieldAccuracy());
+        EvaluationSettings::setSchedulingMode(config->getSchedulingMode());
+        EvaluationSettings::setParallelBackend(config->getParallelBackend());
+        EvaluationSettings::setThreadCount(config->getThreadCount());
+        EvaluationSettings::setGrainSize(config->getGrainSize());
+        EvaluationSettings::setSerialFaceThreshold(config->getSerialFaceThreshold());
+        EvaluationSettings::setParallelAxis(config->getParallelAxis());
+        EvaluationSettings::setSimdArchitecture(config->getSimdArchitecture());
+        Autotuner::setProfileFile(config->getAutotuningProfile());
 
         // Checking that the vertices are correctly set-up in the input if activated
         if (checkPolyhedralInput) {
@@ -39,6 +52,13 @@ int main(int argc, char *argv[]) {
             }
         }
 
+        // The first run on a machine tunes the kernel for the size of the mesh, later runs reuse the profile
+        if (!Autotuner::getProfileFile().empty() && computationPoints.size() >= Autotuner::MIN_POINTS &&
+            !Autotuner::lookup(poly.countFaces())) {
+            SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(), "Autotuning...");
+            Autotuner::tune(poly);
+        }
+
         SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(), "The calculation started...");
         auto start = std::chrono::high_resolution_clock::now();
         auto result = GravityModel::evaluate(poly, density, computationPoints);
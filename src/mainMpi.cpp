@@ -0,0 +1,106 @@
+#include <chrono>
+#include "polyhedralGravity/input/ConfigSource.h"
+#include "polyhedralGravity/input/YAMLConfigReader.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/Autotuner.h"
+#include "polyhedralGravity/calculation/MeshChecking.h"
+#include "polyhedralGravity/mpi/MpiEvaluation.h"
+#include "polyhedralGravity/output/Logging.h"
+#include "polyhedralGravity/output/CSVWriter.h"
+
+int main(int argc, char *argv[]) {
+    using namespace polyhedralGravity;
+    MPI_Init(&argc, &argv);
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    const bool isRoot = rank == 0;
+    if (argc != 2 && argc != 3) {
+        if (isRoot) {
+            SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                               "Wrong program call! Please use the program like that:\n"
+                               "mpirun -np N ./polyhedralGravity_mpi [YAML-Configuration-File] [Binary-Result-File]\n"
+                               "Without binary result file, the results are gathered into the CSV output file.");
+        }
+        MPI_Finalize();
+        return 0;
+    }
+
+    try {
+
+        // Every rank reads the (small) configuration, but only the root reads the mesh and the points
+        std::shared_ptr<ConfigSource> config = std::make_shared<YAMLConfigReader>(argv[1]);
+        EvaluationSettings::setReductionMode(config->getReductionMode());
+        EvaluationSettings::setMathBackend(config->getMathBackend());
+        EvaluationSettings::setFarFieldAccuracy(config->getFarFieldAccuracy());
+        EvaluationSettings::setSchedulingMode(config->getSchedulingMode());
+        EvaluationSettings::setParallelBackend(config->getParallelBackend());
+        EvaluationSettings::setThreadCount(config->getThreadCount());
+        EvaluationSettings::setGrainSize(config->getGrainSize());
+        EvaluationSettings::setSerialFaceThreshold(config->getSerialFaceThreshold());
+        EvaluationSettings::setParallelAxis(config->getParallelAxis());
+        EvaluationSettings::setSimdArchitecture(config->getSimdArchitecture());
+        // Every rank looks up the entry of its own CPU model, the profile is tuned by the single-node executables
+        Autotuner::setProfileFile(config->getAutotuningProfile());
+        const auto poly = MpiEvaluation::broadcastPolyhedron(
+                isRoot ? config->getDataSource()->getPolyhedron() : Polyhedron{}, MPI_COMM_WORLD);
+        if (isRoot && config->getMeshInputCheckStatus()) {
+            SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(), "Checking mesh...");
+            if (!MeshChecking::checkTrianglesNotDegenerated(poly)) {
+                throw std::runtime_error{
+                        "At least on triangle in the mesh is degenerated and its surface area equals zero!"};
+            } else if (!MeshChecking::checkNormalsOutwardPointing(poly)) {
+                throw std::runtime_error{
+                        "The plane unit normals are not pointing outwards! Please check the order "
+                        "of the vertices in the polyhedral input source!"};
+            }
+            SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(), "The mesh is fine.");
+        }
+        const auto density = isRoot ? config->getDensity() : 0.0;
+        const auto computationPoints = isRoot ? config->getPointsOfInterest() : std::vector<Array3>{};
+
+        int rankCount = 1;
+        MPI_Comm_size(MPI_COMM_WORLD, &rankCount);
+        if (isRoot) {
+            SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                               "The calculation of {} points on {} ranks started...", computationPoints.size(),
+                               rankCount);
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<GravityModelResult> result{};
+        if (argc == 3) {
+            MpiEvaluation::evaluateToFile(poly, density, computationPoints, argv[2], MPI_COMM_WORLD);
+        } else {
+            result = MpiEvaluation::evaluate(poly, density, computationPoints, MPI_COMM_WORLD);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        auto ms = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+        if (isRoot) {
+            SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                               "The calculation finished. It took {} microseconds.", ms.count());
+            auto outputFileName = config->getOutputFileName();
+            if (argc == 3) {
+                SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                                   "The results were written to the binary file {}", argv[2]);
+            } else if (!outputFileName.empty()) {
+                SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                                   "Writing results to specified output file {}", outputFileName);
+                CSVWriter csvWriter{outputFileName};
+                csvWriter.printResult(computationPoints, result);
+                SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(), "Writing finished!");
+            } else {
+                SPDLOG_LOGGER_WARN(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                                   "No output filename was specified!");
+            }
+        }
+
+        MPI_Finalize();
+        return 0;
+
+    } catch (const std::exception &e) {
+        SPDLOG_LOGGER_ERROR(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(), "Rank {}: {}", rank, e.what());
+        // The other ranks may wait in a collective operation
+        MPI_Abort(MPI_COMM_WORLD, -1);
+        return -1;
+    }
+}
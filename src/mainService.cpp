@@ -0,0 +1,78 @@
+#include <csignal>
+#include "polyhedralGravity/input/ConfigSource.h"
+#include "polyhedralGravity/input/YAMLConfigReader.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/Autotuner.h"
+#include "polyhedralGravity/calculation/MeshChecking.h"
+#include "polyhedralGravity/service/EvaluationServer.h"
+#include "polyhedralGravity/output/Logging.h"
+
+int main(int argc, char *argv[]) {
+    using namespace polyhedralGravity;
+    if (argc < 2) {
+        SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                           "Wrong program call! Please use the program like that:\n"
+                           "./polyhedralGravity_service [Socket-Path] [YAML-Configuration-File]...\n"
+                           "The meshes of the configuration files are preloaded with the ids 1, 2, ... and the "
+                           "evaluation settings are taken from the first one.");
+        return 0;
+    }
+
+    try {
+
+        // The signals are blocked before any thread is started, so that only the main thread receives them
+        sigset_t signals{};
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+        EvaluationServer server{argv[1]};
+        for (int i = 2; i < argc; ++i) {
+            std::shared_ptr<ConfigSource> config = std::make_shared<YAMLConfigReader>(argv[i]);
+            if (i == 2) {
+                EvaluationSettings::setReductionMode(config->getReductionMode());
+                EvaluationSettings::setMathBackend(config->getMathBackend());
+                EvaluationSettings::setFarFieldAccuracy(config->getFarFieldAccuracy());
+                EvaluationSettings::setSchedulingMode(config->getSchedulingMode());
+                EvaluationSettings::setParallelBackend(config->getParallelBackend());
+                EvaluationSettings::setThreadCount(config->getThreadCount());
+                EvaluationSettings::setGrainSize(config->getGrainSize());
+                EvaluationSettings::setSerialFaceThreshold(config->getSerialFaceThreshold());
+                EvaluationSettings::setParallelAxis(config->getParallelAxis());
+                EvaluationSettings::setSimdArchitecture(config->getSimdArchitecture());
+                Autotuner::setProfileFile(config->getAutotuningProfile());
+            }
+            auto poly = config->getDataSource()->getPolyhedron();
+            if (config->getMeshInputCheckStatus()) {
+                if (!MeshChecking::checkTrianglesNotDegenerated(poly)) {
+                    throw std::runtime_error{
+                            "At least on triangle in the mesh is degenerated and its surface area equals zero!"};
+                } else if (!MeshChecking::checkNormalsOutwardPointing(poly)) {
+                    throw std::runtime_error{
+                            "The plane unit normals are not pointing outwards! Please check the order "
+                            "of the vertices in the polyhedral input source!"};
+                }
+            }
+            // The preloaded meshes are tuned before the server accepts requests
+            if (!Autotuner::getProfileFile().empty() && !Autotuner::lookup(poly.countFaces())) {
+                Autotuner::tune(poly);
+            }
+            const uint64_t id = server.addPolyhedron(std::move(poly));
+            SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                               "The mesh of {} has the id {}", argv[i], id);
+        }
+
+        server.start();
+        int signal = 0;
+        sigwait(&signals, &signal);
+        SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                           "Received signal {}, shutting down...", signal);
+        server.stop();
+        return 0;
+
+    } catch (const std::exception &e) {
+        SPDLOG_LOGGER_ERROR(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(), "{}", e.what());
+        return -1;
+    }
+}
@@ -0,0 +1,300 @@
+#include "Autotuner.h"
+
+namespace polyhedralGravity {
+
+    namespace {
+
+        /**
+         * The entries of the profile keyed by the CPU model and the size class of the mesh
+         */
+        using Profile = std::map<std::pair<std::string, size_t>, TuningParameters>;
+
+        /**
+         * Guards the profile and the profile file
+         */
+        std::mutex profileMutex;
+
+        Profile profile;
+
+        std::string profileFile;
+
+        void validate(const TuningParameters &parameters) {
+            if (parameters.variant == KernelVariant::AUTO) {
+                throw std::invalid_argument{"The autotuner can only store and evaluate a concrete kernel variant!"};
+            }
+            if ((parameters.variant == KernelVariant::TILED || parameters.variant == KernelVariant::BATCHED) &&
+                parameters.pointBlockSize == 0) {
+                throw std::invalid_argument{"The point block size of the tuning parameters must be positive!"};
+            }
+            if (parameters.variant == KernelVariant::TILED && parameters.faceBlockSize == 0) {
+                throw std::invalid_argument{"The face block size of the tuning parameters must be positive!"};
+            }
+        }
+
+        /**
+         * Reads the entries of a profile file into a profile, a missing file adds no entries.
+         * @param fileName - the path of the profile file
+         * @param entries - the profile receiving the entries, replacing the ones with the same key
+         * @throws std::runtime_error if the file is malformed
+         */
+        void readProfile(const std::string &fileName, Profile &entries) {
+            std::ifstream file{fileName};
+            std::string line;
+            size_t lineNumber = 0;
+            while (std::getline(file, line)) {
+                ++lineNumber;
+                if (line.empty() || line.front() == '#') {
+                    continue;
+                }
+                //The CPU model may contain spaces, so the fields are separated by tabulators
+                std::vector<std::string> fields{};
+                std::istringstream lineStream{line};
+                std::string field;
+                while (std::getline(lineStream, field, '\t')) {
+                    fields.push_back(field);
+                }
+                try {
+                    if (fields.size() != 5) {
+                        throw std::invalid_argument{"expected five tab-separated fields"};
+                    }
+                    TuningParameters parameters{EvaluationSettings::parseKernelVariant(fields[2]),
+                                                std::stoul(fields[3]), std::stoul(fields[4])};
+                    validate(parameters);
+                    entries[{fields[0], std::stoul(fields[1])}] = parameters;
+                } catch (const std::exception &e) {
+                    throw std::runtime_error{"The autotuning profile " + fileName + " is malformed in line " +
+                                             std::to_string(lineNumber) + ": " + e.what()};
+                }
+            }
+        }
+
+        /**
+         * Returns points on Fibonacci spheres around the centroid of the vertices, alternating between the near and
+         * the far field of the polyhedron.
+         * @param polyhedron - the polyhedron
+         * @param pointCount - the number of points
+         * @return the points
+         */
+        std::vector<Array3> benchmarkPoints(const Polyhedron &polyhedron, size_t pointCount) {
+            using namespace util;
+            Array3 centroid{0.0, 0.0, 0.0};
+            for (const Array3 &vertex: polyhedron.getVertices()) {
+                centroid = centroid + vertex;
+            }
+            centroid = centroid / static_cast<double>(std::max<size_t>(polyhedron.countVertices(), 1));
+            double radius = 0.0;
+            for (const Array3 &vertex: polyhedron.getVertices()) {
+                radius = std::max(radius, euclideanNorm(vertex - centroid));
+            }
+            const double goldenAngle = PI * (3.0 - std::sqrt(5.0));
+            std::vector<Array3> points(pointCount);
+            for (size_t i = 0; i < pointCount; ++i) {
+                const double z = 1.0 - 2.0 * (static_cast<double>(i) + 0.5) / static_cast<double>(pointCount);
+                const double r = std::sqrt(1.0 - z * z);
+                const double angle = goldenAngle * static_cast<double>(i);
+                const double distance = (i % 2 == 0 ? 1.1 : 3.0) * radius;
+                points[i] = centroid + Array3{r * std::cos(angle), r * std::sin(angle), z} * distance;
+            }
+            return points;
+        }
+
+    }
+
+    const std::string &Autotuner::cpuModel() {
+        static const std::string model = [] {
+            std::ifstream cpuInfo{"/proc/cpuinfo"};
+            std::string line;
+            while (std::getline(cpuInfo, line)) {
+                if (line.rfind("model name", 0) != 0) {
+                    continue;
+                }
+                const size_t colon = line.find(':');
+                if (colon == std::string::npos) {
+                    continue;
+                }
+                const size_t begin = line.find_first_not_of(" \t", colon + 1);
+                const size_t end = line.find_last_not_of(" \t\r");
+                if (begin != std::string::npos && end >= begin) {
+                    std::string name = line.substr(begin, end - begin + 1);
+                    //The tabulator separates the fields of the profile file
+                    std::replace(name.begin(), name.end(), '\t', ' ');
+                    return name;
+                }
+            }
+            return std::string{"unknown"};
+        }();
+        return model;
+    }
+
+    size_t Autotuner::sizeClass(size_t faceCount) {
+        size_t result = 0;
+        while (faceCount > 1) {
+            faceCount >>= 1;
+            ++result;
+        }
+        return result;
+    }
+
+    std::vector<TuningParameters> Autotuner::candidates(size_t faceCount) {
+        std::vector<TuningParameters> result{{KernelVariant::POINTWISE, 0, 0},
+                                             {KernelVariant::POINT_LANES, 0, 0}};
+        //Face blocks beyond the number of faces behave alike, so only the smallest of them is benchmarked
+        std::vector<size_t> faceBlockSizes{};
+        for (size_t faceBlockSize: {256, 512, 1024}) {
+            faceBlockSizes.push_back(faceBlockSize);
+            if (faceBlockSize >= faceCount) {
+                break;
+            }
+        }
+        for (size_t pointBlockSize: {8, 16, 32}) {
+            for (size_t faceBlockSize: faceBlockSizes) {
+                result.push_back({KernelVariant::TILED, pointBlockSize, faceBlockSize});
+            }
+        }
+        for (size_t pointBlockSize: {4, 8, 16}) {
+            result.push_back({KernelVariant::BATCHED, pointBlockSize, 0});
+        }
+        return result;
+    }
+
+    std::vector<GravityModelResult> Autotuner::evaluateGeometricSums(const Polyhedron &polyhedron,
+                                                                     const std::vector<Array3> &computationPoints,
+                                                                     const TuningParameters &parameters) {
+        validate(parameters);
+        switch (parameters.variant) {
+            case KernelVariant::TILED:
+                return TiledKernel::evaluateGeometricSums(TiledKernel::prepareFaces(polyhedron), computationPoints,
+                                                          parameters.pointBlockSize, parameters.faceBlockSize);
+            case KernelVariant::BATCHED:
+                return BatchedKernel::evaluateGeometricSums(BatchedKernel::prepare(polyhedron), computationPoints,
+                                                            parameters.pointBlockSize);
+            case KernelVariant::POINT_LANES:
+                return PointLaneKernel::evaluateGeometricSums(polyhedron, computationPoints);
+            default:
+                return GravityModel::detail::evaluatePointwise(polyhedron, computationPoints);
+        }
+    }
+
+    std::vector<GravityModelResult> Autotuner::evaluate(const Polyhedron &polyhedron, double density,
+                                                        const std::vector<Array3> &computationPoints,
+                                                        const TuningParameters &parameters) {
+        std::vector<GravityModelResult> result = evaluateGeometricSums(polyhedron, computationPoints, parameters);
+        std::transform(result.begin(), result.end(), result.begin(), [density](const GravityModelResult &sums) {
+            return GravityModel::detail::applyDensityPrefix(sums, density);
+        });
+        return result;
+    }
+
+    TuningParameters Autotuner::tune(const Polyhedron &polyhedron, size_t pointCount) {
+        const size_t faceCount = polyhedron.countFaces();
+        if (pointCount == 0) {
+            pointCount = std::clamp<size_t>(BENCHMARK_FACE_EVALUATIONS / std::max<size_t>(faceCount, 1),
+                                            MIN_POINTS, 4096);
+        }
+        const std::vector<Array3> points = benchmarkPoints(polyhedron, pointCount);
+        TuningParameters best{};
+        double bestDuration = std::numeric_limits<double>::infinity();
+        for (const TuningParameters &candidate: candidates(faceCount)) {
+            //The first run also warms up the caches, the faster of both runs counts
+            double duration = std::numeric_limits<double>::infinity();
+            for (int repetition = 0; repetition < 2; ++repetition) {
+                const auto start = std::chrono::steady_clock::now();
+                evaluate(polyhedron, 1.0, points, candidate);
+                const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                duration = std::min(duration, elapsed.count());
+            }
+            SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                                "Autotuning candidate {} ({}, {}): {} s",
+                                EvaluationSettings::toString(candidate.variant), candidate.pointBlockSize,
+                                candidate.faceBlockSize, duration);
+            if (duration < bestDuration) {
+                bestDuration = duration;
+                best = candidate;
+            }
+        }
+        store(cpuModel(), sizeClass(faceCount), best);
+        SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                           "Autotuned {} faces on {}: {} with point blocks of {} and face blocks of {} "
+                           "({} points in {} s)", faceCount, cpuModel(), EvaluationSettings::toString(best.variant),
+                           best.pointBlockSize, best.faceBlockSize, pointCount, bestDuration);
+        if (!getProfileFile().empty()) {
+            saveProfile();
+        }
+        return best;
+    }
+
+    std::optional<TuningParameters> Autotuner::lookup(size_t faceCount) {
+        std::lock_guard<std::mutex> lock{profileMutex};
+        if (profile.empty()) {
+            return std::nullopt;
+        }
+        const auto it = profile.find({cpuModel(), sizeClass(faceCount)});
+        if (it == profile.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    void Autotuner::store(const std::string &model, size_t sizeClass, const TuningParameters &parameters) {
+        validate(parameters);
+        std::lock_guard<std::mutex> lock{profileMutex};
+        profile[{model, sizeClass}] = parameters;
+    }
+
+    void Autotuner::setProfileFile(const std::string &fileName) {
+        Profile entries{};
+        if (!fileName.empty()) {
+            readProfile(fileName, entries);
+        }
+        std::lock_guard<std::mutex> lock{profileMutex};
+        profileFile = fileName;
+        for (const auto &[key, parameters]: entries) {
+            profile[key] = parameters;
+        }
+    }
+
+    std::string Autotuner::getProfileFile() {
+        std::lock_guard<std::mutex> lock{profileMutex};
+        return profileFile;
+    }
+
+    void Autotuner::saveProfile() {
+        std::lock_guard<std::mutex> lock{profileMutex};
+        if (profileFile.empty()) {
+            throw std::runtime_error{"No autotuning profile file is set!"};
+        }
+        //Other processes may have tuned other machines or meshes in the meantime, their entries are kept
+        Profile entries{};
+        readProfile(profileFile, entries);
+        for (const auto &[key, parameters]: profile) {
+            entries[key] = parameters;
+        }
+        //Writing a temporary file and renaming it never leaves a partially written profile behind
+        const std::string temporaryFile = profileFile + ".tmp" + std::to_string(
+                std::chrono::steady_clock::now().time_since_epoch().count());
+        {
+            std::ofstream file{temporaryFile, std::ios::trunc};
+            file << "# Autotuning profile of the polyhedral gravity model\n"
+                 << "# cpu model\tsize class (log2 of the number of faces)\tkernel variant\tpoint block size\t"
+                 << "face block size\n";
+            for (const auto &[key, parameters]: entries) {
+                file << key.first << '\t' << key.second << '\t' << EvaluationSettings::toString(parameters.variant)
+                     << '\t' << parameters.pointBlockSize << '\t' << parameters.faceBlockSize << '\n';
+            }
+            if (!file) {
+                std::remove(temporaryFile.c_str());
+                throw std::runtime_error{"The autotuning profile could not be written to " + temporaryFile + "!"};
+            }
+        }
+        if (std::rename(temporaryFile.c_str(), profileFile.c_str()) != 0) {
+            std::remove(temporaryFile.c_str());
+            throw std::runtime_error{"The autotuning profile could not be written to " + profileFile + "!"};
+        }
+    }
+
+    void Autotuner::clearProfile() {
+        std::lock_guard<std::mutex> lock{profileMutex};
+        profile.clear();
+    }
+
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <optional>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <stdexcept>
+#include <algorithm>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/calculation/TiledKernel.h"
+#include "polyhedralGravity/calculation/BatchedKernel.h"
+#include "polyhedralGravity/calculation/PointLaneKernel.h"
+#include "polyhedralGravity/util/UtilityConstants.h"
+#include "polyhedralGravity/util/UtilityContainer.h"
+#include "polyhedralGravity/output/Logging.h"
+
+namespace polyhedralGravity {
+
+    /**
+     * The kernel and its block sizes chosen by the Autotuner for the evaluation of multiple computation points.
+     */
+    struct TuningParameters {
+
+        /**
+         * The kernel, never AUTO
+         */
+        KernelVariant variant{KernelVariant::POINTWISE};
+
+        /**
+         * The number of computation points per block of the TILED and the BATCHED kernel, zero otherwise
+         */
+        size_t pointBlockSize{0};
+
+        /**
+         * The number of faces per block of the TILED kernel, zero otherwise
+         */
+        size_t faceBlockSize{0};
+
+        bool operator==(const TuningParameters &other) const {
+            return variant == other.variant && pointBlockSize == other.pointBlockSize &&
+                   faceBlockSize == other.faceBlockSize;
+        }
+
+        bool operator!=(const TuningParameters &other) const {
+            return !(*this == other);
+        }
+
+    };
+
+    /**
+     * Chooses the kernel variant and the block sizes for the evaluation of multiple computation points by
+     * benchmarking the candidates once per machine and mesh size, instead of tuning them by hand per cluster.
+     *
+     * The winners are kept in a profile keyed by the CPU model and the size class of the mesh (the binary order of
+     * magnitude of its number of faces). The multi-point GravityModel::evaluate(..) consults the profile with
+     * KernelVariant::AUTO and ReductionMode::DEFAULT for calls with at least MIN_POINTS points, otherwise (and
+     * without an entry) its built-in choice applies. An entry for the PointLaneKernel is also skipped while
+     * MathBackend::FAST or a far-field accuracy is set (see GravityModel::detail::requiresScalarFaces()).
+     *
+     * With a profile file, the profile persists between runs. The file is a text file with one tab-separated line
+     * per entry (CPU model, size class, kernel variant, point block size, face block size), so one file on a shared
+     * file system serves all nodes of a heterogeneous cluster.
+     *
+     * @note The kernels only differ in the association order of the sums, i.e. in the last bits of the results.
+     */
+    namespace Autotuner {
+
+        /**
+         * The minimal number of computation points of a call for which the profile is consulted
+         */
+        constexpr size_t MIN_POINTS = 64;
+
+        /**
+         * The number of face evaluations per candidate from which the number of benchmark points is derived
+         */
+        constexpr size_t BENCHMARK_FACE_EVALUATIONS = size_t{1} << 21;
+
+        /**
+         * Returns the CPU model of this machine, i.e. the model name of /proc/cpuinfo on Linux.
+         * @return the CPU model, "unknown" if it cannot be determined
+         */
+        const std::string &cpuModel();
+
+        /**
+         * Returns the size class of a mesh, i.e. the binary order of magnitude of its number of faces.
+         * @param faceCount - the number of faces
+         * @return floor(log2(faceCount)), zero for less than two faces
+         */
+        size_t sizeClass(size_t faceCount);
+
+        /**
+         * Returns the configurations benchmarked by tune(..) for a mesh.
+         * @param faceCount - the number of faces
+         * @return the candidates, POINTWISE first
+         */
+        std::vector<TuningParameters> candidates(size_t faceCount);
+
+        /**
+         * Evaluates the geometric sums (i.e. the results for a unit density before the application of the prefix
+         * GRAVITATIONAL_CONSTANT * density) at multiple computation points with the given configuration.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @param computationPoints - vector of computation points
+         * @param parameters - the kernel and its block sizes
+         * @return the density-independent sums foreach computation Point P
+         * @throws std::invalid_argument if the kernel is AUTO or a required block size is zero
+         */
+        std::vector<GravityModelResult> evaluateGeometricSums(const Polyhedron &polyhedron,
+                                                              const std::vector<Array3> &computationPoints,
+                                                              const TuningParameters &parameters);
+
+        /**
+         * Evaluates the polyhedral gravity model at multiple computation points with the given configuration.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoints - vector of computation points
+         * @param parameters - the kernel and its block sizes
+         * @return the GravityModelResult foreach computation Point P
+         * @throws std::invalid_argument if the kernel is AUTO or a required block size is zero
+         */
+        std::vector<GravityModelResult> evaluate(const Polyhedron &polyhedron, double density,
+                                                 const std::vector<Array3> &computationPoints,
+                                                 const TuningParameters &parameters);
+
+        /**
+         * Benchmarks all candidates(..) on points around the polyhedron, stores the fastest one in the profile for
+         * this CPU model and the size class of the polyhedron, and saves the profile if a profile file is set.
+         * Every candidate is run twice, the faster run counts.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @param pointCount - the number of benchmark points, zero derives it from BENCHMARK_FACE_EVALUATIONS
+         * (between MIN_POINTS and 4096)
+         * @return the winning TuningParameters
+         * @throws std::runtime_error if the profile file cannot be written
+         */
+        TuningParameters tune(const Polyhedron &polyhedron, size_t pointCount = 0);
+
+        /**
+         * Returns the entry of the profile for this CPU model and a mesh.
+         * @param faceCount - the number of faces of the mesh
+         * @return the TuningParameters, empty if the mesh's size class has not been tuned on this CPU model
+         */
+        std::optional<TuningParameters> lookup(size_t faceCount);
+
+        /**
+         * Stores an entry in the profile (in memory only).
+         * @param model - the CPU model
+         * @param sizeClass - the size class of the mesh
+         * @param parameters - the TuningParameters
+         * @throws std::invalid_argument if the kernel is AUTO
+         */
+        void store(const std::string &model, size_t sizeClass, const TuningParameters &parameters);
+
+        /**
+         * Sets the file in which the profile persists and loads its entries, if it already exists.
+         * The entries of the file replace the ones in memory with the same key.
+         * @param fileName - the path of the profile file, empty to keep the profile in memory only
+         * @throws std::runtime_error if an existing file is malformed
+         */
+        void setProfileFile(const std::string &fileName);
+
+        /**
+         * Returns the file in which the profile persists.
+         * @return the path, empty if none is set
+         */
+        std::string getProfileFile();
+
+        /**
+         * Writes the profile into the profile file. The entries of other processes, which were written into the
+         * file in the meantime, are merged. The file is replaced atomically.
+         * @throws std::runtime_error if no profile file is set or it cannot be written
+         */
+        void saveProfile();
+
+        /**
+         * Removes all entries from the profile in memory (not from the profile file).
+         */
+        void clearProfile();
+
+    }
+
+}
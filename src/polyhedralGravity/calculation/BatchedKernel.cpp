@@ -0,0 +1,202 @@
+#include "BatchedKernel.h"
+
+namespace polyhedralGravity {
+
+    namespace {
+
+        /**
+         * Returns the i-th row of a (N x 3) row-major matrix.
+         * @param matrix - the matrix
+         * @param i - the row index
+         * @return the row as Array3
+         */
+        Array3 row(const std::vector<double> &matrix, size_t i) {
+            return {matrix[3 * i], matrix[3 * i + 1], matrix[3 * i + 2]};
+        }
+
+        /**
+         * Flattens points into a (N x 3) row-major matrix.
+         * @param points - the points
+         * @return the matrix
+         */
+        std::vector<double> toMatrix(const std::vector<Array3> &points) {
+            std::vector<double> matrix(3 * points.size());
+            for (size_t i = 0; i < points.size(); ++i) {
+                std::copy(points[i].begin(), points[i].end(), matrix.begin() + 3 * i);
+            }
+            return matrix;
+        }
+
+    }
+
+    PreparedPolyhedron BatchedKernel::prepare(const Polyhedron &polyhedron) {
+        using namespace util;
+        PreparedPolyhedron prepared{};
+        prepared.vertexMatrix = toMatrix(polyhedron.getVertices());
+        prepared.vertexSquaredNorms.resize(polyhedron.countVertices());
+        std::transform(polyhedron.getVertices().cbegin(), polyhedron.getVertices().cend(),
+                       prepared.vertexSquaredNorms.begin(), [](const Array3 &vertex) {
+                    return dot(vertex, vertex);
+                });
+        prepared.faces = polyhedron.getFaces();
+        prepared.planeNormalMatrix.resize(3 * polyhedron.countFaces());
+        prepared.planeOffsets.resize(polyhedron.countFaces());
+        prepared.preparedFaces.resize(polyhedron.countFaces());
+        for (size_t face = 0; face < polyhedron.countFaces(); ++face) {
+            const std::array<size_t, 3> &indices = polyhedron.getFaces()[face];
+            const Array3Triplet vertices{polyhedron.getVertex(indices[0]), polyhedron.getVertex(indices[1]),
+                                         polyhedron.getVertex(indices[2])};
+            //Same normal as in GravityModel::detail::computeHessianPlane(..)
+            const Array3 planeNormal = cross(vertices[0] - vertices[1], vertices[0] - vertices[2]);
+            std::copy(planeNormal.begin(), planeNormal.end(), std::next(prepared.planeNormalMatrix.begin(), 3 * face));
+            prepared.planeOffsets[face] = dot(planeNormal, vertices[0]);
+            prepared.preparedFaces[face] = GravityModel::detail::prepareFace(vertices);
+        }
+        return prepared;
+    }
+
+    std::vector<double> BatchedKernel::computePlaneConstants(const PreparedPolyhedron &prepared,
+                                                             const std::vector<Array3> &computationPoints) {
+        using namespace util;
+        const size_t faceCount = prepared.faces.size();
+        std::vector<double> constants(computationPoints.size() * faceCount);
+        const std::vector<double> pointMatrix = toMatrix(computationPoints);
+        //C_p * P for all points and faces
+        detail::gemm(computationPoints.size(), faceCount, 3, pointMatrix.data(), prepared.planeNormalMatrix.data(),
+                     constants.data());
+        for (size_t point = 0; point < computationPoints.size(); ++point) {
+            for (size_t face = 0; face < faceCount; ++face) {
+                double &d = constants[point * faceCount + face];
+                const double product = d;
+                //Rank-1 correction: d = C_p * P - C_p * v0
+                d = product - prepared.planeOffsets[face];
+                if (std::abs(d) < CANCELLATION_THRESHOLD * (std::abs(product) + std::abs(prepared.planeOffsets[face]))) {
+                    //Too many digits cancelled, compute -(v0 - P) * C_p directly
+                    const Array3 planeNormal = row(prepared.planeNormalMatrix, face);
+                    const Array3 vertex0 = row(prepared.vertexMatrix, prepared.faces[face][0]);
+                    d = -dot(vertex0 - computationPoints[point], planeNormal);
+                }
+            }
+        }
+        return constants;
+    }
+
+    std::vector<double> BatchedKernel::computeVertexDistances(const PreparedPolyhedron &prepared,
+                                                              const std::vector<Array3> &computationPoints) {
+        using namespace util;
+        const size_t vertexCount = prepared.vertexSquaredNorms.size();
+        std::vector<double> distances(computationPoints.size() * vertexCount);
+        const std::vector<double> pointMatrix = toMatrix(computationPoints);
+        //v * P for all points and vertices
+        detail::gemm(computationPoints.size(), vertexCount, 3, pointMatrix.data(), prepared.vertexMatrix.data(),
+                     distances.data());
+        for (size_t point = 0; point < computationPoints.size(); ++point) {
+            const double pointSquaredNorm = dot(computationPoints[point], computationPoints[point]);
+            for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+                double &distance = distances[point * vertexCount + vertex];
+                //Rank-1 corrections: |v - P|^2 = |v|^2 + |P|^2 - 2 * v * P
+                const double magnitude = prepared.vertexSquaredNorms[vertex] + pointSquaredNorm;
+                const double squaredDistance = magnitude - 2.0 * distance;
+                if (squaredDistance < CANCELLATION_THRESHOLD * magnitude) {
+                    //Too many digits cancelled, compute |v - P| directly
+                    distance = euclideanNorm(row(prepared.vertexMatrix, vertex) - computationPoints[point]);
+                } else {
+                    distance = std::sqrt(squaredDistance);
+                }
+            }
+        }
+        return distances;
+    }
+
+    std::vector<GravityModelResult> BatchedKernel::evaluateGeometricSums(
+            const PreparedPolyhedron &prepared, const std::vector<Array3> &computationPoints,
+            size_t pointBlockSize) {
+        if (pointBlockSize == 0) {
+            throw std::invalid_argument{"The block size of the batched kernel must be greater than zero!"};
+        }
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Batched evaluation of {} faces for {} computation points in blocks of {}",
+                            prepared.faces.size(), computationPoints.size(), pointBlockSize);
+        std::vector<GravityModelResult> result{computationPoints.size()};
+        const size_t pointCount = computationPoints.size();
+        const size_t faceCount = prepared.faces.size();
+        const size_t vertexCount = prepared.vertexSquaredNorms.size();
+        const size_t blockCount = (pointCount + pointBlockSize - 1) / pointBlockSize;
+        const double farFieldAccuracy = EvaluationSettings::getFarFieldAccuracy();
+        ParallelExecution::forEach(blockCount, [&, pointBlockSize, farFieldAccuracy](size_t block) {
+            using namespace util;
+            const size_t pointBegin = block * pointBlockSize;
+            const size_t pointEnd = std::min(pointCount, pointBegin + pointBlockSize);
+            const std::vector<Array3> blockPoints{std::next(computationPoints.begin(), pointBegin),
+                                                  std::next(computationPoints.begin(), pointEnd)};
+            //1. Step: The point-dependent inputs of the whole block by dense linear algebra
+            const std::vector<double> planeConstants = computePlaneConstants(prepared, blockPoints);
+            const std::vector<double> vertexDistances = computeVertexDistances(prepared, blockPoints);
+            //2. Step: The remaining per-face computation, summed up in index order
+            for (size_t i = 0; i < blockPoints.size(); ++i) {
+                const Array3 &computationPoint = blockPoints[i];
+                GravityModelResult sum{};
+                for (size_t face = 0; face < faceCount; ++face) {
+                    const std::array<size_t, 3> &indices = prepared.faces[face];
+                    const Array3Triplet relativeFace{row(prepared.vertexMatrix, indices[0]) - computationPoint,
+                                                     row(prepared.vertexMatrix, indices[1]) - computationPoint,
+                                                     row(prepared.vertexMatrix, indices[2]) - computationPoint};
+                    //Small, distant faces are approximated like in the scalar GravityModel::detail::evaluateFace(..)
+                    if (farFieldAccuracy > 0.0 && GravityModel::detail::isFarField(relativeFace, farFieldAccuracy)) {
+                        sum = GravityModel::detail::sumResults(
+                                sum, GravityModel::detail::evaluateFaceMoments(relativeFace));
+                        continue;
+                    }
+                    const Array3 planeNormal = row(prepared.planeNormalMatrix, face);
+                    sum = GravityModel::detail::sumResults(sum, GravityModel::detail::evaluateFace(
+                            relativeFace,
+                            prepared.preparedFaces[face],
+                            {planeNormal[0], planeNormal[1], planeNormal[2],
+                             planeConstants[i * faceCount + face]},
+                            {vertexDistances[i * vertexCount + indices[0]],
+                             vertexDistances[i * vertexCount + indices[1]],
+                             vertexDistances[i * vertexCount + indices[2]]}));
+                }
+                sum.eliminateRoundingErrors();
+                result[pointBegin + i] = sum;
+            }
+        });
+        return result;
+    }
+
+    std::vector<GravityModelResult> BatchedKernel::evaluate(
+            const Polyhedron &polyhedron, double density, const std::vector<Array3> &computationPoints,
+            size_t pointBlockSize) {
+        std::vector<GravityModelResult> result =
+                evaluateGeometricSums(prepare(polyhedron), computationPoints, pointBlockSize);
+        std::transform(result.begin(), result.end(), result.begin(), [density](const GravityModelResult &sums) {
+            return GravityModel::detail::applyDensityPrefix(sums, density);
+        });
+        return result;
+    }
+
+    void BatchedKernel::detail::gemm(size_t m, size_t n, size_t k, const double *a, const double *b, double *c) {
+#ifdef POLYHEDRAL_GRAVITY_USE_BLAS
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, static_cast<int>(m), static_cast<int>(n),
+                    static_cast<int>(k), 1.0, a, static_cast<int>(k), b, static_cast<int>(k), 0.0, c,
+                    static_cast<int>(n));
+#else
+        //Blocked over the rows of B, so that one block of B stays in the cache for all rows of A
+        for (size_t columnBegin = 0; columnBegin < n; columnBegin += GEMM_BLOCK_SIZE) {
+            const size_t columnEnd = std::min(n, columnBegin + GEMM_BLOCK_SIZE);
+            for (size_t i = 0; i < m; ++i) {
+                const double *rowA = a + i * k;
+                for (size_t j = columnBegin; j < columnEnd; ++j) {
+                    const double *rowB = b + j * k;
+                    double sum = 0.0;
+                    for (size_t l = 0; l < k; ++l) {
+                        sum += rowA[l] * rowB[l];
+                    }
+                    c[i * n + j] = sum;
+                }
+            }
+        }
+#endif
+    }
+
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/util/UtilityContainer.h"
+#include "polyhedralGravity/output/Logging.h"
+#include "polyhedralGravity/calculation/ParallelExecution.h"
+
+#ifdef POLYHEDRAL_GRAVITY_USE_BLAS
+#include "cblas.h"
+#endif
+
+namespace polyhedralGravity {
+
+    /**
+     * The point-independent data of a polyhedron used by the BatchedKernel, stored as dense row-major matrices.
+     */
+    struct PreparedPolyhedron {
+
+        /**
+         * The vertices as (V x 3) matrix
+         */
+        std::vector<double> vertexMatrix;
+
+        /**
+         * The squared norms |v|^2 of the vertices
+         */
+        std::vector<double> vertexSquaredNorms;
+
+        /**
+         * The not normalized plane normals C_p = (v0 - v1) x (v0 - v2) as (F x 3) matrix, i.e. [a, b, c] of the
+         * Hessian Normal Form
+         */
+        std::vector<double> planeNormalMatrix;
+
+        /**
+         * The products C_p * v0 of the plane normals with the first vertex of each face
+         */
+        std::vector<double> planeOffsets;
+
+        /**
+         * The vertex indices of the faces
+         */
+        std::vector<std::array<size_t, 3>> faces;
+
+        /**
+         * The segment vectors, the plane unit normal and the segment unit normals of the faces
+         */
+        std::vector<PreparedFace> preparedFaces;
+
+    };
+
+    /**
+     * Evaluation of the polyhedral gravity model for many computation points with a dense linear algebra stage.
+     * The point-dependent inputs of the per-face computation are for a block of points P:
+     * - the Hessian plane constants d_p = C_p * P - C_p * v0, i.e. the matrix product (P x C^T) plus a rank-1
+     *   correction, from which the plane distances h_p = |d_p| / |C_p| follow
+     * - the vertex distances |v - P| = sqrt(|v|^2 + |P|^2 - 2 * v * P), i.e. the matrix product (P x V^T) plus
+     *   two rank-1 corrections
+     * Both products are computed by a blocked matrix multiplication (or by cblas_dgemm if the library is built with
+     * POLYHEDRAL_GRAVITY_USE_BLAS) and passed to the remaining per-face computation.
+     * If the subtraction cancels too many digits, i.e. if P is close to a plane or a vertex, the value is recomputed
+     * directly from the difference vector, so that the results equal the ones of GravityModel::evaluate(..) up to
+     * rounding.
+     */
+    namespace BatchedKernel {
+
+        /**
+         * The default number of computation points in one block
+         */
+        constexpr size_t DEFAULT_POINT_BLOCK_SIZE = 8;
+
+        /**
+         * A value computed by the matrix product formulation is recomputed directly if it is smaller than this
+         * factor times the magnitude of the cancelled terms, i.e. at most four bits are lost by the cancellation
+         */
+        constexpr double CANCELLATION_THRESHOLD = 0.0625;
+
+        /**
+         * Computes the point-independent data of a polyhedron.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @return the PreparedPolyhedron
+         */
+        PreparedPolyhedron prepare(const Polyhedron &polyhedron);
+
+        /**
+         * Computes the constants d of the Hessian Normal Form of every face relative to every point of a block.
+         * @param prepared - the PreparedPolyhedron
+         * @param computationPoints - the points of the block
+         * @return (points x faces) matrix of the constants d
+         */
+        std::vector<double> computePlaneConstants(const PreparedPolyhedron &prepared,
+                                                  const std::vector<Array3> &computationPoints);
+
+        /**
+         * Computes the 3D distances between every vertex and every point of a block.
+         * @param prepared - the PreparedPolyhedron
+         * @param computationPoints - the points of the block
+         * @return (points x vertices) matrix of the distances
+         */
+        std::vector<double> computeVertexDistances(const PreparedPolyhedron &prepared,
+                                                   const std::vector<Array3> &computationPoints);
+
+        /**
+         * Evaluates the geometric sums (i.e. the results for a unit density before the application of the prefix
+         * GRAVITATIONAL_CONSTANT * density) for multiple computation points.
+         * Rounding errors are already eliminated from the returned sums.
+         * @param prepared - the PreparedPolyhedron
+         * @param computationPoints - vector of computation points
+         * @param pointBlockSize - the number of computation points in one block
+         * @return the density-independent sums foreach computation Point P
+         * @throws std::invalid_argument if the block size is zero
+         */
+        std::vector<GravityModelResult> evaluateGeometricSums(
+                const PreparedPolyhedron &prepared,
+                const std::vector<Array3> &computationPoints,
+                size_t pointBlockSize = DEFAULT_POINT_BLOCK_SIZE);
+
+        /**
+         * Evaluates the polyhedral gravity model for a given constant density polyhedron at multiple computation
+         * points with the batched kernel.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoints - vector of computation points
+         * @param pointBlockSize - the number of computation points in one block
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * foreach computation Point P
+         * @throws std::invalid_argument if the block size is zero
+         */
+        std::vector<GravityModelResult> evaluate(
+                const Polyhedron &polyhedron,
+                double density,
+                const std::vector<Array3> &computationPoints,
+                size_t pointBlockSize = DEFAULT_POINT_BLOCK_SIZE);
+
+        namespace detail {
+
+            /**
+             * The number of columns of the result processed at once by the fallback matrix multiplication
+             */
+            constexpr size_t GEMM_BLOCK_SIZE = 256;
+
+            /**
+             * Computes the matrix product C = A x B^T for row-major matrices.
+             * @param m - the number of rows of A and C
+             * @param n - the number of rows of B and columns of C
+             * @param k - the number of columns of A and B
+             * @param a - the (m x k) matrix A
+             * @param b - the (n x k) matrix B
+             * @param c - the (m x n) matrix C (output)
+             */
+            void gemm(size_t m, size_t n, size_t k, const double *a, const double *b, double *c);
+
+        }
+
+    }
+
+}
@@ -0,0 +1,107 @@
+#include "CoalescingEvaluator.h"
+
+namespace polyhedralGravity {
+
+    CoalescingEvaluator::CoalescingEvaluator(const Polyhedron &polyhedron, double density,
+                                             std::chrono::microseconds maxWait, size_t maxBatchSize)
+            : _polyhedron{polyhedron},
+              _density{density},
+              _maxWait{maxWait},
+              _maxBatchSize{maxBatchSize},
+              _stopping{false},
+              _batches{0},
+              _requests{0} {
+        if (maxWait.count() < 0) {
+            throw std::invalid_argument{"The maximal wait of the CoalescingEvaluator must not be negative!"};
+        }
+        if (maxBatchSize == 0) {
+            throw std::invalid_argument{"The maximal batch size of the CoalescingEvaluator must be positive!"};
+        }
+        _dispatcher = std::thread{&CoalescingEvaluator::dispatch, this};
+    }
+
+    CoalescingEvaluator::~CoalescingEvaluator() {
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _stopping = true;
+        }
+        _signal.notify_all();
+        _dispatcher.join();
+    }
+
+    std::future<GravityModelResult> CoalescingEvaluator::submit(const Array3 &computationPoint) {
+        Request request{computationPoint, {}};
+        std::future<GravityModelResult> future = request.promise.get_future();
+        bool wakeUp;
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            if (_pending.empty()) {
+                _oldestArrival = std::chrono::steady_clock::now();
+            }
+            _pending.push_back(std::move(request));
+            //The dispatcher only needs to know about the first request of a batch and about a full batch
+            wakeUp = _pending.size() == 1 || _pending.size() >= _maxBatchSize;
+        }
+        if (wakeUp) {
+            _signal.notify_one();
+        }
+        return future;
+    }
+
+    GravityModelResult CoalescingEvaluator::evaluate(const Array3 &computationPoint) {
+        return submit(computationPoint).get();
+    }
+
+    size_t CoalescingEvaluator::countBatches() const {
+        std::lock_guard<std::mutex> lock{_mutex};
+        return _batches;
+    }
+
+    size_t CoalescingEvaluator::countRequests() const {
+        std::lock_guard<std::mutex> lock{_mutex};
+        return _requests;
+    }
+
+    void CoalescingEvaluator::dispatch() {
+        std::vector<Request> batch{};
+        std::vector<Array3> points{};
+        std::unique_lock<std::mutex> lock{_mutex};
+        while (true) {
+            _signal.wait(lock, [this] { return _stopping || !_pending.empty(); });
+            if (_pending.empty()) {
+                return;
+            }
+            //Waits for further requests until the batch is full or its oldest request has waited long enough
+            _signal.wait_until(lock, _oldestArrival + _maxWait,
+                               [this] { return _stopping || _pending.size() >= _maxBatchSize; });
+
+            const size_t batchSize = std::min(_pending.size(), _maxBatchSize);
+            batch.assign(std::make_move_iterator(_pending.begin()),
+                         std::make_move_iterator(_pending.begin() + batchSize));
+            _pending.erase(_pending.begin(), _pending.begin() + batchSize);
+            //Counted before the results are delivered, so that they include the batch once a future is ready
+            ++_batches;
+            _requests += batchSize;
+            //The remaining requests arrived while the batch was full, they have not waited for long
+            _oldestArrival = std::chrono::steady_clock::now();
+            lock.unlock();
+
+            points.resize(batch.size());
+            std::transform(batch.cbegin(), batch.cend(), points.begin(),
+                           [](const Request &request) { return request.point; });
+            std::vector<GravityModelResult> results{};
+            try {
+                results = GravityModel::evaluate(_polyhedron, _density, points);
+            } catch (...) {
+                for (Request &request: batch) {
+                    request.promise.set_exception(std::current_exception());
+                }
+            }
+            for (size_t i = 0; i < results.size(); ++i) {
+                batch[i].promise.set_value(results[i]);
+            }
+            lock.lock();
+        }
+    }
+
+}
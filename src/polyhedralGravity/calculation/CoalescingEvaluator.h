@@ -0,0 +1,181 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <future>
+#include <chrono>
+#include <condition_variable>
+#include <algorithm>
+#include <iterator>
+#include <exception>
+#include <stdexcept>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+
+namespace polyhedralGravity {
+
+    /**
+     * A thread-safe front-end of the polyhedral gravity model for many threads requesting one computation point at
+     * a time, e.g. the threads of a simulator. Instead of one parallel evaluation per point, whose parallel regions
+     * contend for the cores, the concurrent requests are collected and evaluated together by one dispatcher thread
+     * with the multi-point GravityModel::evaluate(..).
+     *
+     * A batch is evaluated once it holds the maximal batch size or once its oldest request has waited for the
+     * maximal wait, whichever comes first. The requests arriving during an evaluation form the next batch.
+     * The results are delivered via futures, i.e. every request only waits for its own batch.
+     *
+     * @note The polyhedron is referenced, not copied! It must outlive the evaluator.
+     * @example Hundreds of simulator threads propagating single particles around the same body
+     */
+    class CoalescingEvaluator {
+
+        /**
+         * One pending request
+         */
+        struct Request {
+
+            /**
+             * The computation point
+             */
+            Array3 point;
+
+            /**
+             * Receives the result
+             */
+            std::promise<GravityModelResult> promise;
+
+        };
+
+        /**
+         * The polyhedron to evaluate
+         */
+        const Polyhedron &_polyhedron;
+
+        /**
+         * The constant density in [kg/m^3]
+         */
+        const double _density;
+
+        /**
+         * The maximal time the oldest request of a batch waits for further requests
+         */
+        const std::chrono::microseconds _maxWait;
+
+        /**
+         * The maximal number of points per batch
+         */
+        const size_t _maxBatchSize;
+
+        /**
+         * Guards the pending requests, the stop flag and the statistics
+         */
+        mutable std::mutex _mutex;
+
+        /**
+         * Signals new requests and the stop to the dispatcher
+         */
+        std::condition_variable _signal;
+
+        /**
+         * The requests which are not yet taken by the dispatcher, in the order of their arrival
+         */
+        std::vector<Request> _pending;
+
+        /**
+         * The time when the oldest pending request arrived
+         */
+        std::chrono::steady_clock::time_point _oldestArrival;
+
+        /**
+         * Whether the dispatcher should finish
+         */
+        bool _stopping;
+
+        /**
+         * The number of evaluated batches
+         */
+        size_t _batches;
+
+        /**
+         * The number of evaluated requests
+         */
+        size_t _requests;
+
+        /**
+         * The thread evaluating the batches
+         */
+        std::thread _dispatcher;
+
+    public:
+
+        /**
+         * The default maximal wait of a request for further requests
+         */
+        static constexpr std::chrono::microseconds DEFAULT_MAX_WAIT{200};
+
+        /**
+         * The default maximal number of points per batch
+         */
+        static constexpr size_t DEFAULT_MAX_BATCH_SIZE = 1024;
+
+        /**
+         * Creates a new CoalescingEvaluator and starts its dispatcher thread.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces (referenced, not copied)
+         * @param density - the constant density in [kg/m^3]
+         * @param maxWait - the maximal time the oldest request of a batch waits for further requests, zero evaluates
+         * whatever is pending as soon as the dispatcher is idle
+         * @param maxBatchSize - the maximal number of points per batch
+         * @throws std::invalid_argument if the maximal wait is negative or the maximal batch size is zero
+         */
+        CoalescingEvaluator(const Polyhedron &polyhedron, double density,
+                            std::chrono::microseconds maxWait = DEFAULT_MAX_WAIT,
+                            size_t maxBatchSize = DEFAULT_MAX_BATCH_SIZE);
+
+        /**
+         * Evaluates the pending requests and stops the dispatcher thread.
+         */
+        ~CoalescingEvaluator();
+
+        CoalescingEvaluator(const CoalescingEvaluator &) = delete;
+
+        CoalescingEvaluator &operator=(const CoalescingEvaluator &) = delete;
+
+        /**
+         * Requests the evaluation of a computation point. May be called from any number of threads.
+         * @param computationPoint - the computation Point P
+         * @return the future GravityModelResult at computation Point P, which rethrows the exception of a failed
+         * evaluation
+         */
+        std::future<GravityModelResult> submit(const Array3 &computationPoint);
+
+        /**
+         * Evaluates a computation point together with the concurrent requests and waits for the result.
+         * @param computationPoint - the computation Point P
+         * @return the GravityModelResult at computation Point P
+         */
+        GravityModelResult evaluate(const Array3 &computationPoint);
+
+        /**
+         * Returns the number of evaluated batches.
+         * @return number of batches
+         */
+        [[nodiscard]] size_t countBatches() const;
+
+        /**
+         * Returns the number of evaluated requests.
+         * @return number of requests
+         */
+        [[nodiscard]] size_t countRequests() const;
+
+    private:
+
+        /**
+         * Collects and evaluates the batches until the evaluator is destroyed.
+         */
+        void dispatch();
+
+    };
+
+}
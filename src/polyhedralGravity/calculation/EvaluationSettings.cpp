@@ -0,0 +1,377 @@
+#include "EvaluationSettings.h"
+
+namespace polyhedralGravity {
+
+    namespace {
+
+        /**
+         * The currently selected reduction mode
+         */
+        std::atomic<ReductionMode> reductionMode{ReductionMode::DEFAULT};
+
+        /**
+         * The currently selected kernel for multiple computation points
+         */
+        std::atomic<KernelVariant> kernelVariant{KernelVariant::AUTO};
+
+        /**
+         * The currently selected implementation of the transcendental functions
+         */
+        std::atomic<MathBackend> mathBackend{MathBackend::ACCURATE};
+
+        /**
+         * The currently selected accuracy of the far-field approximation, zero if disabled
+         */
+        std::atomic<double> farFieldAccuracy{0.0};
+
+        /**
+         * The currently selected distribution of the blocks of computation points
+         */
+        std::atomic<SchedulingMode> schedulingMode{SchedulingMode::STATIC};
+
+        /**
+         * The currently selected parallelization of the loops
+         */
+        std::atomic<ParallelBackend> parallelBackend{ParallelBackend::DEFAULT};
+
+        /**
+         * The currently selected number of threads, zero for all hardware threads
+         */
+        std::atomic<size_t> threadCount{0};
+
+        /**
+         * The currently selected number of loop iterations per task, zero for automatic
+         */
+        std::atomic<size_t> grainSize{0};
+
+        /**
+         * The currently selected number of faces from which on a single point is evaluated in parallel, zero for
+         * the calibrated one
+         */
+        std::atomic<size_t> serialFaceThreshold{0};
+
+        /**
+         * The currently selected loop parallelized by the pointwise evaluation of multiple points
+         */
+        std::atomic<ParallelAxis> parallelAxis{ParallelAxis::AUTO};
+
+        /**
+         * The currently selected architecture of the SIMD kernels, AUTO for the detected one
+         */
+        std::atomic<SimdArchitecture> simdArchitecture{SimdArchitecture::AUTO};
+
+        /**
+         * The rank of the instruction set which the compiler already targets, a dispatched architecture is only
+         * preferred over GENERIC if it is wider
+         */
+#if defined(__AVX512F__)
+        constexpr int GENERIC_RANK = 3;
+#elif defined(__AVX2__) && defined(__FMA__)
+        constexpr int GENERIC_RANK = 2;
+#elif defined(__SSE4_2__)
+        constexpr int GENERIC_RANK = 1;
+#else
+        constexpr int GENERIC_RANK = 0;
+#endif
+
+    }
+
+    void EvaluationSettings::setReductionMode(ReductionMode mode) {
+        reductionMode.store(mode);
+    }
+
+    ReductionMode EvaluationSettings::getReductionMode() {
+        return reductionMode.load();
+    }
+
+    ReductionMode EvaluationSettings::parseReductionMode(const std::string &name) {
+        if (name == "DEFAULT") {
+            return ReductionMode::DEFAULT;
+        } else if (name == "DETERMINISTIC") {
+            return ReductionMode::DETERMINISTIC;
+        }
+        throw std::invalid_argument{"Unknown reduction mode: " + name + "! Use DEFAULT or DETERMINISTIC."};
+    }
+
+    void EvaluationSettings::setKernelVariant(KernelVariant variant) {
+        kernelVariant.store(variant);
+    }
+
+    KernelVariant EvaluationSettings::getKernelVariant() {
+        return kernelVariant.load();
+    }
+
+    KernelVariant EvaluationSettings::parseKernelVariant(const std::string &name) {
+        if (name == "AUTO") {
+            return KernelVariant::AUTO;
+        } else if (name == "POINTWISE") {
+            return KernelVariant::POINTWISE;
+        } else if (name == "TILED") {
+            return KernelVariant::TILED;
+        } else if (name == "BATCHED") {
+            return KernelVariant::BATCHED;
+        } else if (name == "POINT_LANES") {
+            return KernelVariant::POINT_LANES;
+        }
+        throw std::invalid_argument{"Unknown kernel variant: " + name +
+                                    "! Use AUTO, POINTWISE, TILED, BATCHED or POINT_LANES."};
+    }
+
+    std::string EvaluationSettings::toString(KernelVariant variant) {
+        switch (variant) {
+            case KernelVariant::POINTWISE:
+                return "POINTWISE";
+            case KernelVariant::TILED:
+                return "TILED";
+            case KernelVariant::BATCHED:
+                return "BATCHED";
+            case KernelVariant::POINT_LANES:
+                return "POINT_LANES";
+            default:
+                return "AUTO";
+        }
+    }
+
+    void EvaluationSettings::setMathBackend(MathBackend backend) {
+        mathBackend.store(backend);
+    }
+
+    MathBackend EvaluationSettings::getMathBackend() {
+        return mathBackend.load();
+    }
+
+    MathBackend EvaluationSettings::parseMathBackend(const std::string &name) {
+        if (name == "ACCURATE") {
+            return MathBackend::ACCURATE;
+        } else if (name == "FAST") {
+            return MathBackend::FAST;
+        }
+        throw std::invalid_argument{"Unknown math backend: " + name + "! Use ACCURATE or FAST."};
+    }
+
+    void EvaluationSettings::setFarFieldAccuracy(double accuracy) {
+        if (!(accuracy >= 0.0 && accuracy < 1.0)) {
+            throw std::invalid_argument{"The accuracy of the far-field approximation must be in [0, 1)!"};
+        }
+        farFieldAccuracy.store(accuracy);
+    }
+
+    double EvaluationSettings::getFarFieldAccuracy() {
+        return farFieldAccuracy.load();
+    }
+
+    FaceApproximations EvaluationSettings::getFaceApproximations() {
+        return {mathBackend.load(), farFieldAccuracy.load()};
+    }
+
+    void EvaluationSettings::setSchedulingMode(SchedulingMode mode) {
+        schedulingMode.store(mode);
+    }
+
+    SchedulingMode EvaluationSettings::getSchedulingMode() {
+        return schedulingMode.load();
+    }
+
+    SchedulingMode EvaluationSettings::parseSchedulingMode(const std::string &name) {
+        if (name == "STATIC") {
+            return SchedulingMode::STATIC;
+        } else if (name == "WORK_STEALING") {
+            return SchedulingMode::WORK_STEALING;
+        }
+        throw std::invalid_argument{"Unknown scheduling mode: " + name + "! Use STATIC or WORK_STEALING."};
+    }
+
+    bool EvaluationSettings::isParallelBackendAvailable(ParallelBackend backend) {
+        switch (backend) {
+            case ParallelBackend::OPENMP:
+#ifdef POLYHEDRAL_GRAVITY_RUNTIME_OMP
+                return true;
+#else
+                return false;
+#endif
+            case ParallelBackend::TBB:
+#ifdef POLYHEDRAL_GRAVITY_RUNTIME_TBB
+                return true;
+#else
+                return false;
+#endif
+            default:
+                return true;
+        }
+    }
+
+    void EvaluationSettings::setParallelBackend(ParallelBackend backend) {
+        if (!isParallelBackendAvailable(backend)) {
+            throw std::invalid_argument{"The parallel backend " + toString(backend) + " is not available in this "
+                                        "build! Configure with POLYHEDRAL_GRAVITY_RUNTIME_OMP or "
+                                        "POLYHEDRAL_GRAVITY_RUNTIME_TBB."};
+        }
+        parallelBackend.store(backend);
+    }
+
+    ParallelBackend EvaluationSettings::getParallelBackend() {
+        return parallelBackend.load();
+    }
+
+    ParallelBackend EvaluationSettings::parseParallelBackend(const std::string &name) {
+        if (name == "DEFAULT") {
+            return ParallelBackend::DEFAULT;
+        } else if (name == "SERIAL") {
+            return ParallelBackend::SERIAL;
+        } else if (name == "THREADS") {
+            return ParallelBackend::THREADS;
+        } else if (name == "OPENMP") {
+            return ParallelBackend::OPENMP;
+        } else if (name == "TBB") {
+            return ParallelBackend::TBB;
+        }
+        throw std::invalid_argument{"Unknown parallel backend: " + name +
+                                    "! Use DEFAULT, SERIAL, THREADS, OPENMP or TBB."};
+    }
+
+    std::string EvaluationSettings::toString(ParallelBackend backend) {
+        switch (backend) {
+            case ParallelBackend::SERIAL:
+                return "SERIAL";
+            case ParallelBackend::THREADS:
+                return "THREADS";
+            case ParallelBackend::OPENMP:
+                return "OPENMP";
+            case ParallelBackend::TBB:
+                return "TBB";
+            default:
+                return "DEFAULT";
+        }
+    }
+
+    void EvaluationSettings::setThreadCount(size_t count) {
+        threadCount.store(count);
+    }
+
+    size_t EvaluationSettings::getThreadCount() {
+        return threadCount.load();
+    }
+
+    void EvaluationSettings::setGrainSize(size_t size) {
+        grainSize.store(size);
+    }
+
+    size_t EvaluationSettings::getGrainSize() {
+        return grainSize.load();
+    }
+
+    void EvaluationSettings::setSerialFaceThreshold(size_t faceCount) {
+        serialFaceThreshold.store(faceCount);
+    }
+
+    size_t EvaluationSettings::getSerialFaceThreshold() {
+        return serialFaceThreshold.load();
+    }
+
+    void EvaluationSettings::setParallelAxis(ParallelAxis axis) {
+        parallelAxis.store(axis);
+    }
+
+    ParallelAxis EvaluationSettings::getParallelAxis() {
+        return parallelAxis.load();
+    }
+
+    ParallelAxis EvaluationSettings::parseParallelAxis(const std::string &name) {
+        if (name == "AUTO") {
+            return ParallelAxis::AUTO;
+        } else if (name == "POINTS") {
+            return ParallelAxis::POINTS;
+        } else if (name == "FACES") {
+            return ParallelAxis::FACES;
+        }
+        throw std::invalid_argument{"Unknown parallel axis: " + name + "! Use AUTO, POINTS or FACES."};
+    }
+
+    bool EvaluationSettings::isSimdArchitectureAvailable(SimdArchitecture architecture) {
+        if (architecture == SimdArchitecture::AUTO || architecture == SimdArchitecture::GENERIC) {
+            return true;
+        }
+#ifdef POLYHEDRAL_GRAVITY_SIMD_DISPATCH
+        //xsimd queries CPUID (and the OS support of the extended registers)
+        const auto supported = xsimd::available_architectures();
+        switch (architecture) {
+            case SimdArchitecture::SSE4_2:
+                return supported.sse4_2;
+            case SimdArchitecture::AVX2_FMA:
+                return supported.fma3_avx2;
+            case SimdArchitecture::AVX512F:
+                return supported.avx512f;
+            default:
+                return false;
+        }
+#else
+        return false;
+#endif
+    }
+
+    SimdArchitecture EvaluationSettings::detectSimdArchitecture() {
+        static const SimdArchitecture detected = [] {
+            SimdArchitecture best = SimdArchitecture::GENERIC;
+            int rank = GENERIC_RANK;
+            const std::array<SimdArchitecture, 3> candidates{SimdArchitecture::SSE4_2, SimdArchitecture::AVX2_FMA,
+                                                             SimdArchitecture::AVX512F};
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                if (static_cast<int>(i) + 1 > rank && isSimdArchitectureAvailable(candidates[i])) {
+                    best = candidates[i];
+                    rank = static_cast<int>(i) + 1;
+                }
+            }
+            SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                               "Detected {} as the best SIMD architecture of this machine", toString(best));
+            return best;
+        }();
+        return detected;
+    }
+
+    void EvaluationSettings::setSimdArchitecture(SimdArchitecture architecture) {
+        if (!isSimdArchitectureAvailable(architecture)) {
+            throw std::invalid_argument{"The SIMD architecture " + toString(architecture) + " is not available on "
+                                        "this machine or not compiled into this build!"};
+        }
+        simdArchitecture.store(architecture);
+        SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                           "The SIMD kernels use the architecture {}", toString(getSimdArchitecture()));
+    }
+
+    SimdArchitecture EvaluationSettings::getSimdArchitecture() {
+        const SimdArchitecture architecture = simdArchitecture.load();
+        return architecture == SimdArchitecture::AUTO ? detectSimdArchitecture() : architecture;
+    }
+
+    SimdArchitecture EvaluationSettings::parseSimdArchitecture(const std::string &name) {
+        if (name == "AUTO") {
+            return SimdArchitecture::AUTO;
+        } else if (name == "GENERIC") {
+            return SimdArchitecture::GENERIC;
+        } else if (name == "SSE4_2") {
+            return SimdArchitecture::SSE4_2;
+        } else if (name == "AVX2_FMA") {
+            return SimdArchitecture::AVX2_FMA;
+        } else if (name == "AVX512F") {
+            return SimdArchitecture::AVX512F;
+        }
+        throw std::invalid_argument{"Unknown SIMD architecture: " + name +
+                                    "! Use AUTO, GENERIC, SSE4_2, AVX2_FMA or AVX512F."};
+    }
+
+    std::string EvaluationSettings::toString(SimdArchitecture architecture) {
+        switch (architecture) {
+            case SimdArchitecture::GENERIC:
+                return "GENERIC";
+            case SimdArchitecture::SSE4_2:
+                return "SSE4_2";
+            case SimdArchitecture::AVX2_FMA:
+                return "AVX2_FMA";
+            case SimdArchitecture::AVX512F:
+                return "AVX512F";
+            default:
+                return "AUTO";
+        }
+    }
+
+}
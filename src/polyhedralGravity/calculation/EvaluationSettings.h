@@ -0,0 +1,503 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include "polyhedralGravity/output/Logging.h"
+#include "xsimd/xsimd.hpp"
+
+namespace polyhedralGravity {
+
+    /**
+     * The order in which the contributions of the faces are summed up for one computation point.
+     */
+    enum class ReductionMode {
+
+        /**
+         * The reduction of thrust, its association order depends on the backend and the number of threads.
+         * The results may differ in the last bits between runs and machines.
+         */
+        DEFAULT,
+
+        /**
+         * The faces are split into blocks of fixed size, which are summed up in index order and in parallel.
+         * The partial sums of the blocks are then combined by a pairwise tree of fixed shape.
+         * The association order only depends on the number of faces, so the results are bitwise reproducible
+         * independent of the backend and the number of threads.
+         */
+        DETERMINISTIC
+
+    };
+
+    /**
+     * The kernel used to evaluate multiple computation points at once.
+     */
+    enum class KernelVariant {
+
+        /**
+         * Chooses the kernel from the shape of the call if the reduction mode is DEFAULT: POINT_LANES for small
+         * polyhedrons and many computation points (unless MathBackend::FAST or a far-field accuracy is set), TILED
+         * for large polyhedrons and many computation points, POINTWISE otherwise
+         */
+        AUTO,
+
+        /**
+         * Evaluates the points one after another, the faces of every point are evaluated in parallel
+         */
+        POINTWISE,
+
+        /**
+         * Evaluates blocks of points against blocks of faces which fit into the caches, the blocks of points
+         * are evaluated in parallel (see TiledKernel)
+         */
+        TILED,
+
+        /**
+         * Computes the plane and vertex distances of a block of points by matrix products and evaluates the
+         * remaining per-face work afterwards, the blocks of points are evaluated in parallel (see BatchedKernel),
+         * always with SchedulingMode::STATIC
+         */
+        BATCHED,
+
+        /**
+         * Maps the SIMD lanes to computation points and evaluates one face after another for a batch of points
+         * (see PointLaneKernel), ignores MathBackend::FAST and the far-field accuracy
+         */
+        POINT_LANES
+
+    };
+
+    /**
+     * The implementation of the transcendental functions in the per-face computation.
+     */
+    enum class MathBackend {
+
+        /**
+         * std::log(..) and xsimd::atan(..) with the full accuracy of the math library
+         */
+        ACCURATE,
+
+        /**
+         * Branch-free polynomial approximations of log(..) and atan(..) with a relative error below
+         * util::FAST_MATH_MAX_RELATIVE_ERROR (see UtilityFastMath.h). Close to the polyhedron, the results differ
+         * from the ones of ACCURATE by less than 1e-10 relative. Far away, the differences grow like the
+         * cancellation in the sum over the faces, to which the results of ACCURATE are equally sensitive.
+         */
+        FAST
+
+    };
+
+    /**
+     * The distribution of the blocks of computation points over the threads by the kernels for multiple points.
+     */
+    enum class SchedulingMode {
+
+        /**
+         * The blocks are handed to ParallelExecution::forEach(..) of the configured ParallelBackend
+         */
+        STATIC,
+
+        /**
+         * The points are sorted by their estimated cost into coherent blocks, which are distributed over
+         * per-thread deques with work stealing (see WorkStealingScheduler). Only the TiledKernel schedules its
+         * blocks this way, the other kernels always use STATIC.
+         */
+        WORK_STEALING
+
+    };
+
+    /**
+     * The parallelization of the loops over faces and blocks of computation points (see ParallelExecution).
+     */
+    enum class ParallelBackend {
+
+        /**
+         * The thrust backend chosen at configure time with POLYHEDRAL_GRAVITY_PARALLELIZATION, the thread count
+         * and the grain size of the EvaluationSettings do not apply
+         */
+        DEFAULT,
+
+        /**
+         * A plain loop on the calling thread
+         */
+        SERIAL,
+
+        /**
+         * The built-in pool of std::threads with work stealing (see WorkStealingScheduler), always available
+         */
+        THREADS,
+
+        /**
+         * OpenMP with dynamic scheduling, only available if configured with POLYHEDRAL_GRAVITY_RUNTIME_OMP
+         */
+        OPENMP,
+
+        /**
+         * TBB in a task arena, only available if configured with POLYHEDRAL_GRAVITY_RUNTIME_TBB
+         */
+        TBB
+
+    };
+
+    /**
+     * The loop which is parallelized by the pointwise evaluation of multiple computation points
+     * (KernelVariant::POINTWISE).
+     */
+    enum class ParallelAxis {
+
+        /**
+         * Chooses the axis from the shape of the call: POINTS if there are at least as many points as threads,
+         * FACES otherwise
+         */
+        AUTO,
+
+        /**
+         * The points are evaluated in parallel, the faces of every point serially on its thread
+         */
+        POINTS,
+
+        /**
+         * The points are evaluated one after another, the faces of every point in parallel if there are at least
+         * as many as the serial face threshold
+         */
+        FACES
+
+    };
+
+    /**
+     * The instruction set of the SIMD kernels (PointLaneKernel and MasconModel).
+     * Apart from GENERIC, the kernels are compiled for every instruction set into the same library if configured
+     * with POLYHEDRAL_GRAVITY_SIMD_DISPATCH, so a portable build still uses the widest registers of the machine.
+     */
+    enum class SimdArchitecture {
+
+        /**
+         * The best architecture supported by the CPU, detected once via CPUID
+         */
+        AUTO,
+
+        /**
+         * The instruction set targeted by the compiler, e.g. SSE2 for a portable x86-64 build
+         */
+        GENERIC,
+
+        /**
+         * SSE4.2 with two lanes of doubles
+         */
+        SSE4_2,
+
+        /**
+         * AVX2 and FMA with four lanes of doubles
+         */
+        AVX2_FMA,
+
+        /**
+         * AVX-512 Foundation with eight lanes of doubles
+         */
+        AVX512F
+
+    };
+
+    /**
+     * The approximations of the per-face computation. The kernels which accept them take them as an argument
+     * instead of reading the process-wide EvaluationSettings, so that a caller may choose them per evaluation.
+     */
+    struct FaceApproximations {
+
+        /**
+         * The implementation of the transcendental functions
+         */
+        MathBackend mathBackend{MathBackend::ACCURATE};
+
+        /**
+         * The accuracy of the far-field approximation of single faces, zero if disabled
+         */
+        double farFieldAccuracy{0.0};
+
+    };
+
+    /**
+     * Process-wide settings of the evaluation of the polyhedral gravity model.
+     * The settings are read at the beginning of every evaluation and may be changed from any thread.
+     */
+    namespace EvaluationSettings {
+
+        /**
+         * Sets the reduction mode used for the sum over the faces.
+         * @param mode - the ReductionMode
+         */
+        void setReductionMode(ReductionMode mode);
+
+        /**
+         * Returns the reduction mode used for the sum over the faces.
+         * @return the ReductionMode, DEFAULT if never set
+         */
+        ReductionMode getReductionMode();
+
+        /**
+         * Parses a reduction mode from its name (case-sensitive, like the enumerator).
+         * @param name - either "DEFAULT" or "DETERMINISTIC"
+         * @return the ReductionMode
+         * @throws std::invalid_argument if the name is unknown
+         */
+        ReductionMode parseReductionMode(const std::string &name);
+
+        /**
+         * Sets the kernel used to evaluate multiple computation points at once.
+         * @param variant - the KernelVariant
+         */
+        void setKernelVariant(KernelVariant variant);
+
+        /**
+         * Returns the kernel used to evaluate multiple computation points at once.
+         * @return the KernelVariant, AUTO if never set
+         */
+        KernelVariant getKernelVariant();
+
+        /**
+         * Parses a kernel variant from its name (case-sensitive, like the enumerator).
+         * @param name - either "AUTO", "POINTWISE", "TILED", "BATCHED" or "POINT_LANES"
+         * @return the KernelVariant
+         * @throws std::invalid_argument if the name is unknown
+         */
+        KernelVariant parseKernelVariant(const std::string &name);
+
+        /**
+         * Returns the name of a kernel variant, the inverse of parseKernelVariant(..).
+         * @param variant - the KernelVariant
+         * @return the name of the enumerator
+         */
+        std::string toString(KernelVariant variant);
+
+        /**
+         * Sets the implementation of the transcendental functions.
+         * @param backend - the MathBackend
+         */
+        void setMathBackend(MathBackend backend);
+
+        /**
+         * Returns the implementation of the transcendental functions.
+         * @return the MathBackend, ACCURATE if never set
+         */
+        MathBackend getMathBackend();
+
+        /**
+         * Parses a math backend from its name (case-sensitive, like the enumerator).
+         * @param name - either "ACCURATE" or "FAST"
+         * @return the MathBackend
+         * @throws std::invalid_argument if the name is unknown
+         */
+        MathBackend parseMathBackend(const std::string &name);
+
+        /**
+         * Sets the accuracy of the far-field approximation of single faces. A face whose size is small compared
+         * to its distance from the computation point is evaluated by its area and second moment instead of
+         * the line integrals, if the error of its contribution is below this accuracy relative to the
+         * contribution (see GravityModel::detail::isFarField(..)).
+         * @param accuracy - the relative accuracy in [0, 1), zero disables the approximation
+         * @throws std::invalid_argument if the accuracy is not in [0, 1)
+         */
+        void setFarFieldAccuracy(double accuracy);
+
+        /**
+         * Returns the accuracy of the far-field approximation of single faces.
+         * @return the relative accuracy, zero (disabled) if never set
+         */
+        double getFarFieldAccuracy();
+
+        /**
+         * Returns the current math backend and far-field accuracy together.
+         * @return the FaceApproximations of these settings
+         */
+        FaceApproximations getFaceApproximations();
+
+        /**
+         * Sets the distribution of the blocks of computation points over the threads.
+         * @param mode - the SchedulingMode
+         */
+        void setSchedulingMode(SchedulingMode mode);
+
+        /**
+         * Returns the distribution of the blocks of computation points over the threads.
+         * @return the SchedulingMode, STATIC if never set
+         */
+        SchedulingMode getSchedulingMode();
+
+        /**
+         * Parses a scheduling mode from its name (case-sensitive, like the enumerator).
+         * @param name - either "STATIC" or "WORK_STEALING"
+         * @return the SchedulingMode
+         * @throws std::invalid_argument if the name is unknown
+         */
+        SchedulingMode parseSchedulingMode(const std::string &name);
+
+        /**
+         * Returns if a parallel backend is compiled into this build.
+         * @param backend - the ParallelBackend
+         * @return true if the backend can be selected
+         */
+        bool isParallelBackendAvailable(ParallelBackend backend);
+
+        /**
+         * Sets the parallelization of the loops over faces and blocks of computation points.
+         * @param backend - the ParallelBackend
+         * @throws std::invalid_argument if the backend is not compiled into this build
+         */
+        void setParallelBackend(ParallelBackend backend);
+
+        /**
+         * Returns the parallelization of the loops over faces and blocks of computation points.
+         * @return the ParallelBackend, DEFAULT if never set
+         */
+        ParallelBackend getParallelBackend();
+
+        /**
+         * Parses a parallel backend from its name (case-sensitive, like the enumerator).
+         * @param name - either "DEFAULT", "SERIAL", "THREADS", "OPENMP" or "TBB"
+         * @return the ParallelBackend
+         * @throws std::invalid_argument if the name is unknown
+         */
+        ParallelBackend parseParallelBackend(const std::string &name);
+
+        /**
+         * Returns the name of a parallel backend, the inverse of parseParallelBackend(..).
+         * @param backend - the ParallelBackend
+         * @return the name of the enumerator
+         */
+        std::string toString(ParallelBackend backend);
+
+        /**
+         * Sets the number of threads used by the backends SERIAL, THREADS, OPENMP and TBB (and by the
+         * WorkStealingScheduler of SchedulingMode::WORK_STEALING).
+         * @param threadCount - the number of threads, zero uses all hardware threads
+         */
+        void setThreadCount(size_t threadCount);
+
+        /**
+         * Returns the number of threads used by the backends.
+         * @return the number of threads, zero (all hardware threads) if never set
+         */
+        size_t getThreadCount();
+
+        /**
+         * Sets the number of consecutive loop iterations (e.g. faces) which are processed as one task.
+         * @param grainSize - the number of iterations per task, zero chooses about four tasks per thread
+         */
+        void setGrainSize(size_t grainSize);
+
+        /**
+         * Returns the number of consecutive loop iterations processed as one task.
+         * @return the number of iterations, zero (automatic) if never set
+         */
+        size_t getGrainSize();
+
+        /**
+         * Sets the number of faces from which on the faces of a single computation point are evaluated in parallel.
+         * Below it, the loop over the faces runs serially on the calling thread, since the start of a parallel
+         * region costs more than the work itself, e.g. for a model of 1k faces evaluated once per step of a
+         * control loop.
+         * @param faceCount - the threshold, zero calibrates it once per backend and thread count (see
+         * GravityModel::calibrateSerialFaceThreshold()), one always parallelizes
+         */
+        void setSerialFaceThreshold(size_t faceCount);
+
+        /**
+         * Returns the number of faces from which on the faces of a single computation point are evaluated in
+         * parallel.
+         * @return the threshold, zero (calibrated) if never set
+         */
+        size_t getSerialFaceThreshold();
+
+        /**
+         * Sets the loop which is parallelized by the pointwise evaluation of multiple computation points.
+         * @param axis - the ParallelAxis
+         */
+        void setParallelAxis(ParallelAxis axis);
+
+        /**
+         * Returns the loop which is parallelized by the pointwise evaluation of multiple computation points.
+         * @return the ParallelAxis, AUTO if never set
+         */
+        ParallelAxis getParallelAxis();
+
+        /**
+         * Parses a parallel axis from its name (case-sensitive, like the enumerator).
+         * @param name - either "AUTO", "POINTS" or "FACES"
+         * @return the ParallelAxis
+         * @throws std::invalid_argument if the name is unknown
+         */
+        ParallelAxis parseParallelAxis(const std::string &name);
+
+        /**
+         * Returns if the SIMD kernels can run with an architecture, i.e. if they are compiled for it and the CPU
+         * supports it.
+         * @param architecture - the SimdArchitecture
+         * @return true if the architecture can be selected
+         */
+        bool isSimdArchitectureAvailable(SimdArchitecture architecture);
+
+        /**
+         * Returns the widest architecture which is available on this machine. The detection runs once and its
+         * result is logged.
+         * @return the detected SimdArchitecture, never AUTO
+         */
+        SimdArchitecture detectSimdArchitecture();
+
+        /**
+         * Sets the architecture of the SIMD kernels, e.g. to compare the variants or to enforce the same results
+         * on all nodes of a heterogeneous cluster.
+         * @param architecture - the SimdArchitecture, AUTO uses detectSimdArchitecture()
+         * @throws std::invalid_argument if the architecture is not available on this machine
+         */
+        void setSimdArchitecture(SimdArchitecture architecture);
+
+        /**
+         * Returns the architecture used by the SIMD kernels.
+         * @return the SimdArchitecture, never AUTO
+         */
+        SimdArchitecture getSimdArchitecture();
+
+        /**
+         * Parses a SIMD architecture from its name (case-sensitive, like the enumerator).
+         * @param name - either "AUTO", "GENERIC", "SSE4_2", "AVX2_FMA" or "AVX512F"
+         * @return the SimdArchitecture
+         * @throws std::invalid_argument if the name is unknown
+         */
+        SimdArchitecture parseSimdArchitecture(const std::string &name);
+
+        /**
+         * Returns the name of a SIMD architecture, the inverse of parseSimdArchitecture(..).
+         * @param architecture - the SimdArchitecture
+         * @return the name of the enumerator
+         */
+        std::string toString(SimdArchitecture architecture);
+
+        /**
+         * Calls a generic function with the xsimd architecture tag of getSimdArchitecture().
+         * The function must only call code which is instantiated for the architecture in a translation unit
+         * compiled with the matching instruction set (see simd/SimdKernels.h).
+         * @tparam Function - generic callable with an xsimd architecture tag
+         * @param function - the function, e.g. [&](auto arch) { return kernel<decltype(arch)>(..); }
+         * @return the result of the function
+         */
+        template<typename Function>
+        decltype(auto) dispatchSimdArchitecture(const Function &function) {
+            switch (getSimdArchitecture()) {
+#ifdef POLYHEDRAL_GRAVITY_SIMD_DISPATCH
+                case SimdArchitecture::SSE4_2:
+                    return function(xsimd::sse4_2{});
+                case SimdArchitecture::AVX2_FMA:
+                    return function(xsimd::fma3<xsimd::avx2>{});
+                case SimdArchitecture::AVX512F:
+                    return function(xsimd::avx512f{});
+#endif
+                default:
+                    return function(xsimd::default_arch{});
+            }
+        }
+
+    }
+
+}
@@ -0,0 +1,134 @@
+#include "GeometricSumCache.h"
+
+namespace polyhedralGravity {
+
+    GeometricSumCache::Handle GeometricSumCache::prepare(const Polyhedron &polyhedron) {
+        return {polyhedron, hashPolyhedron(polyhedron)};
+    }
+
+    GravityModelResult GeometricSumCache::evaluate(
+            const Handle &polyhedron, double density, const Array3 &computationPoint) {
+        const CacheKey key = makeKey(polyhedron, computationPoint);
+        GravityModelResult geometricSums{};
+        if (!lookup(key, geometricSums)) {
+            geometricSums = GravityModel::detail::evaluateGeometricSums(polyhedron.getPolyhedron(), computationPoint);
+            if (isCacheable(computationPoint)) {
+                std::unique_lock lock{_mutex};
+                _entries.emplace(key, geometricSums);
+            }
+        }
+        return GravityModel::detail::applyDensityPrefix(geometricSums, density);
+    }
+
+    std::vector<GravityModelResult> GeometricSumCache::evaluate(
+            const Handle &polyhedron, double density, const std::vector<Array3> &computationPoints) {
+        std::vector<GravityModelResult> result{computationPoints.size()};
+
+        //1. Step: Take everything available from the cache, remember the indices of the missing points
+        //The settings are read once, so that all points of the call share them
+        const CacheKey settingsKey = makeKey(polyhedron, {});
+        const auto keyOf = [&settingsKey](const Array3 &computationPoint) {
+            CacheKey key = settingsKey;
+            key.computationPoint = computationPoint;
+            return key;
+        };
+        std::vector<size_t> missingIndices{};
+        for (size_t index = 0; index < computationPoints.size(); ++index) {
+            if (!lookup(keyOf(computationPoints[index]), result[index])) {
+                missingIndices.push_back(index);
+            }
+        }
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Geometric sum cache: {} of {} computation points need to be evaluated",
+                            missingIndices.size(), computationPoints.size());
+
+        //2. Step: Evaluate the missing geometric sums and store them
+        //The missing points are evaluated at once, so that the kernel is chosen like by GravityModel::evaluate(..)
+        std::vector<Array3> missingPoints{missingIndices.size()};
+        std::transform(missingIndices.cbegin(), missingIndices.cend(), missingPoints.begin(),
+                       [&computationPoints](size_t index) { return computationPoints[index]; });
+        const std::vector<GravityModelResult> missingSums =
+                GravityModel::detail::evaluateGeometricSums(polyhedron.getPolyhedron(), missingPoints);
+        {
+            std::unique_lock lock{_mutex};
+            for (size_t i = 0; i < missingIndices.size(); ++i) {
+                const Array3 &computationPoint = computationPoints[missingIndices[i]];
+                result[missingIndices[i]] = missingSums[i];
+                if (isCacheable(computationPoint)) {
+                    _entries.emplace(keyOf(computationPoint), missingSums[i]);
+                }
+            }
+        }
+
+        //3. Step: Rescale all sums with the given density
+        std::transform(result.begin(), result.end(), result.begin(), [density](const GravityModelResult &sums) {
+            return GravityModel::detail::applyDensityPrefix(sums, density);
+        });
+        return result;
+    }
+
+    GravityModelResult GeometricSumCache::evaluate(
+            const Polyhedron &polyhedron, double density, const Array3 &computationPoint) {
+        return evaluate(prepare(polyhedron), density, computationPoint);
+    }
+
+    std::vector<GravityModelResult> GeometricSumCache::evaluate(
+            const Polyhedron &polyhedron, double density, const std::vector<Array3> &computationPoints) {
+        return evaluate(prepare(polyhedron), density, computationPoints);
+    }
+
+    void GeometricSumCache::clear() {
+        std::unique_lock lock{_mutex};
+        _entries.clear();
+        _hits = 0;
+        _misses = 0;
+    }
+
+    size_t GeometricSumCache::size() const {
+        std::shared_lock lock{_mutex};
+        return _entries.size();
+    }
+
+    std::uint64_t GeometricSumCache::hashPolyhedron(const Polyhedron &polyhedron) {
+        constexpr std::uint64_t fnvOffsetBasis = 14695981039346656037ULL;
+        constexpr std::uint64_t fnvPrime = 1099511628211ULL;
+        std::uint64_t hash = fnvOffsetBasis;
+        const auto hashBytes = [&hash](const void *data, size_t length) {
+            const auto *bytes = static_cast<const unsigned char *>(data);
+            for (size_t i = 0; i < length; ++i) {
+                hash ^= bytes[i];
+                hash *= fnvPrime;
+            }
+        };
+        const auto &vertices = polyhedron.getVertices();
+        const auto &faces = polyhedron.getFaces();
+        const std::array<size_t, 2> sizes{vertices.size(), faces.size()};
+        hashBytes(sizes.data(), sizeof(sizes));
+        hashBytes(vertices.data(), vertices.size() * sizeof(Array3));
+        hashBytes(faces.data(), faces.size() * sizeof(std::array<size_t, 3>));
+        return hash;
+    }
+
+    bool GeometricSumCache::isCacheable(const Array3 &computationPoint) {
+        return std::all_of(computationPoint.cbegin(), computationPoint.cend(),
+                           [](double coordinate) { return std::isfinite(coordinate); });
+    }
+
+    GeometricSumCache::CacheKey GeometricSumCache::makeKey(const Handle &polyhedron, const Array3 &computationPoint) {
+        return {polyhedron.getHash(), computationPoint, EvaluationSettings::getFaceApproximations(),
+                EvaluationSettings::getReductionMode()};
+    }
+
+    bool GeometricSumCache::lookup(const CacheKey &key, GravityModelResult &geometricSums) const {
+        std::shared_lock lock{_mutex};
+        const auto it = _entries.find(key);
+        if (it == _entries.end()) {
+            ++_misses;
+            return false;
+        }
+        ++_hits;
+        geometricSums = it->second;
+        return true;
+    }
+
+}
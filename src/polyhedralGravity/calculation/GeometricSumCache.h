@@ -0,0 +1,286 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/output/Logging.h"
+
+namespace polyhedralGravity {
+
+    /**
+     * Caches the density-independent geometric sums of the polyhedral gravity model, i.e. the results of the
+     * model for unit density before the prefix GRAVITATIONAL_CONSTANT * density is applied.
+     * Entries are keyed by a hash of the polyhedron's content, the computation point and the settings changing the
+     * sums, i.e. the FaceApproximations and the ReductionMode of the EvaluationSettings. A repeated evaluation of
+     * the same polyhedron at the same point with a different density is then only a rescaling of the cached sums.
+     * The missing points of a call are evaluated at once with the kernel the multi-point GravityModel::evaluate(..)
+     * would choose for them. The results are therefore bitwise identical to the ones of GravityModel::evaluate(..)
+     * if both evaluate a point with the same kernel, e.g. always for KernelVariant::POINTWISE or for a single
+     * point. Otherwise, they agree up to the rounding differences between the kernels. A cache hit returns the
+     * sums of the evaluation which stored them, so repeated calls are always bitwise reproducible.
+     *
+     * The hash of a polyhedron costs a pass over all vertices and faces. Repeated evaluations should therefore go
+     * through a Handle returned by prepare(..), which carries the hash computed once, so that a cache hit does not
+     * depend on the size of the mesh. Points with a non-finite coordinate are evaluated, but never cached.
+     *
+     * @note The cache is thread-safe. It is unbounded, use clear() to release memory.
+     * @example Density sweeps or density estimation fits evaluating the same point set with many densities
+     */
+    class GeometricSumCache {
+
+        /**
+         * The key of one cache entry consisting of the polyhedron's content hash, the computation point and the
+         * settings with which the sums were evaluated.
+         */
+        struct CacheKey {
+
+            /**
+             * The hash of the polyhedron's content
+             */
+            std::uint64_t polyhedronHash;
+
+            /**
+             * The computation point P
+             */
+            Array3 computationPoint;
+
+            /**
+             * The math backend and the far-field accuracy of the faces
+             */
+            FaceApproximations approximations;
+
+            /**
+             * The summation of the faces' contributions
+             */
+            ReductionMode reductionMode;
+
+            bool operator==(const CacheKey &rhs) const {
+                return polyhedronHash == rhs.polyhedronHash && computationPoint == rhs.computationPoint &&
+                       approximations.mathBackend == rhs.approximations.mathBackend &&
+                       approximations.farFieldAccuracy == rhs.approximations.farFieldAccuracy &&
+                       reductionMode == rhs.reductionMode;
+            }
+
+        };
+
+        /**
+         * Hash function for a CacheKey combining the polyhedron's hash, the point's coordinates and the settings.
+         */
+        struct CacheKeyHash {
+
+            size_t operator()(const CacheKey &key) const {
+                size_t seed = std::hash<std::uint64_t>{}(key.polyhedronHash);
+                const auto combine = [&seed](size_t value) {
+                    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+                };
+                for (const double coordinate: key.computationPoint) {
+                    combine(std::hash<double>{}(coordinate));
+                }
+                combine(std::hash<int>{}(static_cast<int>(key.approximations.mathBackend)));
+                combine(std::hash<double>{}(key.approximations.farFieldAccuracy));
+                combine(std::hash<int>{}(static_cast<int>(key.reductionMode)));
+                return seed;
+            }
+
+        };
+
+        /**
+         * The cached geometric sums
+         */
+        std::unordered_map<CacheKey, GravityModelResult, CacheKeyHash> _entries;
+
+        /**
+         * Guards the entries, multiple readers are allowed at the same time
+         */
+        mutable std::shared_mutex _mutex;
+
+        /**
+         * Number of lookups which were answered from the cache
+         */
+        mutable std::atomic<size_t> _hits;
+
+        /**
+         * Number of lookups which required an evaluation of the gravity model
+         */
+        mutable std::atomic<size_t> _misses;
+
+    public:
+
+        /**
+         * A polyhedron together with the hash of its content, computed once by prepare(..).
+         * @note The polyhedron is referenced, not copied! It must outlive the handle and must not change.
+         */
+        class Handle {
+
+            friend class GeometricSumCache;
+
+            /**
+             * The polyhedron
+             */
+            const Polyhedron &_polyhedron;
+
+            /**
+             * The hash of the polyhedron's content
+             */
+            std::uint64_t _hash;
+
+            Handle(const Polyhedron &polyhedron, std::uint64_t hash)
+                    : _polyhedron{polyhedron},
+                      _hash{hash} {}
+
+        public:
+
+            /**
+             * Returns the referenced polyhedron.
+             * @return the polyhedron
+             */
+            [[nodiscard]] const Polyhedron &getPolyhedron() const {
+                return _polyhedron;
+            }
+
+            /**
+             * Returns the hash of the polyhedron's content.
+             * @return the 64-bit hash
+             */
+            [[nodiscard]] std::uint64_t getHash() const {
+                return _hash;
+            }
+
+        };
+
+        /**
+         * Creates a new empty cache.
+         */
+        GeometricSumCache()
+                : _entries{},
+                  _mutex{},
+                  _hits{0},
+                  _misses{0} {}
+
+        /**
+         * Hashes a polyhedron once for the repeated evaluation with evaluate(..).
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces (referenced, not copied)
+         * @return the Handle
+         */
+        static Handle prepare(const Polyhedron &polyhedron);
+
+        /**
+         * Evaluates the polyhedral gravity model for a given constant density polyhedron at computation point P.
+         * The geometric sums are taken from the cache if present, otherwise they are evaluated and stored.
+         * @param polyhedron - the polyhedron as returned by prepare(..)
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoint - the computation Point P
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * at computation Point P
+         */
+        GravityModelResult evaluate(const Handle &polyhedron, double density, const Array3 &computationPoint);
+
+        /**
+         * Evaluates the polyhedral gravity model for a given constant density polyhedron at multiple computation
+         * points. Only the missing points are evaluated.
+         * @param polyhedron - the polyhedron as returned by prepare(..)
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoints - vector of computation points
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * foreach computation Point P
+         */
+        std::vector<GravityModelResult> evaluate(const Handle &polyhedron, double density,
+                                                 const std::vector<Array3> &computationPoints);
+
+        /**
+         * Evaluates the polyhedral gravity model for a given constant density polyhedron at computation point P.
+         * Hashes the polyhedron on every call, prefer prepare(..) for repeated evaluations.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoint - the computation Point P
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * at computation Point P
+         */
+        GravityModelResult evaluate(const Polyhedron &polyhedron, double density, const Array3 &computationPoint);
+
+        /**
+         * Evaluates the polyhedral gravity model for a given constant density polyhedron at multiple computation
+         * points. The polyhedron's content is hashed once per call and only the missing points are evaluated.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoints - vector of computation points
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * foreach computation Point P
+         */
+        std::vector<GravityModelResult> evaluate(const Polyhedron &polyhedron, double density,
+                                                 const std::vector<Array3> &computationPoints);
+
+        /**
+         * Removes all entries from the cache and resets the statistics.
+         */
+        void clear();
+
+        /**
+         * Returns the number of cached entries.
+         * @return number of entries
+         */
+        [[nodiscard]] size_t size() const;
+
+        /**
+         * Returns the number of lookups answered from the cache.
+         * @return number of hits
+         */
+        [[nodiscard]] size_t hits() const {
+            return _hits.load();
+        }
+
+        /**
+         * Returns the number of lookups requiring an evaluation.
+         * @return number of misses
+         */
+        [[nodiscard]] size_t misses() const {
+            return _misses.load();
+        }
+
+        /**
+         * Computes a hash of the polyhedron's content (vertices and faces) with the 64-bit FNV-1a algorithm.
+         * Two polyhedra with identical vertices and faces always have the same hash.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @return the 64-bit hash
+         */
+        static std::uint64_t hashPolyhedron(const Polyhedron &polyhedron);
+
+    private:
+
+        /**
+         * Looks up the geometric sums for a key.
+         * @param key - the CacheKey
+         * @param geometricSums - output, set if the key is present
+         * @return true if the key was present
+         */
+        bool lookup(const CacheKey &key, GravityModelResult &geometricSums) const;
+
+        /**
+         * Checks if a computation point can be cached, i.e. all its coordinates are finite. A NaN would never equal
+         * the stored key, so its entry could never be found.
+         * @param computationPoint - the computation Point P
+         * @return true if the point can be cached
+         */
+        static bool isCacheable(const Array3 &computationPoint);
+
+        /**
+         * Creates the key of a computation point with the current EvaluationSettings.
+         * @param polyhedron - the polyhedron as returned by prepare(..)
+         * @param computationPoint - the computation Point P
+         * @return the CacheKey
+         */
+        static CacheKey makeKey(const Handle &polyhedron, const Array3 &computationPoint);
+
+    };
+
+}
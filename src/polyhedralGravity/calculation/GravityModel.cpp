@@ -1,14 +1,153 @@
 #include "GravityModel.h"
 
+#include "polyhedralGravity/calculation/TiledKernel.h"
+#include "polyhedralGravity/calculation/BatchedKernel.h"
+#include "polyhedralGravity/calculation/PointLaneKernel.h"
+#include "polyhedralGravity/calculation/Autotuner.h"
+
 namespace polyhedralGravity {
 
     GravityModelResult GravityModel::evaluate(
             const Polyhedron &polyhedron, double density, const Array3 &computationPoint) {
-        using namespace util;
-        using namespace detail;
         SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
                             "Evaluation for computation point P = [{}, {}, {}] started, given density = {} kg/m^3",
                             computationPoint[0], computationPoint[1], computationPoint[2], density);
+        return detail::applyDensityPrefix(detail::evaluateGeometricSums(polyhedron, computationPoint), density);
+    }
+
+    std::vector<GravityModelResult> GravityModel::evaluate(
+            const Polyhedron &polyhedron, double density, const std::vector<Array3> &computationPoints) {
+        std::vector<GravityModelResult> result = detail::evaluateGeometricSums(polyhedron, computationPoints);
+        std::transform(result.begin(), result.end(), result.begin(), [density](const GravityModelResult &sums) {
+            return detail::applyDensityPrefix(sums, density);
+        });
+        return result;
+    }
+
+    GravityModelResult GravityModel::evaluate(
+            const Polyhedron &polyhedron, double density, const Array3 &computationPoint,
+            const FrameTransformation &frame) {
+        return frame.toOuterFrame(evaluate(polyhedron, density, frame.toBodyFrame(computationPoint)));
+    }
+
+    std::vector<GravityModelResult> GravityModel::evaluate(
+            const Polyhedron &polyhedron, double density, const std::vector<Array3> &computationPoints,
+            const FrameTransformation &frame) {
+        //The points are evaluated at once, so that the kernel is chosen like for points in the body-fixed frame
+        std::vector<Array3> bodyPoints{computationPoints.size()};
+        ParallelExecution::forEach(computationPoints.size(), [&](size_t i) {
+            bodyPoints[i] = frame.toBodyFrame(computationPoints[i]);
+        });
+        std::vector<GravityModelResult> result = evaluate(polyhedron, density, bodyPoints);
+        ParallelExecution::forEach(result.size(), [&](size_t i) { result[i] = frame.toOuterFrame(result[i]); });
+        return result;
+    }
+
+    std::vector<GravityModelResult> GravityModel::evaluate(
+            const Polyhedron &polyhedron, double density, const std::vector<Array3> &computationPoints,
+            const std::vector<FrameTransformation> &frames) {
+        if (computationPoints.size() != frames.size()) {
+            throw std::invalid_argument{"The number of computation points and frame transformations must be equal!"};
+        }
+        std::vector<Array3> bodyPoints{computationPoints.size()};
+        ParallelExecution::forEach(computationPoints.size(), [&](size_t i) {
+            bodyPoints[i] = frames[i].toBodyFrame(computationPoints[i]);
+        });
+        std::vector<GravityModelResult> result = evaluate(polyhedron, density, bodyPoints);
+        ParallelExecution::forEach(result.size(), [&](size_t i) { result[i] = frames[i].toOuterFrame(result[i]); });
+        return result;
+    }
+
+    size_t GravityModel::calibrateSerialFaceThreshold() {
+        const size_t threadCount = ParallelExecution::resolveThreadCount();
+        if (EvaluationSettings::getParallelBackend() == ParallelBackend::SERIAL || threadCount <= 1) {
+            return std::numeric_limits<size_t>::max();
+        }
+        //The lateral faces of a cone around the origin, i.e. regular faces seen from a point outside of them
+        constexpr size_t faceCount = 64;
+        std::vector<Array3Triplet> faces(faceCount);
+        for (size_t i = 0; i < faceCount; ++i) {
+            const double angle = 2.0 * util::PI * static_cast<double>(i) / faceCount;
+            const double nextAngle = 2.0 * util::PI * static_cast<double>(i + 1) / faceCount;
+            faces[i] = {Array3{3.0 * std::cos(angle), 3.0 * std::sin(angle), -1.0},
+                        Array3{3.0 * std::cos(nextAngle), 3.0 * std::sin(nextAngle), -1.0},
+                        Array3{0.0, 0.0, 2.0}};
+        }
+        //The minimum of repeated runs excludes interruptions by the OS
+        const auto measure = [](const auto &function) {
+            double best = std::numeric_limits<double>::infinity();
+            for (int repetition = 0; repetition < 20; ++repetition) {
+                const auto start = std::chrono::steady_clock::now();
+                function();
+                const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+                best = std::min(best, duration.count());
+            }
+            return best;
+        };
+        volatile double sink = 0.0;
+        const double faceCost = measure([&faces, &sink] {
+            GravityModelResult sum{};
+            for (const Array3Triplet &face: faces) {
+                sum = detail::sumResults(sum, detail::evaluateFace(face));
+            }
+            sink = sink + sum.gravitationalPotential;
+        }) / faceCount;
+        const double overhead = measure([threadCount, &sink] {
+            const GravityModelResult sum = ParallelExecution::transformReduce(
+                    threadCount, [](size_t) { return GravityModelResult{}; }, GravityModelResult{},
+                    &detail::sumResults);
+            sink = sink + sum.gravitationalPotential;
+        });
+        const double threshold =
+                std::ceil(overhead / (faceCost * (1.0 - 1.0 / static_cast<double>(threadCount))));
+        if (!(threshold < static_cast<double>(std::numeric_limits<size_t>::max()))) {
+            return std::numeric_limits<size_t>::max();
+        }
+        return std::max<size_t>(static_cast<size_t>(threshold), 1);
+    }
+
+    size_t GravityModel::resolveSerialFaceThreshold() {
+        const size_t configured = EvaluationSettings::getSerialFaceThreshold();
+        if (configured != 0) {
+            return configured;
+        }
+        const std::pair<ParallelBackend, size_t> key{EvaluationSettings::getParallelBackend(),
+                                                     ParallelExecution::resolveThreadCount()};
+        //Every thread remembers the last threshold, so the shared map is only locked if the settings change
+        thread_local std::pair<ParallelBackend, size_t> cachedKey{ParallelBackend::DEFAULT, 0};
+        thread_local size_t cachedThreshold = 0;
+        if (cachedThreshold != 0 && cachedKey == key) {
+            return cachedThreshold;
+        }
+        static std::mutex mutex{};
+        static std::map<std::pair<ParallelBackend, size_t>, size_t> thresholds{};
+        std::lock_guard<std::mutex> lock{mutex};
+        auto it = thresholds.find(key);
+        if (it == thresholds.end()) {
+            it = thresholds.emplace(key, calibrateSerialFaceThreshold()).first;
+            if (it->second == std::numeric_limits<size_t>::max()) {
+                SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                                   "The faces of single points are evaluated serially with the {} backend and {} "
+                                   "threads", EvaluationSettings::toString(key.first), key.second);
+            } else {
+                SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                                   "Calibrated the serial face threshold of the {} backend with {} threads: {} faces",
+                                   EvaluationSettings::toString(key.first), key.second, it->second);
+            }
+        }
+        cachedKey = key;
+        cachedThreshold = it->second;
+        return cachedThreshold;
+    }
+
+    GravityModelResult GravityModel::detail::evaluateGeometricSums(
+            const Polyhedron &polyhedron, const Array3 &computationPoint) {
+        return evaluateGeometricSums(polyhedron, computationPoint,
+                                     polyhedron.countFaces() >= resolveSerialFaceThreshold());
+    }
+
+    GravityModelResult GravityModel::detail::evaluateGeometricSums(
+            const Polyhedron &polyhedron, const Array3 &computationPoint, bool parallelFaces) {
         /*
          * Calculate V and Vx, Vy, Vz and Vxx, Vyy, Vzz, Vxy, Vxz, Vyz
          */
@@ -17,184 +156,331 @@ namespace polyhedralGravity {
         SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
                             "Starting to iterate over the planes...");
         GravityModelResult result{};
-        result = thrust::transform_reduce(
-                thrust::device,
-                polyhedronIterator.first,
-                polyhedronIterator.second,
-                [](const Array3Triplet &face) {
-                    using namespace util;
-                    using namespace detail;
-                    SPDLOG_LOGGER_TRACE(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
-                                        "Evaluating the plane with vertices: v1 = [{}, {}, {}], v2 = [{}, {}, {}], "
-                                        "v3 = [{}, {}, {}]",
-                                        face[0][0], face[0][1], face[0][2],
-                                        face[1][0], face[1][1], face[1][2],
-                                        face[2][0], face[2][1], face[2][2]);
-                    //1. Step: Compute ingredients for current plane
-                    //1-01 Step: Compute Segment Vectors G_pq which describe each one the edge between two vertices
-                    Array3Triplet segmentVectors = buildVectorsOfSegments(face[0], face[1], face[2]);
-                    //1-02 Step: Compute the Plane Unit Normals N_p (pointing outside the polyhedron)
-                    Array3 planeUnitNormal = buildUnitNormalOfPlane(segmentVectors[0], segmentVectors[1]);
-                    //1-03 Step: Compute Segment Unit Normals n_pq (normal pointing away from each segment)
-                    Array3Triplet segmentUnitNormals = buildUnitNormalOfSegments(segmentVectors, planeUnitNormal);
-                    //1-04 Step: Compute Plane Normal Orientation sigma_p (direction of N_p in relation to P)
-                    double planeNormalOrientation = computeUnitNormalOfPlaneDirection(planeUnitNormal, face[0]);
-                    //1-05 Step: Compute Hessian Normal Plane Representation
-                    HessianPlane hessianPlane = computeHessianPlane(face[0], face[1], face[2]);
-                    //1-06 Step: Compute distance h_p between P and P'
-                    double planeDistance = distanceBetweenOriginAndPlane(hessianPlane);
-                    //1-07 Step: Compute the actual position of P' (projection of P on the plane)
-                    Array3 orthogonalProjectionPointOnPlane = projectPointOrthogonallyOntoPlane(
-                            planeUnitNormal,
-                            planeDistance,
-                            hessianPlane);
-                    //1-08 Step: Compute the segment normal orientation sigma_pq (direction of n_pq in relation to P')
-                    Array3 segmentNormalOrientations = computeUnitNormalOfSegmentsDirections(
-                            face,
-                            orthogonalProjectionPointOnPlane,
-                            segmentUnitNormals);
-                    //1-09 Step: Compute the orthogonal projection point P'' of P' on each segment
-                    Array3Triplet orthogonalProjectionPointsOnSegmentsForPlane = projectPointOrthogonallyOntoSegments(
-                            orthogonalProjectionPointOnPlane,
-                            segmentNormalOrientations,
-                            face);
-                    //1-10 Step: Compute the segment distances h_pq between P'' and P'
-                    Array3 segmentDistances = distancesBetweenProjectionPoints(
-                            orthogonalProjectionPointOnPlane,
-                            orthogonalProjectionPointsOnSegmentsForPlane);
-                    //1-11 Step: Compute the 3D distances l1, l2 (between P and vertices)
-                    // and 1D distances s1, s2 (between P'' and vertices)
-                    std::array<Distance, 3> distances = distancesToSegmentEndpoints(
-                            segmentVectors,
-                            orthogonalProjectionPointsOnSegmentsForPlane,
-                            face);
-                    //1-12 Step: Compute the euclidian Norms of the vectors consisting of P and the vertices
-                    // they are later used for determining the position of P in relation to the plane
-                    Array3 projectionPointVertexNorms = computeNormsOfProjectionPointAndVertices(
-                            orthogonalProjectionPointOnPlane,
-                            face);
-                    //1-13 Step: Compute the transcendental Expressions LN_pq and AN_pq
-                    std::array<TranscendentalExpression, 3> transcendentalExpressions = computeTranscendentalExpressions(
-                            distances,
-                            planeDistance,
-                            segmentDistances,
-                            segmentNormalOrientations,
-                            projectionPointVertexNorms);
-                    //1-14 Step: Compute the singularities sing A and sing B if P' is located in the plane,
-                    // on any vertex, or on one segment (G_pq)
-                    std::pair<double, Array3> singularities = computeSingularityTerms(
-                            segmentVectors,
-                            segmentNormalOrientations,
-                            projectionPointVertexNorms,
-                            planeUnitNormal, planeDistance,
-                            planeNormalOrientation);
-                    //2. Step: Compute Sum 1 used for potential and acceleration (first derivative)
-                    // sum over: sigma_pq * h_pq * LN_pq
-                    // --> Equation 11/12 the first summation in the brackets
-                    auto zipIteratorSum1PotentialAcceleration =
-                            util::zipPair(segmentNormalOrientations, segmentDistances, transcendentalExpressions);
-                    const double sum1PotentialAcceleration = std::accumulate(
-                            zipIteratorSum1PotentialAcceleration.first,
-                            zipIteratorSum1PotentialAcceleration.second,
-                            0.0,
-                            [](double acc, const auto &tuple) {
-                                const double &segmentOrientation = thrust::get<0>(tuple);
-                                const double &segmentDistance = thrust::get<1>(tuple);
-                                const TranscendentalExpression &transcendentalExpressions = thrust::get<2>(tuple);
-                                return acc + segmentOrientation * segmentDistance * transcendentalExpressions.ln;
-                            });
-
-                    //3. Step: Compute Sum 1 used for the gradiometric tensor (second derivative)
-                    // sum over: n_pq * LN_pq
-                    // --> Equation 13 the first summation in the brackets
-                    auto zipIteratorSum1Tensor = util::zipPair(segmentUnitNormals, transcendentalExpressions);
-                    const Array3 sum1Tensor = std::accumulate(
-                            zipIteratorSum1Tensor.first,
-                            zipIteratorSum1Tensor.second,
-                            Array3{0.0, 0.0, 0.0},
-                            [](const Array3 &acc, const auto &tuple) {
-                                const Array3 &segmentNormal = thrust::get<0>(tuple);
-                                const TranscendentalExpression &transcendentalExpressions = thrust::get<1>(tuple);
-                                return acc + (segmentNormal * transcendentalExpressions.ln);
-                            });
-
-                    //4. Step: Compute Sum 2 which is the same for every result parameter
-                    // sum over: sigma_pq * AN_pq
-                    // --> Equation 11/12/13 the second summation in the brackets
-                    auto zipIteratorSum2 = util::zipPair(segmentNormalOrientations, transcendentalExpressions);
-                    const double sum2 = std::accumulate(
-                            zipIteratorSum2.first,
-                            zipIteratorSum2.second,
-                            0.0,
-                            [](double acc, const auto &tuple) {
-                                const double &segmentOrientation = thrust::get<0>(tuple);
-                                const TranscendentalExpression &transcendentalExpressions = thrust::get<1>(tuple);
-                                return acc + segmentOrientation * transcendentalExpressions.an;
-                            });
-
-                    //5. Step: Sum for potential and acceleration
-                    // consisting of: sum1 + h_p * sum2 + sing A
-                    // --> Equation 11/12 the total sum of the brackets
-                    const double planeSumPotentialAcceleration =
-                            sum1PotentialAcceleration + planeDistance * sum2 + singularities.first;
-
-                    //6. Step: Sum for tensor
-                    // consisting of: sum1 + sigma_p * N_p * sum2 + sing B
-                    // --> Equation 13 the total sum of the brackets
-                    const Array3 subSum = (sum1Tensor + (planeUnitNormal * (planeNormalOrientation * sum2))) + singularities.second;
-                    // first component: trivial case Vxx, Vyy, Vzz --> just N_p * subSum
-                    // 00, 11, 22 --> xx, yy, zz with x as 0, y as 1, z as 2
-                    const Array3 first = planeUnitNormal * subSum;
-                    // second component: reordering required to build Vxy, Vxz, Vyz
-                    // 01, 02, 12 --> xy, xz, yz with x as 0, y as 1, z as 2
-                    const Array3 reorderedNp = {planeUnitNormal[0], planeUnitNormal[0], planeUnitNormal[1]};
-                    const Array3 reorderedSubSum = {subSum[1], subSum[2], subSum[2]};
-                    const Array3 second = reorderedNp * reorderedSubSum;
-
-                    //7. Step: Multiply with prefix
-                    // Equation (11): sigma_p * h_p * sum
-                    // Equation (12): N_p * sum
-                    // Equation (13): already done above, just concat the two components for later summation
-                    return GravityModelResult{
-                            planeNormalOrientation * planeDistance * planeSumPotentialAcceleration,
-                            planeUnitNormal * planeSumPotentialAcceleration,
-                            concat(first, second)
-                    };
-                },
-                result,
-                [](const GravityModelResult &a, const GravityModelResult &b) {
-                    //8. Step: Accumulate the partial sums
-                    return GravityModelResult{
-                            a.gravitationalPotential + b.gravitationalPotential,
-                            a.acceleration + b.acceleration,
-                            a.gradiometricTensor + b.gradiometricTensor
-                    };
-                });
+        if (EvaluationSettings::getReductionMode() == ReductionMode::DETERMINISTIC) {
+            result = reduceDeterministic(polyhedronIterator.first, polyhedron.countFaces(), parallelFaces);
+        } else if (!parallelFaces) {
+            const auto faces = polyhedronIterator.first;
+            for (size_t face = 0; face < polyhedron.countFaces(); ++face) {
+                result = sumResults(result, evaluateFace(faces[face]));
+            }
+        } else {
+            const auto faces = polyhedronIterator.first;
+            result = ParallelExecution::transformReduce(
+                    polyhedron.countFaces(),
+                    [faces](size_t face) { return evaluateFace(faces[face]); },
+                    result,
+                    &sumResults);
+        }
 
         SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
-                            "Finished the sums. Applying final prefix and eliminating rounding errors.");
+                            "Finished the sums. Eliminating rounding errors.");
 
         //9. Step: Eliminate rounding errors in the result and set those tiny values to "really" zero
         result.eliminateRoundingErrors();
+        return result;
+    }
+
+    bool GravityModel::detail::requiresScalarFaces() {
+        return EvaluationSettings::getMathBackend() == MathBackend::FAST ||
+               EvaluationSettings::getFarFieldAccuracy() > 0.0;
+    }
+
+    ParallelAxis GravityModel::detail::resolveParallelAxis(size_t pointCount) {
+        const ParallelAxis axis = EvaluationSettings::getParallelAxis();
+        if (axis != ParallelAxis::AUTO) {
+            return axis;
+        }
+        return pointCount >= ParallelExecution::resolveThreadCount() ? ParallelAxis::POINTS : ParallelAxis::FACES;
+    }
+
+    std::vector<GravityModelResult> GravityModel::detail::evaluateGeometricSums(
+            const Polyhedron &polyhedron, const std::vector<Array3> &computationPoints) {
+        const KernelVariant variant = EvaluationSettings::getKernelVariant();
+        const bool automatic = variant == KernelVariant::AUTO &&
+                               EvaluationSettings::getReductionMode() == ReductionMode::DEFAULT;
+        if (automatic && computationPoints.size() >= Autotuner::MIN_POINTS) {
+            //A tuned entry for this machine and mesh size replaces the built-in choice, unless it is the point lanes
+            //which do not implement the approximations of the settings
+            const auto parameters = Autotuner::lookup(polyhedron.countFaces());
+            if (parameters && !(parameters->variant == KernelVariant::POINT_LANES && requiresScalarFaces())) {
+                return Autotuner::evaluateGeometricSums(polyhedron, computationPoints, *parameters);
+            }
+        }
+        if (variant == KernelVariant::BATCHED) {
+            return BatchedKernel::evaluateGeometricSums(BatchedKernel::prepare(polyhedron), computationPoints);
+        }
+        if (variant == KernelVariant::POINT_LANES ||
+            (automatic && polyhedron.countFaces() <= PointLaneKernel::AUTO_MAX_FACES &&
+             computationPoints.size() >= PointLaneKernel::AUTO_MIN_POINTS && !requiresScalarFaces())) {
+            return PointLaneKernel::evaluateGeometricSums(polyhedron, computationPoints);
+        }
+        if (variant == KernelVariant::TILED ||
+            (automatic && computationPoints.size() >= TiledKernel::AUTO_MIN_POINTS)) {
+            return TiledKernel::evaluateGeometricSums(TiledKernel::prepareFaces(polyhedron), computationPoints);
+        }
+        return evaluatePointwise(polyhedron, computationPoints);
+    }
+
+    std::vector<GravityModelResult> GravityModel::detail::evaluatePointwise(
+            const Polyhedron &polyhedron, const std::vector<Array3> &computationPoints) {
+        std::vector<GravityModelResult> result(computationPoints.size());
+        if (resolveParallelAxis(computationPoints.size()) == ParallelAxis::POINTS) {
+            ParallelExecution::forEach(computationPoints.size(), [&](size_t i) {
+                result[i] = evaluateGeometricSums(polyhedron, computationPoints[i], false);
+            });
+        } else {
+            std::transform(computationPoints.cbegin(), computationPoints.cend(), result.begin(),
+                           [&polyhedron](const Array3 &computationPoint) {
+                               return evaluateGeometricSums(polyhedron, computationPoint);
+                           });
+        }
+        return result;
+    }
 
+    GravityModelResult GravityModel::detail::applyDensityPrefix(GravityModelResult geometricSums, double density) {
         //10. Step: Compute prefix consisting of GRAVITATIONAL_CONSTANT * density
         const double prefix = util::GRAVITATIONAL_CONSTANT * density;
 
         //11. Step: Final expressions after application of the prefix (and a division by 2 for the potential)
-        result.gravitationalPotential = (result.gravitationalPotential * prefix) / 2.0;
-        result.acceleration = result.acceleration * prefix;
-        result.gradiometricTensor = result.gradiometricTensor * prefix;
-        return result;
+        using util::operator*;
+        geometricSums.gravitationalPotential = (geometricSums.gravitationalPotential * prefix) / 2.0;
+        geometricSums.acceleration = geometricSums.acceleration * prefix;
+        geometricSums.gradiometricTensor = geometricSums.gradiometricTensor * prefix;
+        return geometricSums;
     }
 
-    std::vector<GravityModelResult> GravityModel::evaluate(
-            const Polyhedron &polyhedron, double density, const std::vector<Array3> &computationPoints) {
-        std::vector<GravityModelResult> result{computationPoints.size()};
-        thrust::transform(computationPoints.begin(), computationPoints.end(), result.begin(),
-                          [&polyhedron, density](const Array3 &computationPoint) {
-                              return evaluate(polyhedron, density, computationPoint);
-                          });
-        return result;
+    GravityModelResult GravityModel::detail::evaluateFace(const Array3Triplet &face) {
+        return evaluateFace(face, EvaluationSettings::getFaceApproximations());
+    }
+
+    GravityModelResult GravityModel::detail::evaluateFace(
+            const Array3Triplet &face, const FaceApproximations &approximations) {
+        using namespace util;
+        SPDLOG_LOGGER_TRACE(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Evaluating the plane with vertices: v1 = [{}, {}, {}], v2 = [{}, {}, {}], "
+                            "v3 = [{}, {}, {}]",
+                            face[0][0], face[0][1], face[0][2],
+                            face[1][0], face[1][1], face[1][2],
+                            face[2][0], face[2][1], face[2][2]);
+        //0. Step: Approximate the contribution of small faces far away from P
+        if (approximations.farFieldAccuracy > 0.0 && isFarField(face, approximations.farFieldAccuracy)) {
+            return evaluateFaceMoments(face);
+        }
+        //1. Step: Compute ingredients for current plane
+        //1-01 to 1-03 Step: Compute Segment Vectors G_pq, Plane Unit Normal N_p and Segment Unit Normals n_pq
+        const PreparedFace preparedFace = prepareFace(face);
+        //1-05 Step: Compute Hessian Normal Plane Representation
+        const HessianPlane hessianPlane = computeHessianPlane(face[0], face[1], face[2]);
+        //1-11 Step (partially): Compute the 3D distances between P and the vertices
+        const Array3 vertexNorms{euclideanNorm(face[0]), euclideanNorm(face[1]), euclideanNorm(face[2])};
+        return evaluateFace(face, preparedFace, hessianPlane, vertexNorms, approximations.mathBackend);
+    }
+
+    bool GravityModel::detail::isFarField(const Array3Triplet &face, double accuracy) {
+        using namespace util;
+        const Array3 centroid = (face[0] + face[1] + face[2]) / 3.0;
+        const double squaredRadius = std::max({dot(face[0] - centroid, face[0] - centroid),
+                                               dot(face[1] - centroid, face[1] - centroid),
+                                               dot(face[2] - centroid, face[2] - centroid)});
+        //(a/|c|)^3 <= accuracy / 4 compared without roots as (a^2/|c|^2)^3 <= (accuracy / 4)^2
+        const double squaredRatio = squaredRadius / dot(centroid, centroid);
+        const double bound = accuracy / 4.0;
+        return squaredRatio * squaredRatio * squaredRatio <= bound * bound;
+    }
+
+    GravityModelResult GravityModel::detail::evaluateFaceMoments(const Array3Triplet &face) {
+        using namespace util;
+        const Array3 centroid = (face[0] + face[1] + face[2]) / 3.0;
+        const double distance = euclideanNorm(centroid);
+        const Array3 planeUnitNormal = buildUnitNormalOfPlane(face[1] - face[0], face[2] - face[1]);
+        const double area = euclideanNorm(cross(face[1] - face[0], face[2] - face[0])) / 2.0;
+        //The second moment M = A/12 * sum(u * u^T) of the face about its centroid with u = v - c
+        Matrix<double, 3, 3> secondMoment{};
+        for (const Array3 &vertex: face) {
+            const Array3 u = vertex - centroid;
+            for (size_t i = 0; i < 3; ++i) {
+                secondMoment[i] = secondMoment[i] + u * (u[i] * area / 12.0);
+            }
+        }
+        const double trace = secondMoment[0][0] + secondMoment[1][1] + secondMoment[2][2];
+        const Array3 momentTimesCentroid{dot(secondMoment[0], centroid), dot(secondMoment[1], centroid),
+                                         dot(secondMoment[2], centroid)};
+        //The quadrupole term 3 * c^T M c - |c|^2 * tr(M)
+        const double quadrupole = 3.0 * dot(centroid, momentTimesCentroid) - distance * distance * trace;
+        const double distance3 = distance * distance * distance;
+        const double distance5 = distance3 * distance * distance;
+
+        //The surface integral of 1/r, i.e. the sum of Equation 11/12: A/|c| + quadrupole / (2 * |c|^5)
+        const double planeSumPotentialAcceleration = area / distance + quadrupole / (2.0 * distance5);
+        //The negative gradient of that integral w.r.t. c, i.e. the sum of Equation 13 with inverted sign
+        const double distance7 = distance5 * distance * distance;
+        const Array3 subSum = centroid * (-area / distance3 - 5.0 * quadrupole / (2.0 * distance7)) +
+                              (momentTimesCentroid * 3.0 - centroid * trace) / distance5;
+
+        //7. Step like in evaluateFace(..) with sigma_p * h_p = N_p * v0
+        const Array3 first = planeUnitNormal * subSum;
+        const Array3 second = Array3{planeUnitNormal[0], planeUnitNormal[0], planeUnitNormal[1]} *
+                              Array3{subSum[1], subSum[2], subSum[2]};
+        return GravityModelResult{
+                dot(planeUnitNormal, face[0]) * planeSumPotentialAcceleration,
+                planeUnitNormal * planeSumPotentialAcceleration,
+                concat(first, second)
+        };
+    }
+
+    PreparedFace GravityModel::detail::prepareFace(const Array3Triplet &face) {
+        PreparedFace preparedFace{};
+        //1-01 Step: Compute Segment Vectors G_pq which describe each one the edge between two vertices
+        preparedFace.segmentVectors = buildVectorsOfSegments(face[0], face[1], face[2]);
+        //1-02 Step: Compute the Plane Unit Normals N_p (pointing outside the polyhedron)
+        preparedFace.planeUnitNormal =
+                buildUnitNormalOfPlane(preparedFace.segmentVectors[0], preparedFace.segmentVectors[1]);
+        //1-03 Step: Compute Segment Unit Normals n_pq (normal pointing away from each segment)
+        preparedFace.segmentUnitNormals =
+                buildUnitNormalOfSegments(preparedFace.segmentVectors, preparedFace.planeUnitNormal);
+        return preparedFace;
+    }
+
+    GravityModelResult GravityModel::detail::evaluateFace(
+            const Array3Triplet &face, const PreparedFace &preparedFace,
+            const HessianPlane &hessianPlane, const Array3 &vertexNorms, MathBackend mathBackend) {
+        using namespace util;
+        const Array3Triplet &segmentVectors = preparedFace.segmentVectors;
+        const Array3 &planeUnitNormal = preparedFace.planeUnitNormal;
+        const Array3Triplet &segmentUnitNormals = preparedFace.segmentUnitNormals;
+        //1-04 Step: Compute Plane Normal Orientation sigma_p (direction of N_p in relation to P)
+        double planeNormalOrientation = computeUnitNormalOfPlaneDirection(planeUnitNormal, face[0]);
+        //1-06 Step: Compute distance h_p between P and P'
+        double planeDistance = distanceBetweenOriginAndPlane(hessianPlane);
+        //1-07 Step: Compute the actual position of P' (projection of P on the plane)
+        Array3 orthogonalProjectionPointOnPlane = projectPointOrthogonallyOntoPlane(
+                planeUnitNormal,
+                planeDistance,
+                hessianPlane);
+        //1-08 Step: Compute the segment normal orientation sigma_pq (direction of n_pq in relation to P')
+        Array3 segmentNormalOrientations = computeUnitNormalOfSegmentsDirections(
+                face,
+                orthogonalProjectionPointOnPlane,
+                segmentUnitNormals);
+        //1-09 Step: Compute the orthogonal projection point P'' of P' on each segment
+        Array3Triplet orthogonalProjectionPointsOnSegmentsForPlane = projectPointOrthogonallyOntoSegments(
+                orthogonalProjectionPointOnPlane,
+                segmentNormalOrientations,
+                face);
+        //1-10 Step: Compute the segment distances h_pq between P'' and P'
+        Array3 segmentDistances = distancesBetweenProjectionPoints(
+                orthogonalProjectionPointOnPlane,
+                orthogonalProjectionPointsOnSegmentsForPlane);
+        //1-11 Step: Compute the 3D distances l1, l2 (between P and vertices)
+        // and 1D distances s1, s2 (between P'' and vertices)
+        std::array<Distance, 3> distances = distancesToSegmentEndpoints(
+                segmentVectors,
+                orthogonalProjectionPointsOnSegmentsForPlane,
+                face,
+                vertexNorms);
+        //1-12 Step: Compute the euclidian Norms of the vectors consisting of P and the vertices
+        // they are later used for determining the position of P in relation to the plane
+        Array3 projectionPointVertexNorms = computeNormsOfProjectionPointAndVertices(
+                orthogonalProjectionPointOnPlane,
+                face);
+        //1-13 Step: Compute the transcendental Expressions LN_pq and AN_pq
+        std::array<TranscendentalExpression, 3> transcendentalExpressions = computeTranscendentalExpressions(
+                distances,
+                planeDistance,
+                segmentDistances,
+                segmentNormalOrientations,
+                projectionPointVertexNorms,
+                mathBackend);
+        //1-14 Step: Compute the singularities sing A and sing B if P' is located in the plane,
+        // on any vertex, or on one segment (G_pq)
+        std::pair<double, Array3> singularities = computeSingularityTerms(
+                segmentVectors,
+                segmentNormalOrientations,
+                projectionPointVertexNorms,
+                planeUnitNormal, planeDistance,
+                planeNormalOrientation);
+        //2. Step: Compute Sum 1 used for potential and acceleration (first derivative)
+        // sum over: sigma_pq * h_pq * LN_pq
+        // --> Equation 11/12 the first summation in the brackets
+        auto zipIteratorSum1PotentialAcceleration =
+                util::zipPair(segmentNormalOrientations, segmentDistances, transcendentalExpressions);
+        const double sum1PotentialAcceleration = std::accumulate(
+                zipIteratorSum1PotentialAcceleration.first,
+                zipIteratorSum1PotentialAcceleration.second,
+                0.0,
+                [](double acc, const auto &tuple) {
+                    const double &segmentOrientation = thrust::get<0>(tuple);
+                    const double &segmentDistance = thrust::get<1>(tuple);
+                    const TranscendentalExpression &transcendentalExpressions = thrust::get<2>(tuple);
+                    return acc + segmentOrientation * segmentDistance * transcendentalExpressions.ln;
+                });
+
+        //3. Step: Compute Sum 1 used for the gradiometric tensor (second derivative)
+        // sum over: n_pq * LN_pq
+        // --> Equation 13 the first summation in the brackets
+        auto zipIteratorSum1Tensor = util::zipPair(segmentUnitNormals, transcendentalExpressions);
+        const Array3 sum1Tensor = std::accumulate(
+                zipIteratorSum1Tensor.first,
+                zipIteratorSum1Tensor.second,
+                Array3{0.0, 0.0, 0.0},
+                [](const Array3 &acc, const auto &tuple) {
+                    const Array3 &segmentNormal = thrust::get<0>(tuple);
+                    const TranscendentalExpression &transcendentalExpressions = thrust::get<1>(tuple);
+                    return acc + (segmentNormal * transcendentalExpressions.ln);
+                });
+
+        //4. Step: Compute Sum 2 which is the same for every result parameter
+        // sum over: sigma_pq * AN_pq
+        // --> Equation 11/12/13 the second summation in the brackets
+        auto zipIteratorSum2 = util::zipPair(segmentNormalOrientations, transcendentalExpressions);
+        const double sum2 = std::accumulate(
+                zipIteratorSum2.first,
+                zipIteratorSum2.second,
+                0.0,
+                [](double acc, const auto &tuple) {
+                    const double &segmentOrientation = thrust::get<0>(tuple);
+                    const TranscendentalExpression &transcendentalExpressions = thrust::get<1>(tuple);
+                    return acc + segmentOrientation * transcendentalExpressions.an;
+                });
+
+        //5. Step: Sum for potential and acceleration
+        // consisting of: sum1 + h_p * sum2 + sing A
+        // --> Equation 11/12 the total sum of the brackets
+        const double planeSumPotentialAcceleration =
+                sum1PotentialAcceleration + planeDistance * sum2 + singularities.first;
+
+        //6. Step: Sum for tensor
+        // consisting of: sum1 + sigma_p * N_p * sum2 + sing B
+        // --> Equation 13 the total sum of the brackets
+        const Array3 subSum = (sum1Tensor + (planeUnitNormal * (planeNormalOrientation * sum2))) + singularities.second;
+        // first component: trivial case Vxx, Vyy, Vzz --> just N_p * subSum
+        // 00, 11, 22 --> xx, yy, zz with x as 0, y as 1, z as 2
+        const Array3 first = planeUnitNormal * subSum;
+        // second component: reordering required to build Vxy, Vxz, Vyz
+        // 01, 02, 12 --> xy, xz, yz with x as 0, y as 1, z as 2
+        const Array3 reorderedNp = {planeUnitNormal[0], planeUnitNormal[0], planeUnitNormal[1]};
+        const Array3 reorderedSubSum = {subSum[1], subSum[2], subSum[2]};
+        const Array3 second = reorderedNp * reorderedSubSum;
+
+        //7. Step: Multiply with prefix
+        // Equation (11): sigma_p * h_p * sum
+        // Equation (12): N_p * sum
+        // Equation (13): already done above, just concat the two components for later summation
+        return GravityModelResult{
+                planeNormalOrientation * planeDistance * planeSumPotentialAcceleration,
+                planeUnitNormal * planeSumPotentialAcceleration,
+                concat(first, second)
+        };
+    }
+
+    GravityModelResult GravityModel::detail::sumResults(const GravityModelResult &a, const GravityModelResult &b) {
+        using util::operator+;
+        //8. Step: Accumulate the partial sums
+        return GravityModelResult{
+                a.gravitationalPotential + b.gravitationalPotential,
+                a.acceleration + b.acceleration,
+                a.gradiometricTensor + b.gradiometricTensor
+        };
     }
 
     Array3Triplet GravityModel::detail::buildVectorsOfSegments(
@@ -369,12 +655,22 @@ namespace polyhedralGravity {
             const Array3Triplet &segmentVectorsForPlane,
             const Array3Triplet &orthogonalProjectionPointsOnSegmentForPlane,
             const Array3Triplet &face) {
+        using util::euclideanNorm;
+        return distancesToSegmentEndpoints(segmentVectorsForPlane, orthogonalProjectionPointsOnSegmentForPlane, face,
+                                           {euclideanNorm(face[0]), euclideanNorm(face[1]), euclideanNorm(face[2])});
+    }
+
+    std::array<Distance, 3> GravityModel::detail::distancesToSegmentEndpoints(
+            const Array3Triplet &segmentVectorsForPlane,
+            const Array3Triplet &orthogonalProjectionPointsOnSegmentForPlane,
+            const Array3Triplet &face,
+            const Array3 &vertexNorms) {
         std::array<Distance, 3> distancesForPlane{};
         auto counter = thrust::counting_iterator<unsigned int>(0);
         auto zip = util::zipPair(segmentVectorsForPlane, orthogonalProjectionPointsOnSegmentForPlane);
 
         thrust::transform(zip.first, zip.second, counter,
-                          distancesForPlane.begin(), [&face](const auto &tuple, unsigned int j) {
+                          distancesForPlane.begin(), [&face, &vertexNorms](const auto &tuple, unsigned int j) {
                     using namespace util;
                     Distance distance{};
                     //segment vector G_pq
@@ -384,8 +680,8 @@ namespace polyhedralGravity {
 
                     //Calculate the 3D distances between P (0, 0, 0) and
                     // the segment endpoints face[j] and face[(j + 1) % 3])
-                    distance.l1 = euclideanNorm(face[j]);
-                    distance.l2 = euclideanNorm(face[(j + 1) % 3]);
+                    distance.l1 = vertexNorms[j];
+                    distance.l2 = vertexNorms[(j + 1) % 3];
                     //Calculate the 1D distances between P'' (every segment has its own) and
                     // the segment endpoints face[j] and face[(j + 1) % 3])
                     distance.s1 = euclideanNorm(orthogonalProjectionPointsOnSegment - face[j]);
@@ -447,8 +743,9 @@ namespace polyhedralGravity {
             const std::array<Distance, 3> &distancesForPlane,
             double planeDistance, const Array3 &segmentDistancesForPlane,
             const Array3 &segmentNormalOrientationsForPlane,
-            const Array3 &projectionPointVertexNorms) {
+            const Array3 &projectionPointVertexNorms, MathBackend mathBackend) {
         std::array<TranscendentalExpression, 3> transcendentalExpressionsForPlane{};
+        const bool fastMath = mathBackend == MathBackend::FAST;
 
         //Zip iterator consisting of 3D and 1D distances l1/l2 and s1/2 for this plane | h_pq | sigma_pq for this plane
         auto zip = util::zipPair(distancesForPlane, segmentDistancesForPlane, segmentNormalOrientationsForPlane);
@@ -483,14 +780,19 @@ namespace polyhedralGravity {
                     } else {
                         //Implementation of
                         // log((s2_pq + l2_pq) / (s1_pq + l1_pq))
-                        transcendentalExpressionPerSegment.ln =
-                                std::log((distance.s2 + distance.l2) / (distance.s1 + distance.l1));
+                        const double quotient = (distance.s2 + distance.l2) / (distance.s1 + distance.l1);
+                        transcendentalExpressionPerSegment.ln = fastMath ? fastLog(quotient) : std::log(quotient);
                     }
 
                     //Compute AN_pq according to (15)
                     // If h_p == 0 or h_pq == 0 then AN_pq is zero, too (distances are always positive!)
                     if (planeDistance < EPSILON || segmentDistance < EPSILON) {
                         transcendentalExpressionPerSegment.an = 0.0;
+                    } else if (fastMath) {
+                        //The same expression with the polynomial approximation of atan(..)
+                        transcendentalExpressionPerSegment.an =
+                                fastAtan(planeDistance * distance.s2 / (segmentDistance * distance.l2)) -
+                                fastAtan(planeDistance * distance.s1 / (segmentDistance * distance.l1));
                     } else {
                         //Implementation of:
                         // atan(h_p * s2_pq / h_pq * l2_pq) - atan(h_p * s1_pq / h_pq * l1_pq)
@@ -4,10 +4,15 @@
 #include <array>
 #include <vector>
 #include <algorithm>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <mutex>
 #include "polyhedralGravity/model/Polyhedron.h"
 #include "polyhedralGravity/model/GravityModelData.h"
 #include "polyhedralGravity/util/UtilityConstants.h"
 #include "polyhedralGravity/util/UtilityContainer.h"
+#include "polyhedralGravity/util/UtilityFastMath.h"
 #include "spdlog/spdlog.h"
 #include "thrust/iterator/zip_iterator.h"
 #include "thrust/iterator/transform_iterator.h"
@@ -17,6 +22,8 @@
 #include "thrust/execution_policy.h"
 #include "polyhedralGravity/util/UtilityThrust.h"
 #include "polyhedralGravity/output/Logging.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/ParallelExecution.h"
 #include "xsimd/xsimd.hpp"
 
 namespace polyhedralGravity {
@@ -45,7 +52,7 @@ namespace polyhedralGravity {
 
         /**
          * Evaluates the polyhedral gravity model for a given constant density polyhedron at multiple computation
-         * points.
+         * points. The kernel is selected by EvaluationSettings::getKernelVariant().
          * @param polyhedron - the polyhedron consisting of vertices and triangular faces
          * @param density - the constant density in [kg/m^3]
          * @param computationPoints - vector of computation points
@@ -57,6 +64,74 @@ namespace polyhedralGravity {
                 double density,
                 const std::vector<Array3> &computationPoints);
 
+        /**
+         * Evaluates the polyhedral gravity model at computation point P given in another frame than the
+         * polyhedron's body-fixed frame. P is transformed into the body-fixed frame and the result back into the
+         * outer frame, the polyhedron itself is not modified or copied.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoint - the computation Point P in the outer frame
+         * @param frame - the transformation from the body-fixed to the outer frame
+         * @return the GravityModelResult in the outer frame
+         */
+        GravityModelResult evaluate(
+                const Polyhedron &polyhedron,
+                double density,
+                const Array3 &computationPoint,
+                const FrameTransformation &frame);
+
+        /**
+         * Evaluates the polyhedral gravity model at multiple computation points given in another frame than the
+         * polyhedron's body-fixed frame. The points are transformed into the body-fixed frame, evaluated at once
+         * like by the multi-point evaluate(..) (with its choice of the kernel), and the results are transformed back.
+         * Both transformations are parallel loops over the points with the ParallelBackend of the EvaluationSettings.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoints - vector of computation points in the outer frame
+         * @param frame - the transformation from the body-fixed to the outer frame, the same for all points
+         * @return the GravityModelResult in the outer frame foreach computation Point P
+         */
+        std::vector<GravityModelResult> evaluate(
+                const Polyhedron &polyhedron,
+                double density,
+                const std::vector<Array3> &computationPoints,
+                const FrameTransformation &frame);
+
+        /**
+         * Evaluates the polyhedral gravity model at multiple computation points, each given with its own
+         * transformation, e.g. the points of a trajectory around a rotating body at different epochs.
+         * Like with a single transformation, all points are evaluated at once in the body-fixed frame.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoints - vector of computation points in their outer frames
+         * @param frames - the transformation from the body-fixed to the outer frame foreach computation Point P
+         * @return the GravityModelResult in the outer frame foreach computation Point P
+         * @throws std::invalid_argument if the number of points and transformations differs
+         */
+        std::vector<GravityModelResult> evaluate(
+                const Polyhedron &polyhedron,
+                double density,
+                const std::vector<Array3> &computationPoints,
+                const std::vector<FrameTransformation> &frames);
+
+        /**
+         * Measures the number of faces from which on the parallel evaluation of the faces of a single computation
+         * point is faster than the serial one with the current ParallelBackend and thread count. With the cost c of
+         * one face and the cost o of starting and joining a parallel loop, p threads break even at
+         * n = o / (c * (1 - 1/p)) faces. Both costs are the minimum of repeated measurements, which takes a few
+         * milliseconds.
+         * @return the threshold, the maximum of size_t if the backend is SERIAL or has a single thread
+         */
+        size_t calibrateSerialFaceThreshold();
+
+        /**
+         * Returns the number of faces from which on the faces of a single computation point are evaluated in
+         * parallel, i.e. the one of the EvaluationSettings or, if that is zero, the calibrated one. The calibration
+         * runs once per ParallelBackend and thread count, its result is logged.
+         * @return the threshold
+         */
+        size_t resolveSerialFaceThreshold();
+
 
         /**
          * An iterator transforming the polyhedron's coordinates on demand by a given offset.
@@ -82,6 +157,190 @@ namespace polyhedralGravity {
 
         namespace detail {
 
+            /**
+             * Evaluates the geometric sums of the polyhedral gravity model for computation point P, i.e. the result
+             * of the model for a unit density before the application of the prefix GRAVITATIONAL_CONSTANT * density.
+             * Rounding errors are already eliminated from the returned sums.
+             * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+             * @param computationPoint - the computation Point P
+             * @return the density-independent sums for potential, acceleration and gradiometric tensor
+             */
+            GravityModelResult evaluateGeometricSums(const Polyhedron &polyhedron, const Array3 &computationPoint);
+
+            /**
+             * Evaluates the geometric sums of the polyhedral gravity model for computation point P like
+             * evaluateGeometricSums(..) above, with an explicit choice of the parallelization of the faces.
+             * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+             * @param computationPoint - the computation Point P
+             * @param parallelFaces - true if the faces are evaluated with the ParallelBackend, false if serially on
+             * the calling thread (e.g. within a parallel loop over the points)
+             * @return the density-independent sums for potential, acceleration and gradiometric tensor
+             */
+            GravityModelResult evaluateGeometricSums(const Polyhedron &polyhedron, const Array3 &computationPoint,
+                                                     bool parallelFaces);
+
+            /**
+             * Chooses the loop parallelized by the pointwise evaluation of multiple computation points.
+             * @param pointCount - the number of computation points
+             * @return the ParallelAxis of the EvaluationSettings, or for AUTO: POINTS if there are at least as
+             * many points as threads, FACES otherwise
+             */
+            ParallelAxis resolveParallelAxis(size_t pointCount);
+
+            /**
+             * Returns whether the EvaluationSettings enable an approximation which the SIMD lanes of the
+             * PointLaneKernel do not implement, i.e. MathBackend::FAST or a positive far-field accuracy.
+             * KernelVariant::AUTO does not choose the PointLaneKernel in that case.
+             * @return true if the per-face computation must be the scalar GravityModel::detail::evaluateFace(..)
+             */
+            bool requiresScalarFaces();
+
+            /**
+             * Evaluates the geometric sums of multiple computation points with the kernel chosen like by the
+             * multi-point GravityModel::evaluate(..), which applies the density prefix to the returned sums.
+             * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+             * @param computationPoints - vector of computation points
+             * @return the density-independent sums foreach computation Point P
+             */
+            std::vector<GravityModelResult> evaluateGeometricSums(const Polyhedron &polyhedron,
+                                                                  const std::vector<Array3> &computationPoints);
+
+            /**
+             * Evaluates the geometric sums of multiple computation points one after another like the single-point
+             * evaluateGeometricSums(..), with the loop given by resolveParallelAxis(..) parallelized
+             * (KernelVariant::POINTWISE).
+             * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+             * @param computationPoints - vector of computation points
+             * @return the density-independent sums foreach computation Point P
+             */
+            std::vector<GravityModelResult> evaluatePointwise(const Polyhedron &polyhedron,
+                                                              const std::vector<Array3> &computationPoints);
+
+            /**
+             * Applies the prefix GRAVITATIONAL_CONSTANT * density (and the division by 2 for the potential) to the
+             * geometric sums computed by evaluateGeometricSums(..).
+             * @param geometricSums - the density-independent sums
+             * @param density - the constant density in [kg/m^3]
+             * @return the final GravityModelResult
+             */
+            GravityModelResult applyDensityPrefix(GravityModelResult geometricSums, double density);
+
+            /**
+             * Computes the contribution of one triangular face to the geometric sums of the gravity model.
+             * The face's vertices must already be given relative to the computation point P (i.e. P is the origin).
+             * The approximations are the ones of the EvaluationSettings.
+             * @param face - the vertices of plane p shifted by -P
+             * @return the (density-independent) contribution of the face to potential, acceleration and tensor
+             */
+            GravityModelResult evaluateFace(const Array3Triplet &face);
+
+            /**
+             * Computes the contribution of one triangular face like evaluateFace(..), but with the given
+             * approximations instead of the ones of the EvaluationSettings.
+             * @param face - the vertices of plane p shifted by -P
+             * @param approximations - the math backend and the far-field accuracy
+             * @return the (density-independent) contribution of the face to potential, acceleration and tensor
+             */
+            GravityModelResult evaluateFace(const Array3Triplet &face, const FaceApproximations &approximations);
+
+            /**
+             * Checks if a face is evaluated by evaluateFaceMoments(..) for a given accuracy.
+             * With a as the largest distance between the centroid c and a vertex, the series of 1/|c + x| in
+             * (a/|c|) converges for all points x of the face. The terms beyond the second order contribute less than
+             * (a/|c|)^3 relative to the surface integral of 1/r and less than 4 * (a/|c|)^3 relative to its gradient
+             * (for a/|c| << 1), hence the criterion (a/|c|)^3 <= accuracy / 4. The observed errors are about two
+             * orders of magnitude smaller, since |x| < a for most points of the face.
+             * @param face - the vertices of plane p shifted by -P
+             * @param accuracy - the relative accuracy of the face's contribution
+             * @return true if the face's size is small enough compared to its distance from P
+             */
+            bool isFarField(const Array3Triplet &face, double accuracy);
+
+            /**
+             * Computes the contribution of one face like evaluateFace(..), but from the expansion of the surface
+             * integral of 1/r over the face in its area and second moment about the centroid c (up to the terms of
+             * second order in x/|c|), i.e. without any projection, logarithm, arctangent or singularity test.
+             * @param face - the vertices of plane p shifted by -P
+             * @return the (density-independent) approximated contribution of the face
+             */
+            GravityModelResult evaluateFaceMoments(const Array3Triplet &face);
+
+            /**
+             * Computes the ingredients of a face which do not depend on the computation point P (steps 1-01 to 1-03).
+             * @param face - the vertices of plane p (shifted or not)
+             * @return the segment vectors, the plane unit normal and the segment unit normals
+             */
+            PreparedFace prepareFace(const Array3Triplet &face);
+
+            /**
+             * Computes the contribution of one triangular face to the geometric sums of the gravity model from
+             * point-independent and point-dependent ingredients computed in advance, e.g. for a batch of points.
+             * @param face - the vertices of plane p shifted by -P
+             * @param preparedFace - the point-independent ingredients of plane p
+             * @param hessianPlane - the Hessian Normal Form of plane p relative to P
+             * @param vertexNorms - the 3D distances between P and the three vertices of plane p
+             * @param mathBackend - the implementation of the transcendental functions
+             * @return the (density-independent) contribution of the face to potential, acceleration and tensor
+             */
+            GravityModelResult evaluateFace(const Array3Triplet &face, const PreparedFace &preparedFace,
+                                            const HessianPlane &hessianPlane, const Array3 &vertexNorms,
+                                            MathBackend mathBackend = EvaluationSettings::getMathBackend());
+
+            /**
+             * Adds two (partial) results component-wise.
+             * @param a - first partial result
+             * @param b - second partial result
+             * @return the sum of both
+             */
+            GravityModelResult sumResults(const GravityModelResult &a, const GravityModelResult &b);
+
+            /**
+             * The number of faces summed up serially in one block by reduceDeterministic(..).
+             */
+            constexpr size_t DETERMINISTIC_BLOCK_SIZE = 128;
+
+            /**
+             * Sums up the contributions of the faces in an order which only depends on the number of faces.
+             * The faces are split into blocks of DETERMINISTIC_BLOCK_SIZE, the blocks are evaluated in parallel
+             * and each one is summed up in index order. Afterwards, the partial sums are combined by a pairwise
+             * tree of fixed shape.
+             * @tparam FaceIterator - random access iterator over the faces (already shifted by -P)
+             * @param faces - iterator pointing to the first face
+             * @param faceCount - the number of faces
+             * @param parallel - false evaluates the blocks serially, the result is the same
+             * @return the (not yet rounded) geometric sums
+             */
+            template<typename FaceIterator>
+            GravityModelResult reduceDeterministic(FaceIterator faces, size_t faceCount, bool parallel = true) {
+                const size_t blockCount = (faceCount + DETERMINISTIC_BLOCK_SIZE - 1) / DETERMINISTIC_BLOCK_SIZE;
+                std::vector<GravityModelResult> partialSums(blockCount);
+                const auto sumBlock = [faces, faceCount, &partialSums](size_t block) {
+                    const size_t end = std::min(faceCount, (block + 1) * DETERMINISTIC_BLOCK_SIZE);
+                    GravityModelResult sum{};
+                    for (size_t face = block * DETERMINISTIC_BLOCK_SIZE; face < end; ++face) {
+                        sum = sumResults(sum, evaluateFace(faces[face]));
+                    }
+                    partialSums[block] = sum;
+                };
+                if (parallel) {
+                    ParallelExecution::forEach(blockCount, sumBlock);
+                } else {
+                    for (size_t block = 0; block < blockCount; ++block) {
+                        sumBlock(block);
+                    }
+                }
+                //Pairwise tree, an odd element at the end is carried over to the next level
+                for (size_t width = blockCount; width > 1; width = (width + 1) / 2) {
+                    for (size_t i = 0; i < width / 2; ++i) {
+                        partialSums[i] = sumResults(partialSums[2 * i], partialSums[2 * i + 1]);
+                    }
+                    if (width % 2 == 1) {
+                        partialSums[width / 2] = partialSums[width - 1];
+                    }
+                }
+                return partialSums.empty() ? GravityModelResult{} : partialSums.front();
+            }
+
             /**
              * Computes the segment vectors G_ij for one plane of the polyhedron according to Tsoulis (18).
              * The segment vectors G_ij represent the vector from one vertex of the face to the neighboring vertex and
@@ -221,24 +480,43 @@ namespace polyhedralGravity {
                     const Array3Triplet &orthogonalProjectionPointsOnSegmentForPlane,
                     const Array3Triplet &face);
 
+            /**
+             * Computes the 3D distances l1_pq, l2_pq and the 1D distances s1_pq, s2_pq like above, but takes the
+             * norms of the vertices (i.e. the distances between P and the vertices) as already computed input.
+             * @param segmentVectorsForPlane - the segment vectors G_pq for plane p
+             * @param orthogonalProjectionPointsOnSegmentForPlane - the orthogonal projection Points P'' for plane p
+             * @param face - the vertices of plane p
+             * @param vertexNorms - the 3D distances between P and the vertices of plane p
+             * @return distances l1_pq and l2_pq and s1_pq and s2_pq foreach segment q of plane p
+             */
+            std::array<Distance, 3> distancesToSegmentEndpoints(
+                    const Array3Triplet &segmentVectorsForPlane,
+                    const Array3Triplet &orthogonalProjectionPointsOnSegmentForPlane,
+                    const Array3Triplet &face,
+                    const Array3 &vertexNorms);
+
             /**
              * Calculates the Transcendental Expressions LN_pq and AN_pq for every line segment of the polyhedron for
              * a given plane p.
              * LN_pq is calculated according to (14) using the natural logarithm and AN_pq is calculated according
              * to (15) using the arctan.
+             * With MathBackend::FAST, both are evaluated by the polynomial approximations util::fastLog(..) and
+             * util::fastAtan(..).
              * @param distancesForPlane - the distances l1, l2, s1, s2 foreach segment q of plane p
              * @param planeDistance - the plane distance h_p for plane p
              * @param segmentDistancesForPlane - the segment distance h_pq for segment q of plane p
              * @param segmentNormalOrientationsForPlane - the segment normal orientations n_pq for a plane p
              * @param orthogonalProjectionPointOnPlane - the orthogonal projection point P' for plane p
              * @param face - the vertices of plane p
+             * @param mathBackend - the implementation of the transcendental functions
              * @return LN_pq and AN_pq foreach segment q of plane p
              */
             std::array<TranscendentalExpression, 3>
             computeTranscendentalExpressions(const std::array<Distance, 3> &distancesForPlane,
                                              double planeDistance, const Array3 &segmentDistancesForPlane,
                                              const Array3 &segmentNormalOrientationsForPlane,
-                                             const Array3 &projectionPointVertexNorms);
+                                             const Array3 &projectionPointVertexNorms,
+                                             MathBackend mathBackend = EvaluationSettings::getMathBackend());
 
             /**
              * Calculates the singularities (correction) terms according to the Flow text for a given plane p.
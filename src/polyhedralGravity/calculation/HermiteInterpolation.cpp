@@ -0,0 +1,78 @@
+#include "HermiteInterpolation.h"
+
+namespace polyhedralGravity {
+
+    GravityModelResult HermiteInterpolation::interpolate(const std::array<HermiteNode, 8> &corners,
+                                                         const Array3 &localCoordinates, const Array3 &spacing) {
+        const auto basisX = detail::hermiteBasis(localCoordinates[0], spacing[0]);
+        const auto basisY = detail::hermiteBasis(localCoordinates[1], spacing[1]);
+        const auto basisZ = detail::hermiteBasis(localCoordinates[2], spacing[2]);
+
+        double potential = 0.0;
+        Array3 gradient{};
+        std::array<double, 6> hessian{};
+        for (size_t corner = 0; corner < 8; ++corner) {
+            const GravityModelResult &node = corners[corner].result;
+            //The derivatives of V at the corner, indexed by the derivative order along x + 2y + 4z
+            const std::array<double, 8> derivatives{
+                    node.gravitationalPotential,
+                    -node.acceleration[0],
+                    -node.acceleration[1],
+                    node.gradiometricTensor[3],
+                    -node.acceleration[2],
+                    node.gradiometricTensor[4],
+                    node.gradiometricTensor[5],
+                    corners[corner].mixedDerivative
+            };
+            const size_t i = corner & 1u, j = (corner >> 1u) & 1u, k = (corner >> 2u) & 1u;
+            for (size_t order = 0; order < 8; ++order) {
+                const size_t bx = 2 * i + (order & 1u), by = 2 * j + ((order >> 1u) & 1u),
+                        bz = 2 * k + ((order >> 2u) & 1u);
+                const double coefficient = derivatives[order];
+                potential += coefficient * basisX[0][bx] * basisY[0][by] * basisZ[0][bz];
+                gradient[0] += coefficient * basisX[1][bx] * basisY[0][by] * basisZ[0][bz];
+                gradient[1] += coefficient * basisX[0][bx] * basisY[1][by] * basisZ[0][bz];
+                gradient[2] += coefficient * basisX[0][bx] * basisY[0][by] * basisZ[1][bz];
+                hessian[0] += coefficient * basisX[2][bx] * basisY[0][by] * basisZ[0][bz];
+                hessian[1] += coefficient * basisX[0][bx] * basisY[2][by] * basisZ[0][bz];
+                hessian[2] += coefficient * basisX[0][bx] * basisY[0][by] * basisZ[2][bz];
+                hessian[3] += coefficient * basisX[1][bx] * basisY[1][by] * basisZ[0][bz];
+                hessian[4] += coefficient * basisX[1][bx] * basisY[0][by] * basisZ[1][bz];
+                hessian[5] += coefficient * basisX[0][bx] * basisY[1][by] * basisZ[1][bz];
+            }
+        }
+        //The acceleration is the negative gradient of V in the sign convention of the model
+        return {potential, {-gradient[0], -gradient[1], -gradient[2]}, hessian};
+    }
+
+    void HermiteInterpolation::estimateMixedDerivatives(std::array<HermiteNode, 8> &corners, const Array3 &spacing) {
+        //The tensor entries xy, xz, yz are differentiated along z, y, x (bit 2, 1, 0 of the corner index)
+        constexpr std::array<std::pair<size_t, size_t>, 3> differences{{{2, 3}, {1, 4}, {0, 5}}};
+        std::array<double, 8> mixedDerivatives{};
+        for (size_t corner = 0; corner < 8; ++corner) {
+            for (const auto &[axis, tensorIndex]: differences) {
+                const size_t bit = 1u << axis;
+                const double upper = corners[corner | bit].result.gradiometricTensor[tensorIndex];
+                const double lower = corners[corner & ~bit].result.gradiometricTensor[tensorIndex];
+                mixedDerivatives[corner] += (upper - lower) / spacing[axis] / 3.0;
+            }
+        }
+        for (size_t corner = 0; corner < 8; ++corner) {
+            corners[corner].mixedDerivative = mixedDerivatives[corner];
+        }
+    }
+
+    std::array<std::array<double, 4>, 3> HermiteInterpolation::detail::hermiteBasis(double t, double length) {
+        const double t2 = t * t;
+        const double t3 = t2 * t;
+        return {{
+                        {2.0 * t3 - 3.0 * t2 + 1.0, (t3 - 2.0 * t2 + t) * length,
+                         -2.0 * t3 + 3.0 * t2, (t3 - t2) * length},
+                        {(6.0 * t2 - 6.0 * t) / length, 3.0 * t2 - 4.0 * t + 1.0,
+                         (-6.0 * t2 + 6.0 * t) / length, 3.0 * t2 - 2.0 * t},
+                        {(12.0 * t - 6.0) / (length * length), (6.0 * t - 4.0) / length,
+                         (-12.0 * t + 6.0) / (length * length), (6.0 * t - 2.0) / length}
+                }};
+    }
+
+}
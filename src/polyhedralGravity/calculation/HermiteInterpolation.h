@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <utility>
+#include "polyhedralGravity/model/GravityModelData.h"
+
+namespace polyhedralGravity {
+
+    /**
+     * The data required by the tricubic Hermite interpolation at one node of a cell.
+     * The derivatives of the potential V are taken from the exact model: Vx, Vy, Vz from the acceleration and
+     * the mixed derivatives Vxy, Vxz, Vyz from the gradiometric tensor. Only Vxyz has to be approximated.
+     */
+    struct HermiteNode {
+
+        /**
+         * The result of the polyhedral gravity model at the node
+         */
+        GravityModelResult result;
+
+        /**
+         * The mixed third order derivative Vxyz of the potential at the node
+         */
+        double mixedDerivative{};
+
+    };
+
+    /**
+     * Tricubic Hermite interpolation of the potential V inside a cuboid cell.
+     * The interpolant is the tensor product of one-dimensional cubic Hermite polynomials matching
+     * V, Vx, Vy, Vz, Vxy, Vxz, Vyz and Vxyz at the eight corners (Lekien & Marsden, 2005).
+     * The acceleration and the gradiometric tensor are the analytical derivatives of this interpolant, so that
+     * the three returned quantities are consistent with each other (the interpolated field is conservative).
+     */
+    namespace HermiteInterpolation {
+
+        /**
+         * Interpolates the result of the polyhedral gravity model inside a cell.
+         * @param corners - the eight corners of the cell, corner (i, j, k) with i, j, k in {0, 1} at index i + 2j + 4k
+         * @param localCoordinates - the position inside the cell normalized to [0, 1] per axis
+         * @param spacing - the edge lengths of the cell
+         * @return the interpolated GravityModelResult
+         */
+        GravityModelResult interpolate(const std::array<HermiteNode, 8> &corners, const Array3 &localCoordinates,
+                                       const Array3 &spacing);
+
+        /**
+         * Approximates the mixed derivative Vxyz at the corners of a single cell by averaging the one-sided
+         * differences of Vxy along z, Vxz along y and Vyz along x over the cell's edges.
+         * Used if no neighboring nodes are available for a central difference.
+         * @param corners - the eight corners of the cell, the mixedDerivative members are overwritten
+         * @param spacing - the edge lengths of the cell
+         */
+        void estimateMixedDerivatives(std::array<HermiteNode, 8> &corners, const Array3 &spacing);
+
+        namespace detail {
+
+            /**
+             * Evaluates the one-dimensional cubic Hermite basis and its first and second derivative at t.
+             * The basis functions are ordered: value at 0, derivative at 0, value at 1, derivative at 1 (h00, h10,
+             * h01, h11) whereas the derivative bases are already scaled by the edge length.
+             * @param t - the local coordinate in [0, 1]
+             * @param length - the edge length of the cell along this axis
+             * @return [basis, first derivative, second derivative] with respect to the global coordinate
+             */
+            std::array<std::array<double, 4>, 3> hermiteBasis(double t, double length);
+
+        }
+
+    }
+
+}
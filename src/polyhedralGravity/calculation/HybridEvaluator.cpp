@@ -0,0 +1,199 @@
+#include "HybridEvaluator.h"
+
+namespace polyhedralGravity {
+
+    std::string HybridReport::toString() const {
+        return "EXACT: " + std::to_string(countPoints(EvaluationMethod::EXACT)) +
+               ", FAST_MATH: " + std::to_string(countPoints(EvaluationMethod::FAST_MATH)) +
+               ", FACE_FAR_FIELD: " + std::to_string(countPoints(EvaluationMethod::FACE_FAR_FIELD)) +
+               ", GLOBAL_EXPANSION: " + std::to_string(countPoints(EvaluationMethod::GLOBAL_EXPANSION));
+    }
+
+    HybridEvaluator::HybridEvaluator(const Polyhedron &polyhedron, double density)
+            : _polyhedron{polyhedron},
+              _density{density},
+              _volume{0.0},
+              _centroid{},
+              _secondMoment{},
+              _boundingRadius{0.0},
+              _surfaceArea{0.0},
+              _medianFaceRadius{0.0} {
+        using namespace util;
+        std::tie(_volume, _centroid) = MeshDecimation::computeVolumeAndCentroid(polyhedron);
+        for (const Array3 &vertex: polyhedron.getVertices()) {
+            _boundingRadius = std::max(_boundingRadius, euclideanNorm(vertex - _centroid));
+        }
+
+        //The second moment as sum of the tetrahedra spanned by the centroid and the faces:
+        //det / 120 * (sum of v * v^T + s * s^T) with the vertices v relative to the centroid and their sum s
+        std::vector<double> faceRadii{};
+        faceRadii.reserve(polyhedron.countFaces());
+        for (const auto &indices: polyhedron.getFaces()) {
+            const Array3Triplet face{polyhedron.getVertex(indices[0]) - _centroid,
+                                     polyhedron.getVertex(indices[1]) - _centroid,
+                                     polyhedron.getVertex(indices[2]) - _centroid};
+            const double determinant = dot(face[0], cross(face[1], face[2]));
+            const Array3 sum = face[0] + face[1] + face[2];
+            for (size_t i = 0; i < 3; ++i) {
+                for (size_t j = 0; j < 3; ++j) {
+                    _secondMoment[i][j] += determinant / 120.0 *
+                                           (face[0][i] * face[0][j] + face[1][i] * face[1][j] +
+                                            face[2][i] * face[2][j] + sum[i] * sum[j]);
+                }
+            }
+            _surfaceArea += surfaceArea(face);
+            const Array3 faceCentroid = sum / 3.0;
+            faceRadii.push_back(std::max({euclideanNorm(face[0] - faceCentroid), euclideanNorm(face[1] - faceCentroid),
+                                          euclideanNorm(face[2] - faceCentroid)}));
+        }
+        const auto median = faceRadii.begin() + static_cast<std::ptrdiff_t>(faceRadii.size() / 2);
+        std::nth_element(faceRadii.begin(), median, faceRadii.end());
+        _medianFaceRadius = faceRadii.empty() ? 0.0 : *median;
+    }
+
+    std::pair<std::vector<GravityModelResult>, HybridReport>
+    HybridEvaluator::evaluate(const std::vector<Array3> &computationPoints, double accuracy) const {
+        if (!(accuracy >= 0.0 && accuracy < 1.0)) {
+            throw std::invalid_argument("The accuracy must be in [0, 1)!");
+        }
+        //1. Step: Group the points by their method
+        std::array<std::vector<size_t>, 4> groups{};
+        double farFieldAccuracy = 1.0;
+        for (size_t i = 0; i < computationPoints.size(); ++i) {
+            const EvaluationMethod method = selectMethod(computationPoints[i], accuracy);
+            groups[static_cast<size_t>(method)].push_back(i);
+            if (method == EvaluationMethod::FACE_FAR_FIELD) {
+                using util::operator-;
+                const double distance = util::euclideanNorm(computationPoints[i] - _centroid);
+                farFieldAccuracy = std::min(farFieldAccuracy, faceAccuracy(distance, accuracy));
+            }
+        }
+        HybridReport report{};
+        for (size_t method = 0; method < groups.size(); ++method) {
+            report.pointsPerMethod[method] = groups[method].size();
+        }
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Hybrid evaluation of {} computation points with the accuracy {}: {}",
+                            computationPoints.size(), accuracy, report.toString());
+
+        //2. Step: Evaluate every group at once, the approximations with the tiled kernel
+        std::vector<GravityModelResult> result{computationPoints.size()};
+        const auto evaluateGroup = [&](EvaluationMethod method, const auto &evaluation) {
+            const std::vector<size_t> &group = groups[static_cast<size_t>(method)];
+            if (group.empty()) {
+                return;
+            }
+            std::vector<Array3> points{};
+            points.reserve(group.size());
+            for (const size_t index: group) {
+                points.push_back(computationPoints[index]);
+            }
+            const std::vector<GravityModelResult> groupResult = evaluation(points);
+            for (size_t i = 0; i < group.size(); ++i) {
+                result[group[i]] = groupResult[i];
+            }
+        };
+        //The tiled kernel takes the approximations per call, so the process-wide EvaluationSettings stay untouched
+        const auto evaluateWithApproximations = [this](const std::vector<Array3> &points,
+                                                       const FaceApproximations &approximations) {
+            return TiledKernel::evaluate(_polyhedron, _density, points, TiledKernel::DEFAULT_POINT_BLOCK_SIZE,
+                                         TiledKernel::DEFAULT_FACE_BLOCK_SIZE, approximations);
+        };
+
+        evaluateGroup(EvaluationMethod::EXACT, [&](const std::vector<Array3> &points) {
+            return evaluateWithApproximations(points, {MathBackend::ACCURATE, 0.0});
+        });
+        evaluateGroup(EvaluationMethod::FAST_MATH, [&](const std::vector<Array3> &points) {
+            return evaluateWithApproximations(points, {MathBackend::FAST, 0.0});
+        });
+        evaluateGroup(EvaluationMethod::FACE_FAR_FIELD, [&](const std::vector<Array3> &points) {
+            return evaluateWithApproximations(points, {MathBackend::ACCURATE, farFieldAccuracy});
+        });
+        evaluateGroup(EvaluationMethod::GLOBAL_EXPANSION, [this](const std::vector<Array3> &points) {
+            std::vector<GravityModelResult> groupResult{points.size()};
+            thrust::transform(thrust::device, points.begin(), points.end(), groupResult.begin(),
+                              [this](const Array3 &point) {
+                                  return evaluateExpansion(point);
+                              });
+            return groupResult;
+        });
+        return {result, report};
+    }
+
+    EvaluationMethod HybridEvaluator::selectMethod(const Array3 &computationPoint, double accuracy) const {
+        using util::operator-;
+        const double distance = util::euclideanNorm(computationPoint - _centroid);
+        if (accuracy <= 0.0) {
+            return EvaluationMethod::EXACT;
+        }
+        if (expansionErrorBound(distance) <= accuracy) {
+            return EvaluationMethod::GLOBAL_EXPANSION;
+        }
+        //A typical face qualifies for the far-field approximation even at the closest possible distance
+        if (distance > _boundingRadius) {
+            const double sizeRatio = _medianFaceRadius / (distance - _boundingRadius);
+            if (4.0 * sizeRatio * sizeRatio * sizeRatio <= faceAccuracy(distance, accuracy)) {
+                return EvaluationMethod::FACE_FAR_FIELD;
+            }
+        }
+        if (accuracy >= FAST_MATH_ACCURACY * std::max(1.0, distance / _boundingRadius)) {
+            return EvaluationMethod::FAST_MATH;
+        }
+        return EvaluationMethod::EXACT;
+    }
+
+    GravityModelResult HybridEvaluator::evaluateExpansion(const Array3 &computationPoint) const {
+        using namespace util;
+        //The potential V = G * rho * (vol / r + Q / (2 r^5)) with Q = 3 d^T S d - r^2 tr(S) and d = P - c,
+        //the acceleration -grad V and the gradiometric tensor grad grad V like the sign conventions of the model
+        const Array3 d = computationPoint - _centroid;
+        const double r2 = dot(d, d);
+        const double r = std::sqrt(r2);
+        const double r5 = r2 * r2 * r;
+        const double r7 = r5 * r2;
+        const double r9 = r7 * r2;
+        const double trace = _secondMoment[0][0] + _secondMoment[1][1] + _secondMoment[2][2];
+        const Array3 sd{dot(_secondMoment[0], d), dot(_secondMoment[1], d), dot(_secondMoment[2], d)};
+        const double q = 3.0 * dot(d, sd) - r2 * trace;
+        //The gradient of Q
+        const Array3 g = sd * 6.0 - d * (2.0 * trace);
+        const double prefix = GRAVITATIONAL_CONSTANT * _density;
+
+        GravityModelResult result{};
+        result.gravitationalPotential = prefix * (_volume / r + q / (2.0 * r5));
+        for (size_t i = 0; i < 3; ++i) {
+            result.acceleration[i] = prefix * (_volume * d[i] / (r2 * r) - g[i] / (2.0 * r5) +
+                                               5.0 * q * d[i] / (2.0 * r7));
+        }
+        constexpr std::array<std::pair<size_t, size_t>, 6> components{{{0, 0}, {1, 1}, {2, 2}, {0, 1}, {0, 2}, {1, 2}}};
+        for (size_t k = 0; k < 6; ++k) {
+            const auto [i, j] = components[k];
+            const double identity = i == j ? 1.0 : 0.0;
+            const double monopole = _volume * (3.0 * d[i] * d[j] - r2 * identity) / r5;
+            const double quadrupole = ((6.0 * _secondMoment[i][j] - 2.0 * trace * identity) / r5 -
+                                       5.0 * (g[i] * d[j] + d[i] * g[j]) / r7 +
+                                       q * (35.0 * d[i] * d[j] / r9 - 5.0 * identity / r7)) / 2.0;
+            result.gradiometricTensor[k] = prefix * (monopole + quadrupole);
+        }
+        return result;
+    }
+
+    double HybridEvaluator::expansionErrorBound(double distance) const {
+        const double x = _boundingRadius / distance;
+        if (!(x < 1.0)) {
+            return std::numeric_limits<double>::infinity();
+        }
+        //The sum of (2n + 1) * x^n over all n is (1 + x) / (1 - x)^2
+        const double series = (1.0 + x) / ((1.0 - x) * (1.0 - x));
+        const double truncated = std::max(series - 1.0 - 3.0 * x - 5.0 * x * x, 0.0);
+        const double lowerBound = 1.0 - (series - 1.0 - 3.0 * x);
+        return lowerBound > 0.0 ? truncated / lowerBound : std::numeric_limits<double>::infinity();
+    }
+
+    double HybridEvaluator::faceAccuracy(double distance, double accuracy) const {
+        //The contributions of the faces to the acceleration are about area / distance, their sum about
+        //volume / distance^2, the difference is lost by cancellation
+        return std::min(accuracy * _volume / (_surfaceArea * (distance + _boundingRadius)), 0.5);
+    }
+
+}
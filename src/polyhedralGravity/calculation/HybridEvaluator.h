@@ -0,0 +1,223 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <tuple>
+#include <limits>
+#include <utility>
+#include <stdexcept>
+#include <algorithm>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/TiledKernel.h"
+#include "polyhedralGravity/calculation/MeshDecimation.h"
+#include "polyhedralGravity/util/UtilityConstants.h"
+#include "polyhedralGravity/util/UtilityContainer.h"
+#include "polyhedralGravity/output/Logging.h"
+#include "thrust/transform.h"
+#include "thrust/execution_policy.h"
+
+namespace polyhedralGravity {
+
+    /**
+     * The methods of the HybridEvaluator from the most accurate (and most expensive) to the cheapest one.
+     */
+    enum class EvaluationMethod {
+
+        /**
+         * The exact polyhedral gravity model with the accurate transcendental functions and without far-field
+         * approximation, independent of the EvaluationSettings
+         */
+        EXACT,
+
+        /**
+         * The exact model with MathBackend::FAST, if the accuracy allows the error of the fast transcendental
+         * functions
+         */
+        FAST_MATH,
+
+        /**
+         * The exact model with the far-field approximation of the faces far away from the computation point
+         * (see EvaluationSettings::setFarFieldAccuracy(..))
+         */
+        FACE_FAR_FIELD,
+
+        /**
+         * The expansion of the whole polyhedron about its centroid up to the second moments (mass and quadrupole)
+         */
+        GLOBAL_EXPANSION
+
+    };
+
+    /**
+     * Reports how the HybridEvaluator treated the computation points of one call.
+     */
+    struct HybridReport {
+
+        /**
+         * The number of computation points foreach EvaluationMethod (indexed by the enumerator's value)
+         */
+        std::array<size_t, 4> pointsPerMethod{};
+
+        /**
+         * Returns the number of computation points evaluated with a method.
+         * @param method - the EvaluationMethod
+         * @return number of points
+         */
+        [[nodiscard]] size_t countPoints(EvaluationMethod method) const {
+            return pointsPerMethod[static_cast<size_t>(method)];
+        }
+
+        /**
+         * Returns a human-readable summary, e.g. for logging.
+         * @return the number of points per method
+         */
+        [[nodiscard]] std::string toString() const;
+
+    };
+
+    /**
+     * Evaluates the polyhedral gravity model for a required relative accuracy of the acceleration with the cheapest
+     * adequate method per computation point. The method is chosen from the distance r between the point and the
+     * centroid compared to the bounding radius R (the largest distance between the centroid and a vertex):
+     * <ul>
+     * <li>GLOBAL_EXPANSION if the bound of its truncation error in R / r is within the accuracy,</li>
+     * <li>FACE_FAR_FIELD outside the bounding sphere if a typical face is small enough compared to the distance
+     * r - R to qualify for the far-field approximation at the accuracy, which is reduced by the cancellation
+     * between the faces' contributions (total surface area * r compared to the volume),</li>
+     * <li>FAST_MATH if the accuracy is coarser than the error of MathBackend::FAST,</li>
+     * <li>EXACT otherwise.</li>
+     * </ul>
+     * The points are grouped by their method and every group is evaluated at once.
+     *
+     * @note EXACT, FAST_MATH and FACE_FAR_FIELD pass their FaceApproximations to the TiledKernel, the process-wide
+     * approximations of the EvaluationSettings neither apply nor are changed, so concurrent evaluations are safe
+     * @example One call for a mixed set of points from the surface to far away with a common error budget
+     */
+    class HybridEvaluator {
+
+        /**
+         * The relative error of the fast transcendental functions' results close to the polyhedron
+         * (see MathBackend::FAST)
+         */
+        static constexpr double FAST_MATH_ACCURACY = 1e-10;
+
+        /**
+         * The polyhedron consisting of vertices and triangular faces
+         */
+        Polyhedron _polyhedron;
+
+        /**
+         * The constant density in [kg/m^3]
+         */
+        double _density;
+
+        /**
+         * The volume of the polyhedron
+         */
+        double _volume;
+
+        /**
+         * The centroid of the polyhedron
+         */
+        Array3 _centroid;
+
+        /**
+         * The second moment of the volume about the centroid, i.e. the integral of (x - c)(x - c)^T
+         */
+        Array3Triplet _secondMoment;
+
+        /**
+         * The largest distance between the centroid and a vertex
+         */
+        double _boundingRadius;
+
+        /**
+         * The total surface area of the faces
+         */
+        double _surfaceArea;
+
+        /**
+         * The median of the largest distances between the centroid of a face and its vertices
+         */
+        double _medianFaceRadius;
+
+    public:
+
+        /**
+         * Creates a HybridEvaluator and computes the moments and sizes of the polyhedron.
+         * @param polyhedron - the closed polyhedron consisting of vertices and triangular faces
+         * @param density - the constant density in [kg/m^3]
+         */
+        HybridEvaluator(const Polyhedron &polyhedron, double density);
+
+        /**
+         * Evaluates the polyhedral gravity model at multiple computation points with the cheapest method which
+         * meets the accuracy.
+         * @param computationPoints - vector of computation points
+         * @param accuracy - the required accuracy of the acceleration relative to its norm
+         * @return the GravityModelResult foreach computation Point P and the report of the chosen methods
+         * @throws std::invalid_argument if the accuracy is not in [0, 1)
+         */
+        [[nodiscard]] std::pair<std::vector<GravityModelResult>, HybridReport>
+        evaluate(const std::vector<Array3> &computationPoints, double accuracy) const;
+
+        /**
+         * Chooses the cheapest method which meets the accuracy at a computation point.
+         * @param computationPoint - the computation Point P
+         * @param accuracy - the required accuracy of the acceleration relative to its norm
+         * @return the EvaluationMethod
+         */
+        [[nodiscard]] EvaluationMethod selectMethod(const Array3 &computationPoint, double accuracy) const;
+
+        /**
+         * Evaluates the expansion of the whole polyhedron about its centroid at a computation point.
+         * @param computationPoint - the computation Point P
+         * @return the approximated GravityModelResult
+         */
+        [[nodiscard]] GravityModelResult evaluateExpansion(const Array3 &computationPoint) const;
+
+        /**
+         * Returns the bound of the relative acceleration error of the expansion at a distance from the centroid.
+         * With x = R / r, the gradient of the term of degree n is at most (2n + 1) * x^n relative to the monopole's
+         * one, so the truncated terms of degree n >= 3 are bounded by their sum, while the acceleration is at least
+         * (1 - sum of the bounds of degree n >= 2) times the monopole's acceleration.
+         * @param distance - the distance from the centroid in [m]
+         * @return the bound, infinity inside the bounding sphere or if the series does not bound the acceleration
+         */
+        [[nodiscard]] double expansionErrorBound(double distance) const;
+
+        /**
+         * Returns the largest distance between the centroid and a vertex.
+         * @return the bounding radius in [m]
+         */
+        [[nodiscard]] double getBoundingRadius() const {
+            return _boundingRadius;
+        }
+
+        /**
+         * Returns the centroid of the polyhedron.
+         * @return the centroid
+         */
+        [[nodiscard]] const Array3 &getCentroid() const {
+            return _centroid;
+        }
+
+    private:
+
+        /**
+         * Returns the per-face accuracy of the far-field approximation which keeps the accuracy of the total
+         * acceleration at a distance from the centroid.
+         * @param distance - the distance from the centroid in [m]
+         * @param accuracy - the required accuracy of the acceleration relative to its norm
+         * @return the per-face accuracy
+         */
+        [[nodiscard]] double faceAccuracy(double distance, double accuracy) const;
+
+    };
+
+}
@@ -0,0 +1,106 @@
+#include "IncrementalEvaluator.h"
+
+namespace polyhedralGravity {
+
+    IncrementalEvaluator::IncrementalEvaluator(const Polyhedron &polyhedron, double density,
+                                               std::vector<Array3> computationPoints)
+            : _vertices{polyhedron.getVertices()},
+              _faces{polyhedron.getFaces()},
+              _incidentFaces{polyhedron.countVertices()},
+              _density{density},
+              _computationPoints{std::move(computationPoints)},
+              _contributions{_computationPoints.size() * _faces.size()},
+              _sums{_computationPoints.size()} {
+        for (size_t face = 0; face < _faces.size(); ++face) {
+            for (const size_t vertex: _faces[face]) {
+                if (vertex >= _vertices.size()) {
+                    throw std::invalid_argument{"A face of the polyhedron references a non-existing vertex!"};
+                }
+                _incidentFaces[vertex].push_back(face);
+            }
+        }
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Incremental evaluator: evaluating {} faces for {} computation points",
+                            _faces.size(), _computationPoints.size());
+        const size_t faceCount = _faces.size();
+        thrust::for_each(thrust::device, thrust::counting_iterator<size_t>(0),
+                         thrust::counting_iterator<size_t>(_computationPoints.size()),
+                         [this, faceCount](size_t point) {
+                             for (size_t face = 0; face < faceCount; ++face) {
+                                 _contributions[point * faceCount + face] =
+                                         evaluateFace(face, _computationPoints[point]);
+                             }
+                         });
+        resynchronize();
+    }
+
+    size_t IncrementalEvaluator::moveVertices(const std::vector<size_t> &indices,
+                                              const std::vector<Array3> &positions) {
+        if (indices.size() != positions.size()) {
+            throw std::invalid_argument{"The number of vertex indices and new positions must be equal!"};
+        }
+        //All indices are checked before the first vertex moves, so that a failed call leaves the state unchanged
+        if (std::any_of(indices.cbegin(), indices.cend(), [this](size_t index) { return index >= _vertices.size(); })) {
+            throw std::invalid_argument{"The vertex index is out of range of the polyhedron!"};
+        }
+        //1. Step: Move the vertices and collect the incident faces (each only once)
+        std::vector<size_t> changedFaces{};
+        for (size_t i = 0; i < indices.size(); ++i) {
+            _vertices[indices[i]] = positions[i];
+            changedFaces.insert(changedFaces.end(), _incidentFaces[indices[i]].begin(),
+                                _incidentFaces[indices[i]].end());
+        }
+        std::sort(changedFaces.begin(), changedFaces.end());
+        changedFaces.erase(std::unique(changedFaces.begin(), changedFaces.end()), changedFaces.end());
+
+        //2. Step: Replace the old contributions of these faces by the new ones
+        const size_t faceCount = _faces.size();
+        thrust::for_each(thrust::device, thrust::counting_iterator<size_t>(0),
+                         thrust::counting_iterator<size_t>(_computationPoints.size()),
+                         [this, faceCount, &changedFaces](size_t point) {
+                             using namespace util;
+                             GravityModelResult &sum = _sums[point];
+                             for (const size_t face: changedFaces) {
+                                 GravityModelResult &contribution = _contributions[point * faceCount + face];
+                                 const GravityModelResult updated = evaluateFace(face, _computationPoints[point]);
+                                 sum.gravitationalPotential +=
+                                         updated.gravitationalPotential - contribution.gravitationalPotential;
+                                 sum.acceleration = sum.acceleration + (updated.acceleration - contribution.acceleration);
+                                 sum.gradiometricTensor = sum.gradiometricTensor +
+                                                          (updated.gradiometricTensor - contribution.gradiometricTensor);
+                                 contribution = updated;
+                             }
+                         });
+        return changedFaces.size();
+    }
+
+    void IncrementalEvaluator::resynchronize() {
+        const size_t faceCount = _faces.size();
+        thrust::for_each(thrust::device, thrust::counting_iterator<size_t>(0),
+                         thrust::counting_iterator<size_t>(_computationPoints.size()),
+                         [this, faceCount](size_t point) {
+                             GravityModelResult sum{};
+                             for (size_t face = 0; face < faceCount; ++face) {
+                                 sum = GravityModel::detail::sumResults(sum, _contributions[point * faceCount + face]);
+                             }
+                             _sums[point] = sum;
+                         });
+    }
+
+    std::vector<GravityModelResult> IncrementalEvaluator::getResults() const {
+        std::vector<GravityModelResult> result{_sums.size()};
+        std::transform(_sums.begin(), _sums.end(), result.begin(), [this](GravityModelResult sum) {
+            sum.eliminateRoundingErrors();
+            return GravityModel::detail::applyDensityPrefix(sum, _density);
+        });
+        return result;
+    }
+
+    GravityModelResult IncrementalEvaluator::evaluateFace(size_t face, const Array3 &computationPoint) const {
+        using namespace util;
+        return GravityModel::detail::evaluateFace({_vertices[_faces[face][0]] - computationPoint,
+                                                   _vertices[_faces[face][1]] - computationPoint,
+                                                   _vertices[_faces[face][2]] - computationPoint});
+    }
+
+}
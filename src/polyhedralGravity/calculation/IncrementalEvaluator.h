@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/util/UtilityContainer.h"
+#include "polyhedralGravity/output/Logging.h"
+#include "thrust/for_each.h"
+#include "thrust/execution_policy.h"
+#include "thrust/iterator/counting_iterator.h"
+
+namespace polyhedralGravity {
+
+    /**
+     * A stateful evaluation of the polyhedral gravity model for a fixed set of computation points and a polyhedron
+     * whose vertices are moved, e.g. during the fitting of a shape model.
+     * The contribution of every face to every point is stored. If vertices are moved, only the faces incident to
+     * these vertices are re-evaluated: their old contribution is subtracted from and the new one is added to the
+     * per-point sums. Hence, an update costs O(changed faces) per point instead of O(faces).
+     *
+     * @note The evaluator stores ten doubles per face and computation point.
+     * @note Repeated updates accumulate rounding errors in the sums, use resynchronize() to sum up the stored
+     * contributions again once in a while.
+     */
+    class IncrementalEvaluator {
+
+        /**
+         * The current vertices of the polyhedron
+         */
+        std::vector<Array3> _vertices;
+
+        /**
+         * The triangular faces of the polyhedron (constant)
+         */
+        const std::vector<std::array<size_t, 3>> _faces;
+
+        /**
+         * The indices of the faces incident to every vertex
+         */
+        std::vector<std::vector<size_t>> _incidentFaces;
+
+        /**
+         * The constant density in [kg/m^3]
+         */
+        const double _density;
+
+        /**
+         * The computation points
+         */
+        const std::vector<Array3> _computationPoints;
+
+        /**
+         * The geometric sums of each face for each point at index point * faces + face
+         */
+        std::vector<GravityModelResult> _contributions;
+
+        /**
+         * The geometric sums over all faces for each point
+         */
+        std::vector<GravityModelResult> _sums;
+
+    public:
+
+        /**
+         * Creates a new IncrementalEvaluator and evaluates every face for every computation point once.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces (copied)
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoints - vector of computation points
+         */
+        IncrementalEvaluator(const Polyhedron &polyhedron, double density, std::vector<Array3> computationPoints);
+
+        /**
+         * Moves vertices of the polyhedron and updates the results by re-evaluating only the incident faces.
+         * @param indices - the indices of the moved vertices
+         * @param positions - the new positions of these vertices
+         * @return the number of re-evaluated faces (per computation point)
+         * @throws std::invalid_argument if the sizes differ or an index is out of range (then no vertex is moved)
+         */
+        size_t moveVertices(const std::vector<size_t> &indices, const std::vector<Array3> &positions);
+
+        /**
+         * Moves one vertex of the polyhedron and updates the results by re-evaluating only the incident faces.
+         * @param index - the index of the moved vertex
+         * @param position - the new position of the vertex
+         * @return the number of re-evaluated faces (per computation point)
+         * @throws std::invalid_argument if the index is out of range
+         */
+        size_t moveVertex(size_t index, const Array3 &position) {
+            return moveVertices({index}, {position});
+        }
+
+        /**
+         * Sums up the stored contributions again to eliminate the rounding errors accumulated by updates.
+         * This requires no evaluation of the model.
+         */
+        void resynchronize();
+
+        /**
+         * Returns the results of the polyhedral gravity model for the current vertices.
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * foreach computation Point P
+         */
+        [[nodiscard]] std::vector<GravityModelResult> getResults() const;
+
+        /**
+         * Returns the polyhedron with the current vertices.
+         * @return the Polyhedron
+         */
+        [[nodiscard]] Polyhedron getPolyhedron() const {
+            return {_vertices, _faces};
+        }
+
+        /**
+         * Returns the computation points.
+         * @return vector of computation points
+         */
+        [[nodiscard]] const std::vector<Array3> &getComputationPoints() const {
+            return _computationPoints;
+        }
+
+    private:
+
+        /**
+         * Evaluates the geometric sums of one face for one computation point.
+         * @param face - the index of the face
+         * @param computationPoint - the computation point P
+         * @return the contribution of the face
+         */
+        [[nodiscard]] GravityModelResult evaluateFace(size_t face, const Array3 &computationPoint) const;
+
+    };
+
+}
@@ -0,0 +1,148 @@
+#include "LevelOfDetailEvaluator.h"
+
+namespace polyhedralGravity {
+
+    LevelOfDetailEvaluator::LevelOfDetailEvaluator(const Polyhedron &polyhedron, double density, double tolerance,
+                                                   size_t maxLevels, double reductionFactor, size_t minFaces)
+            : _density{density},
+              _tolerance{tolerance},
+              _centroid{},
+              _boundingRadius{0.0},
+              _levels{polyhedron},
+              _predictedErrors{} {
+        using namespace util;
+        if (!(tolerance > 0.0)) {
+            throw std::invalid_argument("The tolerance must be positive!");
+        }
+        if (!(reductionFactor > 1.0) || maxLevels == 0 || minFaces < 4) {
+            throw std::invalid_argument("The pyramid requires at least one level, a reduction factor greater than "
+                                        "one and at least four faces per level!");
+        }
+        _centroid = MeshDecimation::computeVolumeAndCentroid(polyhedron).second;
+        for (const Array3 &vertex: polyhedron.getVertices()) {
+            _boundingRadius = std::max(_boundingRadius, euclideanNorm(vertex - _centroid));
+        }
+
+        //Every level is decimated from the previous one, until it becomes too coarse or can not be decimated
+        double targetFaces = static_cast<double>(polyhedron.countFaces());
+        while (_levels.size() < maxLevels) {
+            targetFaces /= reductionFactor;
+            if (targetFaces < static_cast<double>(minFaces)) {
+                break;
+            }
+            Polyhedron level = MeshDecimation::decimate(_levels.back(), static_cast<size_t>(targetFaces));
+            if (level.countFaces() >= _levels.back().countFaces()) {
+                break;
+            }
+            _levels.push_back(std::move(level));
+        }
+        calibrate();
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Level of detail pyramid with {} levels, the coarsest one with {} faces",
+                            _levels.size(), _levels.back().countFaces());
+    }
+
+    GravityModelResult LevelOfDetailEvaluator::evaluate(const Array3 &computationPoint) const {
+        return GravityModel::evaluate(_levels[selectLevel(computationPoint)], _density, computationPoint);
+    }
+
+    std::vector<GravityModelResult>
+    LevelOfDetailEvaluator::evaluate(const std::vector<Array3> &computationPoints) const {
+        //Group the points by their level
+        std::vector<std::vector<size_t>> groups(_levels.size());
+        for (size_t i = 0; i < computationPoints.size(); ++i) {
+            groups[selectLevel(computationPoints[i])].push_back(i);
+        }
+        std::vector<GravityModelResult> result{computationPoints.size()};
+        for (size_t level = 0; level < _levels.size(); ++level) {
+            if (groups[level].empty()) {
+                continue;
+            }
+            SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                                "Evaluating {} computation points with level {} ({} faces)", groups[level].size(),
+                                level, _levels[level].countFaces());
+            std::vector<Array3> points{};
+            points.reserve(groups[level].size());
+            for (const size_t index: groups[level]) {
+                points.push_back(computationPoints[index]);
+            }
+            const std::vector<GravityModelResult> groupResult =
+                    GravityModel::evaluate(_levels[level], _density, points);
+            for (size_t i = 0; i < groups[level].size(); ++i) {
+                result[groups[level][i]] = groupResult[i];
+            }
+        }
+        return result;
+    }
+
+    size_t LevelOfDetailEvaluator::selectLevel(const Array3 &computationPoint) const {
+        using util::operator-;
+        const double distance = util::euclideanNorm(computationPoint - _centroid);
+        for (size_t level = _levels.size() - 1; level > 0; --level) {
+            if (predictError(level, distance) <= _tolerance) {
+                return level;
+            }
+        }
+        return 0;
+    }
+
+    double LevelOfDetailEvaluator::predictError(size_t level, double distance) const {
+        const auto &errors = _predictedErrors.at(level);
+        const double radius = distance / _boundingRadius;
+        if (level == 0) {
+            return 0.0;
+        }
+        if (radius < CALIBRATION_RADII.front()) {
+            return std::numeric_limits<double>::infinity();
+        }
+        //The error at the next smaller calibration radius, beyond the last one decaying with 1/r^2
+        const auto next = std::upper_bound(CALIBRATION_RADII.begin(), CALIBRATION_RADII.end(), radius);
+        if (next == CALIBRATION_RADII.end()) {
+            const double ratio = CALIBRATION_RADII.back() / radius;
+            return errors.back() * ratio * ratio;
+        }
+        return errors[std::distance(CALIBRATION_RADII.begin(), next) - 1];
+    }
+
+    void LevelOfDetailEvaluator::calibrate() {
+        using namespace util;
+        //Points in the 26 directions of the corners, edges and faces of a cube on every calibration sphere
+        std::vector<Array3> samples{};
+        for (const double radius: CALIBRATION_RADII) {
+            for (int i = -1; i <= 1; ++i) {
+                for (int j = -1; j <= 1; ++j) {
+                    for (int k = -1; k <= 1; ++k) {
+                        if (i == 0 && j == 0 && k == 0) {
+                            continue;
+                        }
+                        const Array3 direction{static_cast<double>(i), static_cast<double>(j), static_cast<double>(k)};
+                        samples.push_back(
+                                _centroid + direction * (radius * _boundingRadius / euclideanNorm(direction)));
+                    }
+                }
+            }
+        }
+        const size_t samplesPerRadius = samples.size() / CALIBRATION_RADII.size();
+        const std::vector<GravityModelResult> exact = GravityModel::evaluate(_levels[0], _density, samples);
+
+        _predictedErrors.assign(_levels.size(), {});
+        for (size_t level = 1; level < _levels.size(); ++level) {
+            const std::vector<GravityModelResult> approximated =
+                    GravityModel::evaluate(_levels[level], _density, samples);
+            auto &errors = _predictedErrors[level];
+            for (size_t i = 0; i < samples.size(); ++i) {
+                const double error = euclideanNorm(approximated[i].acceleration - exact[i].acceleration) /
+                                     euclideanNorm(exact[i].acceleration);
+                errors[i / samplesPerRadius] = std::max(errors[i / samplesPerRadius], error);
+            }
+            //The envelope from the outside, so that the prediction does not increase with the distance
+            for (size_t radius = errors.size() - 1; radius > 0; --radius) {
+                errors[radius - 1] = std::max(errors[radius - 1], errors[radius]);
+            }
+            SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                                "Level {} ({} faces): relative acceleration error {} at {} bounding radii",
+                                level, _levels[level].countFaces(), errors.front(), CALIBRATION_RADII.front());
+        }
+    }
+
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/calculation/MeshDecimation.h"
+#include "polyhedralGravity/util/UtilityContainer.h"
+#include "polyhedralGravity/output/Logging.h"
+
+namespace polyhedralGravity {
+
+    /**
+     * Evaluates the polyhedral gravity model with a pyramid of simplified versions of a polyhedron and chooses
+     * per computation point the coarsest level whose predicted error is within a tolerance.
+     * Every level is decimated from the previous one (see MeshDecimation) and has the volume and the centroid of
+     * the original polyhedron, so the error of a level decays at least with the squared distance.
+     *
+     * The error of each level is calibrated once against the original polyhedron at sample points on spheres
+     * around the centroid with radii between 1.5 and 16 bounding radii. The predicted error at a distance is the
+     * largest relative acceleration error sampled at this or any larger radius, beyond the outermost sphere it
+     * decays with the squared distance. Points closer than 1.5 bounding radii are always evaluated with the
+     * original polyhedron.
+     *
+     * @note The prediction is based on samples, the tolerance is not a strict bound for every point
+     * @example A shape model with hundreds of thousands of faces evaluated along orbits at altitude
+     */
+    class LevelOfDetailEvaluator {
+
+        /**
+         * The radii of the calibration spheres in units of the bounding radius
+         */
+        static constexpr std::array<double, 6> CALIBRATION_RADII{1.5, 2.0, 3.0, 5.0, 8.0, 16.0};
+
+        /**
+         * The constant density in [kg/m^3]
+         */
+        double _density;
+
+        /**
+         * The tolerated relative error of the acceleration
+         */
+        double _tolerance;
+
+        /**
+         * The centroid of the polyhedron
+         */
+        Array3 _centroid;
+
+        /**
+         * The largest distance between the centroid and a vertex
+         */
+        double _boundingRadius;
+
+        /**
+         * The polyhedra from the original (level zero) to the coarsest one
+         */
+        std::vector<Polyhedron> _levels;
+
+        /**
+         * The predicted relative acceleration error foreach level at the calibration radii
+         */
+        std::vector<std::array<double, CALIBRATION_RADII.size()>> _predictedErrors;
+
+    public:
+
+        /**
+         * Creates the pyramid of simplified polyhedra and calibrates their errors.
+         * Levels are added while they have at least minFaces faces.
+         * @param polyhedron - the closed polyhedron consisting of vertices and triangular faces
+         * @param density - the constant density in [kg/m^3]
+         * @param tolerance - the tolerated relative error of the acceleration
+         * @param maxLevels - the maximal number of levels including the original polyhedron
+         * @param reductionFactor - the ratio between the face counts of two consecutive levels
+         * @param minFaces - the minimal number of faces of a level
+         * @throws std::invalid_argument if the tolerance is not positive, the reduction factor not greater than one,
+         * maxLevels is zero or minFaces less than four
+         */
+        LevelOfDetailEvaluator(const Polyhedron &polyhedron, double density, double tolerance,
+                               size_t maxLevels = 4, double reductionFactor = 4.0, size_t minFaces = 256);
+
+        /**
+         * Evaluates the polyhedral gravity model at computation point P with the coarsest adequate level.
+         * @param computationPoint - the computation Point P
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * at computation Point P
+         */
+        [[nodiscard]] GravityModelResult evaluate(const Array3 &computationPoint) const;
+
+        /**
+         * Evaluates the polyhedral gravity model at multiple computation points. The points are grouped by their
+         * level and every group is evaluated at once.
+         * @param computationPoints - vector of computation points
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * foreach computation Point P
+         */
+        [[nodiscard]] std::vector<GravityModelResult> evaluate(const std::vector<Array3> &computationPoints) const;
+
+        /**
+         * Returns the coarsest level whose predicted error at the computation point is within the tolerance.
+         * @param computationPoint - the computation Point P
+         * @return the index of the level, zero denotes the original polyhedron
+         */
+        [[nodiscard]] size_t selectLevel(const Array3 &computationPoint) const;
+
+        /**
+         * Predicts the relative error of the acceleration of one level at a distance from the centroid.
+         * @param level - the index of the level
+         * @param distance - the distance from the centroid in [m]
+         * @return the predicted error, infinity for the simplified levels closer than the innermost sphere
+         */
+        [[nodiscard]] double predictError(size_t level, double distance) const;
+
+        /**
+         * Returns the number of levels including the original polyhedron.
+         * @return number of levels
+         */
+        [[nodiscard]] size_t countLevels() const {
+            return _levels.size();
+        }
+
+        /**
+         * Returns one level of the pyramid.
+         * @param level - the index of the level, zero denotes the original polyhedron
+         * @return the polyhedron
+         */
+        [[nodiscard]] const Polyhedron &getLevel(size_t level) const {
+            return _levels.at(level);
+        }
+
+        /**
+         * Returns the largest distance between the centroid and a vertex of the original polyhedron.
+         * @return the bounding radius in [m]
+         */
+        [[nodiscard]] double getBoundingRadius() const {
+            return _boundingRadius;
+        }
+
+        /**
+         * Returns the tolerated relative error of the acceleration.
+         * @return tolerance
+         */
+        [[nodiscard]] double getTolerance() const {
+            return _tolerance;
+        }
+
+    private:
+
+        /**
+         * Calibrates the predicted errors of all levels against the original polyhedron.
+         */
+        void calibrate();
+
+    };
+
+}
@@ -0,0 +1,172 @@
+#include "MasconModel.h"
+
+namespace polyhedralGravity {
+
+    MasconModel::MasconModel(const Polyhedron &polyhedron, double density, double maxVolume)
+            : _positions{}, _masses{}, _count{0} {
+        if (!std::isfinite(maxVolume) || maxVolume < 0.0) {
+            throw std::invalid_argument("The maximal volume of the tetrahedra must be a non-negative number!");
+        }
+        //1. Step: Hand over the vertices and faces to tetgen (which frees the arrays in its destructor)
+        tetgenio in{};
+        tetgenio out{};
+        in.firstnumber = 0;
+        in.numberofpoints = static_cast<int>(polyhedron.countVertices());
+        in.pointlist = new REAL[3 * polyhedron.countVertices()];
+        for (size_t i = 0; i < polyhedron.countVertices(); ++i) {
+            const Array3 &vertex = polyhedron.getVertex(i);
+            std::copy(vertex.begin(), vertex.end(), in.pointlist + 3 * i);
+        }
+        in.numberoffacets = static_cast<int>(polyhedron.countFaces());
+        in.facetlist = new tetgenio::facet[polyhedron.countFaces()];
+        for (size_t i = 0; i < polyhedron.countFaces(); ++i) {
+            tetgenio::facet &facet = in.facetlist[i];
+            facet.numberofpolygons = 1;
+            facet.polygonlist = new tetgenio::polygon[1];
+            facet.holelist = nullptr;
+            facet.numberofholes = 0;
+            facet.polygonlist[0].numberofvertices = 3;
+            facet.polygonlist[0].vertexlist = new int[3];
+            for (size_t j = 0; j < 3; ++j) {
+                facet.polygonlist[0].vertexlist[j] = static_cast<int>(polyhedron.getFaces()[i][j]);
+            }
+        }
+
+        //2. Step: Tetrahedralize the piecewise linear complex (p) quietly (Q) with zero-based indices (z),
+        //optionally with a quality (q) and maximal volume constraint (a)
+        std::string switches{"pzQ"};
+        if (maxVolume > 0.0) {
+            std::ostringstream volumeConstraint{};
+            volumeConstraint << "qa" << std::setprecision(17) << maxVolume;
+            switches.append(volumeConstraint.str());
+        }
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Tetrahedralizing {} faces for the mascon model with the switches {}",
+                            polyhedron.countFaces(), switches);
+        try {
+            tetrahedralize(switches.data(), &in, &out);
+        } catch (...) {
+            throw std::runtime_error("Tetgen failed to tetrahedralize the polyhedron for the mascon model! "
+                                     "The polyhedron needs to be closed and free of self-intersections.");
+        }
+        if (out.numberoftetrahedra <= 0) {
+            throw std::runtime_error("Tetgen produced no tetrahedra for the mascon model!");
+        }
+
+        //3. Step: One mascon per tetrahedron at its centroid with the mass density * volume
+        _masses.reserve(out.numberoftetrahedra + PADDING);
+        for (auto &coordinates: _positions) {
+            coordinates.reserve(out.numberoftetrahedra + PADDING);
+        }
+        for (int tetrahedron = 0; tetrahedron < out.numberoftetrahedra; ++tetrahedron) {
+            std::array<Array3, 4> corners{};
+            for (size_t j = 0; j < 4; ++j) {
+                const int index =
+                        out.tetrahedronlist[tetrahedron * out.numberofcorners + static_cast<int>(j)] - out.firstnumber;
+                std::copy(out.pointlist + 3 * index, out.pointlist + 3 * index + 3, corners[j].begin());
+            }
+            using util::operator-;
+            using util::operator+;
+            using util::operator/;
+            const Array3 a = corners[1] - corners[0];
+            const Array3 b = corners[2] - corners[0];
+            const Array3 c = corners[3] - corners[0];
+            const double volume = std::abs(util::dot(a, util::cross(b, c))) / 6.0;
+            addMascon((corners[0] + corners[1] + corners[2] + corners[3]) / 4.0, density * volume);
+        }
+        pad();
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Generated {} mascons with a total mass of {} kg", _count, getTotalMass());
+    }
+
+    MasconModel::MasconModel(const std::vector<Array3> &positions, const std::vector<double> &masses)
+            : _positions{}, _masses{}, _count{0} {
+        if (positions.size() != masses.size()) {
+            throw std::invalid_argument("The number of mascon positions and masses must be equal!");
+        }
+        for (size_t i = 0; i < positions.size(); ++i) {
+            addMascon(positions[i], masses[i]);
+        }
+        pad();
+    }
+
+    GravityModelResult MasconModel::evaluate(const Array3 &computationPoint) const {
+        const std::array<double, 10> sums = EvaluationSettings::dispatchSimdArchitecture([&](auto arch) {
+            return this->sumLanes<decltype(arch)>(computationPoint);
+        });
+        //Apply the gravitational constant
+        GravityModelResult result{};
+        result.gravitationalPotential = sums[0] * util::GRAVITATIONAL_CONSTANT;
+        for (size_t i = 0; i < 3; ++i) {
+            result.acceleration[i] = sums[1 + i] * util::GRAVITATIONAL_CONSTANT;
+        }
+        for (size_t i = 0; i < 6; ++i) {
+            result.gradiometricTensor[i] = sums[4 + i] * util::GRAVITATIONAL_CONSTANT;
+        }
+        return result;
+    }
+
+    std::vector<GravityModelResult> MasconModel::evaluate(const std::vector<Array3> &computationPoints) const {
+        std::vector<GravityModelResult> result{computationPoints.size()};
+        thrust::transform(thrust::device, computationPoints.begin(), computationPoints.end(), result.begin(),
+                          [this](const Array3 &computationPoint) {
+                              return this->evaluate(computationPoint);
+                          });
+        return result;
+    }
+
+    MasconErrorReport MasconModel::compareWithExact(const Polyhedron &polyhedron, double density,
+                                                    const std::vector<Array3> &computationPoints) const {
+        using namespace util;
+        const std::vector<GravityModelResult> exact = GravityModel::evaluate(polyhedron, density, computationPoints);
+        const std::vector<GravityModelResult> approximated = this->evaluate(computationPoints);
+        const auto maximumNorm = [](const std::array<double, 6> &tensor) {
+            return std::abs(*std::max_element(tensor.begin(), tensor.end(), [](double lhs, double rhs) {
+                return std::abs(lhs) < std::abs(rhs);
+            }));
+        };
+        MasconErrorReport report{};
+        double squaredSum = 0.0;
+        for (size_t i = 0; i < computationPoints.size(); ++i) {
+            const GravityModelResult &expected = exact[i];
+            const GravityModelResult &actual = approximated[i];
+            report.maxRelativePotentialError = std::max(
+                    report.maxRelativePotentialError,
+                    std::abs(actual.gravitationalPotential - expected.gravitationalPotential) /
+                    std::abs(expected.gravitationalPotential));
+            const double accelerationError = euclideanNorm(actual.acceleration - expected.acceleration) /
+                                             euclideanNorm(expected.acceleration);
+            report.maxRelativeAccelerationError = std::max(report.maxRelativeAccelerationError, accelerationError);
+            squaredSum += accelerationError * accelerationError;
+            report.maxRelativeTensorError = std::max(
+                    report.maxRelativeTensorError,
+                    maximumNorm(actual.gradiometricTensor - expected.gradiometricTensor) /
+                    maximumNorm(expected.gradiometricTensor));
+        }
+        if (!computationPoints.empty()) {
+            report.rmsRelativeAccelerationError = std::sqrt(squaredSum / static_cast<double>(computationPoints.size()));
+        }
+        return report;
+    }
+
+    double MasconModel::getTotalMass() const {
+        return std::accumulate(_masses.begin(), _masses.end(), 0.0);
+    }
+
+    void MasconModel::addMascon(const Array3 &position, double mass) {
+        for (size_t i = 0; i < 3; ++i) {
+            _positions[i].push_back(position[i]);
+        }
+        _masses.push_back(mass);
+        ++_count;
+    }
+
+    void MasconModel::pad() {
+        const size_t paddedSize = (_count + PADDING - 1) / PADDING * PADDING;
+        for (auto &coordinates: _positions) {
+            coordinates.resize(paddedSize, 0.0);
+        }
+        _masses.resize(paddedSize, 0.0);
+    }
+
+}
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <stdexcept>
+#include <numeric>
+#include <algorithm>
+#include "tetgen.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/util/UtilityConstants.h"
+#include "polyhedralGravity/util/UtilityContainer.h"
+#include "polyhedralGravity/output/Logging.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "thrust/transform.h"
+#include "thrust/execution_policy.h"
+#include "xsimd/xsimd.hpp"
+
+namespace polyhedralGravity {
+
+    /**
+     * The deviation of a MasconModel from the exact polyhedral gravity model at a set of computation points.
+     */
+    struct MasconErrorReport {
+
+        /**
+         * The largest relative error of the potential
+         */
+        double maxRelativePotentialError = 0.0;
+
+        /**
+         * The largest error of the acceleration's norm relative to the norm of the exact acceleration
+         */
+        double maxRelativeAccelerationError = 0.0;
+
+        /**
+         * The root mean square of the relative acceleration errors
+         */
+        double rmsRelativeAccelerationError = 0.0;
+
+        /**
+         * The largest error of the gradiometric tensor (maximum norm) relative to the maximum norm of the
+         * exact tensor
+         */
+        double maxRelativeTensorError = 0.0;
+
+    };
+
+    /**
+     * An approximation of a constant density polyhedron by point masses (mascons).
+     * The interior of the polyhedron is tetrahedralized with tetgen and every tetrahedron is replaced by a point
+     * mass density * volume at its centroid. Thus, the total mass and the center of mass are exact, the error
+     * decreases with the size of the tetrahedra compared to the distance to the computation point.
+     * The maximal volume of the tetrahedra is the knob between speed and accuracy.
+     *
+     * The evaluation of one point sums over the mascons with xsimd, one mascon per SIMD lane, with the instruction
+     * set of the SimdArchitecture of the EvaluationSettings. Multiple points are evaluated in parallel.
+     * The results use the sign conventions of GravityModel, i.e. the potential G * m / r, the acceleration
+     * G * m * (P - q) / r^3 and the gradiometric tensor G * m * (3 * (P - q)(P - q)^T - r^2 * I) / r^5 for a point
+     * mass m at q.
+     * A mascon coinciding with P does not contribute.
+     *
+     * @note Inside the body and close to its surface the single mascons dominate the field,
+     * there the exact GravityModel should be used
+     * @example Long-duration propagations at altitudes of a few body radii
+     */
+    class MasconModel {
+
+        /**
+         * The mascons are padded to a multiple of the widest SIMD register, i.e. eight doubles with AVX-512
+         */
+        static constexpr size_t PADDING = 8;
+
+        /**
+         * The x, y and z coordinates of the mascons (structure of arrays), padded to a multiple of PADDING
+         */
+        std::array<std::vector<double>, 3> _positions;
+
+        /**
+         * The masses of the mascons in [kg], padded with zeros to a multiple of PADDING
+         */
+        std::vector<double> _masses;
+
+        /**
+         * The number of mascons without the padding
+         */
+        size_t _count;
+
+    public:
+
+        /**
+         * Creates a MasconModel by tetrahedralizing the interior of the polyhedron.
+         * @param polyhedron - the closed polyhedron consisting of vertices and triangular faces
+         * @param density - the constant density in [kg/m^3]
+         * @param maxVolume - the maximal volume of one tetrahedron in [m^3], zero leaves the resolution to tetgen
+         * @throws std::invalid_argument if the maximal volume is negative or not finite
+         * @throws std::runtime_error if tetgen fails to tetrahedralize the polyhedron
+         */
+        MasconModel(const Polyhedron &polyhedron, double density, double maxVolume = 0.0);
+
+        /**
+         * Creates a MasconModel of the given point masses.
+         * @param positions - the positions of the mascons
+         * @param masses - the masses of the mascons in [kg]
+         * @throws std::invalid_argument if the number of positions and masses differ
+         */
+        MasconModel(const std::vector<Array3> &positions, const std::vector<double> &masses);
+
+        /**
+         * Evaluates the mascon model at computation point P.
+         * @param computationPoint - the computation Point P
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * at computation Point P
+         */
+        [[nodiscard]] GravityModelResult evaluate(const Array3 &computationPoint) const;
+
+        /**
+         * Evaluates the mascon model at multiple computation points in parallel.
+         * @param computationPoints - vector of computation points
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * foreach computation Point P
+         */
+        [[nodiscard]] std::vector<GravityModelResult> evaluate(const std::vector<Array3> &computationPoints) const;
+
+        /**
+         * Quantifies the error of the mascon model by comparing it with the exact polyhedral gravity model.
+         * @param polyhedron - the polyhedron from which the mascons have been generated
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoints - the points at which both models are compared
+         * @return the MasconErrorReport
+         */
+        [[nodiscard]] MasconErrorReport compareWithExact(const Polyhedron &polyhedron, double density,
+                                                         const std::vector<Array3> &computationPoints) const;
+
+        /**
+         * Returns the number of mascons.
+         * @return number of mascons
+         */
+        [[nodiscard]] size_t countMascons() const {
+            return _count;
+        }
+
+        /**
+         * Returns the position of one mascon.
+         * @param index - the index of the mascon
+         * @return the position
+         */
+        [[nodiscard]] Array3 getPosition(size_t index) const {
+            return {_positions[0][index], _positions[1][index], _positions[2][index]};
+        }
+
+        /**
+         * Returns the mass of one mascon.
+         * @param index - the index of the mascon
+         * @return the mass in [kg]
+         */
+        [[nodiscard]] double getMass(size_t index) const {
+            return _masses[index];
+        }
+
+        /**
+         * Returns the sum of the masses.
+         * @return the total mass in [kg]
+         */
+        [[nodiscard]] double getTotalMass() const;
+
+    private:
+
+        /**
+         * Appends one mascon.
+         * @param position - the position
+         * @param mass - the mass in [kg]
+         */
+        void addMascon(const Array3 &position, double mass);
+
+        /**
+         * Pads the mascons to a multiple of PADDING with zero masses at the origin.
+         */
+        void pad();
+
+        /**
+         * Sums up the contributions of all mascons at computation point P with one mascon per SIMD lane.
+         * @tparam Arch - the xsimd architecture
+         * @param computationPoint - the computation Point P
+         * @return the sums without the gravitational constant in the order potential, acceleration, gradiometric
+         * tensor
+         */
+        template<class Arch>
+        [[nodiscard]] std::array<double, 10> sumLanes(const Array3 &computationPoint) const;
+
+    };
+
+    template<class Arch>
+    std::array<double, 10> MasconModel::sumLanes(const Array3 &computationPoint) const {
+        using Batch = xsimd::batch<double, Arch>;
+        const Batch zero(0.0);
+        const Batch px(computationPoint[0]);
+        const Batch py(computationPoint[1]);
+        const Batch pz(computationPoint[2]);
+        Batch potential(0.0);
+        std::array<Batch, 3> acceleration{zero, zero, zero};
+        std::array<Batch, 6> tensor{zero, zero, zero, zero, zero, zero};
+        for (size_t i = 0; i < _masses.size(); i += Batch::size) {
+            //The vector from the mascon q to P, a mascon at P is excluded by a zero inverse distance
+            const Batch dx = px - Batch::load_unaligned(&_positions[0][i]);
+            const Batch dy = py - Batch::load_unaligned(&_positions[1][i]);
+            const Batch dz = pz - Batch::load_unaligned(&_positions[2][i]);
+            const Batch mass = Batch::load_unaligned(&_masses[i]);
+            const Batch squaredDistance = dx * dx + dy * dy + dz * dz;
+            const Batch inverseDistance =
+                    xsimd::select(squaredDistance > zero, Batch(1.0) / xsimd::sqrt(squaredDistance), zero);
+            const Batch inverseSquared = inverseDistance * inverseDistance;
+            //m / r, m / r^3 and 3 * m / r^5
+            const Batch m1 = mass * inverseDistance;
+            const Batch m3 = m1 * inverseSquared;
+            const Batch m5 = Batch(3.0) * m3 * inverseSquared;
+            potential += m1;
+            acceleration[0] += m3 * dx;
+            acceleration[1] += m3 * dy;
+            acceleration[2] += m3 * dz;
+            tensor[0] += m5 * dx * dx - m3;
+            tensor[1] += m5 * dy * dy - m3;
+            tensor[2] += m5 * dz * dz - m3;
+            tensor[3] += m5 * dx * dy;
+            tensor[4] += m5 * dx * dz;
+            tensor[5] += m5 * dy * dz;
+        }
+        //Reduce the lanes
+        std::array<double, 10> sums{};
+        sums[0] = xsimd::hadd(potential);
+        for (size_t i = 0; i < 3; ++i) {
+            sums[1 + i] = xsimd::hadd(acceleration[i]);
+        }
+        for (size_t i = 0; i < 6; ++i) {
+            sums[4 + i] = xsimd::hadd(tensor[i]);
+        }
+        return sums;
+    }
+
+#ifdef POLYHEDRAL_GRAVITY_SIMD_DISPATCH
+    //Instantiated in the translation units of simd/ which are compiled with the instruction set
+    extern template std::array<double, 10> MasconModel::sumLanes<xsimd::sse4_2>(const Array3 &) const;
+    extern template std::array<double, 10> MasconModel::sumLanes<xsimd::fma3<xsimd::avx2>>(const Array3 &) const;
+    extern template std::array<double, 10> MasconModel::sumLanes<xsimd::avx512f>(const Array3 &) const;
+#endif
+
+}
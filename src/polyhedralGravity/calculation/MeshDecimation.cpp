@@ -0,0 +1,283 @@
+#include "MeshDecimation.h"
+
+namespace polyhedralGravity::MeshDecimation {
+
+    Polyhedron decimate(const Polyhedron &polyhedron, size_t targetFaces) {
+        using namespace util;
+        using detail::Quadric;
+        if (targetFaces < 4) {
+            throw std::invalid_argument("A closed polyhedron consists of at least four faces!");
+        }
+
+        /**
+         * A possible collapse of the edge (first, second) into the position with the given cost.
+         * The versions of the vertices identify outdated candidates.
+         */
+        struct Candidate {
+            double cost;
+            size_t first;
+            size_t second;
+            size_t firstVersion;
+            size_t secondVersion;
+            Array3 position;
+
+            bool operator>(const Candidate &other) const {
+                return cost > other.cost;
+            }
+        };
+
+        std::vector<Array3> vertices = polyhedron.getVertices();
+        std::vector<std::array<size_t, 3>> faces = polyhedron.getFaces();
+        std::vector<bool> vertexAlive(vertices.size(), true);
+        std::vector<bool> faceAlive(faces.size(), true);
+        std::vector<size_t> versions(vertices.size(), 0);
+        std::vector<std::vector<size_t>> incidentFaces(vertices.size());
+        std::vector<Quadric> quadrics(vertices.size(), Quadric{});
+
+        //1. Step: The incident faces and the quadric of every vertex
+        for (size_t face = 0; face < faces.size(); ++face) {
+            const Quadric quadric = detail::faceQuadric(
+                    {vertices[faces[face][0]], vertices[faces[face][1]], vertices[faces[face][2]]});
+            for (const size_t vertex: faces[face]) {
+                incidentFaces[vertex].push_back(face);
+                quadrics[vertex] = quadrics[vertex] + quadric;
+            }
+        }
+
+        const auto neighbors = [&](size_t vertex) {
+            std::vector<size_t> result{};
+            for (const size_t face: incidentFaces[vertex]) {
+                if (!faceAlive[face]) {
+                    continue;
+                }
+                for (const size_t other: faces[face]) {
+                    if (other != vertex) {
+                        result.push_back(other);
+                    }
+                }
+            }
+            std::sort(result.begin(), result.end());
+            result.erase(std::unique(result.begin(), result.end()), result.end());
+            return result;
+        };
+
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> candidates{};
+        const auto pushCandidate = [&](size_t first, size_t second) {
+            const auto [position, cost] =
+                    detail::optimalPosition(quadrics[first] + quadrics[second], vertices[first], vertices[second]);
+            candidates.push({cost, first, second, versions[first], versions[second], position});
+        };
+
+        //A collapse must keep the mesh a closed manifold (the link condition) and must not flip any face
+        const auto isValidCollapse = [&](const Candidate &candidate) {
+            const std::vector<size_t> firstNeighbors = neighbors(candidate.first);
+            const std::vector<size_t> secondNeighbors = neighbors(candidate.second);
+            std::vector<size_t> common{};
+            std::set_intersection(firstNeighbors.begin(), firstNeighbors.end(), secondNeighbors.begin(),
+                                  secondNeighbors.end(), std::back_inserter(common));
+            if (common.size() != 2) {
+                return false;
+            }
+            for (const size_t vertex: {candidate.first, candidate.second}) {
+                for (const size_t face: incidentFaces[vertex]) {
+                    const auto &indices = faces[face];
+                    if (!faceAlive[face]) {
+                        continue;
+                    }
+                    const bool shared = std::count(indices.begin(), indices.end(), candidate.first) +
+                                        std::count(indices.begin(), indices.end(), candidate.second) == 2;
+                    if (shared) {
+                        continue;
+                    }
+                    Array3Triplet before{vertices[indices[0]], vertices[indices[1]], vertices[indices[2]]};
+                    Array3Triplet after = before;
+                    for (size_t j = 0; j < 3; ++j) {
+                        if (indices[j] == vertex) {
+                            after[j] = candidate.position;
+                        }
+                    }
+                    const Array3 normalBefore = cross(before[1] - before[0], before[2] - before[0]);
+                    const Array3 normalAfter = cross(after[1] - after[0], after[2] - after[0]);
+                    const double normProduct = euclideanNorm(normalBefore) * euclideanNorm(normalAfter);
+                    if (dot(normalBefore, normalAfter) <= 0.1 * normProduct) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        };
+
+        //2. Step: Collapse the edges in the order of increasing quadric error
+        for (size_t face = 0; face < faces.size(); ++face) {
+            for (size_t j = 0; j < 3; ++j) {
+                const size_t first = faces[face][j];
+                const size_t second = faces[face][(j + 1) % 3];
+                //Every edge of a closed mesh belongs to two faces, one of which contains it in ascending order
+                if (first < second) {
+                    pushCandidate(first, second);
+                }
+            }
+        }
+        size_t faceCount = faces.size();
+        while (faceCount > targetFaces && !candidates.empty()) {
+            const Candidate candidate = candidates.top();
+            candidates.pop();
+            if (!vertexAlive[candidate.first] || !vertexAlive[candidate.second] ||
+                versions[candidate.first] != candidate.firstVersion ||
+                versions[candidate.second] != candidate.secondVersion || !isValidCollapse(candidate)) {
+                continue;
+            }
+            //The two faces of the edge vanish, the other faces of the second vertex now reference the first one
+            for (const size_t face: incidentFaces[candidate.second]) {
+                auto &indices = faces[face];
+                if (!faceAlive[face]) {
+                    continue;
+                }
+                if (std::find(indices.begin(), indices.end(), candidate.first) != indices.end()) {
+                    faceAlive[face] = false;
+                    --faceCount;
+                } else {
+                    std::replace(indices.begin(), indices.end(), candidate.second, candidate.first);
+                    incidentFaces[candidate.first].push_back(face);
+                }
+            }
+            auto &firstFaces = incidentFaces[candidate.first];
+            firstFaces.erase(std::remove_if(firstFaces.begin(), firstFaces.end(),
+                                            [&faceAlive](size_t face) { return !faceAlive[face]; }),
+                             firstFaces.end());
+            incidentFaces[candidate.second].clear();
+            vertexAlive[candidate.second] = false;
+            vertices[candidate.first] = candidate.position;
+            quadrics[candidate.first] = quadrics[candidate.first] + quadrics[candidate.second];
+            ++versions[candidate.first];
+            for (const size_t neighbor: neighbors(candidate.first)) {
+                pushCandidate(candidate.first, neighbor);
+            }
+        }
+
+        //3. Step: Remove the collapsed vertices (and the ones not referenced by any face) and faces
+        std::vector<bool> referenced(vertices.size(), false);
+        for (size_t face = 0; face < faces.size(); ++face) {
+            if (faceAlive[face]) {
+                for (const size_t vertex: faces[face]) {
+                    referenced[vertex] = true;
+                }
+            }
+        }
+        std::vector<size_t> newIndices(vertices.size(), 0);
+        std::vector<Array3> remainingVertices{};
+        for (size_t vertex = 0; vertex < vertices.size(); ++vertex) {
+            if (referenced[vertex]) {
+                newIndices[vertex] = remainingVertices.size();
+                remainingVertices.push_back(vertices[vertex]);
+            }
+        }
+        std::vector<std::array<size_t, 3>> remainingFaces{};
+        remainingFaces.reserve(faceCount);
+        for (size_t face = 0; face < faces.size(); ++face) {
+            if (faceAlive[face]) {
+                remainingFaces.push_back(
+                        {newIndices[faces[face][0]], newIndices[faces[face][1]], newIndices[faces[face][2]]});
+            }
+        }
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Decimated the polyhedron from {} to {} faces", polyhedron.countFaces(),
+                            remainingFaces.size());
+
+        //4. Step: Restore the volume and the centroid of the original polyhedron
+        const auto [volume, centroid] = computeVolumeAndCentroid(polyhedron);
+        return matchVolumeAndCentroid({remainingVertices, remainingFaces}, volume, centroid);
+    }
+
+    std::pair<double, Array3> computeVolumeAndCentroid(const Polyhedron &polyhedron) {
+        using namespace util;
+        //Sum of the signed tetrahedra spanned by the origin and the faces
+        double volume = 0.0;
+        Array3 firstMoment{0.0, 0.0, 0.0};
+        for (const auto &face: polyhedron.getFaces()) {
+            const Array3 &a = polyhedron.getVertex(face[0]);
+            const Array3 &b = polyhedron.getVertex(face[1]);
+            const Array3 &c = polyhedron.getVertex(face[2]);
+            const double determinant = dot(a, cross(b, c));
+            volume += determinant / 6.0;
+            firstMoment = firstMoment + (a + b + c) * (determinant / 24.0);
+        }
+        return {volume, firstMoment / volume};
+    }
+
+    Polyhedron matchVolumeAndCentroid(const Polyhedron &polyhedron, double volume, const Array3 &centroid) {
+        using namespace util;
+        const auto [currentVolume, currentCentroid] = computeVolumeAndCentroid(polyhedron);
+        const double scale = std::cbrt(volume / currentVolume);
+        std::vector<Array3> vertices{};
+        vertices.reserve(polyhedron.countVertices());
+        for (const Array3 &vertex: polyhedron.getVertices()) {
+            vertices.push_back(centroid + (vertex - currentCentroid) * scale);
+        }
+        return {vertices, polyhedron.getFaces()};
+    }
+
+    detail::Quadric detail::faceQuadric(const Array3Triplet &face) {
+        using namespace util;
+        const Array3 normal = cross(face[1] - face[0], face[2] - face[0]);
+        const double norm = euclideanNorm(normal);
+        if (norm == 0.0) {
+            return Quadric{};
+        }
+        //The unit normal (a, b, c), the offset d and the area as weight
+        const Array3 unitNormal = normal / norm;
+        const double a = unitNormal[0];
+        const double b = unitNormal[1];
+        const double c = unitNormal[2];
+        const double d = -dot(unitNormal, face[0]);
+        const double area = norm / 2.0;
+        return Quadric{a * a, a * b, a * c, a * d, b * b, b * c, b * d, c * c, c * d, d * d} * area;
+    }
+
+    double detail::evaluateQuadric(const Quadric &quadric, const Array3 &point) {
+        const double x = point[0];
+        const double y = point[1];
+        const double z = point[2];
+        const double error = quadric[0] * x * x + 2.0 * quadric[1] * x * y + 2.0 * quadric[2] * x * z +
+                             2.0 * quadric[3] * x + quadric[4] * y * y + 2.0 * quadric[5] * y * z +
+                             2.0 * quadric[6] * y + quadric[7] * z * z + 2.0 * quadric[8] * z + quadric[9];
+        //The quadric is positive semi-definite, negative values are rounding errors
+        return std::max(error, 0.0);
+    }
+
+    std::pair<Array3, double> detail::optimalPosition(const Quadric &quadric, const Array3 &first,
+                                                      const Array3 &second) {
+        using namespace util;
+        //Minimize by solving A * x = -b with the upper left 3x3 block A and the last column b (Cramer's rule)
+        const double a00 = quadric[0], a01 = quadric[1], a02 = quadric[2];
+        const double a11 = quadric[4], a12 = quadric[5], a22 = quadric[7];
+        const double b0 = -quadric[3], b1 = -quadric[6], b2 = -quadric[8];
+        const double c00 = a11 * a22 - a12 * a12;
+        const double c01 = a02 * a12 - a01 * a22;
+        const double c02 = a01 * a12 - a02 * a11;
+        const double determinant = a00 * c00 + a01 * c01 + a02 * c02;
+        const double scale = std::max({std::abs(a00), std::abs(a11), std::abs(a22)});
+        const Array3 midpoint = (first + second) / 2.0;
+        if (std::abs(determinant) > 1e-9 * scale * scale * scale) {
+            const double c11 = a00 * a22 - a02 * a02;
+            const double c12 = a01 * a02 - a00 * a12;
+            const double c22 = a00 * a11 - a01 * a01;
+            const Array3 optimum = Array3{c00 * b0 + c01 * b1 + c02 * b2,
+                                          c01 * b0 + c11 * b1 + c12 * b2,
+                                          c02 * b0 + c12 * b1 + c22 * b2} / determinant;
+            //An optimum far away from the edge indicates an ill-conditioned quadric
+            if (euclideanNorm(optimum - midpoint) <= euclideanNorm(second - first)) {
+                return {optimum, evaluateQuadric(quadric, optimum)};
+            }
+        }
+        std::pair<Array3, double> best{first, evaluateQuadric(quadric, first)};
+        for (const Array3 &position: {second, midpoint}) {
+            const double error = evaluateQuadric(quadric, position);
+            if (error < best.second) {
+                best = {position, error};
+            }
+        }
+        return best;
+    }
+
+}
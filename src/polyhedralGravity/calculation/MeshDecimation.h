@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <queue>
+#include <cmath>
+#include <utility>
+#include <iterator>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/util/UtilityContainer.h"
+#include "polyhedralGravity/output/Logging.h"
+
+/**
+ * Simplification of closed triangle meshes by edge collapses ordered by the quadric error metric
+ * (Garland and Heckbert, Surface Simplification Using Quadric Error Metrics, 1997).
+ * The simplified polyhedron is scaled and shifted afterwards to have the volume and the centroid of the original one.
+ * Hence, a simplified polyhedron of the same constant density has the same mass and center of mass and its
+ * gravitational field differs from the original one only in the second and higher degree terms.
+ */
+namespace polyhedralGravity::MeshDecimation {
+
+    /**
+     * Simplifies a closed polyhedron to (about) the given number of faces and matches its volume and centroid
+     * with the original polyhedron afterwards.
+     * Collapses which would flip a face or make the mesh non-manifold are rejected, so the result may
+     * contain more faces than requested if no valid collapse remains.
+     * @param polyhedron - the closed polyhedron consisting of vertices and triangular faces
+     * @param targetFaces - the number of faces to reach
+     * @return the simplified polyhedron
+     * @throws std::invalid_argument if the target is less than four faces (a tetrahedron)
+     */
+    Polyhedron decimate(const Polyhedron &polyhedron, size_t targetFaces);
+
+    /**
+     * Computes the volume and the centroid of a closed polyhedron with outward pointing normals.
+     * @param polyhedron - the closed polyhedron consisting of vertices and triangular faces
+     * @return the volume and the centroid
+     */
+    std::pair<double, Array3> computeVolumeAndCentroid(const Polyhedron &polyhedron);
+
+    /**
+     * Scales a polyhedron about its centroid and shifts it, so that it has the given volume and centroid.
+     * @param polyhedron - the closed polyhedron consisting of vertices and triangular faces
+     * @param volume - the volume to match
+     * @param centroid - the centroid to match
+     * @return the transformed polyhedron
+     */
+    Polyhedron matchVolumeAndCentroid(const Polyhedron &polyhedron, double volume, const Array3 &centroid);
+
+    namespace detail {
+
+        /**
+         * A symmetric 4x4 matrix Q measuring the sum of squared distances of a point to a set of planes, stored
+         * as the upper triangle a2, ab, ac, ad, b2, bc, bd, c2, cd, d2 of the planes (a, b, c, d)
+         */
+        using Quadric = std::array<double, 10>;
+
+        /**
+         * Computes the quadric of the plane of a face weighted by the face's area.
+         * @param face - the vertices of the face
+         * @return the quadric
+         */
+        Quadric faceQuadric(const Array3Triplet &face);
+
+        /**
+         * Evaluates the quadric error v^T * Q * v at the homogeneous point v = (x, y, z, 1).
+         * @param quadric - the quadric Q
+         * @param point - the point (x, y, z)
+         * @return the error
+         */
+        double evaluateQuadric(const Quadric &quadric, const Array3 &point);
+
+        /**
+         * Computes the position which minimizes the quadric error of the collapse of an edge, or the best of the
+         * edge's endpoints and its midpoint if the quadric is singular.
+         * @param quadric - the sum of the quadrics of both endpoints
+         * @param first - the first endpoint
+         * @param second - the second endpoint
+         * @return the position and its error
+         */
+        std::pair<Array3, double> optimalPosition(const Quadric &quadric, const Array3 &first, const Array3 &second);
+
+    }
+
+}
@@ -0,0 +1,327 @@
+#include "NumaWorkerPool.h"
+
+namespace polyhedralGravity {
+
+    namespace {
+
+        /**
+         * The directory of the NUMA nodes in the sysfs of Linux
+         */
+        const std::string NODE_DIRECTORY{"/sys/devices/system/node/"};
+
+        /**
+         * Reads the first line of a file.
+         * @param path - the path of the file
+         * @return the first line, empty if the file cannot be read
+         */
+        std::string readLine(const std::string &path) {
+            std::ifstream file{path};
+            std::string line{};
+            std::getline(file, line);
+            return line;
+        }
+
+        /**
+         * Returns the logical CPUs this process may run on.
+         * @return the CPUs in ascending order
+         */
+        std::vector<size_t> availableCpus() {
+            std::vector<size_t> cpus{};
+#ifdef __linux__
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (sched_getaffinity(0, sizeof(cpu_set_t), &set) == 0) {
+                for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                    if (CPU_ISSET(cpu, &set)) {
+                        cpus.push_back(cpu);
+                    }
+                }
+            }
+#endif
+            if (cpus.empty()) {
+                cpus.resize(std::max(std::thread::hardware_concurrency(), 1u));
+                std::iota(cpus.begin(), cpus.end(), 0);
+            }
+            return cpus;
+        }
+
+        /**
+         * Pins the calling thread to a logical CPU.
+         * @param cpu - the CPU
+         * @return true if the thread is pinned
+         */
+        bool pinCurrentThread(size_t cpu) {
+#ifdef __linux__
+            if (cpu >= CPU_SETSIZE) {
+                return false;
+            }
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0;
+#else
+            return false;
+#endif
+        }
+
+    }
+
+    NumaWorkerPool::NumaWorkerPool(size_t threadCount, bool pinThreads)
+            : _pinned{pinThreads} {
+        const std::vector<NumaNode> topology = readTopology();
+        size_t cpuCount = 0;
+        for (const NumaNode &node: topology) {
+            cpuCount += node.cpus.size();
+        }
+        if (threadCount == 0) {
+            threadCount = cpuCount;
+        }
+        //The CPUs are taken from the nodes in turns, so that fewer workers than CPUs are spread evenly
+        std::vector<std::pair<size_t, size_t>> order{};
+        for (size_t rank = 0; order.size() < cpuCount; ++rank) {
+            for (size_t node = 0; node < topology.size(); ++node) {
+                if (rank < topology[node].cpus.size()) {
+                    order.emplace_back(node, topology[node].cpus[rank]);
+                }
+            }
+        }
+        std::vector<size_t> nodeIndices(topology.size(), topology.size());
+        for (size_t worker = 0; worker < threadCount; ++worker) {
+            const auto &[node, cpu] = order[worker % order.size()];
+            if (nodeIndices[node] == topology.size()) {
+                nodeIndices[node] = _nodes.size();
+                _nodes.push_back({topology[node].id, {}});
+            }
+            _nodes[nodeIndices[node]].cpus.push_back(cpu);
+            _workerNodes.push_back(nodeIndices[node]);
+            _workerCpus.push_back(cpu);
+        }
+        for (NumaNode &node: _nodes) {
+            std::sort(node.cpus.begin(), node.cpus.end());
+            node.cpus.erase(std::unique(node.cpus.begin(), node.cpus.end()), node.cpus.end());
+        }
+        _replicas.resize(_nodes.size());
+
+        _threads.reserve(threadCount);
+        for (size_t worker = 0; worker < threadCount; ++worker) {
+            _threads.emplace_back(&NumaWorkerPool::work, this, worker, pinThreads);
+        }
+        //An empty job waits until every worker has tried to pin itself
+        runOnAll([](size_t) {});
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Started {} workers on {} NUMA nodes, pinned: {}", threadCount, _nodes.size(),
+                            _pinned.load());
+    }
+
+    NumaWorkerPool::~NumaWorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _shutdown = true;
+        }
+        _wakeUp.notify_all();
+        for (std::thread &thread: _threads) {
+            thread.join();
+        }
+    }
+
+    void NumaWorkerPool::work(size_t worker, bool pinThread) {
+        if (pinThread && !pinCurrentThread(_workerCpus[worker])) {
+            _pinned.store(false);
+        }
+        size_t generation = 0;
+        while (true) {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _wakeUp.wait(lock, [this, generation] { return _shutdown || _generation != generation; });
+            if (_shutdown) {
+                return;
+            }
+            generation = _generation;
+            lock.unlock();
+            try {
+                _job(worker);
+            } catch (...) {
+                lock.lock();
+                if (!_exception) {
+                    _exception = std::current_exception();
+                }
+                lock.unlock();
+            }
+            lock.lock();
+            if (--_pending == 0) {
+                _finished.notify_one();
+            }
+        }
+    }
+
+    void NumaWorkerPool::runOnAll(const std::function<void(size_t)> &job) {
+        std::unique_lock<std::mutex> lock{_mutex};
+        _job = job;
+        _exception = nullptr;
+        _pending = _threads.size();
+        ++_generation;
+        _wakeUp.notify_all();
+        _finished.wait(lock, [this] { return _pending == 0; });
+        _job = nullptr;
+        if (_exception) {
+            std::rethrow_exception(_exception);
+        }
+    }
+
+    void NumaWorkerPool::prepare(const Polyhedron &polyhedron) {
+        std::lock_guard<std::mutex> lock{_callMutex};
+        const std::vector<Array3Triplet> faces = TiledKernel::prepareFaces(polyhedron);
+        _replicas.clear();
+        _replicas.resize(_nodes.size());
+        //The first worker of every node copies the faces, so that the pages are touched first on that node
+        runOnAll([this, &faces](size_t worker) {
+            const size_t node = _workerNodes[worker];
+            if (std::find(_workerNodes.cbegin(), _workerNodes.cend(), node) - _workerNodes.cbegin() ==
+                static_cast<std::ptrdiff_t>(worker)) {
+                _replicas[node] = std::make_unique<const std::vector<Array3Triplet>>(faces);
+            }
+        });
+    }
+
+    std::vector<GravityModelResult> NumaWorkerPool::evaluateGeometricSums(
+            const std::vector<Array3> &computationPoints) {
+        std::lock_guard<std::mutex> lock{_callMutex};
+        if (_replicas.empty() || !_replicas.front()) {
+            throw std::runtime_error{"The NumaWorkerPool has no prepared polyhedron! Call prepare(..) first."};
+        }
+        const size_t pointCount = computationPoints.size();
+        std::vector<GravityModelResult> result{pointCount};
+        if (pointCount == 0) {
+            return result;
+        }
+        std::vector<size_t> indices(pointCount);
+        std::iota(indices.begin(), indices.end(), 0);
+        const FaceApproximations approximations = EvaluationSettings::getFaceApproximations();
+        const size_t blockSize = TiledKernel::DEFAULT_POINT_BLOCK_SIZE;
+        const size_t blockCount = (pointCount + blockSize - 1) / blockSize;
+
+        //The blocks are split over the nodes in proportion to their number of workers
+        const size_t nodeCount = _nodes.size();
+        std::vector<size_t> nodeBegin(nodeCount + 1, 0);
+        size_t workers = 0;
+        for (size_t node = 0; node < nodeCount; ++node) {
+            workers += std::count(_workerNodes.cbegin(), _workerNodes.cend(), node);
+            nodeBegin[node + 1] = blockCount * workers / _workerNodes.size();
+        }
+        std::unique_ptr<std::atomic<size_t>[]> cursors{new std::atomic<size_t>[nodeCount]};
+        for (size_t node = 0; node < nodeCount; ++node) {
+            cursors[node].store(nodeBegin[node]);
+        }
+
+        runOnAll([&](size_t worker) {
+            const size_t localNode = _workerNodes[worker];
+            const std::vector<Array3Triplet> &faces = *_replicas[localNode];
+            //The own blocks first, then the ones of the other nodes
+            for (size_t offset = 0; offset < nodeCount; ++offset) {
+                const size_t node = (localNode + offset) % nodeCount;
+                for (size_t block = cursors[node]++; block < nodeBegin[node + 1]; block = cursors[node]++) {
+                    const size_t pointBegin = block * blockSize;
+                    TiledKernel::evaluateBlock(faces, computationPoints, indices, pointBegin,
+                                               std::min(pointCount, pointBegin + blockSize),
+                                               TiledKernel::DEFAULT_FACE_BLOCK_SIZE, approximations, result);
+                }
+            }
+        });
+        return result;
+    }
+
+    std::vector<GravityModelResult> NumaWorkerPool::evaluate(
+            double density, const std::vector<Array3> &computationPoints) {
+        std::vector<GravityModelResult> result = evaluateGeometricSums(computationPoints);
+        std::transform(result.begin(), result.end(), result.begin(), [density](const GravityModelResult &sums) {
+            return GravityModel::detail::applyDensityPrefix(sums, density);
+        });
+        return result;
+    }
+
+    std::vector<GravityModelResult> NumaWorkerPool::evaluate(
+            const Polyhedron &polyhedron, double density, const std::vector<Array3> &computationPoints) {
+        prepare(polyhedron);
+        return evaluate(density, computationPoints);
+    }
+
+    size_t NumaWorkerPool::countThreads() const {
+        return _threads.size();
+    }
+
+    size_t NumaWorkerPool::countNodes() const {
+        return _nodes.size();
+    }
+
+    const std::vector<NumaNode> &NumaWorkerPool::getNodes() const {
+        return _nodes;
+    }
+
+    bool NumaWorkerPool::isPinned() const {
+        return _pinned.load();
+    }
+
+    const std::vector<Array3Triplet> &NumaWorkerPool::getReplica(size_t node) const {
+        static const std::vector<Array3Triplet> empty{};
+        if (node >= _replicas.size()) {
+            throw std::out_of_range{"The NumaWorkerPool has no node " + std::to_string(node) + "!"};
+        }
+        return _replicas[node] ? *_replicas[node] : empty;
+    }
+
+    std::vector<NumaNode> NumaWorkerPool::readTopology() {
+        const std::vector<size_t> available = availableCpus();
+        std::vector<NumaNode> nodes{};
+        try {
+            for (const size_t id: parseCpuList(readLine(NODE_DIRECTORY + "online"))) {
+                NumaNode node{id, {}};
+                for (const size_t cpu: parseCpuList(readLine(NODE_DIRECTORY + "node" + std::to_string(id) +
+                                                             "/cpulist"))) {
+                    if (std::binary_search(available.cbegin(), available.cend(), cpu)) {
+                        node.cpus.push_back(cpu);
+                    }
+                }
+                if (!node.cpus.empty()) {
+                    nodes.push_back(std::move(node));
+                }
+            }
+        } catch (const std::invalid_argument &) {
+            nodes.clear();
+        }
+        if (nodes.empty()) {
+            nodes.push_back({0, available});
+        }
+        return nodes;
+    }
+
+    std::vector<size_t> NumaWorkerPool::parseCpuList(const std::string &cpuList) {
+        std::vector<size_t> cpus{};
+        std::stringstream stream{cpuList};
+        std::string range{};
+        const auto parseNumber = [&cpuList](const std::string &number) -> size_t {
+            if (number.empty() || number.find_first_not_of("0123456789") != std::string::npos) {
+                throw std::invalid_argument{"Malformed list of CPUs: " + cpuList};
+            }
+            return std::stoul(number);
+        };
+        while (std::getline(stream, range, ',')) {
+            range.erase(std::remove_if(range.begin(), range.end(), [](char c) { return std::isspace(c); }),
+                        range.end());
+            if (range.empty()) {
+                continue;
+            }
+            const size_t separator = range.find('-');
+            const size_t first = parseNumber(range.substr(0, separator));
+            const size_t last = separator == std::string::npos ? first : parseNumber(range.substr(separator + 1));
+            if (last < first) {
+                throw std::invalid_argument{"Malformed list of CPUs: " + cpuList};
+            }
+            for (size_t cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+        std::sort(cpus.begin(), cpus.end());
+        cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+        return cpus;
+    }
+
+}
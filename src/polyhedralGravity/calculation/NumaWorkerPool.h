@@ -0,0 +1,266 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <exception>
+#include <stdexcept>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <cctype>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/calculation/TiledKernel.h"
+#include "polyhedralGravity/output/Logging.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace polyhedralGravity {
+
+    /**
+     * A NUMA node with the logical CPUs on which this process may run.
+     */
+    struct NumaNode {
+
+        /**
+         * The number of the node as given by the operating system
+         */
+        size_t id{0};
+
+        /**
+         * The logical CPUs of the node in ascending order
+         */
+        std::vector<size_t> cpus{};
+
+    };
+
+    /**
+     * A persistent pool of worker threads for the evaluation of the polyhedral gravity model at many computation
+     * points on machines with multiple NUMA nodes (e.g. dual-socket nodes).
+     * Every worker is pinned to one logical CPU and the workers are spread evenly over the NUMA nodes. The resolved
+     * faces (see TiledKernel::prepareFaces(..)) are read-only during the evaluation, so one replica is kept per node.
+     * A replica is allocated and written by a worker of its node, so the first-touch policy of the operating system
+     * places its pages in the local memory of that node. The blocks of computation points are split over the nodes
+     * in proportion to their number of workers. A worker takes the blocks of its own node first and then steals the
+     * remaining blocks of the other nodes, but it always reads the faces from the replica of its own node.
+     * The blocks are evaluated with TiledKernel::evaluateBlock(..), so the results are identical to the ones of the
+     * TiledKernel.
+     *
+     * The threads live as long as the pool, so repeated evaluations do not pay for the creation of threads. The
+     * topology is read from /sys/devices/system/node on Linux. Elsewhere, or if the topology is unavailable, all
+     * CPUs form a single node and the workers are not pinned.
+     *
+     * @note The replicas only help if the memory policy of the process is the default first-touch policy, i.e. not
+     * interleaved by e.g. numactl --interleave.
+     */
+    class NumaWorkerPool {
+
+        /**
+         * The NUMA nodes with at least one worker
+         */
+        std::vector<NumaNode> _nodes;
+
+        /**
+         * The index of the node (in _nodes) foreach worker
+         */
+        std::vector<size_t> _workerNodes;
+
+        /**
+         * The logical CPU foreach worker
+         */
+        std::vector<size_t> _workerCpus;
+
+        /**
+         * Whether every worker could be pinned to its CPU
+         */
+        std::atomic<bool> _pinned;
+
+        /**
+         * The threads of the workers
+         */
+        std::vector<std::thread> _threads;
+
+        /**
+         * Guards the job, the generation, the number of pending workers and the shutdown flag
+         */
+        std::mutex _mutex;
+
+        /**
+         * Wakes up the workers for a new job or the shutdown
+         */
+        std::condition_variable _wakeUp;
+
+        /**
+         * Wakes up the caller once all workers have finished the job
+         */
+        std::condition_variable _finished;
+
+        /**
+         * The job executed by every worker with the index of the worker
+         */
+        std::function<void(size_t)> _job;
+
+        /**
+         * The number of jobs issued so far
+         */
+        size_t _generation{0};
+
+        /**
+         * The number of workers which have not yet finished the current job
+         */
+        size_t _pending{0};
+
+        /**
+         * Whether the workers shall terminate
+         */
+        bool _shutdown{false};
+
+        /**
+         * The first exception thrown by a worker during the current job
+         */
+        std::exception_ptr _exception;
+
+        /**
+         * Serializes the calls of prepare(..) and evaluate(..)
+         */
+        std::mutex _callMutex;
+
+        /**
+         * The resolved faces foreach node (in _nodes), empty if no polyhedron is prepared
+         */
+        std::vector<std::unique_ptr<const std::vector<Array3Triplet>>> _replicas;
+
+    public:
+
+        /**
+         * Starts the workers and pins them to the CPUs of the NUMA nodes.
+         * @param threadCount - the number of workers, zero for every CPU available to this process
+         * @param pinThreads - whether to pin the workers to their CPUs
+         */
+        explicit NumaWorkerPool(size_t threadCount = 0, bool pinThreads = true);
+
+        /**
+         * Stops and joins the workers.
+         */
+        ~NumaWorkerPool();
+
+        NumaWorkerPool(const NumaWorkerPool &) = delete;
+
+        NumaWorkerPool &operator=(const NumaWorkerPool &) = delete;
+
+        /**
+         * Resolves the faces of a polyhedron and replicates them in the local memory of every NUMA node.
+         * The replicas are used by all following calls of evaluate(..) without polyhedron.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         */
+        void prepare(const Polyhedron &polyhedron);
+
+        /**
+         * Evaluates the geometric sums (i.e. the results for a unit density before the application of the prefix
+         * GRAVITATIONAL_CONSTANT * density) of the prepared polyhedron for multiple computation points.
+         * @param computationPoints - vector of computation points
+         * @return the density-independent sums foreach computation Point P
+         * @throws std::runtime_error if no polyhedron has been prepared
+         */
+        std::vector<GravityModelResult> evaluateGeometricSums(const std::vector<Array3> &computationPoints);
+
+        /**
+         * Evaluates the polyhedral gravity model for the prepared constant density polyhedron at multiple
+         * computation points.
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoints - vector of computation points
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * foreach computation Point P
+         * @throws std::runtime_error if no polyhedron has been prepared
+         */
+        std::vector<GravityModelResult> evaluate(double density, const std::vector<Array3> &computationPoints);
+
+        /**
+         * Prepares the polyhedron and evaluates the polyhedral gravity model at multiple computation points.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoints - vector of computation points
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * foreach computation Point P
+         */
+        std::vector<GravityModelResult> evaluate(
+                const Polyhedron &polyhedron, double density, const std::vector<Array3> &computationPoints);
+
+        /**
+         * Returns the number of workers.
+         * @return the number of workers
+         */
+        [[nodiscard]] size_t countThreads() const;
+
+        /**
+         * Returns the number of NUMA nodes with at least one worker, i.e. the number of replicas.
+         * @return the number of NUMA nodes
+         */
+        [[nodiscard]] size_t countNodes() const;
+
+        /**
+         * Returns the NUMA nodes with at least one worker.
+         * @return the NUMA nodes
+         */
+        [[nodiscard]] const std::vector<NumaNode> &getNodes() const;
+
+        /**
+         * Returns whether every worker runs pinned to its CPU.
+         * @return true if all workers are pinned
+         */
+        [[nodiscard]] bool isPinned() const;
+
+        /**
+         * Returns the replica of the resolved faces of a NUMA node.
+         * @param node - the index of the node, smaller than countNodes()
+         * @return the vertices of every face, empty if no polyhedron has been prepared
+         * @throws std::out_of_range if the node does not exist
+         */
+        [[nodiscard]] const std::vector<Array3Triplet> &getReplica(size_t node) const;
+
+        /**
+         * Reads the NUMA topology of this machine restricted to the CPUs this process may run on.
+         * @return the nodes with at least one available CPU, a single node with all CPUs if the topology is unknown
+         */
+        static std::vector<NumaNode> readTopology();
+
+        /**
+         * Parses a list of CPUs in the format of the Linux kernel, e.g. "0-3,8-11".
+         * @param cpuList - the list of CPUs
+         * @return the CPUs in ascending order
+         * @throws std::invalid_argument if the list is malformed
+         */
+        static std::vector<size_t> parseCpuList(const std::string &cpuList);
+
+    private:
+
+        /**
+         * The loop of a worker, which waits for jobs until the shutdown.
+         * @param worker - the index of the worker
+         * @param pinThread - whether to pin the worker to its CPU
+         */
+        void work(size_t worker, bool pinThread);
+
+        /**
+         * Executes a job once on every worker and waits for all of them to finish.
+         * @param job - the function executed with the index of the worker
+         * @throws any exception thrown by the job, the first one if multiple workers throw
+         */
+        void runOnAll(const std::function<void(size_t)> &job);
+
+    };
+
+}
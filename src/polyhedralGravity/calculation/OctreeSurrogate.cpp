@@ -0,0 +1,296 @@
+#include "OctreeSurrogate.h"
+
+namespace polyhedralGravity {
+
+    OctreeSurrogate::OctreeSurrogate(const Polyhedron &polyhedron, double density, const Array3 &lowerCorner,
+                                     const Array3 &upperCorner, double tolerance, size_t maxDepth)
+            : OctreeSurrogate(lowerCorner, upperCorner, tolerance, maxDepth) {
+        using namespace util;
+        using Coordinates = std::array<std::uint64_t, 3>;
+
+        /**
+         * A cell of the current level, which still needs to be checked
+         */
+        struct PendingCell {
+            std::uint32_t index;
+            Coordinates origin;
+            std::uint64_t size;
+        };
+
+        //The center and the six face centers of a cell in units of half its edge length
+        constexpr std::array<Coordinates, 7> samples{{
+                {1, 1, 1}, {0, 1, 1}, {2, 1, 1}, {1, 0, 1}, {1, 2, 1}, {1, 1, 0}, {1, 1, 2}}};
+
+        std::unordered_map<std::uint64_t, std::uint32_t> nodeIndices{};
+        const auto evaluateNodes = [&](const std::vector<Coordinates> &required) {
+            std::vector<Coordinates> missing{};
+            for (const Coordinates &coordinates: required) {
+                const auto nodeIndex = static_cast<std::uint32_t>(_nodes.size() + missing.size());
+                if (nodeIndices.emplace(nodeKey(coordinates), nodeIndex).second) {
+                    missing.push_back(coordinates);
+                }
+            }
+            //All new nodes are evaluated at once, so that the kernel is chosen for them
+            std::vector<Array3> positions{missing.size()};
+            std::transform(missing.cbegin(), missing.cend(), positions.begin(),
+                           [this](const Coordinates &coordinates) { return nodePosition(coordinates); });
+            const std::vector<GravityModelResult> results = GravityModel::evaluate(polyhedron, density, positions);
+            _nodes.insert(_nodes.end(), results.begin(), results.end());
+        };
+
+        const std::uint64_t rootSize = std::uint64_t{1} << _maxDepth;
+        _cells.push_back(Cell{0, {}});
+        std::vector<PendingCell> level{{0, {0, 0, 0}, rootSize}};
+        for (size_t depth = 0; !level.empty(); ++depth) {
+            const bool refinable = depth < _maxDepth;
+            SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                                "Octree surrogate: checking {} cells at depth {}", level.size(), depth);
+
+            //1. Step: Evaluate the exact model at the corners (and the samples if the cells can still be refined)
+            std::vector<Coordinates> required{};
+            for (const PendingCell &pending: level) {
+                for (size_t corner = 0; corner < 8; ++corner) {
+                    required.push_back({pending.origin[0] + (corner & 1u) * pending.size,
+                                        pending.origin[1] + ((corner >> 1u) & 1u) * pending.size,
+                                        pending.origin[2] + ((corner >> 2u) & 1u) * pending.size});
+                }
+                if (refinable) {
+                    const std::uint64_t half = pending.size / 2;
+                    for (const Coordinates &sample: samples) {
+                        required.push_back({pending.origin[0] + sample[0] * half,
+                                            pending.origin[1] + sample[1] * half,
+                                            pending.origin[2] + sample[2] * half});
+                    }
+                }
+            }
+            evaluateNodes(required);
+
+            //2. Step: Set the corners and refine the cells whose interpolation error exceeds the tolerance
+            std::vector<PendingCell> nextLevel{};
+            size_t requiredIndex = 0;
+            for (const PendingCell &pending: level) {
+                for (size_t corner = 0; corner < 8; ++corner) {
+                    _cells[pending.index].corners[corner] = nodeIndices.at(nodeKey(required[requiredIndex++]));
+                }
+                if (!refinable) {
+                    continue;
+                }
+                const Array3 spacing = (_upperCorner - _lowerCorner) *
+                                       (static_cast<double>(pending.size) / static_cast<double>(rootSize));
+                const auto corners = leafCorners(_cells[pending.index], spacing);
+                double error = 0.0;
+                for (const Coordinates &sample: samples) {
+                    const GravityModelResult &exact = _nodes[nodeIndices.at(nodeKey(required[requiredIndex++]))];
+                    const Array3 localCoordinates{sample[0] / 2.0, sample[1] / 2.0, sample[2] / 2.0};
+                    const auto interpolated = HermiteInterpolation::interpolate(corners, localCoordinates, spacing);
+                    error = std::max(error, euclideanNorm(interpolated.acceleration - exact.acceleration));
+                }
+                if (error > _tolerance) {
+                    const auto firstChild = static_cast<std::uint32_t>(_cells.size());
+                    _cells[pending.index].firstChild = firstChild;
+                    const std::uint64_t half = pending.size / 2;
+                    for (std::uint32_t child = 0; child < 8; ++child) {
+                        _cells.push_back(Cell{0, {}});
+                        nextLevel.push_back({firstChild + child,
+                                             {pending.origin[0] + (child & 1u) * half,
+                                              pending.origin[1] + ((child >> 1u) & 1u) * half,
+                                              pending.origin[2] + ((child >> 2u) & 1u) * half},
+                                             half});
+                    }
+                }
+            }
+            level = std::move(nextLevel);
+        }
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Octree surrogate: {} cells with {} nodes", _cells.size(), _nodes.size());
+    }
+
+    OctreeSurrogate::OctreeSurrogate(const Array3 &lowerCorner, const Array3 &upperCorner, double tolerance,
+                                     size_t maxDepth)
+            : _lowerCorner{lowerCorner},
+              _upperCorner{upperCorner},
+              _tolerance{tolerance},
+              _maxDepth{maxDepth},
+              _nodes{},
+              _cells{} {
+        for (size_t axis = 0; axis < 3; ++axis) {
+            if (!(_lowerCorner[axis] < _upperCorner[axis])) {
+                throw std::invalid_argument{
+                        "The lower corner of the OctreeSurrogate must be smaller than the upper corner!"};
+            }
+        }
+        if (!(_tolerance > 0.0)) {
+            throw std::invalid_argument{"The tolerance of the OctreeSurrogate must be greater than zero!"};
+        }
+        if (_maxDepth > MAX_SUPPORTED_DEPTH) {
+            throw std::invalid_argument{"The depth of the OctreeSurrogate is limited to 20!"};
+        }
+    }
+
+    OctreeSurrogate OctreeSurrogate::load(const std::string &filename) {
+        std::ifstream file{filename, std::ios::binary};
+        if (!file) {
+            throw std::runtime_error{"The OctreeSurrogate file " + filename + " could not be opened!"};
+        }
+        char magic[sizeof(FILE_MAGIC)];
+        std::uint32_t version = 0;
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char *>(&version), sizeof(version));
+        if (!file || !std::equal(std::begin(magic), std::end(magic), std::begin(FILE_MAGIC)) ||
+            version != FILE_VERSION) {
+            throw std::runtime_error{"The file " + filename + " does not contain a valid OctreeSurrogate!"};
+        }
+        Array3 lowerCorner{}, upperCorner{};
+        double tolerance = 0.0;
+        std::uint64_t maxDepth = 0, nodeCount = 0, cellCount = 0;
+        file.read(reinterpret_cast<char *>(lowerCorner.data()), sizeof(lowerCorner));
+        file.read(reinterpret_cast<char *>(upperCorner.data()), sizeof(upperCorner));
+        file.read(reinterpret_cast<char *>(&tolerance), sizeof(tolerance));
+        file.read(reinterpret_cast<char *>(&maxDepth), sizeof(maxDepth));
+        file.read(reinterpret_cast<char *>(&nodeCount), sizeof(nodeCount));
+        file.read(reinterpret_cast<char *>(&cellCount), sizeof(cellCount));
+        if (!file) {
+            throw std::runtime_error{"The header of the OctreeSurrogate file " + filename + " is incomplete!"};
+        }
+        OctreeSurrogate surrogate{lowerCorner, upperCorner, tolerance, maxDepth};
+        surrogate._nodes.resize(nodeCount);
+        for (GravityModelResult &node: surrogate._nodes) {
+            file.read(reinterpret_cast<char *>(&node.gravitationalPotential), sizeof(double));
+            file.read(reinterpret_cast<char *>(node.acceleration.data()), sizeof(node.acceleration));
+            file.read(reinterpret_cast<char *>(node.gradiometricTensor.data()), sizeof(node.gradiometricTensor));
+        }
+        surrogate._cells.resize(cellCount);
+        for (size_t index = 0; index < surrogate._cells.size(); ++index) {
+            Cell &cell = surrogate._cells[index];
+            file.read(reinterpret_cast<char *>(&cell.firstChild), sizeof(cell.firstChild));
+            file.read(reinterpret_cast<char *>(cell.corners.data()), sizeof(cell.corners));
+            //Children are always stored after their parent, so the descent in evaluate(..) terminates
+            const bool invalidChildren = cell.firstChild != 0 &&
+                                         (cell.firstChild <= index || cell.firstChild + std::uint64_t{8} > cellCount);
+            const bool invalid = invalidChildren ||
+                                 std::any_of(cell.corners.begin(), cell.corners.end(),
+                                             [nodeCount](std::uint32_t corner) { return corner >= nodeCount; });
+            if (!file || invalid) {
+                throw std::runtime_error{"The cells of the OctreeSurrogate file " + filename + " are corrupted!"};
+            }
+        }
+        if (!file || cellCount == 0) {
+            throw std::runtime_error{"The OctreeSurrogate file " + filename + " is incomplete!"};
+        }
+        return surrogate;
+    }
+
+    void OctreeSurrogate::save(const std::string &filename) const {
+        std::ofstream file{filename, std::ios::binary | std::ios::trunc};
+        if (!file) {
+            throw std::runtime_error{"The OctreeSurrogate file " + filename + " could not be created!"};
+        }
+        const std::uint64_t maxDepth = _maxDepth, nodeCount = _nodes.size(), cellCount = _cells.size();
+        file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+        file.write(reinterpret_cast<const char *>(&FILE_VERSION), sizeof(FILE_VERSION));
+        file.write(reinterpret_cast<const char *>(_lowerCorner.data()), sizeof(_lowerCorner));
+        file.write(reinterpret_cast<const char *>(_upperCorner.data()), sizeof(_upperCorner));
+        file.write(reinterpret_cast<const char *>(&_tolerance), sizeof(_tolerance));
+        file.write(reinterpret_cast<const char *>(&maxDepth), sizeof(maxDepth));
+        file.write(reinterpret_cast<const char *>(&nodeCount), sizeof(nodeCount));
+        file.write(reinterpret_cast<const char *>(&cellCount), sizeof(cellCount));
+        for (const GravityModelResult &node: _nodes) {
+            file.write(reinterpret_cast<const char *>(&node.gravitationalPotential), sizeof(double));
+            file.write(reinterpret_cast<const char *>(node.acceleration.data()), sizeof(node.acceleration));
+            file.write(reinterpret_cast<const char *>(node.gradiometricTensor.data()),
+                       sizeof(node.gradiometricTensor));
+        }
+        for (const Cell &cell: _cells) {
+            file.write(reinterpret_cast<const char *>(&cell.firstChild), sizeof(cell.firstChild));
+            file.write(reinterpret_cast<const char *>(cell.corners.data()), sizeof(cell.corners));
+        }
+        if (!file) {
+            throw std::runtime_error{"The OctreeSurrogate could not be written to " + filename + "!"};
+        }
+    }
+
+    GravityModelResult OctreeSurrogate::evaluate(const Array3 &computationPoint) const {
+        using namespace util;
+        if (!contains(computationPoint)) {
+            throw std::out_of_range{"The computation point is not contained in the region of the OctreeSurrogate!"};
+        }
+        //Descend to the leaf containing P
+        std::uint32_t index = 0;
+        Array3 cellLowerCorner = _lowerCorner;
+        Array3 spacing = _upperCorner - _lowerCorner;
+        while (_cells[index].firstChild != 0) {
+            spacing = spacing / 2.0;
+            std::uint32_t octant = 0;
+            for (size_t axis = 0; axis < 3; ++axis) {
+                if (computationPoint[axis] >= cellLowerCorner[axis] + spacing[axis]) {
+                    octant |= 1u << axis;
+                    cellLowerCorner[axis] += spacing[axis];
+                }
+            }
+            index = _cells[index].firstChild + octant;
+        }
+        Array3 localCoordinates = (computationPoint - cellLowerCorner) / spacing;
+        for (double &coordinate: localCoordinates) {
+            coordinate = std::clamp(coordinate, 0.0, 1.0);
+        }
+        return HermiteInterpolation::interpolate(leafCorners(_cells[index], spacing), localCoordinates, spacing);
+    }
+
+    std::vector<GravityModelResult> OctreeSurrogate::evaluate(const std::vector<Array3> &computationPoints) const {
+        std::vector<GravityModelResult> result{computationPoints.size()};
+        thrust::transform(computationPoints.begin(), computationPoints.end(), result.begin(),
+                          [this](const Array3 &computationPoint) {
+                              return evaluate(computationPoint);
+                          });
+        return result;
+    }
+
+    bool OctreeSurrogate::contains(const Array3 &computationPoint) const {
+        for (size_t axis = 0; axis < 3; ++axis) {
+            if (!(computationPoint[axis] >= _lowerCorner[axis] && computationPoint[axis] <= _upperCorner[axis])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t OctreeSurrogate::getDepth() const {
+        size_t depth = 0;
+        std::vector<std::pair<std::uint32_t, size_t>> stack{{0, 0}};
+        while (!stack.empty()) {
+            const auto [index, cellDepth] = stack.back();
+            stack.pop_back();
+            depth = std::max(depth, cellDepth);
+            if (_cells[index].firstChild != 0) {
+                for (std::uint32_t child = 0; child < 8; ++child) {
+                    stack.emplace_back(_cells[index].firstChild + child, cellDepth + 1);
+                }
+            }
+        }
+        return depth;
+    }
+
+    std::uint64_t OctreeSurrogate::nodeKey(const std::array<std::uint64_t, 3> &coordinates) {
+        return coordinates[0] | (coordinates[1] << 21u) | (coordinates[2] << 42u);
+    }
+
+    Array3 OctreeSurrogate::nodePosition(const std::array<std::uint64_t, 3> &coordinates) const {
+        const auto rootSize = static_cast<double>(std::uint64_t{1} << _maxDepth);
+        Array3 position{};
+        for (size_t axis = 0; axis < 3; ++axis) {
+            position[axis] = _lowerCorner[axis] + (_upperCorner[axis] - _lowerCorner[axis]) *
+                                                  (static_cast<double>(coordinates[axis]) / rootSize);
+        }
+        return position;
+    }
+
+    std::array<HermiteNode, 8> OctreeSurrogate::leafCorners(const Cell &cell, const Array3 &spacing) const {
+        std::array<HermiteNode, 8> corners{};
+        for (size_t corner = 0; corner < 8; ++corner) {
+            corners[corner].result = _nodes[cell.corners[corner]];
+        }
+        HermiteInterpolation::estimateMixedDerivatives(corners, spacing);
+        return corners;
+    }
+
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <unordered_map>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/calculation/HermiteInterpolation.h"
+#include "polyhedralGravity/util/UtilityContainer.h"
+#include "polyhedralGravity/output/Logging.h"
+#include "thrust/transform.h"
+
+namespace polyhedralGravity {
+
+    /**
+     * An adaptively refined surrogate of the polyhedral gravity model.
+     * A cuboid region is recursively subdivided into eight octants until the tricubic Hermite interpolation of
+     * every leaf (see HermiteInterpolation) deviates from the exact acceleration by less than a tolerance at the
+     * leaf's center and the centers of its six faces. Thus, cells near the surface are small and cells far away
+     * from the body are large. The exact results at the corners are shared between neighboring cells and the
+     * mixed derivative Vxyz is estimated per leaf, so the memory footprint is about ten doubles per node.
+     *
+     * A query descends the tree in O(log n) to the leaf containing the point and interpolates inside it.
+     *
+     * @note The error control is based on samples, the tolerance is not a strict bound for every point of a leaf
+     * @example Flight software requiring bounded-error lookups with a small memory footprint
+     */
+    class OctreeSurrogate {
+
+        /**
+         * One cell of the octree
+         */
+        struct Cell {
+
+            /**
+             * The index of the first of the eight consecutive children, zero denotes a leaf
+             * (the root has index zero and is never a child)
+             */
+            std::uint32_t firstChild;
+
+            /**
+             * The indices of the eight corner nodes, corner (i, j, k) at index i + 2j + 4k
+             */
+            std::array<std::uint32_t, 8> corners;
+
+        };
+
+        /**
+         * The identifier at the beginning of a stored surrogate
+         */
+        static constexpr char FILE_MAGIC[8] = {'P', 'G', 'O', 'C', 'T', 'R', 'E', 'E'};
+
+        /**
+         * The version of the file format
+         */
+        static constexpr std::uint32_t FILE_VERSION = 1;
+
+        /**
+         * The largest supported depth, the integer node coordinates are packed into 21 bits each
+         */
+        static constexpr size_t MAX_SUPPORTED_DEPTH = 20;
+
+        /**
+         * The corner of the region with the smallest coordinates
+         */
+        Array3 _lowerCorner;
+
+        /**
+         * The corner of the region with the largest coordinates
+         */
+        Array3 _upperCorner;
+
+        /**
+         * The tolerance of the acceleration's error in [m/s^2] used for the refinement
+         */
+        double _tolerance;
+
+        /**
+         * The maximal depth of the tree
+         */
+        size_t _maxDepth;
+
+        /**
+         * The exact results of the gravity model at the nodes
+         */
+        std::vector<GravityModelResult> _nodes;
+
+        /**
+         * The cells of the tree, the root at index zero
+         */
+        std::vector<Cell> _cells;
+
+    public:
+
+        /**
+         * Creates a new OctreeSurrogate by refining the given region until the tolerance is met or the maximal
+         * depth is reached. The exact model is evaluated by one multi-point call for all new nodes of a level.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @param density - the constant density in [kg/m^3]
+         * @param lowerCorner - the corner of the region with the smallest coordinates
+         * @param upperCorner - the corner of the region with the largest coordinates
+         * @param tolerance - the tolerated absolute error of the acceleration in [m/s^2]
+         * @param maxDepth - the maximal depth of the tree (at most 20)
+         * @throws std::invalid_argument if the region is empty, the tolerance not positive or the depth too large
+         */
+        OctreeSurrogate(const Polyhedron &polyhedron, double density, const Array3 &lowerCorner,
+                        const Array3 &upperCorner, double tolerance, size_t maxDepth = 10);
+
+        /**
+         * Reads a surrogate which has been stored with save(..).
+         * @param filename - the path to the file
+         * @return the OctreeSurrogate
+         * @throws std::runtime_error if the file can not be read or is no valid surrogate
+         */
+        static OctreeSurrogate load(const std::string &filename);
+
+        /**
+         * Stores the surrogate in a binary file (native byte order).
+         * @param filename - the path to the file
+         * @throws std::runtime_error if the file can not be written
+         */
+        void save(const std::string &filename) const;
+
+        /**
+         * Interpolates the polyhedral gravity model at computation point P.
+         * @param computationPoint - the computation Point P
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * at computation Point P
+         * @throws std::out_of_range if P is not contained in the region
+         */
+        [[nodiscard]] GravityModelResult evaluate(const Array3 &computationPoint) const;
+
+        /**
+         * Interpolates the polyhedral gravity model at multiple computation points.
+         * @param computationPoints - vector of computation points
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * foreach computation Point P
+         * @throws std::out_of_range if one P is not contained in the region
+         */
+        [[nodiscard]] std::vector<GravityModelResult> evaluate(const std::vector<Array3> &computationPoints) const;
+
+        /**
+         * Checks if a computation point lies inside the region.
+         * @param computationPoint - the computation Point P
+         * @return true if P can be interpolated
+         */
+        [[nodiscard]] bool contains(const Array3 &computationPoint) const;
+
+        /**
+         * Returns the tolerance used for the refinement.
+         * @return tolerance in [m/s^2]
+         */
+        [[nodiscard]] double getTolerance() const {
+            return _tolerance;
+        }
+
+        /**
+         * Returns the number of nodes at which the exact model has been evaluated.
+         * @return number of nodes
+         */
+        [[nodiscard]] size_t getNodeCount() const {
+            return _nodes.size();
+        }
+
+        /**
+         * Returns the number of cells (inner cells and leafs).
+         * @return number of cells
+         */
+        [[nodiscard]] size_t getCellCount() const {
+            return _cells.size();
+        }
+
+        /**
+         * Returns the depth of the deepest leaf.
+         * @return depth, zero if the root is a leaf
+         */
+        [[nodiscard]] size_t getDepth() const;
+
+    private:
+
+        /**
+         * Creates an empty surrogate and checks the arguments, used by the public constructor and load(..).
+         * @param lowerCorner - the corner of the region with the smallest coordinates
+         * @param upperCorner - the corner of the region with the largest coordinates
+         * @param tolerance - the tolerated absolute error of the acceleration in [m/s^2]
+         * @param maxDepth - the maximal depth of the tree
+         */
+        OctreeSurrogate(const Array3 &lowerCorner, const Array3 &upperCorner, double tolerance, size_t maxDepth);
+
+        /**
+         * Packs integer node coordinates in units of the smallest possible cell into one key.
+         * @param coordinates - the integer coordinates
+         * @return the key
+         */
+        static std::uint64_t nodeKey(const std::array<std::uint64_t, 3> &coordinates);
+
+        /**
+         * Converts integer node coordinates to the cartesian position.
+         * @param coordinates - the integer coordinates
+         * @return the position
+         */
+        [[nodiscard]] Array3 nodePosition(const std::array<std::uint64_t, 3> &coordinates) const;
+
+        /**
+         * Gathers the corners of a leaf and estimates their mixed derivatives.
+         * @param cell - the leaf
+         * @param spacing - the edge lengths of the leaf
+         * @return the corners for the interpolation
+         */
+        [[nodiscard]] std::array<HermiteNode, 8> leafCorners(const Cell &cell, const Array3 &spacing) const;
+
+    };
+
+}
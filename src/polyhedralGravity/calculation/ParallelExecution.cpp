@@ -0,0 +1,19 @@
+#include "ParallelExecution.h"
+
+namespace polyhedralGravity {
+
+    size_t ParallelExecution::resolveThreadCount() {
+        const size_t threadCount = EvaluationSettings::getThreadCount();
+        return threadCount == 0 ? WorkStealingScheduler::defaultThreadCount() : threadCount;
+    }
+
+    size_t ParallelExecution::resolveGrainSize(size_t count) {
+        const size_t grainSize = EvaluationSettings::getGrainSize();
+        if (grainSize != 0) {
+            return grainSize;
+        }
+        const size_t taskCount = 4 * resolveThreadCount();
+        return std::max<size_t>((count + taskCount - 1) / taskCount, 1);
+    }
+
+}
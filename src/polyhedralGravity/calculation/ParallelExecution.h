@@ -0,0 +1,171 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/WorkStealingScheduler.h"
+#include "thrust/for_each.h"
+#include "thrust/transform_reduce.h"
+#include "thrust/execution_policy.h"
+#include "thrust/iterator/counting_iterator.h"
+
+#ifdef POLYHEDRAL_GRAVITY_RUNTIME_OMP
+#include <omp.h>
+#endif
+
+#ifdef POLYHEDRAL_GRAVITY_RUNTIME_TBB
+#include <tbb/task_arena.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
+namespace polyhedralGravity {
+
+    /**
+     * The parallel loops of the kernels, dispatched at runtime to the ParallelBackend of the EvaluationSettings.
+     * Apart from DEFAULT, which hands the loop to thrust, the iterations are cut into tasks of the grain size which
+     * are distributed over the given number of threads. This allows to tune the parallelization per job without
+     * rebuilding, e.g. if one binary is deployed to heterogeneous nodes.
+     */
+    namespace ParallelExecution {
+
+        /**
+         * Returns the number of threads of the current EvaluationSettings.
+         * @return the thread count, the number of hardware threads if the setting is zero
+         */
+        size_t resolveThreadCount();
+
+        /**
+         * Returns the number of iterations per task of the current EvaluationSettings for a loop.
+         * @param count - the number of iterations of the loop
+         * @return the grain size, about four tasks per thread if the setting is zero, at least one
+         */
+        size_t resolveGrainSize(size_t count);
+
+        /**
+         * Calls a function for every index in [0, count) with the current ParallelBackend.
+         * @tparam Function - callable with a size_t
+         * @param count - the number of iterations
+         * @param function - the body of the loop, called once per index
+         * @param grainSize - the number of iterations per task, zero uses resolveGrainSize(..)
+         * @throws std::runtime_error if the backend is not compiled into this build
+         */
+        template<typename Function>
+        void forEach(size_t count, const Function &function, size_t grainSize = 0) {
+            const ParallelBackend backend = EvaluationSettings::getParallelBackend();
+            if (count == 0) {
+                return;
+            }
+            if (backend == ParallelBackend::DEFAULT) {
+                thrust::for_each(thrust::device, thrust::counting_iterator<size_t>(0),
+                                 thrust::counting_iterator<size_t>(count), function);
+                return;
+            }
+            if (backend == ParallelBackend::SERIAL) {
+                for (size_t i = 0; i < count; ++i) {
+                    function(i);
+                }
+                return;
+            }
+            grainSize = grainSize == 0 ? resolveGrainSize(count) : grainSize;
+            const size_t taskCount = (count + grainSize - 1) / grainSize;
+            if (backend == ParallelBackend::THREADS) {
+                WorkStealingScheduler::run(std::vector<double>(taskCount, 1.0), [&](size_t task) {
+                    const size_t end = std::min(count, (task + 1) * grainSize);
+                    for (size_t i = task * grainSize; i < end; ++i) {
+                        function(i);
+                    }
+                }, resolveThreadCount());
+                return;
+            }
+#ifdef POLYHEDRAL_GRAVITY_RUNTIME_OMP
+            if (backend == ParallelBackend::OPENMP) {
+                //Exceptions must not leave the parallel region, the first one is rethrown afterwards
+                std::exception_ptr exception{};
+                std::mutex exceptionMutex{};
+                const auto signedCount = static_cast<long long>(count);
+                const auto chunkSize = static_cast<int>(grainSize);
+                const auto threadCount = static_cast<int>(resolveThreadCount());
+#pragma omp parallel for schedule(dynamic, chunkSize) num_threads(threadCount)
+                for (long long i = 0; i < signedCount; ++i) {
+                    try {
+                        function(static_cast<size_t>(i));
+                    } catch (...) {
+                        std::lock_guard lock{exceptionMutex};
+                        if (!exception) {
+                            exception = std::current_exception();
+                        }
+                    }
+                }
+                if (exception) {
+                    std::rethrow_exception(exception);
+                }
+                return;
+            }
+#endif
+#ifdef POLYHEDRAL_GRAVITY_RUNTIME_TBB
+            if (backend == ParallelBackend::TBB) {
+                tbb::task_arena arena{static_cast<int>(resolveThreadCount())};
+                arena.execute([&]() {
+                    tbb::parallel_for(tbb::blocked_range<size_t>(0, count, grainSize),
+                                      [&function](const tbb::blocked_range<size_t> &range) {
+                                          for (size_t i = range.begin(); i < range.end(); ++i) {
+                                              function(i);
+                                          }
+                                      }, tbb::simple_partitioner{});
+                });
+                return;
+            }
+#endif
+            throw std::runtime_error{"The parallel backend " + EvaluationSettings::toString(backend) +
+                                     " is not available in this build!"};
+        }
+
+        /**
+         * Transforms every index in [0, count) and reduces the results with the current ParallelBackend.
+         * Apart from DEFAULT, every task reduces its consecutive indices in order and the partial results of the
+         * tasks are reduced in order afterwards, so the association order only depends on the grain size.
+         * @tparam T - the type of the result
+         * @tparam Transform - callable with a size_t returning a T
+         * @tparam Reduce - associative callable with two T returning a T
+         * @param count - the number of iterations
+         * @param transform - the transformation of an index
+         * @param init - the initial value of the reduction
+         * @param reduce - the binary reduction
+         * @return the reduced value
+         * @throws std::runtime_error if the backend is not compiled into this build
+         */
+        template<typename T, typename Transform, typename Reduce>
+        T transformReduce(size_t count, const Transform &transform, T init, const Reduce &reduce) {
+            if (EvaluationSettings::getParallelBackend() == ParallelBackend::DEFAULT) {
+                return thrust::transform_reduce(thrust::device, thrust::counting_iterator<size_t>(0),
+                                                thrust::counting_iterator<size_t>(count), transform, init, reduce);
+            }
+            if (count == 0) {
+                return init;
+            }
+            const size_t grainSize = resolveGrainSize(count);
+            const size_t taskCount = (count + grainSize - 1) / grainSize;
+            std::vector<T> partialResults(taskCount);
+            //Every task is already one grain
+            forEach(taskCount, [&](size_t task) {
+                const size_t end = std::min(count, (task + 1) * grainSize);
+                T partialResult = transform(task * grainSize);
+                for (size_t i = task * grainSize + 1; i < end; ++i) {
+                    partialResult = reduce(partialResult, transform(i));
+                }
+                partialResults[task] = partialResult;
+            }, 1);
+            for (const T &partialResult: partialResults) {
+                init = reduce(init, partialResult);
+            }
+            return init;
+        }
+
+    }
+
+}
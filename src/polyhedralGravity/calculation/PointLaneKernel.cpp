@@ -0,0 +1,63 @@
+#include "PointLaneKernel.h"
+
+namespace polyhedralGravity {
+
+    std::vector<GravityModelResult> PointLaneKernel::evaluateGeometricSums(
+            const Polyhedron &polyhedron, const std::vector<Array3> &computationPoints) {
+        //The vertices and point-independent ingredients of every face
+        std::vector<Array3Triplet> faces{polyhedron.countFaces()};
+        std::vector<PreparedFace> preparedFaces{polyhedron.countFaces()};
+        for (size_t face = 0; face < polyhedron.countFaces(); ++face) {
+            const std::array<size_t, 3> &indices = polyhedron.getFaces()[face];
+            faces[face] = {polyhedron.getVertex(indices[0]), polyhedron.getVertex(indices[1]),
+                           polyhedron.getVertex(indices[2])};
+            preparedFaces[face] = GravityModel::detail::prepareFace(faces[face]);
+        }
+
+        std::vector<GravityModelResult> result{computationPoints.size()};
+        EvaluationSettings::dispatchSimdArchitecture([&](auto arch) {
+            using Arch = decltype(arch);
+            const size_t lanes = detail::countLanes<Arch>();
+            SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                                "Point-lane evaluation of {} faces for {} computation points with {} lanes ({})",
+                                polyhedron.countFaces(), computationPoints.size(), lanes,
+                                EvaluationSettings::toString(EvaluationSettings::getSimdArchitecture()));
+            const size_t batchCount = (computationPoints.size() + lanes - 1) / lanes;
+            ParallelExecution::forEach(batchCount, [&](size_t batch) {
+                detail::evaluateBatch<Arch>(faces, preparedFaces, computationPoints, batch * lanes, result);
+            });
+        });
+        return result;
+    }
+
+    std::vector<GravityModelResult> PointLaneKernel::evaluate(
+            const Polyhedron &polyhedron, double density, const std::vector<Array3> &computationPoints) {
+        std::vector<GravityModelResult> result = evaluateGeometricSums(polyhedron, computationPoints);
+        std::transform(result.begin(), result.end(), result.begin(), [density](const GravityModelResult &sums) {
+            return GravityModel::detail::applyDensityPrefix(sums, density);
+        });
+        return result;
+    }
+
+    GravityModelResult PointLaneKernel::detail::evaluateScalarLane(const Array3Triplet &face,
+                                                                   const Array3 &computationPoint) {
+        using namespace util;
+        return GravityModel::detail::evaluateFace(
+                {face[0] - computationPoint, face[1] - computationPoint, face[2] - computationPoint});
+    }
+
+    GravityModelResult PointLaneKernel::detail::combineLane(const GravityModelResult &scalarSum,
+                                                            const std::array<double, 10> &laneSum) {
+        GravityModelResult result = scalarSum;
+        result.gravitationalPotential += laneSum[0];
+        for (size_t i = 0; i < 3; ++i) {
+            result.acceleration[i] += laneSum[1 + i];
+        }
+        for (size_t i = 0; i < 6; ++i) {
+            result.gradiometricTensor[i] += laneSum[4 + i];
+        }
+        result.eliminateRoundingErrors();
+        return result;
+    }
+
+}
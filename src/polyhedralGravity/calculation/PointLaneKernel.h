@@ -0,0 +1,408 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/util/UtilityConstants.h"
+#include "polyhedralGravity/util/UtilityContainer.h"
+#include "polyhedralGravity/output/Logging.h"
+#include "polyhedralGravity/calculation/ParallelExecution.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "xsimd/xsimd.hpp"
+
+namespace polyhedralGravity {
+
+    /**
+     * Evaluation of the polyhedral gravity model with the SIMD lanes mapped to computation points.
+     * The faces are processed one after another, each one for a batch of as many points as one SIMD register holds
+     * (e.g. 4 with AVX2, 8 with AVX-512). This suits small meshes with a few dozen faces evaluated at many points,
+     * for which a vectorization over the faces would leave most lanes empty. The instruction set is chosen at
+     * runtime by the SimdArchitecture of the EvaluationSettings.
+     * The vectorized computation covers the regular configurations, including P' inside the face. Lanes in which P'
+     * lies on the line of a segment or P lies on a segment's line are evaluated by the scalar
+     * GravityModel::detail::evaluateFace(..), since they require the special cases of the singularity handling.
+     *
+     * @note The lanes always use the accurate transcendental functions and evaluate every face exactly, i.e. they
+     * ignore MathBackend::FAST and the far-field accuracy. KernelVariant::AUTO therefore does not choose this kernel
+     * if one of them is set (see GravityModel::detail::requiresScalarFaces()).
+     */
+    namespace PointLaneKernel {
+
+        /**
+         * KernelVariant::AUTO chooses this kernel for polyhedrons with at most this number of faces...
+         */
+        constexpr size_t AUTO_MAX_FACES = 1024;
+
+        /**
+         * ...and at least this number of computation points
+         */
+        constexpr size_t AUTO_MIN_POINTS = 64;
+
+        /**
+         * Evaluates the geometric sums (i.e. the results for a unit density before the application of the prefix
+         * GRAVITATIONAL_CONSTANT * density) for multiple computation points.
+         * Rounding errors are already eliminated from the returned sums.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @param computationPoints - vector of computation points
+         * @return the density-independent sums foreach computation Point P
+         */
+        std::vector<GravityModelResult> evaluateGeometricSums(
+                const Polyhedron &polyhedron,
+                const std::vector<Array3> &computationPoints);
+
+        /**
+         * Evaluates the polyhedral gravity model for a given constant density polyhedron at multiple computation
+         * points with the point-lane kernel.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoints - vector of computation points
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * foreach computation Point P
+         */
+        std::vector<GravityModelResult> evaluate(
+                const Polyhedron &polyhedron,
+                double density,
+                const std::vector<Array3> &computationPoints);
+
+        namespace detail {
+
+            /**
+             * A SIMD register of doubles, one lane per computation point
+             * @tparam Arch - the xsimd architecture
+             */
+            template<class Arch>
+            using Batch = xsimd::batch<double, Arch>;
+
+            /**
+             * A mask with one boolean per lane
+             * @tparam Arch - the xsimd architecture
+             */
+            template<class Arch>
+            using BatchMask = xsimd::batch_bool<double, Arch>;
+
+            /**
+             * Three SIMD registers, i.e. one 3D vector per lane
+             * @tparam Arch - the xsimd architecture
+             */
+            template<class Arch>
+            using BatchArray3 = std::array<Batch<Arch>, 3>;
+
+            /**
+             * The geometric sums for one batch of computation points.
+             * @tparam Arch - the xsimd architecture
+             */
+            template<class Arch>
+            struct LaneResult {
+                /**
+                 * The sum of the potential
+                 */
+                Batch<Arch> potential = Batch<Arch>(0.0);
+                /**
+                 * The sums of the acceleration's components
+                 */
+                BatchArray3<Arch> acceleration{Batch<Arch>(0.0), Batch<Arch>(0.0), Batch<Arch>(0.0)};
+                /**
+                 * The sums of the gradiometric tensor's components in the order xx, yy, zz, xy, xz, yz
+                 */
+                std::array<Batch<Arch>, 6> gradiometricTensor{Batch<Arch>(0.0), Batch<Arch>(0.0), Batch<Arch>(0.0),
+                                                              Batch<Arch>(0.0), Batch<Arch>(0.0), Batch<Arch>(0.0)};
+            };
+
+            /**
+             * Returns the number of computation points evaluated at once with an architecture.
+             * @tparam Arch - the xsimd architecture
+             * @return the number of lanes
+             */
+            template<class Arch>
+            size_t countLanes();
+
+            /**
+             * Evaluates the geometric sums of one batch of computation points, i.e. countLanes<Arch>() points
+             * starting at the given index (fewer at the end of the vector).
+             * @tparam Arch - the xsimd architecture
+             * @param faces - the (not shifted) vertices of every plane
+             * @param preparedFaces - the point-independent ingredients of every plane
+             * @param computationPoints - all computation points
+             * @param pointBegin - the index of the first point of the batch
+             * @param result - the geometric sums of all points, the ones of the batch are written
+             */
+            template<class Arch>
+            void evaluateBatch(const std::vector<Array3Triplet> &faces, const std::vector<PreparedFace> &preparedFaces,
+                               const std::vector<Array3> &computationPoints, size_t pointBegin,
+                               std::vector<GravityModelResult> &result);
+
+            /**
+             * Adds the contribution of one face to the geometric sums of one batch of computation points.
+             * @tparam Arch - the xsimd architecture
+             * @param face - the (not shifted) vertices of plane p
+             * @param preparedFace - the point-independent ingredients of plane p
+             * @param computationPoints - the computation points, one per lane
+             * @param result - the geometric sums to which the contributions are added
+             * @return a mask of the lanes whose contribution was not added since they require the scalar
+             * evaluation of the singular cases
+             */
+            template<class Arch>
+            BatchMask<Arch> accumulateFace(const Array3Triplet &face, const PreparedFace &preparedFace,
+                                           const BatchArray3<Arch> &computationPoints, LaneResult<Arch> &result);
+
+            /**
+             * Evaluates the contribution of one face at one computation point with the scalar
+             * GravityModel::detail::evaluateFace(..). It is compiled for the generic architecture only, so that
+             * the shared inline functions of the scalar path are never emitted with a wider instruction set.
+             * @param face - the (not shifted) vertices of plane p
+             * @param computationPoint - the computation point P
+             * @return the contribution of the face
+             */
+            GravityModelResult evaluateScalarLane(const Array3Triplet &face, const Array3 &computationPoint);
+
+            /**
+             * Adds the vectorized sums of one lane to its scalar sums and eliminates the rounding errors, compiled
+             * for the generic architecture only like evaluateScalarLane(..).
+             * @param scalarSum - the sums of the faces evaluated as scalars
+             * @param laneSum - the vectorized sums in the order potential, acceleration, gradiometric tensor
+             * @return the geometric sums of the computation point
+             */
+            GravityModelResult combineLane(const GravityModelResult &scalarSum, const std::array<double, 10> &laneSum);
+
+            /**
+             * The dot product of a vector per lane and a constant vector.
+             * @tparam Arch - the xsimd architecture
+             * @param a - one vector per lane
+             * @param b - the constant vector
+             * @return the dot product per lane
+             */
+            template<class Arch>
+            inline Batch<Arch> dot(const BatchArray3<Arch> &a, const Array3 &b) {
+                return a[0] * Batch<Arch>(b[0]) + a[1] * Batch<Arch>(b[1]) + a[2] * Batch<Arch>(b[2]);
+            }
+
+            /**
+             * The euclidean norm of a vector per lane.
+             * @tparam Arch - the xsimd architecture
+             * @param a - one vector per lane
+             * @return the norm per lane
+             */
+            template<class Arch>
+            inline Batch<Arch> euclideanNorm(const BatchArray3<Arch> &a) {
+                return xsimd::sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+            }
+
+            /**
+             * The difference of two vectors per lane.
+             * @tparam Arch - the xsimd architecture
+             * @param a - minuend per lane
+             * @param b - subtrahend per lane
+             * @return the difference per lane
+             */
+            template<class Arch>
+            inline BatchArray3<Arch> subtract(const BatchArray3<Arch> &a, const BatchArray3<Arch> &b) {
+                return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+            }
+
+            /**
+             * The sign function with a cutoff like util::sgn(..), applied per lane.
+             * @tparam Arch - the xsimd architecture
+             * @param value - the value per lane
+             * @param cutoffEpsilon - the cutoff
+             * @return -1, 0 or 1 per lane
+             */
+            template<class Arch>
+            inline Batch<Arch> sgn(const Batch<Arch> &value, double cutoffEpsilon) {
+                return xsimd::select(value < Batch<Arch>(-cutoffEpsilon), Batch<Arch>(-1.0),
+                                     xsimd::select(value > Batch<Arch>(cutoffEpsilon), Batch<Arch>(1.0),
+                                                   Batch<Arch>(0.0)));
+            }
+
+            template<class Arch>
+            size_t countLanes() {
+                return Batch<Arch>::size;
+            }
+
+            template<class Arch>
+            void evaluateBatch(const std::vector<Array3Triplet> &faces, const std::vector<PreparedFace> &preparedFaces,
+                               const std::vector<Array3> &computationPoints, size_t pointBegin,
+                               std::vector<GravityModelResult> &result) {
+                constexpr size_t LANES = Batch<Arch>::size;
+                const size_t pointCount = computationPoints.size();
+                //Load the points of this batch, the last batch is filled up with its last point
+                std::array<std::array<double, LANES>, 3> coordinates{};
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    const Array3 &point = computationPoints[std::min(pointBegin + lane, pointCount - 1)];
+                    for (size_t i = 0; i < 3; ++i) {
+                        coordinates[i][lane] = point[i];
+                    }
+                }
+                const BatchArray3<Arch> points{Batch<Arch>::load_unaligned(coordinates[0].data()),
+                                               Batch<Arch>::load_unaligned(coordinates[1].data()),
+                                               Batch<Arch>::load_unaligned(coordinates[2].data())};
+
+                //The sums of the vectorized lanes and of the lanes evaluated as scalars
+                LaneResult<Arch> laneSums{};
+                std::array<GravityModelResult, LANES> scalarSums{};
+                for (size_t face = 0; face < faces.size(); ++face) {
+                    const BatchMask<Arch> scalarLanes =
+                            accumulateFace<Arch>(faces[face], preparedFaces[face], points, laneSums);
+                    if (xsimd::any(scalarLanes)) {
+                        std::array<double, LANES> isScalarLane{};
+                        xsimd::select(scalarLanes, Batch<Arch>(1.0), Batch<Arch>(0.0))
+                                .store_unaligned(isScalarLane.data());
+                        for (size_t lane = 0; lane < LANES; ++lane) {
+                            if (isScalarLane[lane] != 0.0) {
+                                scalarSums[lane] = GravityModel::detail::sumResults(
+                                        scalarSums[lane], evaluateScalarLane(
+                                                faces[face], {coordinates[0][lane], coordinates[1][lane],
+                                                              coordinates[2][lane]}));
+                            }
+                        }
+                    }
+                }
+
+                //Combine both sums per lane
+                std::array<std::array<double, LANES>, 10> lanes{};
+                laneSums.potential.store_unaligned(lanes[0].data());
+                for (size_t i = 0; i < 3; ++i) {
+                    laneSums.acceleration[i].store_unaligned(lanes[1 + i].data());
+                }
+                for (size_t i = 0; i < 6; ++i) {
+                    laneSums.gradiometricTensor[i].store_unaligned(lanes[4 + i].data());
+                }
+                for (size_t lane = 0; lane < LANES && pointBegin + lane < pointCount; ++lane) {
+                    std::array<double, 10> laneSum{};
+                    for (size_t i = 0; i < laneSum.size(); ++i) {
+                        laneSum[i] = lanes[i][lane];
+                    }
+                    result[pointBegin + lane] = combineLane(scalarSums[lane], laneSum);
+                }
+            }
+
+            template<class Arch>
+            BatchMask<Arch> accumulateFace(const Array3Triplet &face, const PreparedFace &preparedFace,
+                                           const BatchArray3<Arch> &computationPoints, LaneResult<Arch> &result) {
+                using util::EPSILON;
+                using BatchType = Batch<Arch>;
+                const Array3 &planeUnitNormal = preparedFace.planeUnitNormal;
+                const BatchType zero(0.0);
+                //The vertices of plane p shifted by -P
+                std::array<BatchArray3<Arch>, 3> vertices{};
+                for (size_t j = 0; j < 3; ++j) {
+                    for (size_t i = 0; i < 3; ++i) {
+                        vertices[j][i] = BatchType(face[j][i]) - computationPoints[i];
+                    }
+                }
+                //1-04 Step: Plane Normal Orientation sigma_p from the signed distance N_p * v0 of the plane
+                const BatchType signedPlaneDistance = dot<Arch>(vertices[0], planeUnitNormal);
+                const BatchType planeNormalOrientation = sgn<Arch>(signedPlaneDistance, EPSILON);
+                //1-06 and 1-07 Step: The plane distance h_p and the projection P' = N_p * (N_p * v0)
+                const BatchType planeDistance = xsimd::abs(signedPlaneDistance);
+                const BatchArray3<Arch> projectionOnPlane{BatchType(planeUnitNormal[0]) * signedPlaneDistance,
+                                                          BatchType(planeUnitNormal[1]) * signedPlaneDistance,
+                                                          BatchType(planeUnitNormal[2]) * signedPlaneDistance};
+
+                BatchMask<Arch> scalarLanes(false);
+                BatchMask<Arch> insidePlane(true);
+                BatchType sum1PotentialAcceleration(0.0);
+                BatchArray3<Arch> sum1Tensor{zero, zero, zero};
+                BatchType sum2(0.0);
+                for (size_t q = 0; q < 3; ++q) {
+                    const BatchArray3<Arch> &vertex1 = vertices[q];
+                    const BatchArray3<Arch> &vertex2 = vertices[(q + 1) % 3];
+                    const Array3 &segmentVector = preparedFace.segmentVectors[q];
+                    const Array3 &segmentUnitNormal = preparedFace.segmentUnitNormals[q];
+                    //1-08 Step: Segment Normal Orientation sigma_pq, P' on the segment's line requires the scalar
+                    // evaluation
+                    const BatchArray3<Arch> vertexToProjection = subtract<Arch>(projectionOnPlane, vertex1);
+                    const BatchType segmentNormalOrientation =
+                            sgn<Arch>(dot<Arch>(vertexToProjection, segmentUnitNormal), EPSILON) * BatchType(-1.0);
+                    scalarLanes = scalarLanes | (segmentNormalOrientation == zero);
+                    insidePlane = insidePlane & (segmentNormalOrientation == BatchType(1.0));
+                    //1-09 Step: The projection P'' of P' onto the segment's line
+                    const double segmentSquaredNorm = segmentVector[0] * segmentVector[0] +
+                                                      segmentVector[1] * segmentVector[1] +
+                                                      segmentVector[2] * segmentVector[2];
+                    const BatchType t = dot<Arch>(vertexToProjection, segmentVector) / BatchType(segmentSquaredNorm);
+                    const BatchArray3<Arch> projectionOnSegment{vertex1[0] + BatchType(segmentVector[0]) * t,
+                                                                vertex1[1] + BatchType(segmentVector[1]) * t,
+                                                                vertex1[2] + BatchType(segmentVector[2]) * t};
+                    //1-10 Step: The segment distance h_pq
+                    const BatchType segmentDistance =
+                            euclideanNorm<Arch>(subtract<Arch>(projectionOnSegment, projectionOnPlane));
+                    //1-11 Step: The 3D distances l1, l2 and 1D distances s1, s2
+                    const BatchType l1 = euclideanNorm<Arch>(vertex1);
+                    const BatchType l2 = euclideanNorm<Arch>(vertex2);
+                    BatchType s1 = euclideanNorm<Arch>(subtract<Arch>(projectionOnSegment, vertex1));
+                    BatchType s2 = euclideanNorm<Arch>(subtract<Arch>(projectionOnSegment, vertex2));
+                    //P located on the segment's line (4. Option) requires the scalar evaluation
+                    scalarLanes = scalarLanes | ((xsimd::abs(s1 - l1) < BatchType(EPSILON)) &
+                                                 (xsimd::abs(s2 - l2) < BatchType(EPSILON)));
+                    //1. Option: P'' inside the segment, 2. Option: P'' on the right side, 3. Option: on the left side
+                    const BatchType segmentNorm(std::sqrt(segmentSquaredNorm));
+                    const BatchMask<Arch> insideSegment = (s1 < segmentNorm) & (s2 < segmentNorm);
+                    const BatchMask<Arch> rightSide = (!insideSegment) & (s2 < s1);
+                    s1 = xsimd::select(insideSegment | rightSide, -s1, s1);
+                    s2 = xsimd::select(rightSide, -s2, s2);
+                    //1-13 Step: The transcendental expressions LN_pq and AN_pq
+                    const BatchType ln = xsimd::select(
+                            (xsimd::abs(s1 + s2) < BatchType(EPSILON)) & (xsimd::abs(l1 + l2) < BatchType(EPSILON)),
+                            zero, xsimd::log((s2 + l2) / (s1 + l1)));
+                    const BatchType an = xsimd::select(
+                            (planeDistance < BatchType(EPSILON)) | (segmentDistance < BatchType(EPSILON)),
+                            zero, xsimd::atan(planeDistance * s2 / (segmentDistance * l2)) -
+                                  xsimd::atan(planeDistance * s1 / (segmentDistance * l1)));
+                    //2. to 4. Step: The sums over the segments
+                    sum1PotentialAcceleration += segmentNormalOrientation * segmentDistance * ln;
+                    for (size_t i = 0; i < 3; ++i) {
+                        sum1Tensor[i] += BatchType(segmentUnitNormal[i]) * ln;
+                    }
+                    sum2 += segmentNormalOrientation * an;
+                }
+                //1-14 Step: The singularities, only the case of P' inside the plane remains for the vectorized lanes
+                const BatchType singularityFactor = xsimd::select(insidePlane, BatchType(-1.0 * util::PI2), zero);
+
+                //5. and 6. Step: Sum for potential and acceleration and sum for tensor
+                const BatchType planeSumPotentialAcceleration =
+                        sum1PotentialAcceleration + planeDistance * sum2 + singularityFactor * planeDistance;
+                BatchArray3<Arch> subSum{};
+                for (size_t i = 0; i < 3; ++i) {
+                    subSum[i] = sum1Tensor[i] + BatchType(planeUnitNormal[i]) * (planeNormalOrientation * sum2) +
+                                BatchType(planeUnitNormal[i]) * (singularityFactor * planeNormalOrientation);
+                }
+
+                //7. Step: Multiply with prefix and accumulate the vectorized lanes
+                const auto add = [&scalarLanes, &zero](BatchType &sum, const BatchType &contribution) {
+                    sum += xsimd::select(scalarLanes, zero, contribution);
+                };
+                add(result.potential, planeNormalOrientation * planeDistance * planeSumPotentialAcceleration);
+                for (size_t i = 0; i < 3; ++i) {
+                    add(result.acceleration[i], BatchType(planeUnitNormal[i]) * planeSumPotentialAcceleration);
+                    add(result.gradiometricTensor[i], BatchType(planeUnitNormal[i]) * subSum[i]);
+                }
+                add(result.gradiometricTensor[3], BatchType(planeUnitNormal[0]) * subSum[1]);
+                add(result.gradiometricTensor[4], BatchType(planeUnitNormal[0]) * subSum[2]);
+                add(result.gradiometricTensor[5], BatchType(planeUnitNormal[1]) * subSum[2]);
+                return scalarLanes;
+            }
+
+#ifdef POLYHEDRAL_GRAVITY_SIMD_DISPATCH
+            //Instantiated in the translation units of simd/ which are compiled with the instruction set
+            extern template size_t countLanes<xsimd::sse4_2>();
+            extern template size_t countLanes<xsimd::fma3<xsimd::avx2>>();
+            extern template size_t countLanes<xsimd::avx512f>();
+            extern template void evaluateBatch<xsimd::sse4_2>(
+                    const std::vector<Array3Triplet> &, const std::vector<PreparedFace> &,
+                    const std::vector<Array3> &, size_t, std::vector<GravityModelResult> &);
+            extern template void evaluateBatch<xsimd::fma3<xsimd::avx2>>(
+                    const std::vector<Array3Triplet> &, const std::vector<PreparedFace> &,
+                    const std::vector<Array3> &, size_t, std::vector<GravityModelResult> &);
+            extern template void evaluateBatch<xsimd::avx512f>(
+                    const std::vector<Array3Triplet> &, const std::vector<PreparedFace> &,
+                    const std::vector<Array3> &, size_t, std::vector<GravityModelResult> &);
+#endif
+
+        }
+
+    }
+
+}
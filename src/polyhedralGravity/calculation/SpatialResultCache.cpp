@@ -0,0 +1,169 @@
+#include "SpatialResultCache.h"
+
+namespace polyhedralGravity {
+
+    SpatialResultCache::SpatialResultCache(const Polyhedron &polyhedron, double density, size_t capacity,
+                                           double tolerance)
+            : _polyhedron{polyhedron},
+              _density{density},
+              _shardCount{std::clamp<size_t>(capacity, 1, SHARD_COUNT)},
+              _tolerance{tolerance},
+              _shards{},
+              _hits{0},
+              _misses{0} {
+        if (capacity == 0) {
+            throw std::invalid_argument{"The capacity of the SpatialResultCache must be greater than zero!"};
+        }
+        if (tolerance < 0.0 || !std::isfinite(tolerance)) {
+            throw std::invalid_argument{"The tolerance of the SpatialResultCache must be finite and not negative!"};
+        }
+        //The capacities of the used shards sum up to the total capacity
+        for (size_t shard = 0; shard < _shardCount; ++shard) {
+            _shards[shard].capacity = capacity / _shardCount + (shard < capacity % _shardCount ? 1 : 0);
+        }
+    }
+
+    GravityModelResult SpatialResultCache::evaluate(const Array3 &computationPoint) {
+        GravityModelResult result{};
+        if (!lookup(computationPoint, result)) {
+            result = GravityModel::evaluate(_polyhedron, _density, computationPoint);
+            insert(computationPoint, result);
+        }
+        return result;
+    }
+
+    std::vector<GravityModelResult> SpatialResultCache::evaluate(const std::vector<Array3> &computationPoints) {
+        std::vector<GravityModelResult> result{computationPoints.size()};
+        std::vector<size_t> missingIndices{};
+        std::vector<Array3> missingPoints{};
+        for (size_t index = 0; index < computationPoints.size(); ++index) {
+            if (!lookup(computationPoints[index], result[index])) {
+                missingIndices.push_back(index);
+                missingPoints.push_back(computationPoints[index]);
+            }
+        }
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Spatial result cache: {} of {} computation points need to be evaluated",
+                            missingPoints.size(), computationPoints.size());
+        if (missingPoints.empty()) {
+            return result;
+        }
+        const auto missingResults = GravityModel::evaluate(_polyhedron, _density, missingPoints);
+        for (size_t i = 0; i < missingIndices.size(); ++i) {
+            result[missingIndices[i]] = missingResults[i];
+            insert(missingPoints[i], missingResults[i]);
+        }
+        return result;
+    }
+
+    void SpatialResultCache::clear() {
+        for (Shard &shard: _shards) {
+            std::lock_guard lock{shard.mutex};
+            shard.index.clear();
+            shard.lru.clear();
+        }
+        _hits = 0;
+        _misses = 0;
+    }
+
+    size_t SpatialResultCache::size() {
+        size_t size = 0;
+        for (Shard &shard: _shards) {
+            std::lock_guard lock{shard.mutex};
+            size += shard.lru.size();
+        }
+        return size;
+    }
+
+    SpatialResultCache::CellKey SpatialResultCache::quantize(const Array3 &computationPoint) const {
+        CellKey cell{};
+        for (size_t i = 0; i < 3; ++i) {
+            if (!std::isfinite(computationPoint[i])) {
+                throw std::invalid_argument{"The SpatialResultCache only accepts finite computation points!"};
+            }
+            if (_tolerance == 0.0) {
+                //Adding 0.0 maps -0.0 to 0.0, both lead to the same result of the gravity model
+                const double coordinate = computationPoint[i] + 0.0;
+                std::memcpy(&cell[i], &coordinate, sizeof(double));
+            } else {
+                //Clamped before the conversion, which is undefined for values out of the range of the integer
+                const double scaled = std::floor(computationPoint[i] / _tolerance);
+                cell[i] = static_cast<std::int64_t>(std::clamp(scaled, -static_cast<double>(MAX_CELL),
+                                                               static_cast<double>(MAX_CELL)));
+            }
+        }
+        return cell;
+    }
+
+    SpatialResultCache::Shard &SpatialResultCache::shardOf(const CellKey &cell) {
+        return _shards[CellKeyHash{}(cell) % _shardCount];
+    }
+
+    bool SpatialResultCache::lookup(const Array3 &computationPoint, GravityModelResult &result) {
+        using namespace util;
+        const CellKey cell = quantize(computationPoint);
+        bool found = false;
+        if (_tolerance == 0.0) {
+            Shard &shard = shardOf(cell);
+            std::lock_guard lock{shard.mutex};
+            const auto it = shard.index.find(cell);
+            if (it != shard.index.end()) {
+                shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+                result = it->second->result;
+                found = true;
+            }
+        } else {
+            //The radius equals the cell's edge length, so every candidate lies in one of the 27 neighboring cells
+            double closestDistance = std::numeric_limits<double>::infinity();
+            for (std::int64_t dx = -1; dx <= 1; ++dx) {
+                for (std::int64_t dy = -1; dy <= 1; ++dy) {
+                    for (std::int64_t dz = -1; dz <= 1; ++dz) {
+                        const CellKey neighbor{cell[0] + dx, cell[1] + dy, cell[2] + dz};
+                        Shard &shard = shardOf(neighbor);
+                        std::lock_guard lock{shard.mutex};
+                        const auto range = shard.index.equal_range(neighbor);
+                        for (auto it = range.first; it != range.second; ++it) {
+                            const double distance = euclideanNorm(it->second->computationPoint - computationPoint);
+                            if (distance <= _tolerance && distance < closestDistance) {
+                                closestDistance = distance;
+                                shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+                                result = it->second->result;
+                                found = true;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        if (found) {
+            ++_hits;
+        } else {
+            ++_misses;
+        }
+        return found;
+    }
+
+    void SpatialResultCache::insert(const Array3 &computationPoint, const GravityModelResult &result) {
+        const CellKey cell = quantize(computationPoint);
+        Shard &shard = shardOf(cell);
+        std::lock_guard lock{shard.mutex};
+        //In exact mode, another thread might have inserted the same point in the meantime
+        if (_tolerance == 0.0 && shard.index.find(cell) != shard.index.end()) {
+            return;
+        }
+        shard.lru.push_front(Entry{cell, computationPoint, result});
+        shard.index.emplace(cell, shard.lru.begin());
+        while (shard.lru.size() > shard.capacity) {
+            const auto &leastRecentlyUsed = shard.lru.back();
+            const auto range = shard.index.equal_range(leastRecentlyUsed.cell);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == std::prev(shard.lru.end())) {
+                    shard.index.erase(it);
+                    break;
+                }
+            }
+            shard.lru.pop_back();
+        }
+    }
+
+}
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <list>
+#include <atomic>
+#include <mutex>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/util/UtilityContainer.h"
+#include "polyhedralGravity/output/Logging.h"
+
+namespace polyhedralGravity {
+
+    /**
+     * A concurrent result cache in front of GravityModel::evaluate(..) for one polyhedron with constant density.
+     * Computation points are quantized to a key, the cache holds at most its capacity of results and counts its hits
+     * and misses. The entries are split over independently locked shards, each evicting its least-recently-used (LRU)
+     * entry when full, i.e. the eviction approximates a global LRU policy.
+     *
+     * The cache has two modes:
+     * - exact (tolerance == 0): the key is the bit pattern of the coordinates, so a hit only occurs for identical
+     *   points and the returned results are bit-for-bit identical to GravityModel::evaluate(..)
+     * - tolerance (tolerance > 0): the key is the cell of a grid with edge length tolerance; a hit occurs if a cached
+     *   point lies within the radius tolerance around the queried point, the closest cached point is returned
+     *
+     * @note The polyhedron is referenced, not copied! It must outlive the cache.
+     * @example Simulators querying identical or near-identical points, e.g. particles at rest on the surface
+     */
+    class SpatialResultCache {
+
+        /**
+         * The quantized coordinates of a computation point
+         */
+        using CellKey = std::array<std::int64_t, 3>;
+
+        /**
+         * Hash function for the CellKey
+         */
+        struct CellKeyHash {
+
+            size_t operator()(const CellKey &key) const {
+                size_t seed = 0;
+                for (const std::int64_t value: key) {
+                    seed ^= std::hash<std::int64_t>{}(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+                }
+                return seed;
+            }
+
+        };
+
+        /**
+         * One entry of the cache, the point is stored to check the distance in tolerance mode
+         */
+        struct Entry {
+
+            /**
+             * The quantized key of the point
+             */
+            CellKey cell;
+
+            /**
+             * The computation point P
+             */
+            Array3 computationPoint;
+
+            /**
+             * The result of the gravity model at P
+             */
+            GravityModelResult result;
+
+        };
+
+        /**
+         * The cache is split into independently locked shards to reduce contention between threads.
+         * Each shard has its own LRU list (front = most recently used) and an index into this list.
+         */
+        struct Shard {
+
+            /**
+             * Guards this shard
+             */
+            std::mutex mutex;
+
+            /**
+             * The entries ordered by their last usage
+             */
+            std::list<Entry> lru;
+
+            /**
+             * Maps the quantized points to the entries in the LRU list
+             */
+            std::unordered_multimap<CellKey, std::list<Entry>::iterator, CellKeyHash> index;
+
+            /**
+             * The maximal number of entries of this shard
+             */
+            size_t capacity{0};
+
+        };
+
+        /**
+         * The maximal number of shards
+         */
+        static constexpr size_t SHARD_COUNT = 16;
+
+        /**
+         * The largest magnitude of a cell coordinate in tolerance mode, so that the neighbors of a cell never overflow
+         */
+        static constexpr std::int64_t MAX_CELL = std::numeric_limits<std::int64_t>::max() / 2;
+
+        /**
+         * The polyhedron to evaluate
+         */
+        const Polyhedron &_polyhedron;
+
+        /**
+         * The constant density in [kg/m^3]
+         */
+        const double _density;
+
+        /**
+         * The number of used shards, at most the capacity so that every used shard holds at least one entry
+         */
+        const size_t _shardCount;
+
+        /**
+         * The lookup radius, zero means exact mode
+         */
+        const double _tolerance;
+
+        /**
+         * The shards of the cache
+         */
+        std::array<Shard, SHARD_COUNT> _shards;
+
+        /**
+         * Number of lookups which were answered from the cache
+         */
+        std::atomic<size_t> _hits;
+
+        /**
+         * Number of lookups which required an evaluation of the gravity model
+         */
+        std::atomic<size_t> _misses;
+
+    public:
+
+        /**
+         * Creates a new SpatialResultCache.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces (referenced, not copied)
+         * @param density - the constant density in [kg/m^3]
+         * @param capacity - the maximal number of cached results, split evenly over the shards (each with LRU eviction)
+         * @param tolerance - the lookup radius in [m], zero enables the exact mode (default)
+         * @throws std::invalid_argument if the capacity is zero or the tolerance is negative
+         */
+        SpatialResultCache(const Polyhedron &polyhedron, double density, size_t capacity, double tolerance = 0.0);
+
+        /**
+         * Evaluates the polyhedral gravity model at computation point P or returns the cached result.
+         * @param computationPoint - the computation Point P
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * at computation Point P
+         * @throws std::invalid_argument if a coordinate of P is not finite
+         */
+        GravityModelResult evaluate(const Array3 &computationPoint);
+
+        /**
+         * Evaluates the polyhedral gravity model at multiple computation points. Only the points which are not
+         * cached are evaluated (as one batch).
+         * @param computationPoints - vector of computation points
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * foreach computation Point P
+         * @throws std::invalid_argument if a coordinate of a computation point is not finite
+         */
+        std::vector<GravityModelResult> evaluate(const std::vector<Array3> &computationPoints);
+
+        /**
+         * Removes all entries from the cache and resets the statistics.
+         */
+        void clear();
+
+        /**
+         * Returns the number of cached entries.
+         * @return number of entries
+         */
+        [[nodiscard]] size_t size();
+
+        /**
+         * Returns the number of lookups answered from the cache.
+         * @return number of hits
+         */
+        [[nodiscard]] size_t hits() const {
+            return _hits.load();
+        }
+
+        /**
+         * Returns the number of lookups requiring an evaluation.
+         * @return number of misses
+         */
+        [[nodiscard]] size_t misses() const {
+            return _misses.load();
+        }
+
+        /**
+         * Returns the lookup radius, zero denotes the exact mode.
+         * @return tolerance in [m]
+         */
+        [[nodiscard]] double getTolerance() const {
+            return _tolerance;
+        }
+
+    private:
+
+        /**
+         * Quantizes a computation point. In exact mode, the bit pattern is used (with -0.0 mapped to 0.0), in
+         * tolerance mode the cell coordinates are clamped to MAX_CELL.
+         * @param computationPoint - the computation point P
+         * @return the CellKey
+         * @throws std::invalid_argument if a coordinate of P is not finite
+         */
+        [[nodiscard]] CellKey quantize(const Array3 &computationPoint) const;
+
+        /**
+         * Returns the shard responsible for a given cell.
+         * @param cell - the CellKey
+         * @return reference to the shard
+         */
+        Shard &shardOf(const CellKey &cell);
+
+        /**
+         * Searches the cache for a result of point P and marks it as most recently used.
+         * @param computationPoint - the computation point P
+         * @param result - output, set if found
+         * @return true if a cached result was found
+         */
+        bool lookup(const Array3 &computationPoint, GravityModelResult &result);
+
+        /**
+         * Inserts a result into the cache and evicts the least recently used entries if required.
+         * @param computationPoint - the computation point P
+         * @param result - the result at P
+         */
+        void insert(const Array3 &computationPoint, const GravityModelResult &result);
+
+    };
+
+}
@@ -0,0 +1,158 @@
+#include "TiledKernel.h"
+
+namespace polyhedralGravity {
+
+    std::vector<Array3Triplet> TiledKernel::prepareFaces(const Polyhedron &polyhedron) {
+        std::vector<Array3Triplet> faces{polyhedron.countFaces()};
+        std::transform(polyhedron.getFaces().cbegin(), polyhedron.getFaces().cend(), faces.begin(),
+                       [&polyhedron](const std::array<size_t, 3> &face) -> Array3Triplet {
+                           return {polyhedron.getVertex(face[0]),
+                                   polyhedron.getVertex(face[1]),
+                                   polyhedron.getVertex(face[2])};
+                       });
+        return faces;
+    }
+
+    std::vector<double> TiledKernel::estimateCosts(
+            const std::vector<Array3Triplet> &faces, const std::vector<Array3> &computationPoints,
+            double farFieldAccuracy) {
+        using namespace util;
+        const double faceCount = static_cast<double>(faces.size());
+        if (faces.empty()) {
+            return std::vector<double>(computationPoints.size(), 0.0);
+        }
+        //The centroid, the squared radius (like isFarField(..)), the unit normal and a vertex of every sampled face
+        struct SampledFace {
+            Array3 centroid;
+            double squaredRadius;
+            Array3 normal;
+            Array3 vertex;
+        };
+        const size_t stride = (faces.size() + COST_SAMPLE_FACES - 1) / COST_SAMPLE_FACES;
+        std::vector<SampledFace> sample{};
+        sample.reserve(COST_SAMPLE_FACES);
+        for (size_t face = 0; face < faces.size(); face += stride) {
+            const Array3Triplet &vertices = faces[face];
+            const Array3 centroid = (vertices[0] + vertices[1] + vertices[2]) / 3.0;
+            const Array3 normal = cross(vertices[1] - vertices[0], vertices[2] - vertices[0]);
+            const double normalNorm = euclideanNorm(normal);
+            sample.push_back({centroid,
+                              std::max({dot(vertices[0] - centroid, vertices[0] - centroid),
+                                        dot(vertices[1] - centroid, vertices[1] - centroid),
+                                        dot(vertices[2] - centroid, vertices[2] - centroid)}),
+                              normalNorm > 0.0 ? normal / normalNorm : normal,
+                              vertices[0]});
+        }
+        //(a/|c|)^3 <= accuracy / 4 compared without roots as (a^2/|c|^2)^3 <= (accuracy / 4)^2
+        const double squaredAccuracy = farFieldAccuracy * farFieldAccuracy / 16.0;
+
+        std::vector<double> costs(computationPoints.size());
+        std::transform(computationPoints.cbegin(), computationPoints.cend(), costs.begin(),
+                       [&](const Array3 &computationPoint) {
+                           double sampleCost = 0.0;
+                           for (const SampledFace &face: sample) {
+                               const Array3 offset = face.centroid - computationPoint;
+                               const double squaredDistance = dot(offset, offset);
+                               const double squaredRatio = face.squaredRadius / squaredDistance;
+                               if (squaredRatio >= 1.0 &&
+                                   std::abs(dot(face.normal, face.vertex - computationPoint)) < EPSILON) {
+                                   sampleCost += SINGULAR_FACE_COST;
+                               } else if (farFieldAccuracy > 0.0 &&
+                                          squaredRatio * squaredRatio * squaredRatio <= squaredAccuracy) {
+                                   sampleCost += FAR_FIELD_FACE_COST;
+                               } else {
+                                   sampleCost += 1.0;
+                               }
+                           }
+                           return faceCount * (sampleCost / static_cast<double>(sample.size()));
+                       });
+        return costs;
+    }
+
+    void TiledKernel::evaluateBlock(
+            const std::vector<Array3Triplet> &faces, const std::vector<Array3> &computationPoints,
+            const std::vector<size_t> &indices, size_t begin, size_t end, size_t faceBlockSize,
+            const FaceApproximations &approximations, std::vector<GravityModelResult> &result) {
+        using namespace util;
+        const size_t faceCount = faces.size();
+        //The partial sums of this block of points
+        std::vector<GravityModelResult> partialSums{end - begin};
+        for (size_t faceBegin = 0; faceBegin < faceCount; faceBegin += faceBlockSize) {
+            const size_t faceEnd = std::min(faceCount, faceBegin + faceBlockSize);
+            for (size_t i = begin; i < end; ++i) {
+                const Array3 &computationPoint = computationPoints[indices[i]];
+                GravityModelResult &sum = partialSums[i - begin];
+                for (size_t face = faceBegin; face < faceEnd; ++face) {
+                    sum = GravityModel::detail::sumResults(
+                            sum, GravityModel::detail::evaluateFace(
+                                    {faces[face][0] - computationPoint,
+                                     faces[face][1] - computationPoint,
+                                     faces[face][2] - computationPoint}, approximations));
+                }
+            }
+        }
+        for (size_t i = begin; i < end; ++i) {
+            result[indices[i]] = partialSums[i - begin];
+            result[indices[i]].eliminateRoundingErrors();
+        }
+    }
+
+    std::vector<GravityModelResult> TiledKernel::evaluateGeometricSums(
+            const std::vector<Array3Triplet> &faces, const std::vector<Array3> &computationPoints,
+            size_t pointBlockSize, size_t faceBlockSize, const FaceApproximations &approximations) {
+        if (pointBlockSize == 0 || faceBlockSize == 0) {
+            throw std::invalid_argument{"The block sizes of the tiled kernel must be greater than zero!"};
+        }
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Tiled evaluation of {} faces for {} computation points in blocks of {} x {}",
+                            faces.size(), computationPoints.size(), pointBlockSize, faceBlockSize);
+        std::vector<GravityModelResult> result{computationPoints.size()};
+        //Evaluates the points with the given indices as one block
+        const auto evaluateBlock = [&, faceBlockSize](const std::vector<size_t> &indices, size_t begin, size_t end) {
+            TiledKernel::evaluateBlock(faces, computationPoints, indices, begin, end, faceBlockSize, approximations,
+                                       result);
+        };
+
+        if (EvaluationSettings::getSchedulingMode() == SchedulingMode::WORK_STEALING) {
+            const std::vector<double> costs =
+                    estimateCosts(faces, computationPoints, approximations.farFieldAccuracy);
+            const std::vector<std::vector<size_t>> batches =
+                    WorkStealingScheduler::createBatches(costs, pointBlockSize);
+            std::vector<double> batchCosts(batches.size(), 0.0);
+            for (size_t batch = 0; batch < batches.size(); ++batch) {
+                for (const size_t index: batches[batch]) {
+                    batchCosts[batch] += costs[index];
+                }
+            }
+            //The SERIAL backend runs the batches on the calling thread only
+            const size_t threadCount = EvaluationSettings::getParallelBackend() == ParallelBackend::SERIAL ?
+                                       1 : EvaluationSettings::getThreadCount();
+            WorkStealingScheduler::run(batchCosts, [&](size_t batch) {
+                evaluateBlock(batches[batch], 0, batches[batch].size());
+            }, threadCount);
+            return result;
+        }
+
+        std::vector<size_t> indices(computationPoints.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        const size_t pointCount = computationPoints.size();
+        const size_t blockCount = (pointCount + pointBlockSize - 1) / pointBlockSize;
+        ParallelExecution::forEach(blockCount, [&, pointBlockSize](size_t block) {
+            const size_t pointBegin = block * pointBlockSize;
+            evaluateBlock(indices, pointBegin, std::min(pointCount, pointBegin + pointBlockSize));
+        });
+        return result;
+    }
+
+    std::vector<GravityModelResult> TiledKernel::evaluate(
+            const Polyhedron &polyhedron, double density, const std::vector<Array3> &computationPoints,
+            size_t pointBlockSize, size_t faceBlockSize, const FaceApproximations &approximations) {
+        std::vector<GravityModelResult> result = evaluateGeometricSums(
+                prepareFaces(polyhedron), computationPoints, pointBlockSize, faceBlockSize, approximations);
+        std::transform(result.begin(), result.end(), result.begin(), [density](const GravityModelResult &sums) {
+            return GravityModel::detail::applyDensityPrefix(sums, density);
+        });
+        return result;
+    }
+
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <stdexcept>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/WorkStealingScheduler.h"
+#include "polyhedralGravity/util/UtilityContainer.h"
+#include "polyhedralGravity/output/Logging.h"
+#include "polyhedralGravity/calculation/ParallelExecution.h"
+
+namespace polyhedralGravity {
+
+    /**
+     * Cache-blocked evaluation of the polyhedral gravity model for many computation points, similar to the
+     * blocking of a matrix-matrix product.
+     * The faces are resolved once into a contiguous array of vertex triplets. Then, a block of points is evaluated
+     * against a block of faces, so that both blocks stay in the L1/L2 cache while every face of the block is
+     * evaluated for every point of the block. The per-point partial sums are kept in a buffer local to the block of
+     * points and the blocks of points are processed in parallel.
+     * For every point, the faces are summed up in index order, so the results do not depend on the number of threads.
+     * With SchedulingMode::WORK_STEALING, the points are sorted by their estimated cost into blocks, which are
+     * distributed by the WorkStealingScheduler instead of ParallelExecution::forEach(..).
+     * The FaceApproximations are an argument, which defaults to the ones of the EvaluationSettings.
+     */
+    namespace TiledKernel {
+
+        /**
+         * The default number of computation points in one block
+         */
+        constexpr size_t DEFAULT_POINT_BLOCK_SIZE = 16;
+
+        /**
+         * The default number of faces in one block (72 bytes per face, i.e. 36 KiB)
+         */
+        constexpr size_t DEFAULT_FACE_BLOCK_SIZE = 512;
+
+        /**
+         * The minimal number of computation points for which KernelVariant::AUTO chooses the tiled kernel (if the
+         * PointLaneKernel is not chosen)
+         */
+        constexpr size_t AUTO_MIN_POINTS = 1024;
+
+        /**
+         * The cost of a face evaluated by the far-field approximation relative to the exact evaluation
+         */
+        constexpr double FAR_FIELD_FACE_COST = 0.3;
+
+        /**
+         * The cost of a face in whose plane the computation point lies (on the surface) relative to the exact
+         * evaluation, since the singular cases skip the logarithm and the arctangent of some segments
+         */
+        constexpr double SINGULAR_FACE_COST = 0.75;
+
+        /**
+         * The maximal number of faces which are classified per computation point by estimateCosts(..)
+         */
+        constexpr size_t COST_SAMPLE_FACES = 256;
+
+        /**
+         * Resolves the faces of a polyhedron into the coordinates of their vertices.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @return the vertices of every face
+         */
+        std::vector<Array3Triplet> prepareFaces(const Polyhedron &polyhedron);
+
+        /**
+         * Estimates the cost of evaluating all faces for every computation point in units of the exact evaluation
+         * of one face. Every point classifies an evenly strided sample of at most COST_SAMPLE_FACES faces: a face
+         * costs SINGULAR_FACE_COST if the point lies in its plane within its bounding sphere, FAR_FIELD_FACE_COST if
+         * it qualifies for the far-field approximation (see GravityModel::detail::isFarField(..)), one otherwise.
+         * The mean cost of the sample is scaled by the number of faces, so points close to the surface cost more
+         * than distant ones with the approximation, and points on the surface of small meshes cost less.
+         * @param faces - the vertices of every face as returned by prepareFaces(..)
+         * @param computationPoints - vector of computation points
+         * @param farFieldAccuracy - the accuracy of the far-field approximation, zero if disabled
+         * @return the estimated cost foreach computation Point P
+         */
+        std::vector<double> estimateCosts(
+                const std::vector<Array3Triplet> &faces,
+                const std::vector<Array3> &computationPoints,
+                double farFieldAccuracy);
+
+        /**
+         * Evaluates the geometric sums of one block of computation points against all faces, face block by face
+         * block, while the partial sums stay in a buffer local to the block.
+         * Rounding errors are already eliminated from the written sums.
+         * @param faces - the vertices of every face as returned by prepareFaces(..)
+         * @param computationPoints - vector of computation points
+         * @param indices - the indices of the computation points in an arbitrary order
+         * @param begin - the position of the first point of the block in the indices
+         * @param end - the position after the last point of the block in the indices
+         * @param faceBlockSize - the number of faces in one block
+         * @param approximations - the math backend and the far-field accuracy of the faces
+         * @param result - the geometric sums of all points, the ones of the block are written
+         */
+        void evaluateBlock(
+                const std::vector<Array3Triplet> &faces,
+                const std::vector<Array3> &computationPoints,
+                const std::vector<size_t> &indices,
+                size_t begin,
+                size_t end,
+                size_t faceBlockSize,
+                const FaceApproximations &approximations,
+                std::vector<GravityModelResult> &result);
+
+        /**
+         * Evaluates the geometric sums (i.e. the results for a unit density before the application of the prefix
+         * GRAVITATIONAL_CONSTANT * density) for multiple computation points.
+         * Rounding errors are already eliminated from the returned sums.
+         * @param faces - the vertices of every face as returned by prepareFaces(..)
+         * @param computationPoints - vector of computation points
+         * @param pointBlockSize - the number of computation points in one block
+         * @param faceBlockSize - the number of faces in one block
+         * @param approximations - the math backend and the far-field accuracy of the faces
+         * @return the density-independent sums foreach computation Point P
+         * @throws std::invalid_argument if a block size is zero
+         */
+        std::vector<GravityModelResult> evaluateGeometricSums(
+                const std::vector<Array3Triplet> &faces,
+                const std::vector<Array3> &computationPoints,
+                size_t pointBlockSize = DEFAULT_POINT_BLOCK_SIZE,
+                size_t faceBlockSize = DEFAULT_FACE_BLOCK_SIZE,
+                const FaceApproximations &approximations = EvaluationSettings::getFaceApproximations());
+
+        /**
+         * Evaluates the polyhedral gravity model for a given constant density polyhedron at multiple computation
+         * points with the cache-blocked kernel.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoints - vector of computation points
+         * @param pointBlockSize - the number of computation points in one block
+         * @param faceBlockSize - the number of faces in one block
+         * @param approximations - the math backend and the far-field accuracy of the faces
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * foreach computation Point P
+         * @throws std::invalid_argument if a block size is zero
+         */
+        std::vector<GravityModelResult> evaluate(
+                const Polyhedron &polyhedron,
+                double density,
+                const std::vector<Array3> &computationPoints,
+                size_t pointBlockSize = DEFAULT_POINT_BLOCK_SIZE,
+                size_t faceBlockSize = DEFAULT_FACE_BLOCK_SIZE,
+                const FaceApproximations &approximations = EvaluationSettings::getFaceApproximations());
+
+    }
+
+}
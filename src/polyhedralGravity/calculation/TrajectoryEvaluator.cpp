@@ -0,0 +1,100 @@
+#include "TrajectoryEvaluator.h"
+
+namespace polyhedralGravity {
+
+    TrajectoryEvaluator::TrajectoryEvaluator(const Polyhedron &polyhedron, double density, double tolerance,
+                                             double maxDisplacement, TaylorOrder order)
+            : _polyhedron{polyhedron},
+              _density{density},
+              _tolerance{tolerance},
+              _maxDisplacement{maxDisplacement},
+              _order{order},
+              _hasAnchor{false},
+              _anchorPoint{},
+              _anchorResult{},
+              _inverseLengthScale{0.0},
+              _exactEvaluations{0},
+              _predictions{0},
+              _maxErrorRatio{0.0} {
+        if (!(tolerance > 0.0)) {
+            throw std::invalid_argument{"The tolerance of the TrajectoryEvaluator must be positive!"};
+        }
+        if (!(maxDisplacement >= 0.0)) {
+            throw std::invalid_argument{"The maximal displacement of the TrajectoryEvaluator must not be negative!"};
+        }
+    }
+
+    GravityModelResult TrajectoryEvaluator::evaluate(const Array3 &computationPoint) {
+        using util::operator-;
+        if (_hasAnchor && util::euclideanNorm(computationPoint - _anchorPoint) <= _maxDisplacement &&
+            estimateError(computationPoint) <= _tolerance) {
+            ++_predictions;
+            return predict(computationPoint);
+        }
+        return evaluateExactly(computationPoint);
+    }
+
+    double TrajectoryEvaluator::estimateError(const Array3 &computationPoint) const {
+        using util::operator-;
+        if (!_hasAnchor) {
+            return std::numeric_limits<double>::infinity();
+        }
+        const double ratio = util::euclideanNorm(computationPoint - _anchorPoint) * _inverseLengthScale;
+        return _order == TaylorOrder::FIRST ? ratio : ratio * ratio / 2.0;
+    }
+
+    void TrajectoryEvaluator::reset() {
+        _hasAnchor = false;
+        _exactEvaluations = 0;
+        _predictions = 0;
+        _maxErrorRatio = 0.0;
+    }
+
+    GravityModelResult TrajectoryEvaluator::predict(const Array3 &computationPoint) const {
+        using util::operator-;
+        const Array3 d = computationPoint - _anchorPoint;
+        const auto &t = _anchorResult.gradiometricTensor;
+        //The tensor (xx, yy, zz, xy, xz, yz) applied to the displacement, with a = -grad V and T = grad grad V
+        const Array3 td{t[0] * d[0] + t[3] * d[1] + t[4] * d[2],
+                        t[3] * d[0] + t[1] * d[1] + t[5] * d[2],
+                        t[4] * d[0] + t[5] * d[1] + t[2] * d[2]};
+
+        GravityModelResult result{_anchorResult};
+        result.gravitationalPotential -= util::dot(_anchorResult.acceleration, d);
+        if (_order == TaylorOrder::SECOND) {
+            result.gravitationalPotential += util::dot(d, td) / 2.0;
+            for (size_t i = 0; i < 3; ++i) {
+                result.acceleration[i] -= td[i];
+            }
+        }
+        return result;
+    }
+
+    GravityModelResult TrajectoryEvaluator::evaluateExactly(const Array3 &computationPoint) {
+        using util::operator-;
+        const GravityModelResult result = GravityModel::evaluate(_polyhedron, _density, computationPoint);
+        ++_exactEvaluations;
+        const double accelerationNorm = util::euclideanNorm(result.acceleration);
+        const double estimatedError = estimateError(computationPoint);
+        if (_hasAnchor && estimatedError > 0.0 && std::isfinite(estimatedError)) {
+            const Array3 predicted = predict(computationPoint).acceleration;
+            const double error = util::euclideanNorm(predicted - result.acceleration) / accelerationNorm;
+            _maxErrorRatio = std::max(_maxErrorRatio, error / estimatedError);
+        }
+
+        const auto &t = result.gradiometricTensor;
+        const double tensorNorm = std::sqrt(t[0] * t[0] + t[1] * t[1] + t[2] * t[2] +
+                                            2.0 * (t[3] * t[3] + t[4] * t[4] + t[5] * t[5]));
+        //Without an acceleration, no relative error can be met, so every further point is evaluated exactly
+        _inverseLengthScale = accelerationNorm > 0.0 ? tensorNorm / accelerationNorm
+                                                     : std::numeric_limits<double>::infinity();
+        _anchorPoint = computationPoint;
+        _anchorResult = result;
+        _hasAnchor = true;
+        SPDLOG_LOGGER_TRACE(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Trajectory evaluator: new anchor after {} predictions, length scale {}",
+                            _predictions, 1.0 / _inverseLengthScale);
+        return result;
+    }
+
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/util/UtilityContainer.h"
+#include "polyhedralGravity/output/Logging.h"
+
+namespace polyhedralGravity {
+
+    /**
+     * The order of the Taylor step of the TrajectoryEvaluator in the displacement from the last exact evaluation.
+     */
+    enum class TaylorOrder {
+
+        /**
+         * The potential changes linearly with the stored acceleration, the acceleration and the tensor stay constant
+         */
+        FIRST,
+
+        /**
+         * The potential changes quadratically and the acceleration linearly with the stored gradiometric tensor,
+         * the tensor stays constant
+         */
+        SECOND
+
+    };
+
+    /**
+     * A stateful evaluation of the polyhedral gravity model along one trajectory, e.g. for the steps of an
+     * integrator. The result of the last exact evaluation (the anchor) is reused and the result at nearby points is
+     * predicted by a Taylor step with the stored acceleration and gradiometric tensor. A new exact evaluation is
+     * only triggered if the displacement from the anchor exceeds the maximal displacement or the estimated relative
+     * error of the acceleration exceeds the tolerance.
+     *
+     * The error is estimated with the length scale L = |a| / |T| of the anchor (for a point mass, L is a fraction
+     * of the distance to it): the neglected term of the acceleration is about (|d| / L)^k / k! * |a| for a step of
+     * order k and the displacement d.
+     *
+     * @note The polyhedron is referenced, not copied! It must outlive the evaluator.
+     * @note The evaluator is not thread-safe, use one instance per trajectory.
+     * @example Long-duration propagations whose integrator queries points moving only slightly between the steps
+     */
+    class TrajectoryEvaluator {
+
+        /**
+         * The polyhedron to evaluate
+         */
+        const Polyhedron &_polyhedron;
+
+        /**
+         * The constant density in [kg/m^3]
+         */
+        const double _density;
+
+        /**
+         * The estimated relative error of the acceleration which triggers an exact evaluation
+         */
+        const double _tolerance;
+
+        /**
+         * The displacement from the anchor in [m] which triggers an exact evaluation
+         */
+        const double _maxDisplacement;
+
+        /**
+         * The order of the Taylor step
+         */
+        const TaylorOrder _order;
+
+        /**
+         * True if an anchor exists
+         */
+        bool _hasAnchor;
+
+        /**
+         * The computation point of the last exact evaluation
+         */
+        Array3 _anchorPoint;
+
+        /**
+         * The result of the last exact evaluation
+         */
+        GravityModelResult _anchorResult;
+
+        /**
+         * The Frobenius norm of the anchor's gradiometric tensor divided by the norm of its acceleration, i.e. 1 / L
+         */
+        double _inverseLengthScale;
+
+        /**
+         * Number of exact evaluations of the gravity model
+         */
+        size_t _exactEvaluations;
+
+        /**
+         * Number of predicted results
+         */
+        size_t _predictions;
+
+        /**
+         * The largest ratio between the actual and the estimated relative error of the acceleration of a prediction,
+         * measured whenever an exact evaluation replaces an anchor
+         */
+        double _maxErrorRatio;
+
+    public:
+
+        /**
+         * Creates a new TrajectoryEvaluator without an anchor.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces (referenced, not copied)
+         * @param density - the constant density in [kg/m^3]
+         * @param tolerance - the estimated relative error of the acceleration which triggers an exact evaluation
+         * @param maxDisplacement - the displacement from the anchor in [m] which triggers an exact evaluation
+         * (default: unlimited)
+         * @param order - the order of the Taylor step (default: SECOND)
+         * @throws std::invalid_argument if the tolerance is not positive or the maximal displacement is negative
+         */
+        TrajectoryEvaluator(const Polyhedron &polyhedron, double density, double tolerance,
+                            double maxDisplacement = std::numeric_limits<double>::infinity(),
+                            TaylorOrder order = TaylorOrder::SECOND);
+
+        /**
+         * Returns the result of the polyhedral gravity model at the next point of the trajectory, either predicted
+         * from the anchor or evaluated exactly (which then becomes the new anchor).
+         * @param computationPoint - the computation Point P
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * at computation Point P
+         */
+        GravityModelResult evaluate(const Array3 &computationPoint);
+
+        /**
+         * Returns the estimated relative error of the acceleration of a prediction at a computation point.
+         * @param computationPoint - the computation Point P
+         * @return the estimated error, infinity without an anchor
+         */
+        [[nodiscard]] double estimateError(const Array3 &computationPoint) const;
+
+        /**
+         * Removes the anchor (e.g. after a discontinuity of the trajectory) and resets the statistics.
+         */
+        void reset();
+
+        /**
+         * Returns the number of exact evaluations of the gravity model.
+         * @return number of exact evaluations
+         */
+        [[nodiscard]] size_t countExactEvaluations() const {
+            return _exactEvaluations;
+        }
+
+        /**
+         * Returns the number of predicted results.
+         * @return number of predictions
+         */
+        [[nodiscard]] size_t countPredictions() const {
+            return _predictions;
+        }
+
+        /**
+         * Returns the largest ratio between the actual and the estimated error of a prediction at the points of the
+         * exact evaluations since the last reset. Values up to one confirm that the estimate is conservative for
+         * this trajectory.
+         * @return the largest ratio
+         */
+        [[nodiscard]] double getMaxErrorRatio() const {
+            return _maxErrorRatio;
+        }
+
+    private:
+
+        /**
+         * Predicts the result at a computation point by the Taylor step from the anchor.
+         * @param computationPoint - the computation Point P
+         * @return the predicted GravityModelResult
+         */
+        [[nodiscard]] GravityModelResult predict(const Array3 &computationPoint) const;
+
+        /**
+         * Evaluates the gravity model exactly at a computation point and makes it the new anchor.
+         * @param computationPoint - the computation Point P
+         * @return the GravityModelResult
+         */
+        GravityModelResult evaluateExactly(const Array3 &computationPoint);
+
+    };
+
+}
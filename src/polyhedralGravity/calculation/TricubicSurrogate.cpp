@@ -0,0 +1,193 @@
+#include "TricubicSurrogate.h"
+
+namespace polyhedralGravity {
+
+    TricubicSurrogate::TricubicSurrogate(const Polyhedron &polyhedron, double density, const Array3 &lowerCorner,
+                                         const Array3 &upperCorner, const std::array<size_t, 3> &resolution)
+            : _lowerCorner{lowerCorner},
+              _upperCorner{upperCorner},
+              _resolution{resolution},
+              _spacing{},
+              _nodes{} {
+        checkAndComputeSpacing();
+        const size_t nodeCount = _resolution[0] * _resolution[1] * _resolution[2];
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Building a tricubic surrogate with {} x {} x {} nodes",
+                            _resolution[0], _resolution[1], _resolution[2]);
+
+        //1. Step: Evaluate the exact model at every node, all nodes at once so that the kernel is chosen for them
+        std::vector<Array3> positions(nodeCount);
+        for (size_t index = 0; index < nodeCount; ++index) {
+            const size_t i = index % _resolution[0];
+            const size_t j = (index / _resolution[0]) % _resolution[1];
+            const size_t k = index / (_resolution[0] * _resolution[1]);
+            positions[index] = {_lowerCorner[0] + static_cast<double>(i) * _spacing[0],
+                                _lowerCorner[1] + static_cast<double>(j) * _spacing[1],
+                                _lowerCorner[2] + static_cast<double>(k) * _spacing[2]};
+        }
+        const std::vector<GravityModelResult> results = GravityModel::evaluate(polyhedron, density, positions);
+        _nodes.reserve(nodeCount);
+        std::transform(results.cbegin(), results.cend(), std::back_inserter(_nodes),
+                       [](const GravityModelResult &result) { return HermiteNode{result, 0.0}; });
+
+        //2. Step: Approximate the only derivative not provided by the model
+        computeMixedDerivatives();
+    }
+
+    TricubicSurrogate::TricubicSurrogate(const Array3 &lowerCorner, const Array3 &upperCorner,
+                                         const std::array<size_t, 3> &resolution, std::vector<HermiteNode> nodes)
+            : _lowerCorner{lowerCorner},
+              _upperCorner{upperCorner},
+              _resolution{resolution},
+              _spacing{},
+              _nodes{std::move(nodes)} {
+        checkAndComputeSpacing();
+    }
+
+    void TricubicSurrogate::checkAndComputeSpacing() {
+        for (size_t axis = 0; axis < 3; ++axis) {
+            if (_resolution[axis] < 2) {
+                throw std::invalid_argument{"The TricubicSurrogate requires at least two nodes along every axis!"};
+            }
+            if (!(_lowerCorner[axis] < _upperCorner[axis])) {
+                throw std::invalid_argument{
+                        "The lower corner of the TricubicSurrogate must be smaller than the upper corner!"};
+            }
+            _spacing[axis] = (_upperCorner[axis] - _lowerCorner[axis]) / static_cast<double>(_resolution[axis] - 1);
+        }
+    }
+
+    void TricubicSurrogate::computeMixedDerivatives() {
+        //Central difference along one axis, one-sided at the boundary of the grid
+        const auto difference = [this](size_t i, size_t j, size_t k, size_t axis, size_t tensorIndex) {
+            std::array<size_t, 3> lower{i, j, k}, upper{i, j, k};
+            if (lower[axis] > 0) {
+                --lower[axis];
+            }
+            if (upper[axis] + 1 < _resolution[axis]) {
+                ++upper[axis];
+            }
+            const double delta = static_cast<double>(upper[axis] - lower[axis]) * _spacing[axis];
+            return (_nodes[nodeIndex(upper[0], upper[1], upper[2])].result.gradiometricTensor[tensorIndex] -
+                    _nodes[nodeIndex(lower[0], lower[1], lower[2])].result.gradiometricTensor[tensorIndex]) / delta;
+        };
+        for (size_t k = 0; k < _resolution[2]; ++k) {
+            for (size_t j = 0; j < _resolution[1]; ++j) {
+                for (size_t i = 0; i < _resolution[0]; ++i) {
+                    _nodes[nodeIndex(i, j, k)].mixedDerivative =
+                            (difference(i, j, k, 2, 3) + difference(i, j, k, 1, 4) + difference(i, j, k, 0, 5)) / 3.0;
+                }
+            }
+        }
+    }
+
+    TricubicSurrogate TricubicSurrogate::load(const std::string &filename) {
+        std::ifstream file{filename, std::ios::binary};
+        if (!file) {
+            throw std::runtime_error{"The TricubicSurrogate file " + filename + " could not be opened!"};
+        }
+        char magic[sizeof(FILE_MAGIC)];
+        std::uint32_t version = 0;
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char *>(&version), sizeof(version));
+        if (!file || !std::equal(std::begin(magic), std::end(magic), std::begin(FILE_MAGIC)) ||
+            version != FILE_VERSION) {
+            throw std::runtime_error{"The file " + filename + " does not contain a valid TricubicSurrogate!"};
+        }
+        Array3 lowerCorner{}, upperCorner{};
+        std::array<std::uint64_t, 3> resolution{};
+        file.read(reinterpret_cast<char *>(lowerCorner.data()), sizeof(lowerCorner));
+        file.read(reinterpret_cast<char *>(upperCorner.data()), sizeof(upperCorner));
+        file.read(reinterpret_cast<char *>(resolution.data()), sizeof(resolution));
+        if (!file) {
+            throw std::runtime_error{"The header of the TricubicSurrogate file " + filename + " is incomplete!"};
+        }
+        if (std::any_of(resolution.begin(), resolution.end(), [](std::uint64_t nodes) { return nodes < 2; })) {
+            throw std::runtime_error{"The header of the TricubicSurrogate file " + filename + " is corrupted!"};
+        }
+        //The number of nodes must neither overflow nor exceed the remaining content of the file
+        constexpr std::uint64_t nodeBytes = 11 * sizeof(double);
+        const std::streampos headerEnd = file.tellg();
+        file.seekg(0, std::ios::end);
+        const auto maxNodes = static_cast<std::uint64_t>(file.tellg() - headerEnd) / nodeBytes;
+        file.seekg(headerEnd);
+        if (resolution[0] > maxNodes || resolution[1] > maxNodes / resolution[0] ||
+            resolution[2] > maxNodes / (resolution[0] * resolution[1])) {
+            throw std::runtime_error{"The nodes of the TricubicSurrogate file " + filename + " are incomplete!"};
+        }
+        std::vector<HermiteNode> nodes(resolution[0] * resolution[1] * resolution[2]);
+        for (HermiteNode &node: nodes) {
+            file.read(reinterpret_cast<char *>(&node.result.gravitationalPotential), sizeof(double));
+            file.read(reinterpret_cast<char *>(node.result.acceleration.data()), sizeof(node.result.acceleration));
+            file.read(reinterpret_cast<char *>(node.result.gradiometricTensor.data()),
+                      sizeof(node.result.gradiometricTensor));
+            file.read(reinterpret_cast<char *>(&node.mixedDerivative), sizeof(double));
+        }
+        if (!file) {
+            throw std::runtime_error{"The nodes of the TricubicSurrogate file " + filename + " are incomplete!"};
+        }
+        return {lowerCorner, upperCorner, {resolution[0], resolution[1], resolution[2]}, std::move(nodes)};
+    }
+
+    void TricubicSurrogate::save(const std::string &filename) const {
+        std::ofstream file{filename, std::ios::binary | std::ios::trunc};
+        if (!file) {
+            throw std::runtime_error{"The TricubicSurrogate file " + filename + " could not be created!"};
+        }
+        const std::array<std::uint64_t, 3> resolution{_resolution[0], _resolution[1], _resolution[2]};
+        file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+        file.write(reinterpret_cast<const char *>(&FILE_VERSION), sizeof(FILE_VERSION));
+        file.write(reinterpret_cast<const char *>(_lowerCorner.data()), sizeof(_lowerCorner));
+        file.write(reinterpret_cast<const char *>(_upperCorner.data()), sizeof(_upperCorner));
+        file.write(reinterpret_cast<const char *>(resolution.data()), sizeof(resolution));
+        for (const HermiteNode &node: _nodes) {
+            file.write(reinterpret_cast<const char *>(&node.result.gravitationalPotential), sizeof(double));
+            file.write(reinterpret_cast<const char *>(node.result.acceleration.data()),
+                       sizeof(node.result.acceleration));
+            file.write(reinterpret_cast<const char *>(node.result.gradiometricTensor.data()),
+                       sizeof(node.result.gradiometricTensor));
+            file.write(reinterpret_cast<const char *>(&node.mixedDerivative), sizeof(double));
+        }
+        if (!file) {
+            throw std::runtime_error{"The TricubicSurrogate could not be written to " + filename + "!"};
+        }
+    }
+
+    GravityModelResult TricubicSurrogate::evaluate(const Array3 &computationPoint) const {
+        if (!contains(computationPoint)) {
+            throw std::out_of_range{"The computation point is not contained in the grid of the TricubicSurrogate!"};
+        }
+        std::array<size_t, 3> cell{};
+        Array3 localCoordinates{};
+        for (size_t axis = 0; axis < 3; ++axis) {
+            const double scaled = (computationPoint[axis] - _lowerCorner[axis]) / _spacing[axis];
+            cell[axis] = std::min(static_cast<size_t>(scaled), _resolution[axis] - 2);
+            localCoordinates[axis] = std::min(scaled - static_cast<double>(cell[axis]), 1.0);
+        }
+        std::array<HermiteNode, 8> corners{};
+        for (size_t corner = 0; corner < 8; ++corner) {
+            corners[corner] = _nodes[nodeIndex(cell[0] + (corner & 1u), cell[1] + ((corner >> 1u) & 1u),
+                                               cell[2] + ((corner >> 2u) & 1u))];
+        }
+        return HermiteInterpolation::interpolate(corners, localCoordinates, _spacing);
+    }
+
+    std::vector<GravityModelResult> TricubicSurrogate::evaluate(const std::vector<Array3> &computationPoints) const {
+        std::vector<GravityModelResult> result{computationPoints.size()};
+        thrust::transform(computationPoints.begin(), computationPoints.end(), result.begin(),
+                          [this](const Array3 &computationPoint) {
+                              return evaluate(computationPoint);
+                          });
+        return result;
+    }
+
+    bool TricubicSurrogate::contains(const Array3 &computationPoint) const {
+        for (size_t axis = 0; axis < 3; ++axis) {
+            if (!(computationPoint[axis] >= _lowerCorner[axis] && computationPoint[axis] <= _upperCorner[axis])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/calculation/HermiteInterpolation.h"
+#include "polyhedralGravity/output/Logging.h"
+#include "thrust/transform.h"
+
+namespace polyhedralGravity {
+
+    /**
+     * A surrogate of the polyhedral gravity model on a regular grid around a polyhedron.
+     * The exact model is evaluated once at every grid node. Afterwards, queries are answered by tricubic Hermite
+     * interpolation of the potential (see HermiteInterpolation), whose derivatives at the nodes are the exact
+     * acceleration and the mixed entries of the gradiometric tensor. The cost of a query is independent of the
+     * number of faces.
+     *
+     * The interpolation error of the potential decreases with O(h^4) of the node spacing h, of the acceleration
+     * with O(h^3) and of the gradiometric tensor with O(h^2). The gradiometric tensor is discontinuous at the
+     * surface of the polyhedron, thus cells intersecting the surface have a considerably larger error.
+     *
+     * @example Real-time simulators propagating many trajectories in a bounded region around the body
+     */
+    class TricubicSurrogate {
+
+        /**
+         * The identifier at the beginning of a stored surrogate
+         */
+        static constexpr char FILE_MAGIC[8] = {'P', 'G', 'T', 'R', 'I', 'C', 'U', 'B'};
+
+        /**
+         * The version of the file format
+         */
+        static constexpr std::uint32_t FILE_VERSION = 1;
+
+        /**
+         * The corner of the grid with the smallest coordinates
+         */
+        Array3 _lowerCorner;
+
+        /**
+         * The corner of the grid with the largest coordinates
+         */
+        Array3 _upperCorner;
+
+        /**
+         * The number of nodes along the x, y and z axis
+         */
+        std::array<size_t, 3> _resolution;
+
+        /**
+         * The distance between two neighboring nodes along the x, y and z axis
+         */
+        Array3 _spacing;
+
+        /**
+         * The nodes with index i + nx * (j + ny * k)
+         */
+        std::vector<HermiteNode> _nodes;
+
+    public:
+
+        /**
+         * Creates a new TricubicSurrogate by evaluating the polyhedral gravity model at every grid node.
+         * @param polyhedron - the polyhedron consisting of vertices and triangular faces
+         * @param density - the constant density in [kg/m^3]
+         * @param lowerCorner - the corner of the grid with the smallest coordinates
+         * @param upperCorner - the corner of the grid with the largest coordinates
+         * @param resolution - the number of nodes along the x, y and z axis
+         * @throws std::invalid_argument if the box is empty or less than two nodes are requested along an axis
+         */
+        TricubicSurrogate(const Polyhedron &polyhedron, double density, const Array3 &lowerCorner,
+                          const Array3 &upperCorner, const std::array<size_t, 3> &resolution);
+
+        /**
+         * Reads a surrogate which has been stored with save(..).
+         * @param filename - the path to the file
+         * @return the TricubicSurrogate
+         * @throws std::runtime_error if the file can not be read or is no valid surrogate
+         */
+        static TricubicSurrogate load(const std::string &filename);
+
+        /**
+         * Stores the surrogate in a binary file (native byte order).
+         * @param filename - the path to the file
+         * @throws std::runtime_error if the file can not be written
+         */
+        void save(const std::string &filename) const;
+
+        /**
+         * Interpolates the polyhedral gravity model at computation point P.
+         * @param computationPoint - the computation Point P
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * at computation Point P
+         * @throws std::out_of_range if P is not contained in the grid
+         */
+        [[nodiscard]] GravityModelResult evaluate(const Array3 &computationPoint) const;
+
+        /**
+         * Interpolates the polyhedral gravity model at multiple computation points.
+         * @param computationPoints - vector of computation points
+         * @return the GravityModelResult containing the potential, the acceleration and the change of acceleration
+         * foreach computation Point P
+         * @throws std::out_of_range if one P is not contained in the grid
+         */
+        [[nodiscard]] std::vector<GravityModelResult> evaluate(const std::vector<Array3> &computationPoints) const;
+
+        /**
+         * Checks if a computation point lies inside the grid.
+         * @param computationPoint - the computation Point P
+         * @return true if P can be interpolated
+         */
+        [[nodiscard]] bool contains(const Array3 &computationPoint) const;
+
+        /**
+         * Returns the corner of the grid with the smallest coordinates.
+         * @return lower corner
+         */
+        [[nodiscard]] const Array3 &getLowerCorner() const {
+            return _lowerCorner;
+        }
+
+        /**
+         * Returns the corner of the grid with the largest coordinates.
+         * @return upper corner
+         */
+        [[nodiscard]] const Array3 &getUpperCorner() const {
+            return _upperCorner;
+        }
+
+        /**
+         * Returns the number of nodes along the x, y and z axis.
+         * @return resolution
+         */
+        [[nodiscard]] const std::array<size_t, 3> &getResolution() const {
+            return _resolution;
+        }
+
+    private:
+
+        /**
+         * Creates a surrogate from already computed nodes, used by load(..).
+         * @param lowerCorner - the corner of the grid with the smallest coordinates
+         * @param upperCorner - the corner of the grid with the largest coordinates
+         * @param resolution - the number of nodes along the x, y and z axis
+         * @param nodes - the nodes with index i + nx * (j + ny * k)
+         */
+        TricubicSurrogate(const Array3 &lowerCorner, const Array3 &upperCorner,
+                          const std::array<size_t, 3> &resolution, std::vector<HermiteNode> nodes);
+
+        /**
+         * Checks the dimensions of the grid and computes the spacing.
+         * @throws std::invalid_argument if the box is empty or less than two nodes are requested along an axis
+         */
+        void checkAndComputeSpacing();
+
+        /**
+         * Approximates the mixed derivative Vxyz at every node by averaging the central differences of Vxy along z,
+         * Vxz along y and Vyz along x (one-sided differences at the boundary).
+         */
+        void computeMixedDerivatives();
+
+        /**
+         * Returns the index of node (i, j, k).
+         * @param i - index along x
+         * @param j - index along y
+         * @param k - index along z
+         * @return the index in _nodes
+         */
+        [[nodiscard]] size_t nodeIndex(size_t i, size_t j, size_t k) const {
+            return i + _resolution[0] * (j + _resolution[1] * k);
+        }
+
+    };
+
+}
@@ -0,0 +1,260 @@
+#include "WorkStealingScheduler.h"
+
+namespace polyhedralGravity {
+
+    namespace {
+
+        /**
+         * The tasks of one thread, guarded by a mutex since the other threads steal from its back
+         */
+        struct TaskDeque {
+
+            std::mutex mutex;
+
+            std::deque<size_t> tasks;
+
+        };
+
+        /**
+         * Whether the current thread executes a task of a run
+         */
+        thread_local bool insideTask = false;
+
+        /**
+         * The threads of a run apart from the calling one, executed by the HelperPool
+         */
+        struct RunWorkers {
+
+            /**
+             * The function of a thread of the run, called with the index of the thread
+             */
+            std::function<void(size_t)> worker;
+
+            /**
+             * The number of helpers currently executing a thread of the run, guarded by the pool's mutex
+             */
+            size_t running;
+
+            /**
+             * Wakes up the caller of the run once no helper executes one of its threads anymore
+             */
+            std::condition_variable finished;
+
+            explicit RunWorkers(std::function<void(size_t)> function)
+                    : worker{std::move(function)},
+                      running{0},
+                      finished{} {}
+
+        };
+
+        /**
+         * The helper threads shared by all runs. The threads of a run are queued and every idle helper takes the
+         * next one. The pool only grows, its threads wait for work until the end of the process.
+         */
+        class HelperPool {
+
+            std::mutex _mutex;
+
+            std::condition_variable _wakeUp;
+
+            std::deque<std::pair<RunWorkers *, size_t>> _queue;
+
+            std::vector<std::thread> _threads;
+
+            bool _shutdown{false};
+
+            void work() {
+                std::unique_lock<std::mutex> lock{_mutex};
+                while (true) {
+                    _wakeUp.wait(lock, [this] { return _shutdown || !_queue.empty(); });
+                    if (_queue.empty()) {
+                        return;
+                    }
+                    const auto [run, thread] = _queue.front();
+                    _queue.pop_front();
+                    ++run->running;
+                    lock.unlock();
+                    run->worker(thread);
+                    lock.lock();
+                    if (--run->running == 0) {
+                        run->finished.notify_all();
+                    }
+                }
+            }
+
+        public:
+
+            ~HelperPool() {
+                {
+                    std::lock_guard<std::mutex> lock{_mutex};
+                    _shutdown = true;
+                }
+                _wakeUp.notify_all();
+                for (std::thread &thread: _threads) {
+                    thread.join();
+                }
+            }
+
+            /**
+             * Queues the threads [1, threadCount) of a run, starting helpers if the pool has fewer.
+             * @param run - the run
+             * @param threadCount - the number of threads of the run including the calling one
+             */
+            void submit(RunWorkers &run, size_t threadCount) {
+                {
+                    std::lock_guard<std::mutex> lock{_mutex};
+                    for (size_t thread = 1; thread < threadCount; ++thread) {
+                        _queue.emplace_back(&run, thread);
+                    }
+                    while (_threads.size() + 1 < threadCount) {
+                        _threads.emplace_back(&HelperPool::work, this);
+                    }
+                }
+                _wakeUp.notify_all();
+            }
+
+            /**
+             * Waits until no helper executes a thread of the run anymore. Threads of the run which have not been
+             * started are dropped, since the calling thread only returns once all tasks have been taken.
+             * @param run - the run
+             */
+            void finish(RunWorkers &run) {
+                std::unique_lock<std::mutex> lock{_mutex};
+                _queue.erase(std::remove_if(_queue.begin(), _queue.end(),
+                                            [&run](const auto &queued) { return queued.first == &run; }),
+                             _queue.end());
+                run.finished.wait(lock, [&run] { return run.running == 0; });
+            }
+
+            /**
+             * Returns the pool of the process.
+             * @return the HelperPool
+             */
+            static HelperPool &instance() {
+                static HelperPool pool{};
+                return pool;
+            }
+
+        };
+
+    }
+
+    size_t WorkStealingScheduler::defaultThreadCount() {
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    std::vector<std::vector<size_t>> WorkStealingScheduler::createBatches(const std::vector<double> &costs,
+                                                                          size_t batchSize) {
+        if (batchSize == 0) {
+            throw std::invalid_argument{"The batch size of the scheduler must be greater than zero!"};
+        }
+        std::vector<size_t> order(costs.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&costs](size_t lhs, size_t rhs) {
+            return costs[lhs] > costs[rhs];
+        });
+        std::vector<std::vector<size_t>> batches{};
+        batches.reserve((order.size() + batchSize - 1) / batchSize);
+        for (size_t begin = 0; begin < order.size(); begin += batchSize) {
+            const size_t end = std::min(order.size(), begin + batchSize);
+            batches.emplace_back(order.begin() + static_cast<std::ptrdiff_t>(begin),
+                                 order.begin() + static_cast<std::ptrdiff_t>(end));
+        }
+        return batches;
+    }
+
+    SchedulerStatistics WorkStealingScheduler::run(const std::vector<double> &taskCosts,
+                                                   const std::function<void(size_t)> &task, size_t threadCount) {
+        SchedulerStatistics statistics{};
+        if (taskCosts.empty()) {
+            return statistics;
+        }
+        //A nested run would wait for helpers which may all be busy with the tasks of the outer runs
+        if (insideTask) {
+            statistics.threadCount = 1;
+            statistics.tasksPerThread.assign(1, taskCosts.size());
+            for (size_t index = 0; index < taskCosts.size(); ++index) {
+                task(index);
+            }
+            return statistics;
+        }
+        threadCount = std::min(threadCount == 0 ? defaultThreadCount() : threadCount, taskCosts.size());
+        statistics.threadCount = threadCount;
+        statistics.tasksPerThread.assign(threadCount, 0);
+
+        //1. Step: Assign the tasks by descending cost to the deque with the smallest assigned cost (LPT rule)
+        std::vector<size_t> order(taskCosts.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&taskCosts](size_t lhs, size_t rhs) {
+            return taskCosts[lhs] > taskCosts[rhs];
+        });
+        std::vector<TaskDeque> deques(threadCount);
+        std::vector<double> assignedCosts(threadCount, 0.0);
+        for (const size_t index: order) {
+            const auto cheapest = std::min_element(assignedCosts.begin(), assignedCosts.end());
+            *cheapest += taskCosts[index];
+            deques[std::distance(assignedCosts.begin(), cheapest)].tasks.push_back(index);
+        }
+
+        //2. Step: Work through the own deque from the front and steal from the back of the others
+        std::atomic<size_t> steals{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr exception{};
+        std::mutex exceptionMutex{};
+        const auto worker = [&](size_t thread) {
+            while (!failed.load(std::memory_order_relaxed)) {
+                size_t index = 0;
+                bool found = false;
+                {
+                    std::lock_guard lock{deques[thread].mutex};
+                    if (!deques[thread].tasks.empty()) {
+                        index = deques[thread].tasks.front();
+                        deques[thread].tasks.pop_front();
+                        found = true;
+                    }
+                }
+                for (size_t offset = 1; !found && offset < threadCount; ++offset) {
+                    TaskDeque &victim = deques[(thread + offset) % threadCount];
+                    std::lock_guard lock{victim.mutex};
+                    if (!victim.tasks.empty()) {
+                        index = victim.tasks.back();
+                        victim.tasks.pop_back();
+                        found = true;
+                        steals.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                //Tasks are never added during a run, so all deques being empty means that the work is done
+                if (!found) {
+                    return;
+                }
+                try {
+                    insideTask = true;
+                    task(index);
+                    insideTask = false;
+                    ++statistics.tasksPerThread[thread];
+                } catch (...) {
+                    insideTask = false;
+                    std::lock_guard lock{exceptionMutex};
+                    if (!exception) {
+                        exception = std::current_exception();
+                    }
+                    failed.store(true);
+                }
+            }
+        };
+        RunWorkers helpers{worker};
+        HelperPool &pool = HelperPool::instance();
+        pool.submit(helpers, threadCount);
+        worker(0);
+        pool.finish(helpers);
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+        statistics.steals = steals.load();
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                            "Work stealing run of {} tasks on {} threads with {} steals",
+                            taskCosts.size(), threadCount, statistics.steals);
+        return statistics;
+    }
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <exception>
+#include <stdexcept>
+#include "polyhedralGravity/output/Logging.h"
+
+namespace polyhedralGravity {
+
+    /**
+     * Statistics of one run of the WorkStealingScheduler.
+     */
+    struct SchedulerStatistics {
+
+        /**
+         * The number of threads which executed the tasks
+         */
+        size_t threadCount{0};
+
+        /**
+         * The number of tasks executed by every thread (including the stolen ones)
+         */
+        std::vector<size_t> tasksPerThread{};
+
+        /**
+         * The number of tasks which were taken from the deque of another thread
+         */
+        size_t steals{0};
+
+    };
+
+    /**
+     * A scheduler for tasks of different, roughly known costs, e.g. blocks of computation points whose faces are
+     * partially evaluated by the far-field approximation. Every thread owns a deque of tasks. The tasks are assigned
+     * to the deques in descending order of their cost, each to the deque with the smallest assigned cost so far.
+     * A thread takes the tasks from the front of its own deque, i.e. the expensive ones first, and steals from the
+     * back of the other deques when its own one is empty, i.e. the cheap ones last. This way, no thread idles while
+     * others still work through a long tail of expensive tasks, even if the estimates are off.
+     *
+     * The calling thread works as the first thread of a run. The others are taken from a pool of helper threads,
+     * which is shared by all runs and lives until the end of the process, so a run only creates threads if the pool
+     * has fewer than it requests. A run started by a task of another run (e.g. a parallel loop nested in a parallel
+     * loop) executes its tasks on the calling thread instead of waiting for helpers.
+     */
+    namespace WorkStealingScheduler {
+
+        /**
+         * Returns the number of threads used if none is given, i.e. the number of hardware threads.
+         * @return the number of threads, at least one
+         */
+        size_t defaultThreadCount();
+
+        /**
+         * Groups items into batches of similar cost, so that every batch follows the same evaluation path.
+         * The items are sorted by descending cost (ties keep their index order) and cut into consecutive batches.
+         * @param costs - the estimated cost of every item
+         * @param batchSize - the maximal number of items per batch
+         * @return the indices of the items foreach batch, the batches in descending order of their cost
+         * @throws std::invalid_argument if the batch size is zero
+         */
+        std::vector<std::vector<size_t>> createBatches(const std::vector<double> &costs, size_t batchSize);
+
+        /**
+         * Executes every task exactly once on multiple threads with work stealing.
+         * Within a task of another run, the tasks are executed in index order on the calling thread.
+         * If a task throws, the remaining tasks are skipped and the first exception is rethrown after all threads
+         * have finished.
+         * @param taskCosts - the estimated cost of every task
+         * @param task - the function executing the task with the given index
+         * @param threadCount - the number of threads, zero uses defaultThreadCount() (never more threads than tasks)
+         * @return the statistics of the run
+         */
+        SchedulerStatistics run(const std::vector<double> &taskCosts, const std::function<void(size_t)> &task,
+                                size_t threadCount = 0);
+
+    }
+
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include "polyhedralGravity/calculation/PointLaneKernel.h"
+#include "polyhedralGravity/calculation/MasconModel.h"
+#include "xsimd/xsimd.hpp"
+
+/*
+ * The SIMD kernels are explicitly instantiated for one architecture per translation unit of this directory.
+ * CMake compiles each of them with the flags of its instruction set (see cmake/simd.cmake), while all other
+ * translation units keep the instruction set of the target. At runtime,
+ * EvaluationSettings::dispatchSimdArchitecture(..) selects the instantiation supported by the CPU.
+ *
+ * The kernels must not call shared inline functions with non-trivial bodies, since the linker may keep the copy
+ * compiled with the wider instruction set for all callers. Hence, e.g. the scalar fallback of the PointLaneKernel
+ * lives in PointLaneKernel::detail::evaluateScalarLane(..) of the generic translation unit.
+ */
@@ -0,0 +1,20 @@
+#include "SimdKernels.h"
+
+#ifdef POLYHEDRAL_GRAVITY_SIMD_DISPATCH
+
+namespace polyhedralGravity {
+
+    //The SIMD kernels for SSE4.2
+    using SimdKernelArch = xsimd::sse4_2;
+
+    template size_t PointLaneKernel::detail::countLanes<SimdKernelArch>();
+
+    template void PointLaneKernel::detail::evaluateBatch<SimdKernelArch>(
+            const std::vector<Array3Triplet> &, const std::vector<PreparedFace> &,
+            const std::vector<Array3> &, size_t, std::vector<GravityModelResult> &);
+
+    template std::array<double, 10> MasconModel::sumLanes<SimdKernelArch>(const Array3 &) const;
+
+}
+
+#endif
@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 #include "DataSource.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
 
 namespace polyhedralGravity {
 
@@ -43,6 +44,72 @@ namespace polyhedralGravity {
          */
         virtual bool getMeshInputCheckStatus() = 0;
 
+        /**
+         * Returns the reduction mode used for the sum over the faces.
+         * @return the ReductionMode
+         */
+        virtual ReductionMode getReductionMode() = 0;
+
+        /**
+         * Returns the implementation of the transcendental functions.
+         * @return the MathBackend
+         */
+        virtual MathBackend getMathBackend() = 0;
+
+        /**
+         * Returns the accuracy of the far-field approximation of single faces.
+         * @return the relative accuracy, zero if disabled
+         */
+        virtual double getFarFieldAccuracy() = 0;
+
+        /**
+         * Returns the distribution of the blocks of computation points over the threads.
+         * @return the SchedulingMode
+         */
+        virtual SchedulingMode getSchedulingMode() = 0;
+
+        /**
+         * Returns the runtime selected parallelization of the loops over the faces and computation points.
+         * @return the ParallelBackend
+         */
+        virtual ParallelBackend getParallelBackend() = 0;
+
+        /**
+         * Returns the number of threads of the ParallelBackend.
+         * @return the thread count, zero for all hardware threads
+         */
+        virtual size_t getThreadCount() = 0;
+
+        /**
+         * Returns the number of loop iterations per task of the ParallelBackend.
+         * @return the grain size, zero for an automatic choice
+         */
+        virtual size_t getGrainSize() = 0;
+
+        /**
+         * Returns the number of faces from which on the faces of a single point are evaluated in parallel.
+         * @return the threshold, zero for the calibrated one
+         */
+        virtual size_t getSerialFaceThreshold() = 0;
+
+        /**
+         * Returns the loop parallelized by the pointwise evaluation of multiple points.
+         * @return the ParallelAxis
+         */
+        virtual ParallelAxis getParallelAxis() = 0;
+
+        /**
+         * Returns the instruction set of the SIMD kernels.
+         * @return the SimdArchitecture
+         */
+        virtual SimdArchitecture getSimdArchitecture() = 0;
+
+        /**
+         * Returns the file in which the autotuning profile persists.
+         * @return the path, empty to keep the profile in memory only
+         */
+        virtual std::string getAutotuningProfile() = 0;
+
         /**
          * The DataSource of the given Polyhedron.
          * @return data source (e. g. a file reader)
@@ -43,6 +43,116 @@ namespace polyhedralGravity {
         }
     }
 
+    ReductionMode YAMLConfigReader::getReductionMode() {
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger() ,
+                            "Reading the reduction mode from the configuration file.");
+        if (_file[ROOT][RUNTIME] && _file[ROOT][RUNTIME][RUNTIME_REDUCTION]) {
+            return EvaluationSettings::parseReductionMode(_file[ROOT][RUNTIME][RUNTIME_REDUCTION].as<std::string>());
+        } else {
+            return ReductionMode::DEFAULT;
+        }
+    }
+
+    MathBackend YAMLConfigReader::getMathBackend() {
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger() ,
+                            "Reading the math backend from the configuration file.");
+        if (_file[ROOT][RUNTIME] && _file[ROOT][RUNTIME][RUNTIME_MATH]) {
+            return EvaluationSettings::parseMathBackend(_file[ROOT][RUNTIME][RUNTIME_MATH].as<std::string>());
+        } else {
+            return MathBackend::ACCURATE;
+        }
+    }
+
+    double YAMLConfigReader::getFarFieldAccuracy() {
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger() ,
+                            "Reading the accuracy of the far-field approximation from the configuration file.");
+        if (_file[ROOT][RUNTIME] && _file[ROOT][RUNTIME][RUNTIME_FAR_FIELD]) {
+            return _file[ROOT][RUNTIME][RUNTIME_FAR_FIELD].as<double>();
+        } else {
+            return 0.0;
+        }
+    }
+
+    SchedulingMode YAMLConfigReader::getSchedulingMode() {
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger() ,
+                            "Reading the scheduling mode from the configuration file.");
+        if (_file[ROOT][RUNTIME] && _file[ROOT][RUNTIME][RUNTIME_SCHEDULING]) {
+            return EvaluationSettings::parseSchedulingMode(_file[ROOT][RUNTIME][RUNTIME_SCHEDULING].as<std::string>());
+        } else {
+            return SchedulingMode::STATIC;
+        }
+    }
+
+    ParallelBackend YAMLConfigReader::getParallelBackend() {
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger() ,
+                            "Reading the parallel backend from the configuration file.");
+        if (_file[ROOT][RUNTIME] && _file[ROOT][RUNTIME][RUNTIME_BACKEND]) {
+            return EvaluationSettings::parseParallelBackend(_file[ROOT][RUNTIME][RUNTIME_BACKEND].as<std::string>());
+        } else {
+            return ParallelBackend::DEFAULT;
+        }
+    }
+
+    size_t YAMLConfigReader::getThreadCount() {
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger() ,
+                            "Reading the thread count from the configuration file.");
+        if (_file[ROOT][RUNTIME] && _file[ROOT][RUNTIME][RUNTIME_THREADS]) {
+            return _file[ROOT][RUNTIME][RUNTIME_THREADS].as<size_t>();
+        } else {
+            return 0;
+        }
+    }
+
+    size_t YAMLConfigReader::getGrainSize() {
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger() ,
+                            "Reading the grain size from the configuration file.");
+        if (_file[ROOT][RUNTIME] && _file[ROOT][RUNTIME][RUNTIME_GRAIN_SIZE]) {
+            return _file[ROOT][RUNTIME][RUNTIME_GRAIN_SIZE].as<size_t>();
+        } else {
+            return 0;
+        }
+    }
+
+    size_t YAMLConfigReader::getSerialFaceThreshold() {
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger() ,
+                            "Reading the serial face threshold from the configuration file.");
+        if (_file[ROOT][RUNTIME] && _file[ROOT][RUNTIME][RUNTIME_SERIAL_THRESHOLD]) {
+            return _file[ROOT][RUNTIME][RUNTIME_SERIAL_THRESHOLD].as<size_t>();
+        } else {
+            return 0;
+        }
+    }
+
+    ParallelAxis YAMLConfigReader::getParallelAxis() {
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger() ,
+                            "Reading the parallel axis from the configuration file.");
+        if (_file[ROOT][RUNTIME] && _file[ROOT][RUNTIME][RUNTIME_PARALLEL_AXIS]) {
+            return EvaluationSettings::parseParallelAxis(_file[ROOT][RUNTIME][RUNTIME_PARALLEL_AXIS].as<std::string>());
+        } else {
+            return ParallelAxis::AUTO;
+        }
+    }
+
+    SimdArchitecture YAMLConfigReader::getSimdArchitecture() {
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger() ,
+                            "Reading the SIMD architecture from the configuration file.");
+        if (_file[ROOT][RUNTIME] && _file[ROOT][RUNTIME][RUNTIME_SIMD]) {
+            return EvaluationSettings::parseSimdArchitecture(_file[ROOT][RUNTIME][RUNTIME_SIMD].as<std::string>());
+        } else {
+            return SimdArchitecture::AUTO;
+        }
+    }
+
+    std::string YAMLConfigReader::getAutotuningProfile() {
+        SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger() ,
+                            "Reading the autotuning profile from the configuration file.");
+        if (_file[ROOT][RUNTIME] && _file[ROOT][RUNTIME][RUNTIME_AUTOTUNING_PROFILE]) {
+            return _file[ROOT][RUNTIME][RUNTIME_AUTOTUNING_PROFILE].as<std::string>();
+        } else {
+            return "";
+        }
+    }
+
     std::shared_ptr<DataSource> YAMLConfigReader::getDataSource() {
         SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger() ,
                             "Reading the data sources (file names) from the configuration file.");
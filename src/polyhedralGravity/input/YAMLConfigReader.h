@@ -25,6 +25,18 @@ namespace polyhedralGravity {
         static constexpr char INPUT_DENSITY[] = "density";
         static constexpr char INPUT_POINTS[] = "points";
         static constexpr char INPUT_CHECK[] = "check_mesh";
+        static constexpr char RUNTIME[] = "runtime";
+        static constexpr char RUNTIME_REDUCTION[] = "reduction";
+        static constexpr char RUNTIME_MATH[] = "math";
+        static constexpr char RUNTIME_FAR_FIELD[] = "far_field_accuracy";
+        static constexpr char RUNTIME_SCHEDULING[] = "scheduling";
+        static constexpr char RUNTIME_BACKEND[] = "backend";
+        static constexpr char RUNTIME_THREADS[] = "threads";
+        static constexpr char RUNTIME_GRAIN_SIZE[] = "grain_size";
+        static constexpr char RUNTIME_SERIAL_THRESHOLD[] = "serial_threshold";
+        static constexpr char RUNTIME_PARALLEL_AXIS[] = "parallel_axis";
+        static constexpr char RUNTIME_SIMD[] = "simd";
+        static constexpr char RUNTIME_AUTOTUNING_PROFILE[] = "autotuning_profile";
         static constexpr char OUTPUT[] = "output";
         static constexpr char OUTPUT_FILENAME[] = "filename";
 
@@ -85,6 +97,72 @@ namespace polyhedralGravity {
          */
         bool getMeshInputCheckStatus() override;
 
+        /**
+         * Reads the reduction mode (DEFAULT or DETERMINISTIC) from the yaml file.
+         * @return the ReductionMode if specified, otherwise per-default ReductionMode::DEFAULT
+         */
+        ReductionMode getReductionMode() override;
+
+        /**
+         * Reads the math backend (ACCURATE or FAST) from the yaml file.
+         * @return the MathBackend if specified, otherwise per-default MathBackend::ACCURATE
+         */
+        MathBackend getMathBackend() override;
+
+        /**
+         * Reads the accuracy of the far-field approximation of single faces from the yaml file.
+         * @return the relative accuracy if specified, otherwise per-default zero (disabled)
+         */
+        double getFarFieldAccuracy() override;
+
+        /**
+         * Reads the scheduling mode (STATIC or WORK_STEALING) from the yaml file.
+         * @return the SchedulingMode if specified, otherwise per-default SchedulingMode::STATIC
+         */
+        SchedulingMode getSchedulingMode() override;
+
+        /**
+         * Reads the parallel backend (DEFAULT, SERIAL, THREADS, OPENMP or TBB) from the yaml file.
+         * @return the ParallelBackend if specified, otherwise per-default ParallelBackend::DEFAULT
+         */
+        ParallelBackend getParallelBackend() override;
+
+        /**
+         * Reads the number of threads of the parallel backend from the yaml file.
+         * @return the thread count if specified, otherwise per-default zero (all hardware threads)
+         */
+        size_t getThreadCount() override;
+
+        /**
+         * Reads the number of loop iterations per task of the parallel backend from the yaml file.
+         * @return the grain size if specified, otherwise per-default zero (automatic)
+         */
+        size_t getGrainSize() override;
+
+        /**
+         * Reads the number of faces from which on a single point is evaluated in parallel from the yaml file.
+         * @return the threshold if specified, otherwise per-default zero (calibrated)
+         */
+        size_t getSerialFaceThreshold() override;
+
+        /**
+         * Reads the parallel axis (AUTO, POINTS or FACES) of the pointwise evaluation from the yaml file.
+         * @return the ParallelAxis if specified, otherwise per-default ParallelAxis::AUTO
+         */
+        ParallelAxis getParallelAxis() override;
+
+        /**
+         * Reads the SIMD architecture (AUTO, GENERIC, SSE4_2, AVX2_FMA or AVX512F) from the yaml file.
+         * @return the SimdArchitecture if specified, otherwise per-default SimdArchitecture::AUTO
+         */
+        SimdArchitecture getSimdArchitecture() override;
+
+        /**
+         * Reads the path of the autotuning profile from the yaml file.
+         * @return the path if specified, otherwise per-default an empty string (profile in memory only)
+         */
+        std::string getAutotuningProfile() override;
+
         /**
          * Reads the DataSource from the yaml configuration file.
          * @return shared_ptr to the DataSource Object created
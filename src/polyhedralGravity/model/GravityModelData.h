@@ -4,6 +4,7 @@
 #include <ostream>
 #include <cmath>
 #include <algorithm>
+#include <stdexcept>
 #include "polyhedralGravity/util/UtilityContainer.h"
 #include "polyhedralGravity/util/UtilityConstants.h"
 
@@ -193,6 +194,25 @@ namespace polyhedralGravity {
         }
     };
 
+    /**
+     * The ingredients of a face which do not depend on the computation point P, i.e. which are invariant under the
+     * translation of the face's vertices by -P. They can be computed once per face and reused for many points.
+     */
+    struct PreparedFace {
+        /**
+         * the segment vectors G_pq of the face
+         */
+        Array3Triplet segmentVectors;
+        /**
+         * the plane unit normal N_p of the face
+         */
+        Array3 planeUnitNormal;
+        /**
+         * the segment unit normals n_pq of the face
+         */
+        Array3Triplet segmentUnitNormals;
+    };
+
     /**
      * A data structure containing the result of the polyhedral gravity model's evaluation.
     */
@@ -270,4 +290,105 @@ namespace polyhedralGravity {
 
     };
 
+    /**
+     * A rigid transformation between the body-fixed frame of the polyhedron and an outer frame, e.g. an inertial
+     * frame in which the body rotates. A point is transformed by P_outer = rotation * P_body + translation.
+     * The potential is invariant, the acceleration is rotated by R * a and the gradiometric tensor by R * T * R^T.
+     */
+    struct FrameTransformation {
+
+        /**
+         * The orthonormal rotation matrix R from the body-fixed to the outer frame
+         */
+        util::Matrix<double, 3, 3> rotation{{{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}}};
+
+        /**
+         * The position of the body-fixed frame's origin in the outer frame
+         */
+        Array3 translation{};
+
+        /**
+         * Creates a new identity transformation
+         */
+        FrameTransformation() = default;
+
+        /**
+         * Creates a new transformation from a rotation matrix and a translation
+         * @param rotation - the orthonormal rotation matrix R from the body-fixed to the outer frame
+         * @param translation - the position of the body-fixed frame's origin in the outer frame
+         */
+        FrameTransformation(const util::Matrix<double, 3, 3> &rotation, const Array3 &translation)
+                : rotation(rotation),
+                  translation(translation) {}
+
+        /**
+         * Creates a new transformation from a rotation quaternion and a translation
+         * @param quaternion - the rotation from the body-fixed to the outer frame as quaternion (w, x, y, z),
+         * it is normalized before usage
+         * @param translation - the position of the body-fixed frame's origin in the outer frame
+         * @return the FrameTransformation
+         * @throws std::invalid_argument if the quaternion's norm is zero
+         */
+        static FrameTransformation fromQuaternion(const std::array<double, 4> &quaternion,
+                                                  const Array3 &translation = {0.0, 0.0, 0.0}) {
+            const double norm = util::euclideanNorm(quaternion);
+            if (norm == 0.0 || !std::isfinite(norm)) {
+                throw std::invalid_argument{"The quaternion of a FrameTransformation must have a finite, non-zero norm!"};
+            }
+            const double w = quaternion[0] / norm, x = quaternion[1] / norm, y = quaternion[2] / norm,
+                    z = quaternion[3] / norm;
+            return {{{{1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y - w * z), 2.0 * (x * z + w * y)},
+                      {2.0 * (x * y + w * z), 1.0 - 2.0 * (x * x + z * z), 2.0 * (y * z - w * x)},
+                      {2.0 * (x * z - w * y), 2.0 * (y * z + w * x), 1.0 - 2.0 * (x * x + y * y)}}},
+                    translation};
+        }
+
+        /**
+         * Transforms a point from the outer frame into the body-fixed frame: R^T * (P - translation)
+         * @param point - the point in the outer frame
+         * @return the point in the body-fixed frame
+         */
+        [[nodiscard]] Array3 toBodyFrame(const Array3 &point) const {
+            const Array3 shifted{point[0] - translation[0], point[1] - translation[1], point[2] - translation[2]};
+            Array3 result{};
+            for (size_t i = 0; i < 3; ++i) {
+                result[i] = rotation[0][i] * shifted[0] + rotation[1][i] * shifted[1] + rotation[2][i] * shifted[2];
+            }
+            return result;
+        }
+
+        /**
+         * Transforms a result of the gravity model from the body-fixed frame into the outer frame.
+         * @param bodyResult - the result in the body-fixed frame
+         * @return the result in the outer frame
+         */
+        [[nodiscard]] GravityModelResult toOuterFrame(const GravityModelResult &bodyResult) const {
+            const auto &t = bodyResult.gradiometricTensor;
+            const util::Matrix<double, 3, 3> tensor{{{t[0], t[3], t[4]}, {t[3], t[1], t[5]}, {t[4], t[5], t[2]}}};
+            //R * T
+            util::Matrix<double, 3, 3> rotatedTensor{};
+            for (size_t i = 0; i < 3; ++i) {
+                for (size_t j = 0; j < 3; ++j) {
+                    rotatedTensor[i][j] =
+                            rotation[i][0] * tensor[0][j] + rotation[i][1] * tensor[1][j] + rotation[i][2] * tensor[2][j];
+                }
+            }
+            //(R * T) * R^T, only the upper triangle is required due to symmetry
+            const auto entry = [this, &rotatedTensor](size_t i, size_t j) {
+                return rotatedTensor[i][0] * rotation[j][0] + rotatedTensor[i][1] * rotation[j][1] +
+                       rotatedTensor[i][2] * rotation[j][2];
+            };
+            GravityModelResult result{};
+            result.gravitationalPotential = bodyResult.gravitationalPotential;
+            for (size_t i = 0; i < 3; ++i) {
+                result.acceleration[i] = rotation[i][0] * bodyResult.acceleration[0] +
+                                         rotation[i][1] * bodyResult.acceleration[1] +
+                                         rotation[i][2] * bodyResult.acceleration[2];
+            }
+            result.gradiometricTensor = {entry(0, 0), entry(1, 1), entry(2, 2), entry(0, 1), entry(0, 2), entry(1, 2)};
+            return result;
+        }
+
+    };
+
 }
@@ -0,0 +1,272 @@
+#include "MpiEvaluation.h"
+
+namespace polyhedralGravity {
+
+    namespace {
+
+        /**
+         * The number of doubles of one GravityModelResult
+         */
+        constexpr size_t RESULT_SIZE = 10;
+
+        /**
+         * Receives the computation points and the results of one chunk starting at the given point index
+         */
+        using ChunkSink = std::function<void(uint64_t, const std::vector<Array3> &,
+                                             const std::vector<GravityModelResult> &)>;
+
+        /**
+         * Writes a result as RESULT_SIZE consecutive doubles.
+         * @param result - the result
+         * @param destination - the first of RESULT_SIZE doubles
+         */
+        void pack(const GravityModelResult &result, double *destination) {
+            destination[0] = result.gravitationalPotential;
+            std::copy(result.acceleration.cbegin(), result.acceleration.cend(), destination + 1);
+            std::copy(result.gradiometricTensor.cbegin(), result.gradiometricTensor.cend(), destination + 4);
+        }
+
+        /**
+         * Reads a result from RESULT_SIZE consecutive doubles.
+         * @param source - the first of RESULT_SIZE doubles
+         * @return the result
+         */
+        GravityModelResult unpack(const double *source) {
+            GravityModelResult result{};
+            result.gravitationalPotential = source[0];
+            std::copy(source + 1, source + 4, result.acceleration.begin());
+            std::copy(source + 4, source + RESULT_SIZE, result.gradiometricTensor.begin());
+            return result;
+        }
+
+        /**
+         * Lets every rank claim chunks of the computation points of the root until all points are evaluated.
+         * @param polyhedron - the polyhedron, identical on every rank
+         * @param density - the constant density, only significant on the root rank
+         * @param computationPoints - the computation points, only significant on the root rank
+         * @param communicator - the MPI communicator
+         * @param chunkSize - the number of points claimed at once
+         * @param root - the rank owning the computation points
+         * @param sink - called with every evaluated chunk on the rank which claimed it
+         * @throws the exception of the evaluation or the sink on the rank where it occurred, std::runtime_error on
+         * all other ranks (after every rank has left the loop, so that no rank blocks in a collective call)
+         */
+        void distribute(const Polyhedron &polyhedron, double density, const std::vector<Array3> &computationPoints,
+                        MPI_Comm communicator, size_t chunkSize, int root, const ChunkSink &sink) {
+            int rank = 0;
+            MPI_Comm_rank(communicator, &rank);
+            const bool isRoot = rank == root;
+            uint64_t pointCount = isRoot ? computationPoints.size() : 0;
+            MPI_Bcast(&pointCount, 1, MPI_UINT64_T, root, communicator);
+            MPI_Bcast(&density, 1, MPI_DOUBLE, root, communicator);
+
+            //The root exposes its points (read-only) and the counter of the next unclaimed point
+            uint64_t nextPoint = 0;
+            MPI_Win pointWindow, counterWindow;
+            MPI_Win_create(isRoot ? const_cast<Array3 *>(computationPoints.data()) : nullptr,
+                           isRoot ? static_cast<MPI_Aint>(pointCount * sizeof(Array3)) : 0, sizeof(double),
+                           MPI_INFO_NULL, communicator, &pointWindow);
+            MPI_Win_create(isRoot ? &nextPoint : nullptr, isRoot ? sizeof(uint64_t) : 0, sizeof(uint64_t),
+                           MPI_INFO_NULL, communicator, &counterWindow);
+
+            const uint64_t increment = chunkSize;
+            size_t chunks = 0;
+            std::exception_ptr exception{};
+            std::vector<Array3> points{};
+            while (true) {
+                uint64_t begin = 0;
+                MPI_Win_lock(MPI_LOCK_SHARED, root, 0, counterWindow);
+                MPI_Fetch_and_op(&increment, &begin, MPI_UINT64_T, root, 0, MPI_SUM, counterWindow);
+                MPI_Win_unlock(root, counterWindow);
+                if (begin >= pointCount) {
+                    break;
+                }
+                const uint64_t end = std::min(pointCount, begin + increment);
+                points.resize(end - begin);
+                const int valueCount = static_cast<int>(3 * points.size());
+                MPI_Win_lock(MPI_LOCK_SHARED, root, 0, pointWindow);
+                MPI_Get(points.data(), valueCount, MPI_DOUBLE, root, static_cast<MPI_Aint>(3 * begin), valueCount,
+                        MPI_DOUBLE, pointWindow);
+                MPI_Win_unlock(root, pointWindow);
+                try {
+                    sink(begin, points, GravityModel::evaluate(polyhedron, density, points));
+                } catch (...) {
+                    exception = std::current_exception();
+                    //The other ranks claim no further chunks, the result is lost anyway
+                    MPI_Win_lock(MPI_LOCK_SHARED, root, 0, counterWindow);
+                    MPI_Accumulate(&pointCount, 1, MPI_UINT64_T, root, 0, 1, MPI_UINT64_T, MPI_REPLACE,
+                                   counterWindow);
+                    MPI_Win_unlock(root, counterWindow);
+                    break;
+                }
+                ++chunks;
+            }
+            SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                                "Rank {} evaluated {} chunks of at most {} points", rank, chunks, chunkSize);
+            int failed = exception ? 1 : 0;
+            MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, communicator);
+            MPI_Win_free(&counterWindow);
+            MPI_Win_free(&pointWindow);
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+            if (failed != 0) {
+                throw std::runtime_error{"The MPI evaluation failed on another rank!"};
+            }
+        }
+
+        /**
+         * Checks the chunk size, which is the same on every rank.
+         * @param chunkSize - the number of points claimed at once
+         * @throws std::invalid_argument if the chunk size is zero or too large for the counts of MPI
+         */
+        void checkChunkSize(size_t chunkSize) {
+            const size_t maximalChunkSize = std::numeric_limits<int>::max() / MpiEvaluation::RECORD_SIZE;
+            if (chunkSize == 0 || chunkSize > maximalChunkSize) {
+                throw std::invalid_argument{"The chunk size of the MPI evaluation must be greater than zero and fit "
+                                            "into the counts of MPI!"};
+            }
+        }
+
+    }
+
+    Polyhedron MpiEvaluation::broadcastPolyhedron(const Polyhedron &polyhedron, MPI_Comm communicator, int root) {
+        int rank = 0;
+        MPI_Comm_rank(communicator, &rank);
+        const bool isRoot = rank == root;
+        std::array<uint64_t, 2> counts{isRoot ? polyhedron.countVertices() : 0, isRoot ? polyhedron.countFaces() : 0};
+        MPI_Bcast(counts.data(), 2, MPI_UINT64_T, root, communicator);
+
+        std::vector<Array3> vertices{isRoot ? polyhedron.getVertices() : std::vector<Array3>(counts[0])};
+        std::vector<uint64_t> faces(3 * counts[1]);
+        if (isRoot) {
+            for (size_t face = 0; face < counts[1]; ++face) {
+                std::copy(polyhedron.getFaces()[face].cbegin(), polyhedron.getFaces()[face].cend(),
+                          faces.begin() + static_cast<std::ptrdiff_t>(3 * face));
+            }
+        }
+        MPI_Bcast(vertices.data(), static_cast<int>(3 * counts[0]), MPI_DOUBLE, root, communicator);
+        MPI_Bcast(faces.data(), static_cast<int>(3 * counts[1]), MPI_UINT64_T, root, communicator);
+        if (isRoot) {
+            return polyhedron;
+        }
+        std::vector<std::array<size_t, 3>> indexTriplets(counts[1]);
+        for (size_t face = 0; face < counts[1]; ++face) {
+            indexTriplets[face] = {faces[3 * face], faces[3 * face + 1], faces[3 * face + 2]};
+        }
+        return {std::move(vertices), std::move(indexTriplets)};
+    }
+
+    std::vector<GravityModelResult> MpiEvaluation::evaluate(
+            const Polyhedron &polyhedron, double density, const std::vector<Array3> &computationPoints,
+            MPI_Comm communicator, size_t chunkSize, int root) {
+        checkChunkSize(chunkSize);
+        int rank = 0;
+        MPI_Comm_rank(communicator, &rank);
+        const bool isRoot = rank == root;
+        //The root exposes the buffer of the results, which the ranks fill with their chunks
+        std::vector<double> buffer(isRoot ? RESULT_SIZE * computationPoints.size() : 0);
+        MPI_Win resultWindow;
+        MPI_Win_create(buffer.data(), static_cast<MPI_Aint>(buffer.size() * sizeof(double)), sizeof(double),
+                       MPI_INFO_NULL, communicator, &resultWindow);
+
+        std::vector<double> chunk{};
+        try {
+            distribute(polyhedron, density, computationPoints, communicator, chunkSize, root,
+                       [&](uint64_t begin, const std::vector<Array3> &,
+                           const std::vector<GravityModelResult> &results) {
+                           chunk.resize(RESULT_SIZE * results.size());
+                           for (size_t i = 0; i < results.size(); ++i) {
+                               pack(results[i], chunk.data() + RESULT_SIZE * i);
+                           }
+                           const int valueCount = static_cast<int>(chunk.size());
+                           MPI_Win_lock(MPI_LOCK_SHARED, root, 0, resultWindow);
+                           MPI_Put(chunk.data(), valueCount, MPI_DOUBLE, root,
+                                   static_cast<MPI_Aint>(RESULT_SIZE * begin), valueCount, MPI_DOUBLE, resultWindow);
+                           MPI_Win_unlock(root, resultWindow);
+                       });
+        } catch (...) {
+            //Every rank ends up here, so the collective free still matches
+            MPI_Win_free(&resultWindow);
+            throw;
+        }
+        //Freeing the window completes all outstanding puts
+        MPI_Win_free(&resultWindow);
+
+        std::vector<GravityModelResult> result(isRoot ? computationPoints.size() : 0);
+        for (size_t i = 0; i < result.size(); ++i) {
+            result[i] = unpack(buffer.data() + RESULT_SIZE * i);
+        }
+        return result;
+    }
+
+    void MpiEvaluation::evaluateToFile(
+            const Polyhedron &polyhedron, double density, const std::vector<Array3> &computationPoints,
+            const std::string &fileName, MPI_Comm communicator, size_t chunkSize, int root) {
+        checkChunkSize(chunkSize);
+        int rank = 0;
+        MPI_Comm_rank(communicator, &rank);
+        uint64_t nameLength = fileName.size();
+        MPI_Bcast(&nameLength, 1, MPI_UINT64_T, root, communicator);
+        std::string name = rank == root ? fileName : std::string(nameLength, '\0');
+        MPI_Bcast(name.data(), static_cast<int>(nameLength), MPI_CHAR, root, communicator);
+
+        MPI_File file;
+        if (MPI_File_open(communicator, name.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file) !=
+            MPI_SUCCESS) {
+            throw std::runtime_error{"The result file " + name + " could not be opened!"};
+        }
+        //Drops the records of a previous, possibly longer run
+        MPI_File_set_size(file, 0);
+
+        std::vector<double> records{};
+        try {
+            distribute(polyhedron, density, computationPoints, communicator, chunkSize, root,
+                       [&](uint64_t begin, const std::vector<Array3> &points,
+                           const std::vector<GravityModelResult> &results) {
+                           records.resize(RECORD_SIZE * results.size());
+                           for (size_t i = 0; i < results.size(); ++i) {
+                               std::copy(points[i].cbegin(), points[i].cend(), records.data() + RECORD_SIZE * i);
+                               pack(results[i], records.data() + RECORD_SIZE * i + 3);
+                           }
+                           const auto offset = static_cast<MPI_Offset>(RECORD_SIZE * begin * sizeof(double));
+                           if (MPI_File_write_at(file, offset, records.data(), static_cast<int>(records.size()),
+                                                 MPI_DOUBLE, MPI_STATUS_IGNORE) != MPI_SUCCESS) {
+                               throw std::runtime_error{"The results could not be written to " + name + "!"};
+                           }
+                       });
+        } catch (...) {
+            //Every rank ends up here, so the collective close still matches
+            MPI_File_close(&file);
+            throw;
+        }
+        MPI_File_close(&file);
+    }
+
+    std::vector<GravityModelResult> MpiEvaluation::readResultFile(const std::string &fileName,
+                                                                  std::vector<Array3> &computationPoints) {
+        std::ifstream file{fileName, std::ios::binary | std::ios::ate};
+        if (!file) {
+            throw std::runtime_error{"The result file " + fileName + " could not be read!"};
+        }
+        const auto byteCount = static_cast<size_t>(file.tellg());
+        if (byteCount % (RECORD_SIZE * sizeof(double)) != 0) {
+            throw std::runtime_error{"The result file " + fileName + " is truncated!"};
+        }
+        std::vector<double> records(byteCount / sizeof(double));
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(records.data()), static_cast<std::streamsize>(byteCount));
+
+        const size_t pointCount = records.size() / RECORD_SIZE;
+        computationPoints.resize(pointCount);
+        std::vector<GravityModelResult> result(pointCount);
+        for (size_t i = 0; i < pointCount; ++i) {
+            std::copy(records.cbegin() + static_cast<std::ptrdiff_t>(RECORD_SIZE * i),
+                      records.cbegin() + static_cast<std::ptrdiff_t>(RECORD_SIZE * i + 3),
+                      computationPoints[i].begin());
+            result[i] = unpack(records.data() + RECORD_SIZE * i + 3);
+        }
+        return result;
+    }
+
+}
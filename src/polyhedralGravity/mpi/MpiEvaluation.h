@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <functional>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <exception>
+#include "mpi.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/output/Logging.h"
+
+namespace polyhedralGravity {
+
+    /**
+     * Distributed evaluation of the polyhedral gravity model for very large sets of computation points with MPI.
+     * The polyhedron is broadcast once from the root rank. The computation points stay on the root rank and are
+     * exposed to the other ranks by a one-sided MPI window. Every rank (including the root) repeatedly claims the
+     * next chunk of points with an atomic fetch-and-add on a counter of the root, fetches the points of the chunk and
+     * evaluates them with GravityModel::evaluate(..), i.e. with the node-local parallelization. Fast ranks thus
+     * simply claim more chunks (dynamic load balancing). The results are either put back into a buffer of the root
+     * or written by every rank directly into a shared binary file with MPI-IO.
+     *
+     * This module is only compiled with -DBUILD_POLYHEDRAL_GRAVITY_MPI=ON into the target polyhedralGravity_mpi,
+     * so the library and the Python interface do not depend on MPI.
+     *
+     * @note All functions are collective, i.e. every rank of the communicator must call them with the same
+     * root rank and chunk size. MPI must have been initialized. If the evaluation of a chunk fails on one rank,
+     * the remaining chunks are skipped and the error is raised on every rank instead of leaving the others blocked.
+     */
+    namespace MpiEvaluation {
+
+        /**
+         * The default number of computation points claimed at once by a rank
+         */
+        constexpr size_t DEFAULT_CHUNK_SIZE = 4096;
+
+        /**
+         * The number of doubles per computation point in the binary result file, the coordinates of the point
+         * followed by the potential, the acceleration and the gradiometric tensor
+         */
+        constexpr size_t RECORD_SIZE = 13;
+
+        /**
+         * Broadcasts a polyhedron from the root rank to all ranks.
+         * @param polyhedron - the polyhedron, only significant on the root rank
+         * @param communicator - the MPI communicator
+         * @param root - the rank owning the polyhedron
+         * @return the polyhedron on every rank
+         */
+        Polyhedron broadcastPolyhedron(const Polyhedron &polyhedron, MPI_Comm communicator, int root = 0);
+
+        /**
+         * Evaluates the polyhedral gravity model at multiple computation points distributed over all ranks and
+         * gathers the results on the root rank.
+         * @param polyhedron - the polyhedron, identical on every rank (see broadcastPolyhedron(..))
+         * @param density - the constant density in [kg/m^3], only significant on the root rank
+         * @param computationPoints - vector of computation points, only significant on the root rank
+         * @param communicator - the MPI communicator
+         * @param chunkSize - the number of points claimed at once by a rank
+         * @param root - the rank owning the computation points
+         * @return the GravityModelResult foreach computation Point P on the root rank, empty on the other ranks
+         * @throws std::invalid_argument if the chunk size is zero or too large for the counts of MPI
+         * @throws std::runtime_error if the evaluation failed on another rank (the failing rank rethrows its error)
+         */
+        std::vector<GravityModelResult> evaluate(
+                const Polyhedron &polyhedron,
+                double density,
+                const std::vector<Array3> &computationPoints,
+                MPI_Comm communicator,
+                size_t chunkSize = DEFAULT_CHUNK_SIZE,
+                int root = 0);
+
+        /**
+         * Evaluates the polyhedral gravity model at multiple computation points distributed over all ranks and
+         * writes the results in parallel into a binary file with RECORD_SIZE doubles (native byte order) per point,
+         * in the order of the computation points.
+         * @param polyhedron - the polyhedron, identical on every rank (see broadcastPolyhedron(..))
+         * @param density - the constant density in [kg/m^3], only significant on the root rank
+         * @param computationPoints - vector of computation points, only significant on the root rank
+         * @param fileName - the path of the binary file, only significant on the root rank
+         * @param communicator - the MPI communicator
+         * @param chunkSize - the number of points claimed at once by a rank
+         * @param root - the rank owning the computation points
+         * @throws std::invalid_argument if the chunk size is zero or too large for the counts of MPI
+         * @throws std::runtime_error if the file cannot be opened or written, or the evaluation failed on another rank
+         */
+        void evaluateToFile(
+                const Polyhedron &polyhedron,
+                double density,
+                const std::vector<Array3> &computationPoints,
+                const std::string &fileName,
+                MPI_Comm communicator,
+                size_t chunkSize = DEFAULT_CHUNK_SIZE,
+                int root = 0);
+
+        /**
+         * Reads a binary result file written by evaluateToFile(..).
+         * @param fileName - the path of the binary file
+         * @param computationPoints - the computation points are stored in here
+         * @return the GravityModelResult foreach computation Point P
+         * @throws std::runtime_error if the file cannot be read or is truncated
+         */
+        std::vector<GravityModelResult> readResultFile(const std::string &fileName,
+                                                       std::vector<Array3> &computationPoints);
+
+    }
+
+}
@@ -0,0 +1,128 @@
+#include "EvaluationClient.h"
+
+namespace polyhedralGravity {
+
+    namespace {
+
+        /**
+         * Numbers the shared memory objects of this process
+         */
+        std::atomic<uint64_t> sharedMemoryCounter{0};
+
+    }
+
+    EvaluationClient::EvaluationClient(const std::string &socketPath, size_t sharedMemoryThreshold)
+            : _socket{-1},
+              _sharedMemoryThreshold{sharedMemoryThreshold} {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(address.sun_path)) {
+            throw std::runtime_error{"The socket path " + socketPath + " is too long!"};
+        }
+        std::copy(socketPath.cbegin(), socketPath.cend(), address.sun_path);
+        _socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (_socket < 0 ||
+            ::connect(_socket, reinterpret_cast<const sockaddr *>(&address), sizeof(sockaddr_un)) != 0) {
+            const int error = errno;
+            if (_socket >= 0) {
+                ::close(_socket);
+            }
+            throw std::runtime_error{"Connecting to the evaluation server on " + socketPath + " failed: " +
+                                     std::strerror(error)};
+        }
+    }
+
+    EvaluationClient::~EvaluationClient() {
+        ::close(_socket);
+    }
+
+    std::vector<char> EvaluationClient::request(ServiceProtocol::MessageType type, const std::vector<char> &request) {
+        using namespace ServiceProtocol;
+        sendMessage(_socket, static_cast<uint16_t>(type), request);
+        Header header{};
+        std::vector<char> response{};
+        if (!receiveMessage(_socket, header, response)) {
+            throw std::runtime_error{"The evaluation server closed the connection!"};
+        }
+        if (static_cast<Status>(header.code) != Status::OK) {
+            throw std::runtime_error{"The evaluation server failed: " + std::string{response.cbegin(),
+                                                                                    response.cend()}};
+        }
+        return response;
+    }
+
+    void EvaluationClient::ping() {
+        request(ServiceProtocol::MessageType::PING, {});
+    }
+
+    uint64_t EvaluationClient::loadPolyhedron(const Polyhedron &polyhedron) {
+        using namespace ServiceProtocol;
+        PayloadWriter writer{};
+        writer.put<uint64_t>(polyhedron.countVertices());
+        writer.put<uint64_t>(polyhedron.countFaces());
+        writer.putArray(polyhedron.getVertices().data(), polyhedron.countVertices());
+        for (const auto &face: polyhedron.getFaces()) {
+            const std::array<uint64_t, 3> indices{face[0], face[1], face[2]};
+            writer.put(indices);
+        }
+        const std::vector<char> response = request(MessageType::LOAD_MESH, writer.getBuffer());
+        return PayloadReader{response}.get<uint64_t>();
+    }
+
+    uint64_t EvaluationClient::loadPolyhedron(const std::vector<std::string> &fileNames) {
+        using namespace ServiceProtocol;
+        PayloadWriter writer{};
+        writer.put<uint64_t>(fileNames.size());
+        for (const std::string &fileName: fileNames) {
+            writer.putString(fileName);
+        }
+        const std::vector<char> response = request(MessageType::LOAD_FILES, writer.getBuffer());
+        return PayloadReader{response}.get<uint64_t>();
+    }
+
+    void EvaluationClient::unloadPolyhedron(uint64_t id) {
+        using namespace ServiceProtocol;
+        PayloadWriter writer{};
+        writer.put(id);
+        request(MessageType::UNLOAD, writer.getBuffer());
+    }
+
+    std::vector<GravityModelResult> EvaluationClient::evaluate(uint64_t id, double density,
+                                                               const std::vector<Array3> &computationPoints) {
+        using namespace ServiceProtocol;
+        const size_t pointCount = computationPoints.size();
+        std::vector<GravityModelResult> results(pointCount);
+        PayloadWriter writer{};
+        writer.put(id);
+        writer.put(density);
+        writer.put<uint64_t>(pointCount);
+        if (pointCount < _sharedMemoryThreshold || pointCount == 0) {
+            writer.putArray(computationPoints.data(), pointCount);
+            const std::vector<char> response = request(MessageType::EVALUATE, writer.getBuffer());
+            PayloadReader reader{response};
+            std::array<double, RESULT_SIZE> values{};
+            for (GravityModelResult &result: results) {
+                reader.getArray(values.data(), values.size());
+                result = unpackResult(values.data());
+            }
+            return results;
+        }
+        //The points followed by the space for the results
+        const std::string name = "/polyhedralGravity_" + std::to_string(::getpid()) + "_" +
+                                 std::to_string(sharedMemoryCounter++);
+        const SharedMemorySegment segment =
+                SharedMemorySegment::create(name, (3 + RESULT_SIZE) * pointCount * sizeof(double));
+        std::memcpy(segment.data(), computationPoints.data(), pointCount * sizeof(Array3));
+        writer.putString(name);
+        request(MessageType::EVALUATE_SHARED, writer.getBuffer());
+        for (size_t i = 0; i < pointCount; ++i) {
+            results[i] = unpackResult(segment.data() + 3 * pointCount + RESULT_SIZE * i);
+        }
+        return results;
+    }
+
+    GravityModelResult EvaluationClient::evaluate(uint64_t id, double density, const Array3 &computationPoint) {
+        return evaluate(id, density, std::vector<Array3>{computationPoint}).front();
+    }
+
+}
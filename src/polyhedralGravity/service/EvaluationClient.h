@@ -0,0 +1,120 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <stdexcept>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/service/ServiceProtocol.h"
+
+#include <sys/un.h>
+
+namespace polyhedralGravity {
+
+    /**
+     * The client of an EvaluationServer, i.e. the connection of one process to the evaluation service.
+     * The batches of computation points are sent inline up to a threshold and via POSIX shared memory above it.
+     * @note A client is not thread-safe, every thread should use its own client.
+     */
+    class EvaluationClient {
+
+        /**
+         * The file descriptor of the connection
+         */
+        int _socket;
+
+        /**
+         * The minimal number of points which are exchanged via shared memory
+         */
+        size_t _sharedMemoryThreshold;
+
+    public:
+
+        /**
+         * The default minimal number of points which are exchanged via shared memory (about 400 KiB of results)
+         */
+        static constexpr size_t DEFAULT_SHARED_MEMORY_THRESHOLD = 4096;
+
+        /**
+         * Connects to an evaluation server.
+         * @param socketPath - the path of the Unix domain socket of the server
+         * @param sharedMemoryThreshold - the minimal number of points which are exchanged via shared memory
+         * @throws std::runtime_error if the connection fails
+         */
+        explicit EvaluationClient(const std::string &socketPath,
+                                  size_t sharedMemoryThreshold = DEFAULT_SHARED_MEMORY_THRESHOLD);
+
+        /**
+         * Closes the connection.
+         */
+        ~EvaluationClient();
+
+        EvaluationClient(const EvaluationClient &) = delete;
+
+        EvaluationClient &operator=(const EvaluationClient &) = delete;
+
+        /**
+         * Checks that the server answers.
+         * @throws std::runtime_error if the server does not answer
+         */
+        void ping();
+
+        /**
+         * Sends a polyhedron to the server, which keeps it in memory.
+         * @param polyhedron - the polyhedron
+         * @return the id of the polyhedron on the server
+         * @throws std::runtime_error if the server rejects the polyhedron
+         */
+        uint64_t loadPolyhedron(const Polyhedron &polyhedron);
+
+        /**
+         * Lets the server read a polyhedron from mesh files (see TetgenAdapter), which it keeps in memory.
+         * @param fileNames - the paths of the mesh files as seen by the server
+         * @return the id of the polyhedron on the server
+         * @throws std::runtime_error if the server cannot read the files
+         */
+        uint64_t loadPolyhedron(const std::vector<std::string> &fileNames);
+
+        /**
+         * Releases a polyhedron on the server.
+         * @param id - the id of the polyhedron
+         * @throws std::runtime_error if the id is unknown
+         */
+        void unloadPolyhedron(uint64_t id);
+
+        /**
+         * Evaluates the polyhedral gravity model on the server.
+         * @param id - the id of the polyhedron
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoints - vector of computation points
+         * @return the GravityModelResult foreach computation Point P
+         * @throws std::runtime_error if the evaluation fails, e.g. for an unknown id
+         */
+        std::vector<GravityModelResult> evaluate(uint64_t id, double density,
+                                                 const std::vector<Array3> &computationPoints);
+
+        /**
+         * Evaluates the polyhedral gravity model on the server for a single computation point.
+         * @param id - the id of the polyhedron
+         * @param density - the constant density in [kg/m^3]
+         * @param computationPoint - the computation point
+         * @return the GravityModelResult at the computation point
+         * @throws std::runtime_error if the evaluation fails, e.g. for an unknown id
+         */
+        GravityModelResult evaluate(uint64_t id, double density, const Array3 &computationPoint);
+
+    private:
+
+        /**
+         * Sends a request and waits for the response.
+         * @param type - the type of the request
+         * @param request - the payload of the request
+         * @return the payload of the successful response
+         * @throws std::runtime_error with the message of the server if the request fails
+         */
+        std::vector<char> request(ServiceProtocol::MessageType type, const std::vector<char> &request);
+
+    };
+
+}
@@ -0,0 +1,243 @@
+#include "EvaluationServer.h"
+
+namespace polyhedralGravity {
+
+    EvaluationServer::EvaluationServer(std::string socketPath)
+            : _socketPath{std::move(socketPath)} {}
+
+    EvaluationServer::~EvaluationServer() {
+        stop();
+    }
+
+    void EvaluationServer::start() {
+        if (_running.load()) {
+            throw std::runtime_error{"The evaluation server is already running!"};
+        }
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (_socketPath.size() >= sizeof(address.sun_path)) {
+            throw std::runtime_error{"The socket path " + _socketPath + " is too long!"};
+        }
+        std::copy(_socketPath.cbegin(), _socketPath.cend(), address.sun_path);
+
+        //A socket file left behind by a crashed server would make the bind fail, but the one of a running server
+        //must not be removed, so it is only unlinked if nobody accepts connections on it
+        const int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (probe < 0) {
+            throw std::runtime_error{std::string{"The socket could not be created: "} + std::strerror(errno)};
+        }
+        const bool connected = ::connect(probe, reinterpret_cast<const sockaddr *>(&address), sizeof(sockaddr_un)) == 0;
+        const int probeError = errno;
+        ::close(probe);
+        if (connected) {
+            throw std::runtime_error{"Another server is already listening on " + _socketPath + "!"};
+        }
+        if (probeError == ECONNREFUSED) {
+            ::unlink(_socketPath.c_str());
+        }
+
+        _listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (_listener < 0) {
+            throw std::runtime_error{std::string{"The socket could not be created: "} + std::strerror(errno)};
+        }
+        if (::bind(_listener, reinterpret_cast<const sockaddr *>(&address), sizeof(sockaddr_un)) != 0 ||
+            ::listen(_listener, SOMAXCONN) != 0) {
+            const int error = errno;
+            ::close(_listener);
+            _listener = -1;
+            throw std::runtime_error{"The socket " + _socketPath + " could not be bound: " + std::strerror(error)};
+        }
+        _running.store(true);
+        _acceptor = std::thread{&EvaluationServer::acceptConnections, this};
+        SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                           "The evaluation server listens on {}", _socketPath);
+    }
+
+    void EvaluationServer::stop() {
+        if (!_running.exchange(false)) {
+            return;
+        }
+        _acceptor.join();
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            //Wakes up the threads blocked in receiving the next request
+            for (const int connection: _connections) {
+                ::shutdown(connection, SHUT_RDWR);
+            }
+            _idle.wait(lock, [this] { return _connections.empty(); });
+        }
+        ::close(_listener);
+        _listener = -1;
+        ::unlink(_socketPath.c_str());
+        SPDLOG_LOGGER_INFO(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                           "The evaluation server on {} stopped", _socketPath);
+    }
+
+    bool EvaluationServer::isRunning() const {
+        return _running.load();
+    }
+
+    uint64_t EvaluationServer::addPolyhedron(Polyhedron polyhedron) {
+        std::lock_guard<std::mutex> lock{_mutex};
+        const uint64_t id = _nextId++;
+        _polyhedra.emplace(id, std::make_shared<const Polyhedron>(std::move(polyhedron)));
+        return id;
+    }
+
+    void EvaluationServer::removePolyhedron(uint64_t id) {
+        std::lock_guard<std::mutex> lock{_mutex};
+        if (_polyhedra.erase(id) == 0) {
+            throw std::invalid_argument{"There is no polyhedron with the id " + std::to_string(id) + "!"};
+        }
+    }
+
+    size_t EvaluationServer::countPolyhedra() const {
+        std::lock_guard<std::mutex> lock{_mutex};
+        return _polyhedra.size();
+    }
+
+    std::shared_ptr<const Polyhedron> EvaluationServer::getPolyhedron(uint64_t id) const {
+        std::lock_guard<std::mutex> lock{_mutex};
+        const auto it = _polyhedra.find(id);
+        if (it == _polyhedra.cend()) {
+            throw std::invalid_argument{"There is no polyhedron with the id " + std::to_string(id) + "!"};
+        }
+        return it->second;
+    }
+
+    void EvaluationServer::acceptConnections() {
+        pollfd listener{_listener, POLLIN, 0};
+        while (_running.load()) {
+            //The timeout bounds the time until a stop is noticed
+            if (::poll(&listener, 1, 100) <= 0) {
+                continue;
+            }
+            const int connection = ::accept(_listener, nullptr, nullptr);
+            if (connection < 0) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock{_mutex};
+            _connections.insert(connection);
+            std::thread{&EvaluationServer::serve, this, connection}.detach();
+        }
+    }
+
+    void EvaluationServer::serve(int connection) {
+        using namespace ServiceProtocol;
+        try {
+            Header header{};
+            std::vector<char> request{};
+            while (receiveMessage(connection, header, request)) {
+                Status status = Status::OK;
+                std::vector<char> response{};
+                try {
+                    response = handle(header, request);
+                } catch (const std::exception &e) {
+                    status = Status::ERROR;
+                    const std::string message{e.what()};
+                    response.assign(message.cbegin(), message.cend());
+                }
+                sendMessage(connection, static_cast<uint16_t>(status), response);
+            }
+        } catch (const std::exception &e) {
+            SPDLOG_LOGGER_DEBUG(PolyhedralGravityLogger::DEFAULT_LOGGER.getLogger(),
+                                "Closing a connection after an error: {}", e.what());
+        }
+        ::close(connection);
+        std::lock_guard<std::mutex> lock{_mutex};
+        _connections.erase(connection);
+        if (_connections.empty()) {
+            _idle.notify_all();
+        }
+    }
+
+    std::vector<char> EvaluationServer::handle(const ServiceProtocol::Header &header,
+                                               const std::vector<char> &request) {
+        using namespace ServiceProtocol;
+        PayloadReader reader{request};
+        PayloadWriter writer{};
+        switch (static_cast<MessageType>(header.code)) {
+            case MessageType::PING:
+                break;
+            case MessageType::LOAD_MESH: {
+                const auto vertexCount = reader.get<uint64_t>();
+                const auto faceCount = reader.get<uint64_t>();
+                if (vertexCount > request.size() || faceCount > request.size()) {
+                    throw std::runtime_error{"The payload of the message is truncated!"};
+                }
+                std::vector<Array3> vertices(vertexCount);
+                reader.getArray(vertices.data(), vertices.size());
+                std::vector<std::array<uint64_t, 3>> indices(faceCount);
+                reader.getArray(indices.data(), indices.size());
+                std::vector<std::array<size_t, 3>> faces(faceCount);
+                for (size_t face = 0; face < faceCount; ++face) {
+                    for (size_t corner = 0; corner < 3; ++corner) {
+                        if (indices[face][corner] >= vertexCount) {
+                            throw std::invalid_argument{"The face " + std::to_string(face) +
+                                                        " refers to a vertex which does not exist!"};
+                        }
+                        faces[face][corner] = indices[face][corner];
+                    }
+                }
+                writer.put(addPolyhedron({std::move(vertices), std::move(faces)}));
+                break;
+            }
+            case MessageType::LOAD_FILES: {
+                const auto fileCount = reader.get<uint64_t>();
+                std::vector<std::string> fileNames{};
+                for (uint64_t file = 0; file < fileCount; ++file) {
+                    fileNames.push_back(reader.getString());
+                }
+                writer.put(addPolyhedron(TetgenAdapter{fileNames}.getPolyhedron()));
+                break;
+            }
+            case MessageType::UNLOAD:
+                removePolyhedron(reader.get<uint64_t>());
+                break;
+            case MessageType::EVALUATE: {
+                const auto polyhedron = getPolyhedron(reader.get<uint64_t>());
+                const auto density = reader.get<double>();
+                const auto pointCount = reader.get<uint64_t>();
+                if (pointCount > MAX_INLINE_POINTS) {
+                    throw std::invalid_argument{"The batch of " + std::to_string(pointCount) + " points is too large, "
+                                                "use shared memory for large batches!"};
+                }
+                std::vector<Array3> points(pointCount);
+                reader.getArray(points.data(), points.size());
+                const auto results = GravityModel::evaluate(*polyhedron, density, points);
+                std::vector<double> values(RESULT_SIZE * results.size());
+                for (size_t i = 0; i < results.size(); ++i) {
+                    packResult(results[i], values.data() + RESULT_SIZE * i);
+                }
+                writer.putArray(values.data(), values.size());
+                break;
+            }
+            case MessageType::EVALUATE_SHARED: {
+                const auto polyhedron = getPolyhedron(reader.get<uint64_t>());
+                const auto density = reader.get<double>();
+                const auto pointCount = reader.get<uint64_t>();
+                if (pointCount > std::numeric_limits<size_t>::max() / ((3 + RESULT_SIZE) * sizeof(double))) {
+                    throw std::invalid_argument{"The batch of " + std::to_string(pointCount) + " points is too large!"};
+                }
+                //An empty batch has nothing to map (mmap(..) rejects a size of zero)
+                if (pointCount == 0) {
+                    static_cast<void>(reader.getString());
+                    break;
+                }
+                const SharedMemorySegment segment = SharedMemorySegment::open(
+                        reader.getString(), (3 + RESULT_SIZE) * pointCount * sizeof(double));
+                std::vector<Array3> points(pointCount);
+                std::memcpy(points.data(), segment.data(), pointCount * sizeof(Array3));
+                const auto results = GravityModel::evaluate(*polyhedron, density, points);
+                for (size_t i = 0; i < results.size(); ++i) {
+                    packResult(results[i], segment.data() + 3 * pointCount + RESULT_SIZE * i);
+                }
+                break;
+            }
+            default:
+                throw std::invalid_argument{"Unknown message type " + std::to_string(header.code) + "!"};
+        }
+        return writer.getBuffer();
+    }
+
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <unordered_map>
+#include <unordered_set>
+#include <limits>
+#include <stdexcept>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/input/TetgenAdapter.h"
+#include "polyhedralGravity/output/Logging.h"
+#include "polyhedralGravity/service/ServiceProtocol.h"
+
+#include <poll.h>
+#include <sys/un.h>
+
+namespace polyhedralGravity {
+
+    /**
+     * A long-running service which keeps polyhedra in memory and evaluates batches of computation points for
+     * other processes on the same machine, so these neither reload nor re-parse the mesh per query.
+     * The clients connect to a Unix domain socket and talk the binary ServiceProtocol (see EvaluationClient).
+     * Small batches are sent inline, large batches are exchanged via POSIX shared memory.
+     * Every connection is served by its own thread, and the evaluation itself uses GravityModel::evaluate(..),
+     * i.e. the selected kernel and parallelization.
+     */
+    class EvaluationServer {
+
+        /**
+         * The path of the socket
+         */
+        const std::string _socketPath;
+
+        /**
+         * The file descriptor of the listening socket, -1 if not started
+         */
+        int _listener{-1};
+
+        /**
+         * Whether the server accepts connections
+         */
+        std::atomic<bool> _running{false};
+
+        /**
+         * The thread accepting the connections
+         */
+        std::thread _acceptor;
+
+        /**
+         * Guards the polyhedra and the connections
+         */
+        mutable std::mutex _mutex;
+
+        /**
+         * The polyhedra by their id
+         */
+        std::unordered_map<uint64_t, std::shared_ptr<const Polyhedron>> _polyhedra;
+
+        /**
+         * The id of the next added polyhedron
+         */
+        uint64_t _nextId{1};
+
+        /**
+         * The file descriptors of the open connections
+         */
+        std::unordered_set<int> _connections;
+
+        /**
+         * Signals that the last connection has been closed
+         */
+        std::condition_variable _idle;
+
+    public:
+
+        /**
+         * Creates a server for the given socket path, which does not yet listen.
+         * @param socketPath - the path of the Unix domain socket
+         */
+        explicit EvaluationServer(std::string socketPath);
+
+        /**
+         * Stops the server.
+         */
+        ~EvaluationServer();
+
+        EvaluationServer(const EvaluationServer &) = delete;
+
+        EvaluationServer &operator=(const EvaluationServer &) = delete;
+
+        /**
+         * Binds the socket and starts accepting connections in the background. An existing socket file is only
+         * replaced if it is stale, i.e. if connecting to it is refused.
+         * @throws std::runtime_error if the socket cannot be bound, the server is already running or another server
+         * listens on the socket path
+         */
+        void start();
+
+        /**
+         * Stops accepting connections, closes the open ones after their current request and removes the socket file.
+         * Does nothing if the server is not running.
+         */
+        void stop();
+
+        /**
+         * Returns whether the server accepts connections.
+         * @return true if running
+         */
+        [[nodiscard]] bool isRunning() const;
+
+        /**
+         * Keeps a polyhedron in memory for the evaluations requested by the clients.
+         * @param polyhedron - the polyhedron
+         * @return the id of the polyhedron in the requests
+         */
+        uint64_t addPolyhedron(Polyhedron polyhedron);
+
+        /**
+         * Releases a polyhedron. Running evaluations keep their reference.
+         * @param id - the id of the polyhedron
+         * @throws std::invalid_argument if the id is unknown
+         */
+        void removePolyhedron(uint64_t id);
+
+        /**
+         * Returns the number of polyhedra kept in memory.
+         * @return the number of polyhedra
+         */
+        [[nodiscard]] size_t countPolyhedra() const;
+
+    private:
+
+        /**
+         * Accepts connections until the server stops.
+         */
+        void acceptConnections();
+
+        /**
+         * Answers the requests of one connection until the client disconnects or the server stops.
+         * @param connection - the file descriptor of the connection
+         */
+        void serve(int connection);
+
+        /**
+         * Executes one request.
+         * @param header - the header of the request
+         * @param request - the payload of the request
+         * @return the payload of the successful response
+         * @throws std::exception if the request fails, the message is sent back to the client
+         */
+        std::vector<char> handle(const ServiceProtocol::Header &header, const std::vector<char> &request);
+
+        /**
+         * Returns a polyhedron kept in memory.
+         * @param id - the id of the polyhedron
+         * @return the polyhedron
+         * @throws std::invalid_argument if the id is unknown
+         */
+        std::shared_ptr<const Polyhedron> getPolyhedron(uint64_t id) const;
+
+    };
+
+}
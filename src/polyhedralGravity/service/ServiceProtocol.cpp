@@ -0,0 +1,161 @@
+#include "ServiceProtocol.h"
+
+//Broken connections are reported by errors instead of SIGPIPE (macOS lacks the flag)
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace polyhedralGravity {
+
+    namespace {
+
+        /**
+         * Writes all bytes to a socket, retrying after interrupts and partial writes.
+         * @param socket - the file descriptor of the socket
+         * @param data - the bytes
+         * @param size - the number of bytes
+         * @throws std::runtime_error if the socket fails
+         */
+        void writeAll(int socket, const char *data, size_t size) {
+            while (size > 0) {
+                const ssize_t written = ::send(socket, data, size, MSG_NOSIGNAL);
+                if (written < 0 && errno == EINTR) {
+                    continue;
+                } else if (written <= 0) {
+                    throw std::runtime_error{std::string{"Sending to the socket failed: "} + std::strerror(errno)};
+                }
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+        }
+
+        /**
+         * Reads exactly the given number of bytes from a socket, retrying after interrupts and partial reads.
+         * @param socket - the file descriptor of the socket
+         * @param data - the bytes are stored in here
+         * @param size - the number of bytes
+         * @return the number of bytes read, less than the size only if the peer closed the connection
+         * @throws std::runtime_error if the socket fails
+         */
+        size_t readAll(int socket, char *data, size_t size) {
+            size_t total = 0;
+            while (total < size) {
+                const ssize_t received = ::recv(socket, data + total, size - total, 0);
+                if (received < 0 && errno == EINTR) {
+                    continue;
+                } else if (received < 0) {
+                    throw std::runtime_error{std::string{"Receiving from the socket failed: "} + std::strerror(errno)};
+                } else if (received == 0) {
+                    break;
+                }
+                total += static_cast<size_t>(received);
+            }
+            return total;
+        }
+
+    }
+
+    void ServiceProtocol::sendMessage(int socket, uint16_t code, const std::vector<char> &payload) {
+        Header header{};
+        header.code = code;
+        header.payloadSize = payload.size();
+        writeAll(socket, reinterpret_cast<const char *>(&header), sizeof(Header));
+        writeAll(socket, payload.data(), payload.size());
+    }
+
+    bool ServiceProtocol::receiveMessage(int socket, Header &header, std::vector<char> &payload) {
+        const size_t headerSize = readAll(socket, reinterpret_cast<char *>(&header), sizeof(Header));
+        if (headerSize == 0) {
+            return false;
+        } else if (headerSize < sizeof(Header)) {
+            throw std::runtime_error{"The connection was closed within the header of a message!"};
+        } else if (header.magic != MAGIC || header.version != VERSION) {
+            throw std::runtime_error{"The message does not belong to version " + std::to_string(VERSION) +
+                                     " of the protocol!"};
+        } else if (header.payloadSize > MAX_PAYLOAD_SIZE) {
+            throw std::runtime_error{"The payload of " + std::to_string(header.payloadSize) + " bytes is too large, "
+                                     "use shared memory for large batches!"};
+        }
+        payload.resize(header.payloadSize);
+        if (readAll(socket, payload.data(), payload.size()) < payload.size()) {
+            throw std::runtime_error{"The connection was closed within the payload of a message!"};
+        }
+        return true;
+    }
+
+    void ServiceProtocol::packResult(const GravityModelResult &result, double *destination) {
+        destination[0] = result.gravitationalPotential;
+        std::copy(result.acceleration.cbegin(), result.acceleration.cend(), destination + 1);
+        std::copy(result.gradiometricTensor.cbegin(), result.gradiometricTensor.cend(), destination + 4);
+    }
+
+    GravityModelResult ServiceProtocol::unpackResult(const double *source) {
+        GravityModelResult result{};
+        result.gravitationalPotential = source[0];
+        std::copy(source + 1, source + 4, result.acceleration.begin());
+        std::copy(source + 4, source + RESULT_SIZE, result.gradiometricTensor.begin());
+        return result;
+    }
+
+    ServiceProtocol::SharedMemorySegment::SharedMemorySegment(std::string name, size_t size, void *data, bool owner)
+            : _name{std::move(name)}, _size{size}, _data{data}, _owner{owner} {}
+
+    ServiceProtocol::SharedMemorySegment::SharedMemorySegment(SharedMemorySegment &&other) noexcept
+            : _name{std::move(other._name)}, _size{other._size}, _data{other._data}, _owner{other._owner} {
+        other._data = nullptr;
+        other._owner = false;
+    }
+
+    ServiceProtocol::SharedMemorySegment::~SharedMemorySegment() {
+        if (_data != nullptr) {
+            ::munmap(_data, _size);
+        }
+        if (_owner) {
+            ::shm_unlink(_name.c_str());
+        }
+    }
+
+    ServiceProtocol::SharedMemorySegment ServiceProtocol::SharedMemorySegment::create(const std::string &name,
+                                                                                      size_t size) {
+        const int descriptor = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+        if (descriptor < 0) {
+            throw std::runtime_error{"The shared memory " + name + " could not be created: " + std::strerror(errno)};
+        }
+        void *data = MAP_FAILED;
+        if (::ftruncate(descriptor, static_cast<off_t>(size)) == 0) {
+            data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+        }
+        const int error = errno;
+        ::close(descriptor);
+        if (data == MAP_FAILED) {
+            ::shm_unlink(name.c_str());
+            throw std::runtime_error{"The shared memory " + name + " could not be mapped: " + std::strerror(error)};
+        }
+        return {name, size, data, true};
+    }
+
+    ServiceProtocol::SharedMemorySegment ServiceProtocol::SharedMemorySegment::open(const std::string &name,
+                                                                                    size_t size) {
+        const int descriptor = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (descriptor < 0) {
+            throw std::runtime_error{"The shared memory " + name + " could not be opened: " + std::strerror(errno)};
+        }
+        struct stat status{};
+        if (::fstat(descriptor, &status) != 0 || static_cast<size_t>(status.st_size) < size) {
+            ::close(descriptor);
+            throw std::runtime_error{"The shared memory " + name + " is smaller than the batch of points!"};
+        }
+        void *data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+        const int error = errno;
+        ::close(descriptor);
+        if (data == MAP_FAILED) {
+            throw std::runtime_error{"The shared memory " + name + " could not be mapped: " + std::strerror(error)};
+        }
+        return {name, size, data, false};
+    }
+
+    double *ServiceProtocol::SharedMemorySegment::data() const {
+        return static_cast<double *>(_data);
+    }
+
+}
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include <utility>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <type_traits>
+#include "polyhedralGravity/model/GravityModelData.h"
+
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+namespace polyhedralGravity {
+
+    /**
+     * The binary protocol between the EvaluationServer and the EvaluationClient over a Unix domain socket.
+     * Every message consists of a Header followed by a payload of Header::payloadSize bytes. The values are
+     * written in the native byte order, since both sides run on the same machine.
+     *
+     * Requests (the code of the header is the MessageType) and the payload of their successful responses:
+     * - PING: empty -> empty
+     * - LOAD_MESH: uint64 vertex count, uint64 face count, 3 doubles per vertex, 3 uint64 per face -> uint64 mesh id
+     * - LOAD_FILES: uint64 file count, per file a string (uint64 length and characters) -> uint64 mesh id
+     * - UNLOAD: uint64 mesh id -> empty
+     * - EVALUATE: uint64 mesh id, double density, uint64 point count, 3 doubles per point
+     *   -> RESULT_SIZE doubles per point (potential, acceleration, gradiometric tensor)
+     * - EVALUATE_SHARED: uint64 mesh id, double density, uint64 point count, string name of a POSIX shared memory
+     *   object holding 3 doubles per point followed by space for RESULT_SIZE doubles per point -> empty, the
+     *   results are written into the shared memory object
+     *
+     * Responses have the code Status::OK or Status::ERROR, the payload of the latter is the error message.
+     */
+    namespace ServiceProtocol {
+
+        /**
+         * The first four bytes of every message ("PGRV")
+         */
+        constexpr uint32_t MAGIC = 0x50475256;
+
+        /**
+         * The version of the protocol, messages of another version are rejected
+         */
+        constexpr uint16_t VERSION = 1;
+
+        /**
+         * The maximal size of a payload in bytes, larger batches of points must use EVALUATE_SHARED
+         */
+        constexpr uint64_t MAX_PAYLOAD_SIZE = uint64_t{1} << 28;
+
+        /**
+         * The number of doubles of one GravityModelResult
+         */
+        constexpr size_t RESULT_SIZE = 10;
+
+        /**
+         * The maximal number of points of an EVALUATE request, so that the response fits into MAX_PAYLOAD_SIZE
+         */
+        constexpr uint64_t MAX_INLINE_POINTS = MAX_PAYLOAD_SIZE / (RESULT_SIZE * sizeof(double));
+
+        /**
+         * The kinds of requests
+         */
+        enum class MessageType : uint16_t {
+            PING = 0,
+            LOAD_MESH = 1,
+            LOAD_FILES = 2,
+            UNLOAD = 3,
+            EVALUATE = 4,
+            EVALUATE_SHARED = 5
+        };
+
+        /**
+         * The outcome of a request
+         */
+        enum class Status : uint16_t {
+            OK = 0,
+            ERROR = 1
+        };
+
+        /**
+         * The fixed-size header of every message
+         */
+        struct Header {
+
+            /**
+             * Always MAGIC
+             */
+            uint32_t magic{MAGIC};
+
+            /**
+             * The version of the protocol of the sender
+             */
+            uint16_t version{VERSION};
+
+            /**
+             * The MessageType of a request or the Status of a response
+             */
+            uint16_t code{0};
+
+            /**
+             * The number of bytes following the header
+             */
+            uint64_t payloadSize{0};
+
+        };
+
+        /**
+         * Serializes values into a payload.
+         */
+        class PayloadWriter {
+
+            std::vector<char> _buffer{};
+
+        public:
+
+            /**
+             * Appends a value.
+             */
+            template<typename T>
+            void put(const T &value) {
+                static_assert(std::is_trivially_copyable_v<T>);
+                putArray(&value, 1);
+            }
+
+            /**
+             * Appends count values of type T.
+             */
+            template<typename T>
+            void putArray(const T *values, size_t count) {
+                static_assert(std::is_trivially_copyable_v<T>);
+                const size_t offset = _buffer.size();
+                _buffer.resize(offset + count * sizeof(T));
+                if (count > 0) {
+                    std::memcpy(_buffer.data() + offset, values, count * sizeof(T));
+                }
+            }
+
+            /**
+             * Appends a string as its length followed by its characters.
+             */
+            void putString(const std::string &value) {
+                put<uint64_t>(value.size());
+                putArray(value.data(), value.size());
+            }
+
+            /**
+             * Returns the serialized payload.
+             */
+            [[nodiscard]] const std::vector<char> &getBuffer() const {
+                return _buffer;
+            }
+
+        };
+
+        /**
+         * Deserializes values from a payload.
+         */
+        class PayloadReader {
+
+            const std::vector<char> &_buffer;
+
+            size_t _position{0};
+
+        public:
+
+            explicit PayloadReader(const std::vector<char> &buffer) : _buffer{buffer} {}
+
+            /**
+             * Reads a value.
+             * @throws std::runtime_error if the payload is too short
+             */
+            template<typename T>
+            T get() {
+                T value{};
+                getArray(&value, 1);
+                return value;
+            }
+
+            /**
+             * Reads count values of type T.
+             * @throws std::runtime_error if the payload is too short
+             */
+            template<typename T>
+            void getArray(T *values, size_t count) {
+                static_assert(std::is_trivially_copyable_v<T>);
+                if (count > (_buffer.size() - _position) / sizeof(T)) {
+                    throw std::runtime_error{"The payload of the message is truncated!"};
+                }
+                std::memcpy(values, _buffer.data() + _position, count * sizeof(T));
+                _position += count * sizeof(T);
+            }
+
+            /**
+             * Reads a string given by its length and its characters.
+             * @throws std::runtime_error if the payload is too short
+             */
+            std::string getString() {
+                const auto length = get<uint64_t>();
+                if (length > _buffer.size() - _position) {
+                    throw std::runtime_error{"The payload of the message is truncated!"};
+                }
+                std::string value(_buffer.data() + _position, length);
+                _position += length;
+                return value;
+            }
+
+        };
+
+        /**
+         * A mapped POSIX shared memory object holding the points and the results of EVALUATE_SHARED.
+         * The creator unlinks the object on destruction.
+         */
+        class SharedMemorySegment {
+
+            std::string _name;
+
+            size_t _size;
+
+            void *_data;
+
+            bool _owner;
+
+        public:
+
+            /**
+             * Creates and maps a new shared memory object.
+             * @param name - the name of the object, starting with a slash
+             * @param size - the size in bytes
+             * @return the mapped segment, which unlinks the object on destruction
+             * @throws std::runtime_error if the object cannot be created or mapped
+             */
+            static SharedMemorySegment create(const std::string &name, size_t size);
+
+            /**
+             * Opens and maps an existing shared memory object.
+             * @param name - the name of the object
+             * @param size - the required size in bytes
+             * @return the mapped segment
+             * @throws std::runtime_error if the object cannot be opened or mapped or is smaller than required
+             */
+            static SharedMemorySegment open(const std::string &name, size_t size);
+
+            SharedMemorySegment(const SharedMemorySegment &) = delete;
+
+            SharedMemorySegment(SharedMemorySegment &&other) noexcept;
+
+            SharedMemorySegment &operator=(const SharedMemorySegment &) = delete;
+
+            SharedMemorySegment &operator=(SharedMemorySegment &&) = delete;
+
+            /**
+             * Unmaps the segment and unlinks the object if this segment created it.
+             */
+            ~SharedMemorySegment();
+
+            /**
+             * Returns the mapped memory as doubles.
+             * @return the first double of the segment
+             */
+            [[nodiscard]] double *data() const;
+
+        private:
+
+            SharedMemorySegment(std::string name, size_t size, void *data, bool owner);
+
+        };
+
+        /**
+         * Sends a message.
+         * @param socket - the file descriptor of the connected socket
+         * @param code - the MessageType of a request or the Status of a response
+         * @param payload - the payload
+         * @throws std::runtime_error if the message cannot be sent completely
+         */
+        void sendMessage(int socket, uint16_t code, const std::vector<char> &payload);
+
+        /**
+         * Receives a message.
+         * @param socket - the file descriptor of the connected socket
+         * @param header - the header of the message is stored in here
+         * @param payload - the payload of the message is stored in here
+         * @return false if the peer closed the connection before the message, true otherwise
+         * @throws std::runtime_error if the message is incomplete, of another protocol version or too large
+         */
+        bool receiveMessage(int socket, Header &header, std::vector<char> &payload);
+
+        /**
+         * Writes a result as RESULT_SIZE consecutive doubles.
+         * @param result - the result
+         * @param destination - the first of RESULT_SIZE doubles
+         */
+        void packResult(const GravityModelResult &result, double *destination);
+
+        /**
+         * Reads a result from RESULT_SIZE consecutive doubles.
+         * @param source - the first of RESULT_SIZE doubles
+         * @return the result
+         */
+        GravityModelResult unpackResult(const double *source);
+
+    }
+
+}
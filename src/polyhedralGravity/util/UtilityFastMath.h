@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "polyhedralGravity/util/UtilityConstants.h"
+
+namespace polyhedralGravity::util {
+
+    /**
+     * The upper bound for the relative error of fastLog(..) and fastAtan(..), the approximations of the
+     * transcendental functions used by MathBackend::FAST.
+     * The polynomials are Chebyshev approximations (close to the minimax polynomials) of the reduced functions
+     * whose errors are below the rounding errors, i.e. the bound is about five units in the last place.
+     */
+    constexpr double FAST_MATH_MAX_RELATIVE_ERROR = 1e-15;
+
+    namespace fastMath {
+
+        /**
+         * ln(2) split into a part which is exact when multiplied by an exponent and the remainder
+         */
+        constexpr double LN2_HI = 6.93147180369123816490e-01;
+        constexpr double LN2_LO = 1.90821492927058770002e-10;
+
+        /**
+         * The bit pattern of sqrt(2)/2, the lower limit of the reduced argument of the logarithm
+         */
+        constexpr std::uint64_t SQRT1_2_BITS = 0x3FE6A09E667F3BCDull;
+
+        /**
+         * tan(pi/8) and tan(3pi/8), the limits of the reductions of the arctangent's argument
+         */
+        constexpr double TAN_PI_8 = 0.4142135623730950488016887242096980785696718753769480731766797380;
+        constexpr double TAN_3PI_8 = 2.4142135623730950488016887242096980785696718753769480731766797380;
+
+        /**
+         * Approximation of atanh(s) / s in z = s^2 for z in [0, (3 - 2 * sqrt(2))^2], error 1.2e-18
+         */
+        constexpr std::array<double, 8> LOG_COEFFICIENTS{
+                1.0, 3.3333333333333823e-1, 1.9999999999651169e-1, 1.428571438032084e-1,
+                1.1111098528363023e-1, 9.0918158401146644e-2, 7.6562640741820955e-2, 7.4048551803276383e-2};
+
+        /**
+         * Approximation of atan(x) / x in z = x^2 for z in [0, tan(pi/8)^2], error 3.5e-17
+         */
+        constexpr std::array<double, 11> ATAN_COEFFICIENTS{
+                9.9999999999999997e-1, -3.3333333333328439e-1, 1.999999999885511e-1, -1.4285714180976467e-1,
+                1.1111106180455945e-1, -9.0907730748084138e-2, 7.6899534963068578e-2, -6.6402339304294086e-2,
+                5.6883492268090105e-2, -4.3480522157164625e-2, 2.1135373157693245e-2};
+
+        /**
+         * Evaluates a polynomial with the Horner scheme, unrolled at compile time.
+         * @tparam I - the index of the current coefficient
+         * @tparam N - the number of coefficients
+         * @param coefficients - the coefficients, the constant one first
+         * @param z - the argument
+         * @return the value of the polynomial
+         */
+        template<size_t I = 0, size_t N>
+        inline double horner(const std::array<double, N> &coefficients, double z) {
+            if constexpr (I + 1 == N) {
+                return coefficients[I];
+            } else {
+                return coefficients[I] + z * horner<I + 1>(coefficients, z);
+            }
+        }
+
+    }
+
+    /**
+     * The natural logarithm with a maximum relative error of about 4e-16.
+     * The argument is reduced to x = m * 2^e with m in [sqrt(2)/2, sqrt(2)), then
+     * log(m) = 2 * atanh(s) with s = (m - 1) / (m + 1) is approximated by a polynomial.
+     * Zero, negative, subnormal and non-finite arguments are passed to std::log(..).
+     * @param x - the argument
+     * @return log(x)
+     */
+    inline double fastLog(double x) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(double));
+        const auto biasedExponent = static_cast<int>((bits >> 52) & 0x7FF);
+        if ((bits >> 63) != 0 || biasedExponent == 0 || biasedExponent == 0x7FF) {
+            return std::log(x);
+        }
+        //m in [sqrt(2)/2, sqrt(2)) by subtracting the exponent e of x / (sqrt(2)/2) from the exponent bits
+        const auto exponent = static_cast<std::int64_t>(bits - fastMath::SQRT1_2_BITS) >> 52;
+        bits -= static_cast<std::uint64_t>(exponent) << 52;
+        double mantissa;
+        std::memcpy(&mantissa, &bits, sizeof(double));
+        const double s = (mantissa - 1.0) / (mantissa + 1.0);
+        const double logMantissa = 2.0 * s * fastMath::horner(fastMath::LOG_COEFFICIENTS, s * s);
+        const auto e = static_cast<double>(exponent);
+        return e * fastMath::LN2_HI + (logMantissa + e * fastMath::LN2_LO);
+    }
+
+    /**
+     * The arctangent with a maximum relative error of about 4e-16.
+     * The argument is reduced to |x| <= tan(pi/8) by atan(x) = pi/2 + atan(-1/x) for x > tan(3pi/8) and
+     * atan(x) = pi/4 + atan((x - 1) / (x + 1)) for x > tan(pi/8), then atan(x) / x is approximated by a
+     * polynomial in x^2.
+     * @param x - the argument
+     * @return atan(x)
+     */
+    inline double fastAtan(double x) {
+        //Branch-free with a single division, since the arguments are spread over all ranges
+        const double absolute = std::abs(x);
+        const bool large = absolute > fastMath::TAN_3PI_8;
+        const bool medium = absolute > fastMath::TAN_PI_8;
+        const double numerator = large ? -1.0 : (medium ? absolute - 1.0 : absolute);
+        const double denominator = large ? absolute : (medium ? absolute + 1.0 : 1.0);
+        const double a = numerator / denominator;
+        const double offset = large ? PI_2 : (medium ? PI_2 / 2.0 : 0.0);
+        return std::copysign(offset + a * fastMath::horner(fastMath::ATAN_COEFFICIENTS, a * a), x);
+    }
+
+}
@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "polyhedralGravity/calculation/Autotuner.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "TestPolyhedra.h"
+
+#include <unistd.h>
+
+/**
+ * Contains Tests for the autotuning of the kernel variants and their block sizes
+ */
+class AutotunerTest : public ::testing::Test {
+
+protected:
+
+    //A cube with the edge length 2 centered at the origin
+    const polyhedralGravity::Polyhedron _cube{polyhedralGravity::TestPolyhedra::createCube()};
+
+    const double _density = 1.0;
+
+    const std::vector<polyhedralGravity::Array3> _points = [] {
+        std::vector<polyhedralGravity::Array3> points{};
+        for (int i = 0; i < 100; ++i) {
+            points.push_back({-3.0 + 0.06 * i, 0.5 - 0.02 * i, 2.0 - 0.04 * i});
+        }
+        return points;
+    }();
+
+    //Unique per process, so that tests running in parallel do not share the profile
+    const std::string _profilePath = "/tmp/polyhedralGravity_profile_" + std::to_string(::getpid()) + ".tsv";
+
+    void TearDown() override {
+        polyhedralGravity::EvaluationSettings::setKernelVariant(polyhedralGravity::KernelVariant::AUTO);
+        polyhedralGravity::EvaluationSettings::setMathBackend(polyhedralGravity::MathBackend::ACCURATE);
+        polyhedralGravity::EvaluationSettings::setFarFieldAccuracy(0.0);
+        polyhedralGravity::Autotuner::setProfileFile("");
+        polyhedralGravity::Autotuner::clearProfile();
+        std::remove(_profilePath.c_str());
+    }
+
+};
+
+TEST_F(AutotunerTest, SizeClass) {
+    using namespace polyhedralGravity;
+    EXPECT_EQ(Autotuner::sizeClass(0), 0);
+    EXPECT_EQ(Autotuner::sizeClass(1), 0);
+    EXPECT_EQ(Autotuner::sizeClass(12), 3);
+    EXPECT_EQ(Autotuner::sizeClass(1024), 10);
+    EXPECT_EQ(Autotuner::sizeClass(14744), 13);
+    EXPECT_FALSE(Autotuner::cpuModel().empty());
+}
+
+TEST_F(AutotunerTest, TuneAndLookup) {
+    using namespace polyhedralGravity;
+    ASSERT_FALSE(Autotuner::lookup(_cube.countFaces()).has_value());
+    const TuningParameters best = Autotuner::tune(_cube, Autotuner::MIN_POINTS);
+    const auto candidates = Autotuner::candidates(_cube.countFaces());
+    EXPECT_NE(std::find(candidates.cbegin(), candidates.cend(), best), candidates.cend());
+    //A mesh of the same size class shares the entry
+    ASSERT_TRUE(Autotuner::lookup(_cube.countFaces()).has_value());
+    EXPECT_EQ(*Autotuner::lookup(15), best);
+    EXPECT_FALSE(Autotuner::lookup(16).has_value());
+}
+
+TEST_F(AutotunerTest, ProfileFileRoundTrip) {
+    using namespace polyhedralGravity;
+    Autotuner::setProfileFile(_profilePath);
+    const TuningParameters best = Autotuner::tune(_cube, Autotuner::MIN_POINTS);
+    //Another process has written an entry for another machine in the meantime
+    {
+        std::ofstream file{_profilePath, std::ios::app};
+        file << "Other CPU\t10\tBATCHED\t4\t0\n";
+    }
+    Autotuner::store(Autotuner::cpuModel(), 20, {KernelVariant::TILED, 32, 256});
+    Autotuner::saveProfile();
+
+    Autotuner::setProfileFile("");
+    Autotuner::clearProfile();
+    ASSERT_FALSE(Autotuner::lookup(_cube.countFaces()).has_value());
+    Autotuner::setProfileFile(_profilePath);
+    ASSERT_TRUE(Autotuner::lookup(_cube.countFaces()).has_value());
+    EXPECT_EQ(*Autotuner::lookup(_cube.countFaces()), best);
+    EXPECT_EQ(*Autotuner::lookup(size_t{1} << 20), (TuningParameters{KernelVariant::TILED, 32, 256}));
+
+    std::ifstream file{_profilePath};
+    const std::string content{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    EXPECT_NE(content.find("Other CPU\t10\tBATCHED\t4\t0"), std::string::npos);
+}
+
+TEST_F(AutotunerTest, MalformedProfile) {
+    using namespace polyhedralGravity;
+    {
+        std::ofstream file{_profilePath};
+        file << "# comment\nSome CPU\t3\tTILED\t16\n";
+    }
+    ASSERT_THROW(Autotuner::setProfileFile(_profilePath), std::runtime_error);
+    {
+        std::ofstream file{_profilePath};
+        file << "Some CPU\t3\tAUTO\t0\t0\n";
+    }
+    ASSERT_THROW(Autotuner::setProfileFile(_profilePath), std::runtime_error);
+    ASSERT_THROW(Autotuner::store("Some CPU", 3, {KernelVariant::AUTO, 0, 0}), std::invalid_argument);
+    ASSERT_THROW(Autotuner::store("Some CPU", 3, {KernelVariant::TILED, 16, 0}), std::invalid_argument);
+    ASSERT_THROW(Autotuner::saveProfile(), std::runtime_error);
+}
+
+TEST_F(AutotunerTest, TunedEvaluation) {
+    using namespace polyhedralGravity;
+    EvaluationSettings::setKernelVariant(KernelVariant::POINTWISE);
+    const auto expected = GravityModel::evaluate(_cube, _density, _points);
+    EvaluationSettings::setKernelVariant(KernelVariant::AUTO);
+
+    //Every candidate, whether chosen by the profile or not, agrees with the pointwise evaluation
+    for (const TuningParameters &candidate: Autotuner::candidates(_cube.countFaces())) {
+        Autotuner::clearProfile();
+        Autotuner::store(Autotuner::cpuModel(), Autotuner::sizeClass(_cube.countFaces()), candidate);
+        const auto actual = GravityModel::evaluate(_cube, _density, _points);
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < actual.size(); ++i) {
+            EXPECT_NEAR(actual[i].gravitationalPotential, expected[i].gravitationalPotential,
+                        1e-12 * std::abs(expected[i].gravitationalPotential))
+                                << EvaluationSettings::toString(candidate.variant) << " at point " << i;
+            for (size_t j = 0; j < 3; ++j) {
+                EXPECT_NEAR(actual[i].acceleration[j], expected[i].acceleration[j], 1e-20)
+                                    << EvaluationSettings::toString(candidate.variant) << " at point " << i;
+            }
+        }
+    }
+}
+
+TEST_F(AutotunerTest, PointLanesSkippedForApproximations) {
+    using namespace polyhedralGravity;
+    Autotuner::store(Autotuner::cpuModel(), Autotuner::sizeClass(_cube.countFaces()),
+                     {KernelVariant::POINT_LANES, 0, 0});
+    //The lanes ignore both approximations, so the entry must not replace the pointwise evaluation honouring them
+    for (const bool fastMath: {true, false}) {
+        EvaluationSettings::setMathBackend(fastMath ? MathBackend::FAST : MathBackend::ACCURATE);
+        EvaluationSettings::setFarFieldAccuracy(fastMath ? 0.0 : 1e-3);
+        EvaluationSettings::setKernelVariant(KernelVariant::POINTWISE);
+        const auto expected = GravityModel::evaluate(_cube, _density, _points);
+        EvaluationSettings::setKernelVariant(KernelVariant::AUTO);
+        const auto actual = GravityModel::evaluate(_cube, _density, _points);
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+            EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include "polyhedralGravity/input/TetgenAdapter.h"
+#include "polyhedralGravity/calculation/BatchedKernel.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+
+/**
+ * Contains Tests for the evaluation with the batched matrix product stage
+ */
+class BatchedKernelTest : public ::testing::Test {
+
+protected:
+
+    //The Eros mesh with 14744 faces
+    const polyhedralGravity::Polyhedron _polyhedron{
+            polyhedralGravity::TetgenAdapter{
+                    {"resources/GravityModelBigTest.node", "resources/GravityModelBigTest.face"}}.getPolyhedron()};
+
+    const double _density = 2670.0;
+
+    //Points inside, close to the surface and far outside of the polyhedron, the last ones are a vertex and a
+    //point on the plane of the first face
+    const std::vector<std::array<double, 3>> _points = [this] {
+        using namespace polyhedralGravity::util;
+        std::vector<std::array<double, 3>> points{};
+        for (int i = 0; i < 13; ++i) {
+            points.push_back({-1.5 + 0.25 * i, 0.1 * std::sin(i), 0.05 * i - 0.3});
+        }
+        points.push_back({40.0, -25.0, 10.0});
+        points.push_back(_polyhedron.getVertex(17));
+        const auto &face = _polyhedron.getFaces()[0];
+        points.push_back((_polyhedron.getVertex(face[0]) + _polyhedron.getVertex(face[1])) * 0.5);
+        return points;
+    }();
+
+    void TearDown() override {
+        polyhedralGravity::EvaluationSettings::setKernelVariant(polyhedralGravity::KernelVariant::AUTO);
+        polyhedralGravity::EvaluationSettings::setFarFieldAccuracy(0.0);
+    }
+
+};
+
+TEST_F(BatchedKernelTest, MatchesPointwiseEvaluation) {
+    using namespace polyhedralGravity;
+    EvaluationSettings::setKernelVariant(KernelVariant::POINTWISE);
+    const auto expected = GravityModel::evaluate(_polyhedron, _density, _points);
+    EvaluationSettings::setKernelVariant(KernelVariant::BATCHED);
+    const auto actual = GravityModel::evaluate(_polyhedron, _density, _points);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        //Far away from the polyhedron, the contributions of the faces cancel out and already the pointwise
+        //evaluation is only accurate to about 1e-8 (e.g. under a translation of the whole setting)
+        const double tolerance = i == 13 ? 1e-7 : 1e-11;
+        EXPECT_NEAR(actual[i].gravitationalPotential, expected[i].gravitationalPotential,
+                    tolerance * std::abs(expected[i].gravitationalPotential));
+        const double accelerationNorm = util::euclideanNorm(expected[i].acceleration);
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_NEAR(actual[i].acceleration[j], expected[i].acceleration[j], tolerance * accelerationNorm);
+        }
+        for (size_t j = 0; j < 6; ++j) {
+            EXPECT_NEAR(actual[i].gradiometricTensor[j], expected[i].gradiometricTensor[j],
+                        100.0 * tolerance * accelerationNorm);
+        }
+    }
+}
+
+TEST_F(BatchedKernelTest, FarFieldAccuracy) {
+    using namespace polyhedralGravity;
+    EvaluationSettings::setKernelVariant(KernelVariant::BATCHED);
+    const auto exact = GravityModel::evaluate(_polyhedron, _density, _points);
+    EvaluationSettings::setFarFieldAccuracy(1e-3);
+    EvaluationSettings::setKernelVariant(KernelVariant::POINTWISE);
+    const auto expected = GravityModel::evaluate(_polyhedron, _density, _points);
+    EvaluationSettings::setKernelVariant(KernelVariant::BATCHED);
+    const auto actual = GravityModel::evaluate(_polyhedron, _density, _points);
+    ASSERT_EQ(actual.size(), expected.size());
+    //The distant point is approximated by the moments of (nearly) all faces, the same ones in both evaluations
+    EXPECT_NE(actual[13].gravitationalPotential, exact[13].gravitationalPotential);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        const double tolerance = i == 13 ? 1e-7 : 1e-11;
+        EXPECT_NEAR(actual[i].gravitationalPotential, expected[i].gravitationalPotential,
+                    tolerance * std::abs(expected[i].gravitationalPotential));
+        const double accelerationNorm = util::euclideanNorm(expected[i].acceleration);
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_NEAR(actual[i].acceleration[j], expected[i].acceleration[j], tolerance * accelerationNorm);
+        }
+    }
+}
+
+TEST_F(BatchedKernelTest, DistanceStage) {
+    using namespace polyhedralGravity;
+    const PreparedPolyhedron prepared = BatchedKernel::prepare(_polyhedron);
+    const std::vector<Array3> points{_points.begin(), _points.begin() + 3};
+    const auto constants = BatchedKernel::computePlaneConstants(prepared, points);
+    const auto distances = BatchedKernel::computeVertexDistances(prepared, points);
+    for (size_t i = 0; i < points.size(); ++i) {
+        for (size_t face = 0; face < _polyhedron.countFaces(); face += 97) {
+            using namespace util;
+            const auto &indices = _polyhedron.getFaces()[face];
+            const HessianPlane expected = GravityModel::detail::computeHessianPlane(
+                    _polyhedron.getVertex(indices[0]) - points[i], _polyhedron.getVertex(indices[1]) - points[i],
+                    _polyhedron.getVertex(indices[2]) - points[i]);
+            EXPECT_NEAR(constants[i * _polyhedron.countFaces() + face], expected.d, 1e-14);
+        }
+        for (size_t vertex = 0; vertex < _polyhedron.countVertices(); vertex += 31) {
+            using namespace util;
+            EXPECT_NEAR(distances[i * _polyhedron.countVertices() + vertex],
+                        euclideanNorm(_polyhedron.getVertex(vertex) - points[i]), 1e-14);
+        }
+    }
+}
+
+TEST_F(BatchedKernelTest, MatrixProduct) {
+    using namespace polyhedralGravity;
+    //(2 x 3) x (4 x 3)^T, the blocking over the columns is covered by the evaluations of the Eros mesh
+    const std::vector<double> a{1.0, 2.0, 3.0, -1.0, 0.5, 2.0};
+    const std::vector<double> b{1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0};
+    std::vector<double> c(8);
+    BatchedKernel::detail::gemm(2, 4, 3, a.data(), b.data(), c.data());
+    ASSERT_THAT(c, testing::ElementsAre(1.0, 2.0, 3.0, 6.0, -1.0, 0.5, 2.0, 1.5));
+    ASSERT_THROW(static_cast<void>(BatchedKernel::evaluate(_polyhedron, _density, _points, 0)),
+                 std::invalid_argument);
+}
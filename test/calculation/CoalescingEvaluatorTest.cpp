@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+#include <thread>
+#include <future>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include "polyhedralGravity/calculation/CoalescingEvaluator.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/input/TetgenAdapter.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+
+/**
+ * Contains Tests for the evaluator batching the concurrent single point requests
+ */
+class CoalescingEvaluatorTest : public ::testing::Test {
+
+protected:
+
+    //The Eros mesh with 14744 faces
+    const polyhedralGravity::Polyhedron _polyhedron{
+            polyhedralGravity::TetgenAdapter{
+                    {"resources/GravityModelBigTest.node", "resources/GravityModelBigTest.face"}}.getPolyhedron()};
+
+    const double _density = 2670.0;
+
+    const std::vector<polyhedralGravity::Array3> _points = [] {
+        std::vector<polyhedralGravity::Array3> points{};
+        for (int i = 0; i < 40; ++i) {
+            points.push_back({-30.0 + 1.7 * i, 0.3 * i - 5.0, 12.0 - 0.5 * i});
+        }
+        return points;
+    }();
+
+    static void expectEqual(const polyhedralGravity::GravityModelResult &actual,
+                            const polyhedralGravity::GravityModelResult &expected) {
+        EXPECT_EQ(actual.gravitationalPotential, expected.gravitationalPotential);
+        EXPECT_EQ(actual.acceleration, expected.acceleration);
+        EXPECT_EQ(actual.gradiometricTensor, expected.gradiometricTensor);
+    }
+
+};
+
+TEST_F(CoalescingEvaluatorTest, ConcurrentRequests) {
+    using namespace polyhedralGravity;
+    const auto expected = GravityModel::evaluate(_polyhedron, _density, _points);
+    CoalescingEvaluator evaluator{_polyhedron, _density, std::chrono::milliseconds{2}, 16};
+
+    //Every thread requests every fourth point one after the other
+    constexpr size_t threadCount = 4;
+    std::vector<GravityModelResult> actual(_points.size());
+    std::vector<std::thread> threads{};
+    for (size_t thread = 0; thread < threadCount; ++thread) {
+        threads.emplace_back([&, thread] {
+            for (size_t i = thread; i < _points.size(); i += threadCount) {
+                actual[i] = evaluator.evaluate(_points[i]);
+            }
+        });
+    }
+    for (std::thread &thread: threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < _points.size(); ++i) {
+        expectEqual(actual[i], expected[i]);
+    }
+    EXPECT_EQ(evaluator.countRequests(), _points.size());
+    EXPECT_LE(evaluator.countBatches(), _points.size());
+}
+
+TEST_F(CoalescingEvaluatorTest, FullBatchesDoNotWait) {
+    using namespace polyhedralGravity;
+    const auto expected = GravityModel::evaluate(_polyhedron, _density, _points);
+    //The wait would exceed the timeout below, so only full batches can be evaluated in time
+    CoalescingEvaluator evaluator{_polyhedron, _density, std::chrono::seconds{60}, 10};
+    std::vector<std::future<GravityModelResult>> futures{};
+    for (const Array3 &point: _points) {
+        futures.push_back(evaluator.submit(point));
+    }
+    for (size_t i = 0; i < futures.size(); ++i) {
+        ASSERT_EQ(futures[i].wait_for(std::chrono::seconds{30}), std::future_status::ready);
+        expectEqual(futures[i].get(), expected[i]);
+    }
+    EXPECT_EQ(evaluator.countBatches(), 4);
+    EXPECT_EQ(evaluator.countRequests(), _points.size());
+}
+
+TEST_F(CoalescingEvaluatorTest, DestructionEvaluatesPendingRequests) {
+    using namespace polyhedralGravity;
+    const auto expected = GravityModel::evaluate(_polyhedron, _density, _points.front());
+    auto evaluator = std::make_unique<CoalescingEvaluator>(_polyhedron, _density, std::chrono::seconds{60});
+    std::future<GravityModelResult> future = evaluator->submit(_points.front());
+    evaluator.reset();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds{0}), std::future_status::ready);
+    expectEqual(future.get(), expected);
+}
+
+TEST_F(CoalescingEvaluatorTest, InvalidArguments) {
+    using namespace polyhedralGravity;
+    ASSERT_THROW(CoalescingEvaluator(_polyhedron, _density, std::chrono::microseconds{-1}), std::invalid_argument);
+    ASSERT_THROW(CoalescingEvaluator(_polyhedron, _density, std::chrono::microseconds{0}, 0), std::invalid_argument);
+}
@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include "polyhedralGravity/input/TetgenAdapter.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "TestPolyhedra.h"
+
+/**
+ * Contains Tests for the process-wide evaluation settings, e.g. the deterministic reduction
+ */
+class EvaluationSettingsTest : public ::testing::Test {
+
+protected:
+
+    //The Eros mesh with 14744 faces, i.e. many blocks
+    const polyhedralGravity::Polyhedron _polyhedron{
+            polyhedralGravity::TetgenAdapter{
+                    {"resources/GravityModelBigTest.node", "resources/GravityModelBigTest.face"}}.getPolyhedron()};
+
+    const std::vector<std::array<double, 3>> _points{
+            {0.0, 0.0, 0.0},
+            {2.0, 0.5, -0.3},
+            {-1.5, 0.2, 0.1}
+    };
+
+    void TearDown() override {
+        polyhedralGravity::EvaluationSettings::setReductionMode(polyhedralGravity::ReductionMode::DEFAULT);
+    }
+
+};
+
+TEST_F(EvaluationSettingsTest, DeterministicReductionMatchesDefault) {
+    using namespace polyhedralGravity;
+    const auto expected = GravityModel::evaluate(_polyhedron, 2670.0, _points);
+    EvaluationSettings::setReductionMode(ReductionMode::DETERMINISTIC);
+    const auto actual = GravityModel::evaluate(_polyhedron, 2670.0, _points);
+    for (size_t i = 0; i < _points.size(); ++i) {
+        EXPECT_NEAR(actual[i].gravitationalPotential, expected[i].gravitationalPotential,
+                    1e-12 * std::abs(expected[i].gravitationalPotential));
+        const double accelerationNorm = util::euclideanNorm(expected[i].acceleration);
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_NEAR(actual[i].acceleration[j], expected[i].acceleration[j], 1e-12 * accelerationNorm);
+        }
+    }
+}
+
+TEST_F(EvaluationSettingsTest, DeterministicReductionIsReproducible) {
+    using namespace polyhedralGravity;
+    EvaluationSettings::setReductionMode(ReductionMode::DETERMINISTIC);
+    const auto first = GravityModel::evaluate(_polyhedron, 2670.0, _points);
+    for (int run = 0; run < 3; ++run) {
+        const auto again = GravityModel::evaluate(_polyhedron, 2670.0, _points);
+        for (size_t i = 0; i < _points.size(); ++i) {
+            EXPECT_EQ(again[i].gravitationalPotential, first[i].gravitationalPotential);
+            EXPECT_EQ(again[i].acceleration, first[i].acceleration);
+            EXPECT_EQ(again[i].gradiometricTensor, first[i].gradiometricTensor);
+        }
+    }
+}
+
+TEST_F(EvaluationSettingsTest, SingleBlockIsSerialSum) {
+    using namespace polyhedralGravity;
+    //Less faces than one block, so the result is the sum in index order
+    const Polyhedron cube = TestPolyhedra::createCube();
+    const std::array<double, 3> point{0.3, -2.0, 1.1};
+    GravityModelResult expected{};
+    auto faces = GravityModel::transformPolyhedron(cube, point);
+    for (auto it = faces.first; it != faces.second; ++it) {
+        expected = GravityModel::detail::sumResults(expected, GravityModel::detail::evaluateFace(*it));
+    }
+    expected.eliminateRoundingErrors();
+
+    EvaluationSettings::setReductionMode(ReductionMode::DETERMINISTIC);
+    const auto actual = GravityModel::detail::evaluateGeometricSums(cube, point);
+    EXPECT_EQ(actual.gravitationalPotential, expected.gravitationalPotential);
+    EXPECT_EQ(actual.acceleration, expected.acceleration);
+    EXPECT_EQ(actual.gradiometricTensor, expected.gradiometricTensor);
+}
+
+TEST_F(EvaluationSettingsTest, ParseReductionMode) {
+    using namespace polyhedralGravity;
+    ASSERT_EQ(EvaluationSettings::getReductionMode(), ReductionMode::DEFAULT);
+    ASSERT_EQ(EvaluationSettings::parseReductionMode("DETERMINISTIC"), ReductionMode::DETERMINISTIC);
+    ASSERT_EQ(EvaluationSettings::parseReductionMode("DEFAULT"), ReductionMode::DEFAULT);
+    ASSERT_THROW(EvaluationSettings::parseReductionMode("FAST"), std::invalid_argument);
+}
+
+TEST_F(EvaluationSettingsTest, ParseMathBackend) {
+    using namespace polyhedralGravity;
+    ASSERT_EQ(EvaluationSettings::getMathBackend(), MathBackend::ACCURATE);
+    ASSERT_EQ(EvaluationSettings::parseMathBackend("FAST"), MathBackend::FAST);
+    ASSERT_EQ(EvaluationSettings::parseMathBackend("ACCURATE"), MathBackend::ACCURATE);
+    ASSERT_THROW(EvaluationSettings::parseMathBackend("fast"), std::invalid_argument);
+}
@@ -0,0 +1,155 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include "polyhedralGravity/calculation/GeometricSumCache.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "TestPolyhedra.h"
+
+/**
+ * Contains Tests for the density-independent cache of geometric sums
+ */
+class GeometricSumCacheTest : public ::testing::Test {
+
+protected:
+
+    const polyhedralGravity::Polyhedron _cube{polyhedralGravity::TestPolyhedra::createCube()};
+
+    const polyhedralGravity::Polyhedron _scaledCube{polyhedralGravity::TestPolyhedra::createCube(2.0)};
+
+    const std::vector<std::array<double, 3>> _points{
+            {0.0, 0.0, 0.0},
+            {1.0, 1.0, 1.0},
+            {1.0, 0.5, 0.0},
+            {3.0, -2.0, 5.0},
+            {0.0, 0.0, 1.0}
+    };
+
+};
+
+TEST_F(GeometricSumCacheTest, DensitySweepIsBitwiseIdentical) {
+    using namespace polyhedralGravity;
+    GeometricSumCache cache{};
+    for (const double density: {1.0, 2670.0, 0.5, 1e4}) {
+        const auto expected = GravityModel::evaluate(_cube, density, _points);
+        const auto actual = cache.evaluate(_cube, density, _points);
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+            EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+            EXPECT_EQ(actual[i].gradiometricTensor, expected[i].gradiometricTensor);
+        }
+    }
+    ASSERT_EQ(cache.size(), _points.size());
+    ASSERT_EQ(cache.misses(), _points.size());
+    ASSERT_EQ(cache.hits(), 3 * _points.size());
+}
+
+TEST_F(GeometricSumCacheTest, SinglePointEvaluation) {
+    using namespace polyhedralGravity;
+    GeometricSumCache cache{};
+    const auto first = cache.evaluate(_cube, 1.0, _points[3]);
+    const auto second = cache.evaluate(_cube, 3.0, _points[3]);
+    const auto expected = GravityModel::evaluate(_cube, 3.0, _points[3]);
+    EXPECT_EQ(second.gravitationalPotential, expected.gravitationalPotential);
+    EXPECT_EQ(second.acceleration, expected.acceleration);
+    EXPECT_DOUBLE_EQ(second.gravitationalPotential, 3.0 * first.gravitationalPotential);
+    ASSERT_EQ(cache.hits(), 1);
+    ASSERT_EQ(cache.misses(), 1);
+}
+
+TEST_F(GeometricSumCacheTest, DistinguishesPolyhedra) {
+    using namespace polyhedralGravity;
+    ASSERT_EQ(GeometricSumCache::hashPolyhedron(_cube),
+              GeometricSumCache::hashPolyhedron({_cube.getVertices(), _cube.getFaces()}));
+    ASSERT_NE(GeometricSumCache::hashPolyhedron(_cube), GeometricSumCache::hashPolyhedron(_scaledCube));
+
+    GeometricSumCache cache{};
+    cache.evaluate(_cube, 1.0, _points);
+    const auto actual = cache.evaluate(_scaledCube, 1.0, _points);
+    const auto expected = GravityModel::evaluate(_scaledCube, 1.0, _points);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+    }
+    ASSERT_EQ(cache.size(), 2 * _points.size());
+
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_EQ(cache.hits(), 0);
+}
+
+TEST_F(GeometricSumCacheTest, PreparedHandle) {
+    using namespace polyhedralGravity;
+    GeometricSumCache cache{};
+    const GeometricSumCache::Handle handle = GeometricSumCache::prepare(_cube);
+    ASSERT_EQ(handle.getHash(), GeometricSumCache::hashPolyhedron(_cube));
+    //The handle and the polyhedron share their entries
+    cache.evaluate(_cube, 1.0, _points);
+    const auto actual = cache.evaluate(handle, 2670.0, _points);
+    const auto expected = GravityModel::evaluate(_cube, 2670.0, _points);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+        EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+    }
+    const auto single = cache.evaluate(handle, 2670.0, _points[3]);
+    EXPECT_EQ(single.gravitationalPotential, expected[3].gravitationalPotential);
+    ASSERT_EQ(cache.size(), _points.size());
+    ASSERT_EQ(cache.hits(), _points.size() + 1);
+}
+
+TEST_F(GeometricSumCacheTest, NonFinitePointsAreNotCached) {
+    using namespace polyhedralGravity;
+    GeometricSumCache cache{};
+    const GeometricSumCache::Handle handle = GeometricSumCache::prepare(_cube);
+    const Array3 nanPoint{std::nan(""), 0.0, 0.0};
+    for (int i = 0; i < 3; ++i) {
+        cache.evaluate(handle, 1.0, nanPoint);
+        cache.evaluate(handle, 1.0, std::vector<Array3>{nanPoint, _points[0]});
+    }
+    ASSERT_EQ(cache.size(), 1);
+}
+
+TEST_F(GeometricSumCacheTest, SettingsChangingTheSumsAreSeparateEntries) {
+    using namespace polyhedralGravity;
+    GeometricSumCache cache{};
+    const GeometricSumCache::Handle handle = GeometricSumCache::prepare(_cube);
+    const auto accurate = cache.evaluate(handle, 1.0, _points[3]);
+    EvaluationSettings::setMathBackend(MathBackend::FAST);
+    const auto fast = cache.evaluate(handle, 1.0, _points[3]);
+    const auto expectedFast = GravityModel::evaluate(_cube, 1.0, _points[3]);
+    EvaluationSettings::setMathBackend(MathBackend::ACCURATE);
+    EvaluationSettings::setFarFieldAccuracy(1e-3);
+    cache.evaluate(handle, 1.0, _points[3]);
+    EvaluationSettings::setFarFieldAccuracy(0.0);
+    EvaluationSettings::setReductionMode(ReductionMode::DETERMINISTIC);
+    cache.evaluate(handle, 1.0, _points);
+    EvaluationSettings::setReductionMode(ReductionMode::DEFAULT);
+
+    EXPECT_EQ(fast.gravitationalPotential, expectedFast.gravitationalPotential);
+    EXPECT_EQ(fast.acceleration, expectedFast.acceleration);
+    EXPECT_EQ(cache.size(), 3 + _points.size());
+    EXPECT_EQ(cache.hits(), 0);
+    const auto again = cache.evaluate(handle, 1.0, _points[3]);
+    EXPECT_EQ(again.gravitationalPotential, accurate.gravitationalPotential);
+    EXPECT_EQ(cache.hits(), 1);
+}
+
+TEST_F(GeometricSumCacheTest, MissesAreEvaluatedWithTheChosenKernel) {
+    using namespace polyhedralGravity;
+    EvaluationSettings::setKernelVariant(KernelVariant::TILED);
+    GeometricSumCache cache{};
+    cache.evaluate(_cube, 1.0, std::vector<Array3>{_points[1], _points[3]});
+    const auto actual = cache.evaluate(_cube, 2670.0, _points);
+    const auto expected = GravityModel::evaluate(_cube, 2670.0, _points);
+    EvaluationSettings::setKernelVariant(KernelVariant::AUTO);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+        EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+        EXPECT_EQ(actual[i].gradiometricTensor, expected[i].gradiometricTensor);
+    }
+    ASSERT_EQ(cache.hits(), 2);
+    ASSERT_EQ(cache.misses(), _points.size());
+}
@@ -0,0 +1,88 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include "polyhedralGravity/input/TetgenAdapter.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+
+/**
+ * Contains Tests for the far-field approximation of single faces by their moments
+ */
+class GravityModelFarFieldTest : public ::testing::Test {
+
+protected:
+
+    //The Eros mesh with 14744 faces
+    const polyhedralGravity::Polyhedron _polyhedron{
+            polyhedralGravity::TetgenAdapter{
+                    {"resources/GravityModelBigTest.node", "resources/GravityModelBigTest.face"}}.getPolyhedron()};
+
+    //An irregular triangle
+    const polyhedralGravity::Array3Triplet _face{{{0.3, 0.1, 0.2}, {-0.2, 0.4, 0.1}, {0.1, -0.3, 0.5}}};
+
+    void TearDown() override {
+        polyhedralGravity::EvaluationSettings::setFarFieldAccuracy(0.0);
+    }
+
+};
+
+TEST_F(GravityModelFarFieldTest, FaceWithinAccuracy) {
+    using namespace polyhedralGravity;
+    using namespace polyhedralGravity::util;
+    //Far beyond a distance of 1000, already the line integrals of evaluateFace(..) lose digits by cancellation
+    for (const double accuracy: {1e-3, 1e-5, 1e-7}) {
+        size_t farFieldCount = 0;
+        for (double distance = 1.0; distance < 1e3; distance *= 1.1) {
+            for (const Array3 &direction: {Array3{0.6, -0.48, 0.64}, Array3{0.0, 0.0, -1.0}, Array3{0.8, 0.6, 0.0}}) {
+                const Array3 point = direction * distance;
+                const Array3Triplet face{_face[0] - point, _face[1] - point, _face[2] - point};
+                if (!GravityModel::detail::isFarField(face, accuracy)) {
+                    continue;
+                }
+                ++farFieldCount;
+                const GravityModelResult expected = GravityModel::detail::evaluateFace(face);
+                const GravityModelResult actual = GravityModel::detail::evaluateFaceMoments(face);
+                //Relative to the magnitudes of the face's contributions, the potential may be zero in the plane
+                const double integral = euclideanNorm(expected.acceleration);
+                EXPECT_NEAR(actual.gravitationalPotential, expected.gravitationalPotential,
+                            accuracy * integral * euclideanNorm(face[0]));
+                for (size_t j = 0; j < 3; ++j) {
+                    EXPECT_NEAR(actual.acceleration[j], expected.acceleration[j], accuracy * integral);
+                }
+                const double tensorNorm = euclideanNorm(expected.gradiometricTensor);
+                for (size_t j = 0; j < 6; ++j) {
+                    EXPECT_NEAR(actual.gradiometricTensor[j], expected.gradiometricTensor[j], accuracy * tensorNorm);
+                }
+            }
+        }
+        EXPECT_GT(farFieldCount, 0);
+    }
+}
+
+TEST_F(GravityModelFarFieldTest, MeshWithinAccuracy) {
+    using namespace polyhedralGravity;
+    const std::vector<Array3> points{{0.0, 0.0, 0.0}, {1.0, -0.5, 0.3}, {5.0, 7.0, -3.0}};
+    const auto expected = GravityModel::evaluate(_polyhedron, 2670.0, points);
+    EvaluationSettings::setFarFieldAccuracy(1e-6);
+    const auto actual = GravityModel::evaluate(_polyhedron, 2670.0, points);
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_NEAR(actual[i].gravitationalPotential, expected[i].gravitationalPotential,
+                    1e-6 * std::abs(expected[i].gravitationalPotential));
+        const double accelerationNorm = util::euclideanNorm(expected[i].acceleration);
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_NEAR(actual[i].acceleration[j], expected[i].acceleration[j], 1e-6 * accelerationNorm);
+        }
+    }
+    //Disabled again, the results are the exact ones
+    EvaluationSettings::setFarFieldAccuracy(0.0);
+    const auto exact = GravityModel::evaluate(_polyhedron, 2670.0, points);
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(exact[i].gravitationalPotential, expected[i].gravitationalPotential);
+        EXPECT_EQ(exact[i].acceleration, expected[i].acceleration);
+    }
+    ASSERT_THROW(EvaluationSettings::setFarFieldAccuracy(-1e-6), std::invalid_argument);
+    ASSERT_THROW(EvaluationSettings::setFarFieldAccuracy(1.0), std::invalid_argument);
+}
@@ -0,0 +1,136 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "TestPolyhedra.h"
+
+/**
+ * Contains Tests for the evaluation of the gravity model in a frame different from the body-fixed frame.
+ * The reference is the polyhedron explicitly transformed into the outer frame.
+ */
+class GravityModelFrameTest : public ::testing::Test {
+
+protected:
+
+    //An elongated box, so that the rotation matters
+    const polyhedralGravity::Polyhedron _box{polyhedralGravity::TestPolyhedra::createBox({2.0, 1.0, 0.5})};
+
+    const double _density = 2670.0;
+
+    //A rotation of 40 degree around the axis (1, 2, 3) and a translation
+    const std::array<double, 4> _quaternion{std::cos(0.349), std::sin(0.349) / std::sqrt(14.0),
+                                            2.0 * std::sin(0.349) / std::sqrt(14.0),
+                                            3.0 * std::sin(0.349) / std::sqrt(14.0)};
+
+    const polyhedralGravity::FrameTransformation _frame{
+            polyhedralGravity::FrameTransformation::fromQuaternion(_quaternion, {10.0, -5.0, 3.0})};
+
+    const std::vector<std::array<double, 3>> _points{
+            {10.0, -5.0, 3.0},
+            {13.0, -5.0, 3.0},
+            {7.5, -2.0, 4.0},
+            {20.0, 20.0, -20.0}
+    };
+
+    /**
+     * Transforms the polyhedron explicitly into the outer frame.
+     */
+    [[nodiscard]] polyhedralGravity::Polyhedron transformedBox() const {
+        std::vector<std::array<double, 3>> vertices{};
+        for (const auto &vertex: _box.getVertices()) {
+            std::array<double, 3> transformed{_frame.translation};
+            for (size_t i = 0; i < 3; ++i) {
+                for (size_t j = 0; j < 3; ++j) {
+                    transformed[i] += _frame.rotation[i][j] * vertex[j];
+                }
+            }
+            vertices.push_back(transformed);
+        }
+        return {vertices, _box.getFaces()};
+    }
+
+    static void expectNear(const polyhedralGravity::GravityModelResult &actual,
+                           const polyhedralGravity::GravityModelResult &expected) {
+        EXPECT_NEAR(actual.gravitationalPotential, expected.gravitationalPotential,
+                    1e-12 * std::abs(expected.gravitationalPotential));
+        for (size_t i = 0; i < 3; ++i) {
+            EXPECT_NEAR(actual.acceleration[i], expected.acceleration[i], 1e-16);
+        }
+        for (size_t i = 0; i < 6; ++i) {
+            EXPECT_NEAR(actual.gradiometricTensor[i], expected.gradiometricTensor[i], 1e-16);
+        }
+    }
+
+};
+
+TEST_F(GravityModelFrameTest, BatchTransformation) {
+    using namespace polyhedralGravity;
+    const auto expected = GravityModel::evaluate(transformedBox(), _density, _points);
+    const auto actual = GravityModel::evaluate(_box, _density, _points, _frame);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        expectNear(actual[i], expected[i]);
+    }
+    expectNear(GravityModel::evaluate(_box, _density, _points[2], _frame), expected[2]);
+}
+
+TEST_F(GravityModelFrameTest, BatchUsesMultiPointKernel) {
+    using namespace polyhedralGravity;
+    //The points are evaluated at once in the body-fixed frame, i.e. with the kernel chosen for the whole batch
+    std::vector<Array3> bodyPoints{};
+    for (const Array3 &point: _points) {
+        bodyPoints.push_back(_frame.toBodyFrame(point));
+    }
+    EvaluationSettings::setKernelVariant(KernelVariant::TILED);
+    const auto bodyResults = GravityModel::evaluate(_box, _density, bodyPoints);
+    const auto actual = GravityModel::evaluate(_box, _density, _points, _frame);
+    EvaluationSettings::setKernelVariant(KernelVariant::AUTO);
+    for (size_t i = 0; i < _points.size(); ++i) {
+        const GravityModelResult expected = _frame.toOuterFrame(bodyResults[i]);
+        EXPECT_EQ(actual[i].gravitationalPotential, expected.gravitationalPotential);
+        EXPECT_EQ(actual[i].acceleration, expected.acceleration);
+        EXPECT_EQ(actual[i].gradiometricTensor, expected.gradiometricTensor);
+    }
+}
+
+TEST_F(GravityModelFrameTest, PerPointTransformation) {
+    using namespace polyhedralGravity;
+    //The first point is evaluated with the identity, the others with the rotation
+    std::vector<FrameTransformation> frames{_points.size(), _frame};
+    frames[0] = FrameTransformation{};
+    const auto actual = GravityModel::evaluate(_box, _density, _points, frames);
+    const auto expectedRotated = GravityModel::evaluate(transformedBox(), _density, _points);
+    const auto expectedIdentity = GravityModel::evaluate(_box, _density, _points[0]);
+    EXPECT_EQ(actual[0].gravitationalPotential, expectedIdentity.gravitationalPotential);
+    EXPECT_EQ(actual[0].acceleration, expectedIdentity.acceleration);
+    EXPECT_EQ(actual[0].gradiometricTensor, expectedIdentity.gradiometricTensor);
+    for (size_t i = 1; i < _points.size(); ++i) {
+        expectNear(actual[i], expectedRotated[i]);
+    }
+
+    frames.pop_back();
+    ASSERT_THROW(GravityModel::evaluate(_box, _density, _points, frames), std::invalid_argument);
+}
+
+TEST_F(GravityModelFrameTest, QuaternionConversion) {
+    using namespace polyhedralGravity;
+    //90 degree around z maps x onto y
+    const auto frame = FrameTransformation::fromQuaternion({std::sqrt(0.5), 0.0, 0.0, std::sqrt(0.5)});
+    const auto bodyPoint = frame.toBodyFrame({0.0, 1.0, 0.0});
+    EXPECT_NEAR(bodyPoint[0], 1.0, 1e-15);
+    EXPECT_NEAR(bodyPoint[1], 0.0, 1e-15);
+    EXPECT_NEAR(bodyPoint[2], 0.0, 1e-15);
+    //The quaternion is normalized
+    const auto scaled = FrameTransformation::fromQuaternion({2.0, 0.0, 0.0, 2.0});
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_NEAR(scaled.rotation[i][j], frame.rotation[i][j], 1e-15);
+        }
+    }
+    ASSERT_THROW(FrameTransformation::fromQuaternion({0.0, 0.0, 0.0, 0.0}), std::invalid_argument);
+}
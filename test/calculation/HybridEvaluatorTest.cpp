@@ -0,0 +1,146 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include "polyhedralGravity/calculation/HybridEvaluator.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/calculation/TiledKernel.h"
+#include "polyhedralGravity/input/TetgenAdapter.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+
+/**
+ * Contains Tests for the accuracy driven choice of the evaluation method
+ */
+class HybridEvaluatorTest : public ::testing::Test {
+
+protected:
+
+    //The Eros mesh with 14744 faces
+    const polyhedralGravity::Polyhedron _polyhedron{
+            polyhedralGravity::TetgenAdapter{
+                    {"resources/GravityModelBigTest.node", "resources/GravityModelBigTest.face"}}.getPolyhedron()};
+
+    const double _density = 2670.0;
+
+    const polyhedralGravity::HybridEvaluator _evaluator{_polyhedron, _density};
+
+    /**
+     * Creates points in twelve directions at multiples of the bounding radius (and the origin inside the body).
+     * @param radii - the distances in bounding radii
+     * @return the points
+     */
+    [[nodiscard]] std::vector<std::array<double, 3>> createPoints(const std::vector<double> &radii) const {
+        std::vector<std::array<double, 3>> points{{0.0, 0.0, 0.0}};
+        for (const double radius: radii) {
+            for (size_t i = 0; i < 12; ++i) {
+                const double z = 1.0 - 2.0 * (static_cast<double>(i) + 0.5) / 12.0;
+                const double r = std::sqrt(1.0 - z * z);
+                const double phi = 2.399963229728653 * static_cast<double>(i);
+                const double distance = radius * _evaluator.getBoundingRadius();
+                points.push_back({distance * r * std::cos(phi), distance * r * std::sin(phi), distance * z});
+            }
+        }
+        return points;
+    }
+
+};
+
+TEST_F(HybridEvaluatorTest, ExpansionWithinBound) {
+    using namespace polyhedralGravity;
+    using namespace polyhedralGravity::util;
+    const double radius = _evaluator.getBoundingRadius();
+    ASSERT_TRUE(std::isinf(_evaluator.expansionErrorBound(0.5 * radius)));
+    ASSERT_TRUE(std::isinf(_evaluator.expansionErrorBound(2.0 * radius)));
+    for (const double distance: {10.0, 30.0, 100.0}) {
+        const double bound = _evaluator.expansionErrorBound(distance * radius);
+        ASSERT_LT(bound, 1e-2);
+        for (const auto &point: createPoints({distance})) {
+            if (point == Array3{0.0, 0.0, 0.0}) {
+                continue;
+            }
+            const auto expected = GravityModel::evaluate(_polyhedron, _density, point);
+            const auto actual = _evaluator.evaluateExpansion(point);
+            EXPECT_LT(euclideanNorm(actual.acceleration - expected.acceleration),
+                      bound * euclideanNorm(expected.acceleration));
+            EXPECT_NEAR(actual.gravitationalPotential, expected.gravitationalPotential,
+                        bound * expected.gravitationalPotential);
+            for (size_t i = 0; i < 6; ++i) {
+                EXPECT_NEAR(actual.gradiometricTensor[i], expected.gradiometricTensor[i],
+                            10.0 * bound * euclideanNorm(expected.acceleration) / (distance * radius));
+            }
+        }
+    }
+}
+
+TEST_F(HybridEvaluatorTest, MethodsWithinAccuracy) {
+    using namespace polyhedralGravity;
+    using namespace polyhedralGravity::util;
+    const std::vector<Array3> points = createPoints({1.2, 3.0, 10.0, 60.0});
+    const auto expected = GravityModel::evaluate(_polyhedron, _density, points);
+
+    size_t previousExact = points.size() + 1;
+    size_t previousExpansion = 0;
+    for (const double accuracy: {0.0, 1e-9, 1e-6, 1e-4}) {
+        const auto [actual, report] = _evaluator.evaluate(points, accuracy);
+        ASSERT_EQ(actual.size(), points.size());
+        size_t total = 0;
+        for (const size_t count: report.pointsPerMethod) {
+            total += count;
+        }
+        ASSERT_EQ(total, points.size());
+        //A coarser accuracy never requires more exact evaluations or fewer expansions
+        EXPECT_LE(report.countPoints(EvaluationMethod::EXACT), previousExact) << report.toString();
+        EXPECT_GE(report.countPoints(EvaluationMethod::GLOBAL_EXPANSION), previousExpansion) << report.toString();
+        previousExact = report.countPoints(EvaluationMethod::EXACT);
+        previousExpansion = report.countPoints(EvaluationMethod::GLOBAL_EXPANSION);
+
+        for (size_t i = 0; i < points.size(); ++i) {
+            const double error = euclideanNorm(actual[i].acceleration - expected[i].acceleration);
+            EXPECT_LE(error, std::max(accuracy, 1e-12) * euclideanNorm(expected[i].acceleration))
+                                << "with accuracy " << accuracy << " at point " << i;
+        }
+    }
+    //The point inside the body is never approximated geometrically, the far ones by the expansion if allowed
+    EXPECT_EQ(_evaluator.selectMethod(points[0], 1e-4), EvaluationMethod::FAST_MATH);
+    EXPECT_EQ(_evaluator.selectMethod(points[0], 1e-11), EvaluationMethod::EXACT);
+    EXPECT_EQ(_evaluator.selectMethod(points.back(), 1e-4), EvaluationMethod::GLOBAL_EXPANSION);
+    EXPECT_EQ(_evaluator.selectMethod(points.back(), 0.0), EvaluationMethod::EXACT);
+    EXPECT_EQ(_evaluator.selectMethod(points[points.size() - 13], 2e-9), EvaluationMethod::FAST_MATH);
+}
+
+TEST_F(HybridEvaluatorTest, SettingsUntouched) {
+    using namespace polyhedralGravity;
+    const std::vector<Array3> points = createPoints({1.2, 5.0});
+    EvaluationSettings::setKernelVariant(KernelVariant::POINTWISE);
+    const auto report = _evaluator.evaluate(points, 1e-6).second;
+    EXPECT_GT(report.countPoints(EvaluationMethod::FACE_FAR_FIELD) + report.countPoints(EvaluationMethod::FAST_MATH),
+              0);
+    EXPECT_EQ(EvaluationSettings::getKernelVariant(), KernelVariant::POINTWISE);
+    EXPECT_EQ(EvaluationSettings::getMathBackend(), MathBackend::ACCURATE);
+    EXPECT_EQ(EvaluationSettings::getFarFieldAccuracy(), 0.0);
+    EvaluationSettings::setKernelVariant(KernelVariant::AUTO);
+
+    ASSERT_THROW(static_cast<void>(_evaluator.evaluate(points, -1.0)), std::invalid_argument);
+    ASSERT_THROW(static_cast<void>(_evaluator.evaluate(points, 1.0)), std::invalid_argument);
+}
+
+TEST_F(HybridEvaluatorTest, ExactIgnoresGlobalApproximations) {
+    using namespace polyhedralGravity;
+    const std::vector<Array3> points = createPoints({1.2});
+    EvaluationSettings::setMathBackend(MathBackend::FAST);
+    EvaluationSettings::setFarFieldAccuracy(1e-3);
+    const auto [actual, report] = _evaluator.evaluate(points, 0.0);
+    EvaluationSettings::setMathBackend(MathBackend::ACCURATE);
+    EvaluationSettings::setFarFieldAccuracy(0.0);
+
+    EXPECT_EQ(report.countPoints(EvaluationMethod::EXACT), points.size());
+    const auto expected = TiledKernel::evaluate(_polyhedron, _density, points);
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+        EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+        EXPECT_EQ(actual[i].gradiometricTensor, expected[i].gradiometricTensor);
+    }
+}
@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <vector>
+#include "polyhedralGravity/calculation/IncrementalEvaluator.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "TestPolyhedra.h"
+
+/**
+ * Contains Tests for the incremental re-evaluation after moving vertices
+ */
+class IncrementalEvaluatorTest : public ::testing::Test {
+
+protected:
+
+    const polyhedralGravity::Polyhedron _cube{polyhedralGravity::TestPolyhedra::createCube()};
+
+    const double _density = 2670.0;
+
+    const std::vector<std::array<double, 3>> _points{
+            {0.0, 0.0, 0.0},
+            {1.0, 1.0, 1.0},
+            {3.0, -2.0, 5.0},
+            {0.0, 0.0, 1.5},
+            {-4.0, 0.5, 0.25}
+    };
+
+    static void expectNear(const std::vector<polyhedralGravity::GravityModelResult> &actual,
+                           const std::vector<polyhedralGravity::GravityModelResult> &expected) {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_NEAR(actual[i].gravitationalPotential, expected[i].gravitationalPotential, 1e-15);
+            for (size_t j = 0; j < 3; ++j) {
+                EXPECT_NEAR(actual[i].acceleration[j], expected[i].acceleration[j], 1e-15);
+            }
+            for (size_t j = 0; j < 6; ++j) {
+                EXPECT_NEAR(actual[i].gradiometricTensor[j], expected[i].gradiometricTensor[j], 1e-15);
+            }
+        }
+    }
+
+};
+
+TEST_F(IncrementalEvaluatorTest, InitialResults) {
+    using namespace polyhedralGravity;
+    IncrementalEvaluator evaluator{_cube, _density, _points};
+    expectNear(evaluator.getResults(), GravityModel::evaluate(_cube, _density, _points));
+}
+
+TEST_F(IncrementalEvaluatorTest, MoveVertices) {
+    using namespace polyhedralGravity;
+    IncrementalEvaluator evaluator{_cube, _density, _points};
+
+    //Vertex 6 is part of 6 faces
+    ASSERT_EQ(evaluator.moveVertex(6, {1.2, 1.1, 1.3}), 6);
+    expectNear(evaluator.getResults(), GravityModel::evaluate(evaluator.getPolyhedron(), _density, _points));
+
+    //Vertex 0 (5 faces) and 6 (6 faces) share no face
+    ASSERT_EQ(evaluator.moveVertices({0, 6}, {{-0.9, -1.2, -1.0}, {1.0, 1.0, 1.0}}), 11);
+    expectNear(evaluator.getResults(), GravityModel::evaluate(evaluator.getPolyhedron(), _density, _points));
+
+    //Many small steps, then the accumulated rounding errors are removed
+    for (int step = 0; step < 100; ++step) {
+        evaluator.moveVertex(3, {-1.0 - 0.001 * step, 1.0, -1.0 + 0.001 * step});
+    }
+    evaluator.resynchronize();
+    expectNear(evaluator.getResults(), GravityModel::evaluate(evaluator.getPolyhedron(), _density, _points));
+}
+
+TEST_F(IncrementalEvaluatorTest, InvalidArguments) {
+    using namespace polyhedralGravity;
+    IncrementalEvaluator evaluator{_cube, _density, _points};
+    ASSERT_THROW(evaluator.moveVertex(8, {0.0, 0.0, 0.0}), std::invalid_argument);
+    ASSERT_THROW(evaluator.moveVertices({0, 1}, {{0.0, 0.0, 0.0}}), std::invalid_argument);
+}
+
+TEST_F(IncrementalEvaluatorTest, FailedMoveLeavesStateUnchanged) {
+    using namespace polyhedralGravity;
+    IncrementalEvaluator evaluator{_cube, _density, _points};
+    const auto before = evaluator.getResults();
+
+    //The valid vertex 0 precedes the invalid index, it must not move
+    ASSERT_THROW(evaluator.moveVertices({0, 8}, {{-0.5, -0.5, -0.5}, {0.0, 0.0, 0.0}}), std::invalid_argument);
+    EXPECT_EQ(evaluator.getPolyhedron().getVertices(), _cube.getVertices());
+    const auto after = evaluator.getResults();
+    ASSERT_EQ(after.size(), before.size());
+    for (size_t i = 0; i < before.size(); ++i) {
+        EXPECT_EQ(after[i].gravitationalPotential, before[i].gravitationalPotential);
+        EXPECT_EQ(after[i].acceleration, before[i].acceleration);
+        EXPECT_EQ(after[i].gradiometricTensor, before[i].gradiometricTensor);
+    }
+}
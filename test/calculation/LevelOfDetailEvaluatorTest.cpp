@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <vector>
+#include <map>
+#include <cmath>
+#include "polyhedralGravity/calculation/LevelOfDetailEvaluator.h"
+#include "polyhedralGravity/calculation/MeshDecimation.h"
+#include "polyhedralGravity/calculation/MeshChecking.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/input/TetgenAdapter.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "TestPolyhedra.h"
+
+/**
+ * Contains Tests for the quadric error decimation and the level of detail evaluation
+ */
+class LevelOfDetailEvaluatorTest : public ::testing::Test {
+
+protected:
+
+    //The Eros mesh with 14744 faces
+    const polyhedralGravity::Polyhedron _polyhedron{
+            polyhedralGravity::TetgenAdapter{
+                    {"resources/GravityModelBigTest.node", "resources/GravityModelBigTest.face"}}.getPolyhedron()};
+
+    const double _density = 2670.0;
+
+    /**
+     * Checks that every directed edge occurs once and its reverse edge occurs as well, i.e. the mesh is closed
+     * and consistently oriented.
+     * @param polyhedron - the polyhedron
+     * @return true if the mesh is closed and consistently oriented
+     */
+    static bool isClosedAndOriented(const polyhedralGravity::Polyhedron &polyhedron) {
+        std::map<std::pair<size_t, size_t>, size_t> edges{};
+        for (const auto &face: polyhedron.getFaces()) {
+            for (size_t j = 0; j < 3; ++j) {
+                ++edges[{face[j], face[(j + 1) % 3]}];
+            }
+        }
+        return std::all_of(edges.begin(), edges.end(), [&edges](const auto &edge) {
+            return edge.second == 1 && edges.count({edge.first.second, edge.first.first}) == 1;
+        });
+    }
+
+    /**
+     * Creates points on spheres around the origin with a Fibonacci lattice.
+     * @param radii - the radii of the spheres
+     * @param count - the number of points per sphere
+     * @return the points
+     */
+    static std::vector<std::array<double, 3>> spherePoints(const std::vector<double> &radii, size_t count) {
+        std::vector<std::array<double, 3>> points{};
+        for (const double radius: radii) {
+            for (size_t i = 0; i < count; ++i) {
+                const double z = 1.0 - 2.0 * (static_cast<double>(i) + 0.5) / static_cast<double>(count);
+                const double r = std::sqrt(1.0 - z * z);
+                const double phi = 2.399963229728653 * static_cast<double>(i);
+                points.push_back({radius * r * std::cos(phi), radius * r * std::sin(phi), radius * z});
+            }
+        }
+        return points;
+    }
+
+};
+
+TEST_F(LevelOfDetailEvaluatorTest, DecimationKeepsVolumeAndCentroid) {
+    using namespace polyhedralGravity;
+    const auto [volume, centroid] = MeshDecimation::computeVolumeAndCentroid(_polyhedron);
+    for (const size_t target: {5000, 1000, 100}) {
+        const Polyhedron decimated = MeshDecimation::decimate(_polyhedron, target);
+        EXPECT_LE(decimated.countFaces(), target);
+        EXPECT_GT(decimated.countFaces(), target - 10);
+        //A closed triangle mesh of genus zero: V - F / 2 = 2
+        EXPECT_EQ(decimated.countVertices(), decimated.countFaces() / 2 + 2);
+        EXPECT_TRUE(isClosedAndOriented(decimated));
+        EXPECT_TRUE(MeshChecking::checkTrianglesNotDegenerated(decimated));
+
+        const auto [decimatedVolume, decimatedCentroid] = MeshDecimation::computeVolumeAndCentroid(decimated);
+        EXPECT_NEAR(decimatedVolume, volume, 1e-12 * volume);
+        for (size_t i = 0; i < 3; ++i) {
+            EXPECT_NEAR(decimatedCentroid[i], centroid[i], 1e-12);
+        }
+    }
+}
+
+TEST_F(LevelOfDetailEvaluatorTest, DecimationOfCube) {
+    using namespace polyhedralGravity;
+    //The planes of a cube's faces do not allow any collapse without error, but the corners can be merged
+    const Polyhedron cube = TestPolyhedra::createCube();
+    const Polyhedron unchanged = MeshDecimation::decimate(cube, 12);
+    EXPECT_EQ(unchanged.getVertices(), cube.getVertices());
+    EXPECT_EQ(unchanged.getFaces(), cube.getFaces());
+
+    const Polyhedron decimated = MeshDecimation::decimate(cube, 8);
+    EXPECT_LE(decimated.countFaces(), 8);
+    EXPECT_TRUE(isClosedAndOriented(decimated));
+    EXPECT_NEAR(MeshDecimation::computeVolumeAndCentroid(decimated).first, 8.0, 1e-12);
+
+    ASSERT_THROW(MeshDecimation::decimate(cube, 3), std::invalid_argument);
+}
+
+TEST_F(LevelOfDetailEvaluatorTest, LevelSelectionWithinTolerance) {
+    using namespace polyhedralGravity;
+    using namespace polyhedralGravity::util;
+    const double tolerance = 1e-4;
+    const LevelOfDetailEvaluator evaluator{_polyhedron, _density, tolerance, 3};
+    ASSERT_EQ(evaluator.countLevels(), 3);
+    EXPECT_EQ(evaluator.getLevel(0).countFaces(), _polyhedron.countFaces());
+    EXPECT_LT(evaluator.getLevel(1).countFaces(), _polyhedron.countFaces() / 3);
+    EXPECT_LT(evaluator.getLevel(2).countFaces(), evaluator.getLevel(1).countFaces() / 3);
+
+    //The predicted errors decrease with the distance and the level of detail
+    const double radius = evaluator.getBoundingRadius();
+    EXPECT_TRUE(std::isinf(evaluator.predictError(1, radius)));
+    EXPECT_EQ(evaluator.predictError(0, radius), 0.0);
+    for (const double distance: {1.5, 2.5, 4.0, 10.0, 40.0}) {
+        EXPECT_GE(evaluator.predictError(1, distance * radius), evaluator.predictError(1, 2.0 * distance * radius));
+        EXPECT_LE(evaluator.predictError(1, distance * radius), evaluator.predictError(2, distance * radius));
+    }
+
+    //Close to the body the original polyhedron is used, far away the coarsest level
+    EXPECT_EQ(evaluator.selectLevel({radius, 0.0, 0.0}), 0);
+    EXPECT_EQ(evaluator.selectLevel({0.0, 0.0, 50.0 * radius}), 2);
+
+    const std::vector<Array3> points = spherePoints({1.2 * radius, 1.7 * radius, 2.7 * radius, 6.0 * radius,
+                                                     30.0 * radius}, 24);
+    const auto expected = GravityModel::evaluate(_polyhedron, _density, points);
+    const auto actual = evaluator.evaluate(points);
+    std::vector<size_t> pointsPerLevel(evaluator.countLevels(), 0);
+    for (size_t i = 0; i < points.size(); ++i) {
+        const size_t level = evaluator.selectLevel(points[i]);
+        ++pointsPerLevel[level];
+        const double error = euclideanNorm(actual[i].acceleration - expected[i].acceleration);
+        EXPECT_LT(error, tolerance * euclideanNorm(expected[i].acceleration)) << "at point " << i;
+        if (level == 0) {
+            EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+        }
+        //The single point evaluation selects the same level (up to the rounding errors of the multi-point kernel)
+        const auto single = evaluator.evaluate(points[i]);
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_NEAR(single.acceleration[j], actual[i].acceleration[j],
+                        1e-8 * euclideanNorm(actual[i].acceleration));
+        }
+    }
+    EXPECT_GT(pointsPerLevel[0], 0);
+    EXPECT_GT(pointsPerLevel[2], 0);
+}
+
+TEST_F(LevelOfDetailEvaluatorTest, InvalidArguments) {
+    using namespace polyhedralGravity;
+    ASSERT_THROW(LevelOfDetailEvaluator(_polyhedron, _density, 0.0), std::invalid_argument);
+    ASSERT_THROW(LevelOfDetailEvaluator(_polyhedron, _density, 1e-3, 0), std::invalid_argument);
+    ASSERT_THROW(LevelOfDetailEvaluator(_polyhedron, _density, 1e-3, 3, 1.0), std::invalid_argument);
+    ASSERT_THROW(LevelOfDetailEvaluator(_polyhedron, _density, 1e-3, 3, 4.0, 3), std::invalid_argument);
+}
@@ -0,0 +1,164 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include "polyhedralGravity/calculation/MasconModel.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "TestPolyhedra.h"
+
+/**
+ * Contains Tests for the mascon approximation of the gravity model
+ */
+class MasconModelTest : public ::testing::Test {
+
+protected:
+
+    const polyhedralGravity::Polyhedron _cube{polyhedralGravity::TestPolyhedra::createCube()};
+
+    const double _density = 2670.0;
+
+    const polyhedralGravity::MasconModel _mascons{_cube, _density, 0.05};
+
+    //Points at distances of five to twenty half edge lengths
+    const std::vector<std::array<double, 3>> _farPoints{
+            {5.0, 0.0, 0.0},
+            {0.0, -6.0, 1.0},
+            {3.1, 4.37, -0.81},
+            {-4.77, -1.33, 8.91},
+            {15.93, 7.2, 0.05},
+            {-12.0, -12.0, -12.0}
+    };
+
+    /**
+     * Evaluates the point masses one after another without SIMD.
+     * @param positions - the positions of the mascons
+     * @param masses - the masses of the mascons
+     * @param point - the computation point
+     * @return the potential, acceleration and gradiometric tensor
+     */
+    static polyhedralGravity::GravityModelResult
+    evaluatePointMasses(const std::vector<std::array<double, 3>> &positions, const std::vector<double> &masses,
+                        const std::array<double, 3> &point) {
+        using namespace polyhedralGravity;
+        GravityModelResult result{};
+        for (size_t i = 0; i < positions.size(); ++i) {
+            const double gm = util::GRAVITATIONAL_CONSTANT * masses[i];
+            const Array3 d{point[0] - positions[i][0], point[1] - positions[i][1], point[2] - positions[i][2]};
+            const double r = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+            const double r3 = r * r * r;
+            const double r5 = r3 * r * r;
+            result.gravitationalPotential += gm / r;
+            for (size_t j = 0; j < 3; ++j) {
+                result.acceleration[j] += gm * d[j] / r3;
+            }
+            result.gradiometricTensor[0] += gm * (3.0 * d[0] * d[0] - r * r) / r5;
+            result.gradiometricTensor[1] += gm * (3.0 * d[1] * d[1] - r * r) / r5;
+            result.gradiometricTensor[2] += gm * (3.0 * d[2] * d[2] - r * r) / r5;
+            result.gradiometricTensor[3] += gm * 3.0 * d[0] * d[1] / r5;
+            result.gradiometricTensor[4] += gm * 3.0 * d[0] * d[2] / r5;
+            result.gradiometricTensor[5] += gm * 3.0 * d[1] * d[2] / r5;
+        }
+        return result;
+    }
+
+};
+
+TEST_F(MasconModelTest, MassAndCenterOfMass) {
+    using namespace polyhedralGravity;
+    //The tetrahedra partition the cube, so the total mass and the center of mass are exact
+    ASSERT_GT(_mascons.countMascons(), 0);
+    ASSERT_NEAR(_mascons.getTotalMass(), 8.0 * _density, 1e-9 * 8.0 * _density);
+    Array3 firstMoment{0.0, 0.0, 0.0};
+    for (size_t i = 0; i < _mascons.countMascons(); ++i) {
+        const Array3 position = _mascons.getPosition(i);
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_GE(position[j], -1.0);
+            EXPECT_LE(position[j], 1.0);
+            firstMoment[j] += _mascons.getMass(i) * position[j];
+        }
+    }
+    for (size_t j = 0; j < 3; ++j) {
+        EXPECT_NEAR(firstMoment[j] / _mascons.getTotalMass(), 0.0, 1e-12);
+    }
+}
+
+TEST_F(MasconModelTest, PointMasses) {
+    using namespace polyhedralGravity;
+    //More mascons than a multiple of the SIMD width to include the padding
+    std::vector<Array3> positions{};
+    std::vector<double> masses{};
+    for (size_t i = 0; i < 23; ++i) {
+        const auto x = static_cast<double>(i);
+        positions.push_back({std::sin(x), std::cos(2.0 * x), 0.1 * x - 1.0});
+        masses.push_back(1e3 + 37.0 * x);
+    }
+    const MasconModel mascons{positions, masses};
+    ASSERT_EQ(mascons.countMascons(), 23);
+
+    for (const auto &point: _farPoints) {
+        const GravityModelResult expected = evaluatePointMasses(positions, masses, point);
+        const GravityModelResult actual = mascons.evaluate(point);
+        EXPECT_NEAR(actual.gravitationalPotential, expected.gravitationalPotential,
+                    1e-14 * std::abs(expected.gravitationalPotential));
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_NEAR(actual.acceleration[j], expected.acceleration[j], 1e-14 * std::abs(expected.acceleration[0]) +
+                                                                          1e-25);
+        }
+        for (size_t j = 0; j < 6; ++j) {
+            EXPECT_NEAR(actual.gradiometricTensor[j], expected.gradiometricTensor[j],
+                        1e-13 * std::abs(expected.gradiometricTensor[0]) + 1e-25);
+        }
+    }
+
+    //A mascon at the computation point does not contribute
+    const GravityModelResult atMascon = mascons.evaluate(positions[5]);
+    EXPECT_TRUE(std::isfinite(atMascon.gravitationalPotential));
+    EXPECT_TRUE(std::isfinite(atMascon.acceleration[0]));
+}
+
+TEST_F(MasconModelTest, SameSignConventionsAsExactModel) {
+    using namespace polyhedralGravity;
+    //Far away, the cube acts like a single point mass at its center
+    const MasconModel pointMass{{{0.0, 0.0, 0.0}}, {8.0 * _density}};
+    const Array3 point{40.0, -25.0, 10.0};
+    const GravityModelResult expected = GravityModel::evaluate(_cube, _density, point);
+    const GravityModelResult actual = pointMass.evaluate(point);
+    EXPECT_NEAR(actual.gravitationalPotential, expected.gravitationalPotential,
+                1e-3 * std::abs(expected.gravitationalPotential));
+    for (size_t j = 0; j < 3; ++j) {
+        EXPECT_NEAR(actual.acceleration[j], expected.acceleration[j], 1e-3 * std::abs(expected.acceleration[0]));
+    }
+    for (size_t j = 0; j < 6; ++j) {
+        EXPECT_NEAR(actual.gradiometricTensor[j], expected.gradiometricTensor[j],
+                    1e-2 * std::abs(expected.gradiometricTensor[0]));
+    }
+}
+
+TEST_F(MasconModelTest, ErrorVersusExactModel) {
+    using namespace polyhedralGravity;
+    const MasconErrorReport report = _mascons.compareWithExact(_cube, _density, _farPoints);
+    EXPECT_LT(report.maxRelativePotentialError, 1e-3);
+    EXPECT_LT(report.maxRelativeAccelerationError, 1e-2);
+    EXPECT_LE(report.rmsRelativeAccelerationError, report.maxRelativeAccelerationError);
+    EXPECT_LT(report.maxRelativeTensorError, 5e-2);
+
+    //The multi-point evaluation equals the single point evaluation
+    const auto results = _mascons.evaluate(_farPoints);
+    ASSERT_EQ(results.size(), _farPoints.size());
+    for (size_t i = 0; i < _farPoints.size(); ++i) {
+        const auto expected = _mascons.evaluate(_farPoints[i]);
+        EXPECT_EQ(results[i].gravitationalPotential, expected.gravitationalPotential);
+        EXPECT_EQ(results[i].acceleration, expected.acceleration);
+        EXPECT_EQ(results[i].gradiometricTensor, expected.gradiometricTensor);
+    }
+}
+
+TEST_F(MasconModelTest, InvalidArguments) {
+    using namespace polyhedralGravity;
+    ASSERT_THROW(MasconModel(_cube, _density, -1.0), std::invalid_argument);
+    ASSERT_THROW(MasconModel(_cube, _density, std::nan("")), std::invalid_argument);
+    ASSERT_THROW(MasconModel({{0.0, 0.0, 0.0}}, {}), std::invalid_argument);
+}
@@ -0,0 +1,96 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "polyhedralGravity/calculation/NumaWorkerPool.h"
+#include "polyhedralGravity/calculation/TiledKernel.h"
+#include "polyhedralGravity/input/TetgenAdapter.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+
+/**
+ * Contains Tests for the persistent worker pool with the replicas of the mesh per NUMA node
+ */
+class NumaWorkerPoolTest : public ::testing::Test {
+
+protected:
+
+    //The Eros mesh with 14744 faces
+    const polyhedralGravity::Polyhedron _polyhedron{
+            polyhedralGravity::TetgenAdapter{
+                    {"resources/GravityModelBigTest.node", "resources/GravityModelBigTest.face"}}.getPolyhedron()};
+
+    const double _density = 2670.0;
+
+    //Points inside and around Eros, not a multiple of the block size
+    const std::vector<polyhedralGravity::Array3> _points = [] {
+        std::vector<polyhedralGravity::Array3> points{};
+        for (int i = 0; i < 37; ++i) {
+            points.push_back({-30.0 + 1.7 * i, 0.3 * i - 5.0, 12.0 - 0.5 * i});
+        }
+        return points;
+    }();
+
+};
+
+TEST_F(NumaWorkerPoolTest, ParseCpuList) {
+    using namespace polyhedralGravity;
+    EXPECT_EQ(NumaWorkerPool::parseCpuList("0-3,8-11"), (std::vector<size_t>{0, 1, 2, 3, 8, 9, 10, 11}));
+    EXPECT_EQ(NumaWorkerPool::parseCpuList("5"), (std::vector<size_t>{5}));
+    EXPECT_EQ(NumaWorkerPool::parseCpuList("2,0-1\n"), (std::vector<size_t>{0, 1, 2}));
+    EXPECT_TRUE(NumaWorkerPool::parseCpuList("").empty());
+    ASSERT_THROW(NumaWorkerPool::parseCpuList("3-1"), std::invalid_argument);
+    ASSERT_THROW(NumaWorkerPool::parseCpuList("a-b"), std::invalid_argument);
+
+    //Every available CPU belongs to exactly one node
+    const auto topology = NumaWorkerPool::readTopology();
+    ASSERT_FALSE(topology.empty());
+    std::vector<size_t> cpus{};
+    for (const NumaNode &node: topology) {
+        EXPECT_FALSE(node.cpus.empty());
+        cpus.insert(cpus.end(), node.cpus.cbegin(), node.cpus.cend());
+    }
+    std::sort(cpus.begin(), cpus.end());
+    EXPECT_EQ(std::unique(cpus.begin(), cpus.end()), cpus.end());
+}
+
+TEST_F(NumaWorkerPoolTest, MatchesTiledKernel) {
+    using namespace polyhedralGravity;
+    const auto expected = TiledKernel::evaluate(_polyhedron, _density, _points);
+    //More workers than CPUs share the CPUs
+    NumaWorkerPool pool{3};
+    EXPECT_EQ(pool.countThreads(), 3);
+    ASSERT_GE(pool.countNodes(), 1);
+    ASSERT_THROW(pool.evaluate(_density, _points), std::runtime_error);
+
+    pool.prepare(_polyhedron);
+    for (size_t node = 0; node < pool.countNodes(); ++node) {
+        EXPECT_EQ(pool.getReplica(node).size(), _polyhedron.countFaces());
+    }
+    ASSERT_THROW(static_cast<void>(pool.getReplica(pool.countNodes())), std::out_of_range);
+
+    //The same summation order as the tiled kernel, and the pool is reused for every call
+    for (int call = 0; call < 3; ++call) {
+        const auto actual = pool.evaluate(_density, _points);
+        ASSERT_EQ(actual.size(), _points.size());
+        for (size_t i = 0; i < _points.size(); ++i) {
+            EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+            EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+            EXPECT_EQ(actual[i].gradiometricTensor, expected[i].gradiometricTensor);
+        }
+    }
+    EXPECT_TRUE(pool.evaluate(_density, {}).empty());
+}
+
+TEST_F(NumaWorkerPoolTest, UnpinnedPool) {
+    using namespace polyhedralGravity;
+    const std::vector<Array3> points{_points.front(), _points.back()};
+    const auto expected = TiledKernel::evaluate(_polyhedron, _density, points);
+    NumaWorkerPool pool{2, false};
+    EXPECT_FALSE(pool.isPinned());
+    const auto actual = pool.evaluate(_polyhedron, _density, points);
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+        EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+    }
+}
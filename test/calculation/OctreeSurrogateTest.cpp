@@ -0,0 +1,135 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include "polyhedralGravity/calculation/OctreeSurrogate.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "TestPolyhedra.h"
+
+/**
+ * Contains Tests for the adaptive octree surrogate of the gravity model
+ */
+class OctreeSurrogateTest : public ::testing::Test {
+
+protected:
+
+    const polyhedralGravity::Polyhedron _cube{polyhedralGravity::TestPolyhedra::createCube()};
+
+    const double _density = 2670.0;
+
+    //The acceleration close to the cube is in the order of 1e-7 m/s^2
+    const double _tolerance = 1e-9;
+
+    const polyhedralGravity::OctreeSurrogate _surrogate{_cube, _density, {-8.0, -8.0, -8.0}, {8.0, 8.0, 8.0},
+                                                        _tolerance, 6};
+
+    const std::vector<std::array<double, 3>> _points{
+            {-8.0, -8.0, -8.0},
+            {2.25, 0.0, 0.0},
+            {3.1, 0.37, -0.81},
+            {-4.77, -1.33, 1.91},
+            {5.93, 7.2, 0.05},
+            {0.1, -0.2, 1.7},
+            {8.0, 8.0, 8.0}
+    };
+
+};
+
+TEST_F(OctreeSurrogateTest, AdaptiveRefinement) {
+    using namespace polyhedralGravity;
+    //The cells are refined near the body only, much less than a uniform grid of the same depth
+    ASSERT_GT(_surrogate.getDepth(), 2);
+    ASSERT_LT(_surrogate.getNodeCount(), 65 * 65 * 65 / 10);
+
+    const polyhedralGravity::OctreeSurrogate coarse{_cube, _density, {-8.0, -8.0, -8.0}, {8.0, 8.0, 8.0},
+                                                    1e-8, 6};
+    ASSERT_LT(coarse.getCellCount(), _surrogate.getCellCount());
+}
+
+TEST_F(OctreeSurrogateTest, InterpolationError) {
+    using namespace polyhedralGravity;
+    using namespace polyhedralGravity::util;
+    for (const auto &point: _points) {
+        const auto expected = GravityModel::evaluate(_cube, _density, point);
+        const auto actual = _surrogate.evaluate(point);
+        EXPECT_LT(euclideanNorm(actual.acceleration - expected.acceleration), 10.0 * _tolerance)
+                            << "at point " << point[0] << ", " << point[1] << ", " << point[2];
+    }
+}
+
+TEST_F(OctreeSurrogateTest, StoreAndLoad) {
+    using namespace polyhedralGravity;
+    const std::string filename{"OctreeSurrogateTest.bin"};
+    _surrogate.save(filename);
+    const auto loaded = OctreeSurrogate::load(filename);
+    std::remove(filename.c_str());
+
+    ASSERT_EQ(loaded.getCellCount(), _surrogate.getCellCount());
+    ASSERT_EQ(loaded.getNodeCount(), _surrogate.getNodeCount());
+    const auto expected = _surrogate.evaluate(_points);
+    const auto actual = loaded.evaluate(_points);
+    for (size_t i = 0; i < _points.size(); ++i) {
+        EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+        EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+        EXPECT_EQ(actual[i].gradiometricTensor, expected[i].gradiometricTensor);
+    }
+
+    ASSERT_THROW(OctreeSurrogate::load("nonExistingFile.bin"), std::runtime_error);
+}
+
+TEST_F(OctreeSurrogateTest, StoreAndLoadRootOnly) {
+    using namespace polyhedralGravity;
+    //Without refinement, the tree consists of the root cell, which is a leaf
+    const OctreeSurrogate rootOnly{_cube, _density, {-8.0, -8.0, -8.0}, {8.0, 8.0, 8.0}, _tolerance, 0};
+    ASSERT_EQ(rootOnly.getCellCount(), 1);
+    const std::string filename{"OctreeSurrogateTestRootOnly.bin"};
+    rootOnly.save(filename);
+    const auto loaded = OctreeSurrogate::load(filename);
+    std::remove(filename.c_str());
+
+    ASSERT_EQ(loaded.getCellCount(), 1);
+    const auto expected = rootOnly.evaluate(_points);
+    const auto actual = loaded.evaluate(_points);
+    for (size_t i = 0; i < _points.size(); ++i) {
+        EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+        EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+    }
+}
+
+TEST_F(OctreeSurrogateTest, LoadCyclicCells) {
+    using namespace polyhedralGravity;
+    ASSERT_GT(_surrogate.getCellCount(), 1);
+    const std::string filename{"OctreeSurrogateTestCyclic.bin"};
+    _surrogate.save(filename);
+    //The cells are stored last, each as its first child and its eight corners. The second cell becomes its own parent.
+    {
+        std::fstream file{filename, std::ios::binary | std::ios::in | std::ios::out};
+        file.seekg(0, std::ios::end);
+        const std::streamoff cellSize = 9 * sizeof(std::uint32_t);
+        const std::streamoff cellsBegin = static_cast<std::streamoff>(file.tellg()) -
+                                          static_cast<std::streamoff>(_surrogate.getCellCount()) * cellSize;
+        const std::uint32_t firstChild = 1;
+        file.seekp(cellsBegin + cellSize);
+        file.write(reinterpret_cast<const char *>(&firstChild), sizeof(firstChild));
+    }
+    ASSERT_THROW(OctreeSurrogate::load(filename), std::runtime_error);
+    std::remove(filename.c_str());
+}
+
+TEST_F(OctreeSurrogateTest, InvalidArguments) {
+    using namespace polyhedralGravity;
+    ASSERT_FALSE(_surrogate.contains({9.0, 0.0, 0.0}));
+    ASSERT_THROW(static_cast<void>(_surrogate.evaluate({9.0, 0.0, 0.0})), std::out_of_range);
+    ASSERT_THROW(OctreeSurrogate(_cube, _density, {0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}, 0.0),
+                 std::invalid_argument);
+    ASSERT_THROW(OctreeSurrogate(_cube, _density, {0.0, 0.0, 0.0}, {1.0, 0.0, 1.0}, 1.0),
+                 std::invalid_argument);
+    ASSERT_THROW(OctreeSurrogate(_cube, _density, {0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}, 1.0, 21),
+                 std::invalid_argument);
+}
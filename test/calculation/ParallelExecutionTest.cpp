@@ -0,0 +1,212 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+#include <atomic>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <stdexcept>
+#include "polyhedralGravity/calculation/ParallelExecution.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/input/TetgenAdapter.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+
+/**
+ * Contains Tests for the runtime selection of the parallel backend
+ */
+class ParallelExecutionTest : public ::testing::Test {
+
+protected:
+
+    //The Eros mesh with 14744 faces
+    const polyhedralGravity::Polyhedron _polyhedron{
+            polyhedralGravity::TetgenAdapter{
+                    {"resources/GravityModelBigTest.node", "resources/GravityModelBigTest.face"}}.getPolyhedron()};
+
+    const double _density = 2670.0;
+
+    //The backends compiled into this build apart from DEFAULT
+    static std::vector<polyhedralGravity::ParallelBackend> availableBackends() {
+        using namespace polyhedralGravity;
+        std::vector<ParallelBackend> backends{};
+        for (const ParallelBackend backend: {ParallelBackend::SERIAL, ParallelBackend::THREADS,
+                                             ParallelBackend::OPENMP, ParallelBackend::TBB}) {
+            if (EvaluationSettings::isParallelBackendAvailable(backend)) {
+                backends.push_back(backend);
+            }
+        }
+        return backends;
+    }
+
+    //Components close to zero suffer from cancellation, so the tolerance is relative to the largest one
+    template<typename Container>
+    static void expectNear(const Container &actual, const Container &expected) {
+        double scale = 0.0;
+        for (const double value: expected) {
+            scale = std::max(scale, std::abs(value));
+        }
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_NEAR(actual[i], expected[i], 1e-12 * scale);
+        }
+    }
+
+    void TearDown() override {
+        polyhedralGravity::EvaluationSettings::setParallelBackend(polyhedralGravity::ParallelBackend::DEFAULT);
+        polyhedralGravity::EvaluationSettings::setThreadCount(0);
+        polyhedralGravity::EvaluationSettings::setGrainSize(0);
+        polyhedralGravity::EvaluationSettings::setSerialFaceThreshold(0);
+        polyhedralGravity::EvaluationSettings::setParallelAxis(polyhedralGravity::ParallelAxis::AUTO);
+        polyhedralGravity::EvaluationSettings::setReductionMode(polyhedralGravity::ReductionMode::DEFAULT);
+    }
+
+};
+
+TEST_F(ParallelExecutionTest, EveryIndexOnce) {
+    using namespace polyhedralGravity;
+    const auto backends = availableBackends();
+    ASSERT_GE(backends.size(), 2);
+    for (const ParallelBackend backend: backends) {
+        SCOPED_TRACE(EvaluationSettings::toString(backend));
+        EvaluationSettings::setParallelBackend(backend);
+        EvaluationSettings::setThreadCount(3);
+        for (const size_t grainSize: {0, 1, 7, 1000}) {
+            EvaluationSettings::setGrainSize(grainSize);
+            std::vector<std::atomic<size_t>> executions(1001);
+            ParallelExecution::forEach(executions.size(), [&executions](size_t i) {
+                ++executions[i];
+            });
+            for (const auto &execution: executions) {
+                ASSERT_EQ(execution.load(), 1);
+            }
+            const double sum = ParallelExecution::transformReduce(
+                    1001, [](size_t i) { return static_cast<double>(i); }, 0.5, std::plus<>{});
+            EXPECT_DOUBLE_EQ(sum, 500500.5);
+        }
+        //Nothing to do for an empty loop
+        ParallelExecution::forEach(0, [](size_t) { throw std::runtime_error{"Unexpected call"}; });
+        EXPECT_EQ(ParallelExecution::transformReduce(0, [](size_t) { return 1; }, 2, std::plus<>{}), 2);
+        //Exceptions of the loop body reach the caller
+        ASSERT_THROW(ParallelExecution::forEach(100, [](size_t i) {
+            if (i == 42) {
+                throw std::runtime_error{"Failed iteration"};
+            }
+        }), std::runtime_error);
+    }
+}
+
+TEST_F(ParallelExecutionTest, GravityModelMatchesDefault) {
+    using namespace polyhedralGravity;
+    const std::vector<Array3> points{{0.0, 0.0, 0.0}, {20.0, 0.0, 0.0}, {5.0, -3.0, 2.0}, {0.5, 0.4, -0.3}};
+    const auto expectedSingle = GravityModel::evaluate(_polyhedron, _density, points.front());
+    const auto expected = GravityModel::evaluate(_polyhedron, _density, points);
+    for (const ParallelBackend backend: availableBackends()) {
+        SCOPED_TRACE(EvaluationSettings::toString(backend));
+        EvaluationSettings::setParallelBackend(backend);
+        EvaluationSettings::setThreadCount(2);
+        const auto actualSingle = GravityModel::evaluate(_polyhedron, _density, points.front());
+        EXPECT_NEAR(actualSingle.gravitationalPotential, expectedSingle.gravitationalPotential,
+                    1e-12 * std::abs(expectedSingle.gravitationalPotential));
+        expectNear(actualSingle.acceleration, expectedSingle.acceleration);
+        expectNear(actualSingle.gradiometricTensor, expectedSingle.gradiometricTensor);
+        const auto actual = GravityModel::evaluate(_polyhedron, _density, points);
+        for (size_t i = 0; i < points.size(); ++i) {
+            EXPECT_NEAR(actual[i].gravitationalPotential, expected[i].gravitationalPotential,
+                        1e-12 * std::abs(expected[i].gravitationalPotential));
+            expectNear(actual[i].acceleration, expected[i].acceleration);
+            expectNear(actual[i].gradiometricTensor, expected[i].gradiometricTensor);
+        }
+    }
+}
+
+TEST_F(ParallelExecutionTest, Settings) {
+    using namespace polyhedralGravity;
+    for (const ParallelBackend backend: {ParallelBackend::DEFAULT, ParallelBackend::SERIAL, ParallelBackend::THREADS,
+                                         ParallelBackend::OPENMP, ParallelBackend::TBB}) {
+        EXPECT_EQ(EvaluationSettings::parseParallelBackend(EvaluationSettings::toString(backend)), backend);
+        if (!EvaluationSettings::isParallelBackendAvailable(backend)) {
+            ASSERT_THROW(EvaluationSettings::setParallelBackend(backend), std::invalid_argument);
+            EXPECT_EQ(EvaluationSettings::getParallelBackend(), ParallelBackend::DEFAULT);
+        }
+    }
+    ASSERT_THROW(EvaluationSettings::parseParallelBackend("CUDA"), std::invalid_argument);
+
+    EvaluationSettings::setThreadCount(5);
+    EvaluationSettings::setGrainSize(0);
+    EXPECT_EQ(ParallelExecution::resolveThreadCount(), 5);
+    //About four tasks per thread
+    EXPECT_EQ(ParallelExecution::resolveGrainSize(1000), 50);
+    EXPECT_EQ(ParallelExecution::resolveGrainSize(3), 1);
+    EvaluationSettings::setGrainSize(64);
+    EXPECT_EQ(ParallelExecution::resolveGrainSize(1000), 64);
+}
+
+TEST_F(ParallelExecutionTest, SerialFaceThreshold) {
+    using namespace polyhedralGravity;
+    const Array3 point{5.0, -3.0, 2.0};
+    EvaluationSettings::setParallelBackend(ParallelBackend::THREADS);
+    EvaluationSettings::setThreadCount(2);
+    const size_t calibrated = GravityModel::calibrateSerialFaceThreshold();
+    EXPECT_GE(calibrated, 1);
+    EXPECT_EQ(GravityModel::resolveSerialFaceThreshold(), GravityModel::resolveSerialFaceThreshold());
+    EvaluationSettings::setThreadCount(1);
+    EXPECT_EQ(GravityModel::calibrateSerialFaceThreshold(), std::numeric_limits<size_t>::max());
+    EvaluationSettings::setThreadCount(2);
+    EvaluationSettings::setParallelBackend(ParallelBackend::SERIAL);
+    EXPECT_EQ(GravityModel::calibrateSerialFaceThreshold(), std::numeric_limits<size_t>::max());
+
+    //The configured threshold takes precedence over the calibrated one
+    EvaluationSettings::setParallelBackend(ParallelBackend::THREADS);
+    EvaluationSettings::setSerialFaceThreshold(1000);
+    EXPECT_EQ(GravityModel::resolveSerialFaceThreshold(), 1000);
+
+    //The deterministic reduction does not depend on the threshold
+    EvaluationSettings::setReductionMode(ReductionMode::DETERMINISTIC);
+    const auto parallel = GravityModel::evaluate(_polyhedron, _density, point);
+    EvaluationSettings::setSerialFaceThreshold(std::numeric_limits<size_t>::max());
+    const auto serial = GravityModel::evaluate(_polyhedron, _density, point);
+    EXPECT_EQ(serial.gravitationalPotential, parallel.gravitationalPotential);
+    EXPECT_EQ(serial.acceleration, parallel.acceleration);
+    EXPECT_EQ(serial.gradiometricTensor, parallel.gradiometricTensor);
+
+    //The default reduction only differs by the association order
+    EvaluationSettings::setReductionMode(ReductionMode::DEFAULT);
+    const auto serialDefault = GravityModel::evaluate(_polyhedron, _density, point);
+    EvaluationSettings::setSerialFaceThreshold(1);
+    const auto parallelDefault = GravityModel::evaluate(_polyhedron, _density, point);
+    EXPECT_NEAR(serialDefault.gravitationalPotential, parallelDefault.gravitationalPotential,
+                1e-12 * std::abs(parallelDefault.gravitationalPotential));
+    expectNear(serialDefault.acceleration, parallelDefault.acceleration);
+    expectNear(serialDefault.gradiometricTensor, parallelDefault.gradiometricTensor);
+}
+
+TEST_F(ParallelExecutionTest, ParallelAxis) {
+    using namespace polyhedralGravity;
+    EXPECT_EQ(EvaluationSettings::getParallelAxis(), ParallelAxis::AUTO);
+    EXPECT_EQ(EvaluationSettings::parseParallelAxis("POINTS"), ParallelAxis::POINTS);
+    EXPECT_EQ(EvaluationSettings::parseParallelAxis("FACES"), ParallelAxis::FACES);
+    EXPECT_EQ(EvaluationSettings::parseParallelAxis("AUTO"), ParallelAxis::AUTO);
+    ASSERT_THROW(EvaluationSettings::parseParallelAxis("points"), std::invalid_argument);
+
+    EvaluationSettings::setParallelBackend(ParallelBackend::THREADS);
+    EvaluationSettings::setThreadCount(4);
+    EXPECT_EQ(GravityModel::detail::resolveParallelAxis(3), ParallelAxis::FACES);
+    EXPECT_EQ(GravityModel::detail::resolveParallelAxis(4), ParallelAxis::POINTS);
+
+    //With serial faces, both axes sum up every point in index order
+    KernelVariant variant = EvaluationSettings::getKernelVariant();
+    EvaluationSettings::setKernelVariant(KernelVariant::POINTWISE);
+    EvaluationSettings::setSerialFaceThreshold(std::numeric_limits<size_t>::max());
+    const std::vector<Array3> points{{0.0, 0.0, 0.0}, {20.0, 0.0, 0.0}, {5.0, -3.0, 2.0}, {0.5, 0.4, -0.3}};
+    EvaluationSettings::setParallelAxis(ParallelAxis::FACES);
+    const auto faces = GravityModel::evaluate(_polyhedron, _density, points);
+    EvaluationSettings::setParallelAxis(ParallelAxis::POINTS);
+    const auto pointsAxis = GravityModel::evaluate(_polyhedron, _density, points);
+    EvaluationSettings::setKernelVariant(variant);
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(pointsAxis[i].gravitationalPotential, faces[i].gravitationalPotential);
+        EXPECT_EQ(pointsAxis[i].acceleration, faces[i].acceleration);
+        EXPECT_EQ(pointsAxis[i].gradiometricTensor, faces[i].gradiometricTensor);
+    }
+}
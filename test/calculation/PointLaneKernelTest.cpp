@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include "polyhedralGravity/calculation/PointLaneKernel.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "TestPolyhedra.h"
+
+/**
+ * Contains Tests for the evaluation with SIMD lanes mapped to computation points
+ */
+class PointLaneKernelTest : public ::testing::Test {
+
+protected:
+
+    const polyhedralGravity::Polyhedron _cube{polyhedralGravity::TestPolyhedra::createCube()};
+
+    const double _density = 2670.0;
+
+    //A grid of points inside, outside and on the surface, on edges and on vertices of the cube
+    const std::vector<std::array<double, 3>> _points = [] {
+        std::vector<std::array<double, 3>> points{};
+        for (int i = -2; i <= 2; ++i) {
+            for (int j = -2; j <= 2; ++j) {
+                for (int k = -2; k <= 2; ++k) {
+                    points.push_back({0.5 * i + 0.1, 0.5 * j, 0.5 * k});
+                    points.push_back({1.0 * i, 1.0 * j, 0.75 * k});
+                }
+            }
+        }
+        //Not a multiple of the number of lanes
+        points.push_back({3.0, -4.0, 0.5});
+        return points;
+    }();
+
+    void TearDown() override {
+        polyhedralGravity::EvaluationSettings::setKernelVariant(polyhedralGravity::KernelVariant::AUTO);
+        polyhedralGravity::EvaluationSettings::setMathBackend(polyhedralGravity::MathBackend::ACCURATE);
+        polyhedralGravity::EvaluationSettings::setFarFieldAccuracy(0.0);
+    }
+
+};
+
+TEST_F(PointLaneKernelTest, MatchesPointwiseEvaluation) {
+    using namespace polyhedralGravity;
+    EvaluationSettings::setKernelVariant(KernelVariant::POINTWISE);
+    const auto expected = GravityModel::evaluate(_cube, _density, _points);
+    const auto actual = PointLaneKernel::evaluate(_cube, _density, _points);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(actual[i].gravitationalPotential, expected[i].gravitationalPotential, 1e-15);
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_NEAR(actual[i].acceleration[j], expected[i].acceleration[j], 1e-15);
+        }
+        for (size_t j = 0; j < 6; ++j) {
+            EXPECT_NEAR(actual[i].gradiometricTensor[j], expected[i].gradiometricTensor[j], 1e-15);
+        }
+    }
+}
+
+TEST_F(PointLaneKernelTest, ChosenAutomaticallyForSmallMeshes) {
+    using namespace polyhedralGravity;
+    ASSERT_GE(_points.size(), PointLaneKernel::AUTO_MIN_POINTS);
+    const auto expected = PointLaneKernel::evaluate(_cube, _density, _points);
+    const auto actual = GravityModel::evaluate(_cube, _density, _points);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+        EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+        EXPECT_EQ(actual[i].gradiometricTensor, expected[i].gradiometricTensor);
+    }
+    ASSERT_EQ(EvaluationSettings::parseKernelVariant("POINT_LANES"), KernelVariant::POINT_LANES);
+}
+
+TEST_F(PointLaneKernelTest, NotChosenAutomaticallyForApproximations) {
+    using namespace polyhedralGravity;
+    //The lanes implement neither approximation, so AUTO falls back to the pointwise evaluation which honours them
+    for (const bool fastMath: {true, false}) {
+        EvaluationSettings::setMathBackend(fastMath ? MathBackend::FAST : MathBackend::ACCURATE);
+        EvaluationSettings::setFarFieldAccuracy(fastMath ? 0.0 : 1e-3);
+        EvaluationSettings::setKernelVariant(KernelVariant::POINTWISE);
+        const auto expected = GravityModel::evaluate(_cube, _density, _points);
+        EvaluationSettings::setKernelVariant(KernelVariant::AUTO);
+        const auto actual = GravityModel::evaluate(_cube, _density, _points);
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+            EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+            EXPECT_EQ(actual[i].gradiometricTensor, expected[i].gradiometricTensor);
+        }
+    }
+}
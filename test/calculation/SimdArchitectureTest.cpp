@@ -0,0 +1,122 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/PointLaneKernel.h"
+#include "polyhedralGravity/calculation/MasconModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "TestPolyhedra.h"
+
+/**
+ * Contains Tests for the runtime selection of the instruction set of the SIMD kernels
+ */
+class SimdArchitectureTest : public ::testing::Test {
+
+protected:
+
+    const polyhedralGravity::Polyhedron _cube{polyhedralGravity::TestPolyhedra::createCube()};
+
+    //Points inside, outside, on faces, edges and vertices, not a multiple of any number of lanes
+    const std::vector<polyhedralGravity::Array3> _points = [] {
+        std::vector<polyhedralGravity::Array3> points{};
+        for (int i = -2; i <= 2; ++i) {
+            for (int j = -2; j <= 2; ++j) {
+                points.push_back({0.5 * i + 0.1, 0.5 * j, 0.3 * (i - j)});
+                points.push_back({1.0 * i, 1.0 * j, 1.0});
+            }
+        }
+        points.push_back({3.0, -4.0, 0.5});
+        return points;
+    }();
+
+    //The architectures which can run on this machine apart from AUTO
+    static std::vector<polyhedralGravity::SimdArchitecture> availableArchitectures() {
+        using namespace polyhedralGravity;
+        std::vector<SimdArchitecture> architectures{};
+        for (const SimdArchitecture architecture: {SimdArchitecture::GENERIC, SimdArchitecture::SSE4_2,
+                                                   SimdArchitecture::AVX2_FMA, SimdArchitecture::AVX512F}) {
+            if (EvaluationSettings::isSimdArchitectureAvailable(architecture)) {
+                architectures.push_back(architecture);
+            }
+        }
+        return architectures;
+    }
+
+    //The lanes differ in their summation order, so the tolerance is relative to the largest component
+    template<typename Container>
+    static void expectNear(const Container &actual, const Container &expected) {
+        double scale = 0.0;
+        for (const double value: expected) {
+            scale = std::max(scale, std::abs(value));
+        }
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_NEAR(actual[i], expected[i], 1e-12 * scale);
+        }
+    }
+
+    static void expectNear(const polyhedralGravity::GravityModelResult &actual,
+                           const polyhedralGravity::GravityModelResult &expected) {
+        EXPECT_NEAR(actual.gravitationalPotential, expected.gravitationalPotential,
+                    1e-12 * std::abs(expected.gravitationalPotential));
+        expectNear(actual.acceleration, expected.acceleration);
+        expectNear(actual.gradiometricTensor, expected.gradiometricTensor);
+    }
+
+    void TearDown() override {
+        polyhedralGravity::EvaluationSettings::setSimdArchitecture(polyhedralGravity::SimdArchitecture::AUTO);
+    }
+
+};
+
+TEST_F(SimdArchitectureTest, Detection) {
+    using namespace polyhedralGravity;
+    const SimdArchitecture detected = EvaluationSettings::detectSimdArchitecture();
+    EXPECT_NE(detected, SimdArchitecture::AUTO);
+    EXPECT_TRUE(EvaluationSettings::isSimdArchitectureAvailable(detected));
+    EXPECT_EQ(EvaluationSettings::getSimdArchitecture(), detected);
+    //The detection picks the widest available architecture
+    const auto available = availableArchitectures();
+    if (detected != SimdArchitecture::GENERIC) {
+        EXPECT_EQ(detected, available.back());
+    }
+
+    for (const SimdArchitecture architecture: {SimdArchitecture::AUTO, SimdArchitecture::GENERIC,
+                                               SimdArchitecture::SSE4_2, SimdArchitecture::AVX2_FMA,
+                                               SimdArchitecture::AVX512F}) {
+        EXPECT_EQ(EvaluationSettings::parseSimdArchitecture(EvaluationSettings::toString(architecture)),
+                  architecture);
+        if (!EvaluationSettings::isSimdArchitectureAvailable(architecture)) {
+            ASSERT_THROW(EvaluationSettings::setSimdArchitecture(architecture), std::invalid_argument);
+        }
+    }
+    ASSERT_THROW(EvaluationSettings::parseSimdArchitecture("NEON"), std::invalid_argument);
+
+    //AUTO is never reported, but resolved to the detected architecture
+    EvaluationSettings::setSimdArchitecture(SimdArchitecture::GENERIC);
+    EXPECT_EQ(EvaluationSettings::getSimdArchitecture(), SimdArchitecture::GENERIC);
+    EvaluationSettings::setSimdArchitecture(SimdArchitecture::AUTO);
+    EXPECT_EQ(EvaluationSettings::getSimdArchitecture(), detected);
+}
+
+TEST_F(SimdArchitectureTest, KernelsMatchGeneric) {
+    using namespace polyhedralGravity;
+    const MasconModel mascons{_cube, 2670.0, 0.05};
+    EvaluationSettings::setSimdArchitecture(SimdArchitecture::GENERIC);
+    const auto expected = PointLaneKernel::evaluate(_cube, 2670.0, _points);
+    const auto expectedMascons = mascons.evaluate(_points);
+    for (const SimdArchitecture architecture: availableArchitectures()) {
+        SCOPED_TRACE(EvaluationSettings::toString(architecture));
+        EvaluationSettings::setSimdArchitecture(architecture);
+        const auto actual = PointLaneKernel::evaluate(_cube, 2670.0, _points);
+        const auto actualMascons = mascons.evaluate(_points);
+        ASSERT_EQ(actual.size(), _points.size());
+        for (size_t i = 0; i < _points.size(); ++i) {
+            expectNear(actual[i], expected[i]);
+            expectNear(actualMascons[i], expectedMascons[i]);
+        }
+    }
+}
@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <vector>
+#include <thread>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "polyhedralGravity/calculation/SpatialResultCache.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "TestPolyhedra.h"
+
+/**
+ * Contains Tests for the spatial result cache in front of the gravity model
+ */
+class SpatialResultCacheTest : public ::testing::Test {
+
+protected:
+
+    const polyhedralGravity::Polyhedron _cube{polyhedralGravity::TestPolyhedra::createCube()};
+
+    const double _density = 2670.0;
+
+};
+
+TEST_F(SpatialResultCacheTest, ExactModeIsBitwiseIdentical) {
+    using namespace polyhedralGravity;
+    SpatialResultCache cache{_cube, _density, 100};
+    const std::vector<std::array<double, 3>> points{{2.0, 0.0, 0.0}, {0.5, 0.5, 1.0}, {2.0, 0.0, 0.0}};
+    const auto actual = cache.evaluate(points);
+    const auto again = cache.evaluate(points);
+    const auto expected = GravityModel::evaluate(_cube, _density, points);
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+        EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+        EXPECT_EQ(actual[i].gradiometricTensor, expected[i].gradiometricTensor);
+        EXPECT_EQ(again[i].gravitationalPotential, expected[i].gravitationalPotential);
+        EXPECT_EQ(again[i].gradiometricTensor, expected[i].gradiometricTensor);
+    }
+    ASSERT_EQ(cache.misses(), 3);
+    ASSERT_EQ(cache.hits(), 3);
+    ASSERT_EQ(cache.size(), 2);
+
+    //A slightly different point is a miss in exact mode
+    cache.evaluate({2.0, 0.0, 1e-12});
+    ASSERT_EQ(cache.misses(), 4);
+}
+
+TEST_F(SpatialResultCacheTest, ToleranceMode) {
+    using namespace polyhedralGravity;
+    SpatialResultCache cache{_cube, _density, 100, 1e-3};
+    const auto first = cache.evaluate({3.0, 0.0, 0.0});
+    const auto near = cache.evaluate({3.0, 0.0005, -0.0005});
+    ASSERT_EQ(cache.hits(), 1);
+    EXPECT_EQ(near.acceleration, first.acceleration);
+
+    //Crossing a cell boundary still finds the cached point
+    const auto acrossCell = cache.evaluate({2.9995, 0.0, 0.0});
+    ASSERT_EQ(cache.hits(), 2);
+    EXPECT_EQ(acrossCell.acceleration, first.acceleration);
+
+    //Outside of the radius, the model is evaluated
+    cache.evaluate({3.002, 0.0, 0.0});
+    ASSERT_EQ(cache.misses(), 2);
+    ASSERT_EQ(cache.size(), 2);
+}
+
+TEST_F(SpatialResultCacheTest, LeastRecentlyUsedEviction) {
+    using namespace polyhedralGravity;
+    //The capacity bounds the whole cache, not every shard
+    SpatialResultCache cache{_cube, _density, 1};
+    for (int i = 0; i < 200; ++i) {
+        cache.evaluate({3.0 + i, 0.0, 0.0});
+    }
+    ASSERT_EQ(cache.size(), 1);
+    ASSERT_EQ(cache.misses(), 200);
+    //Only the most recently used point is left
+    cache.evaluate({202.0, 0.0, 0.0});
+    ASSERT_EQ(cache.hits(), 1);
+
+    SpatialResultCache largerCache{_cube, _density, 40};
+    for (int i = 0; i < 200; ++i) {
+        largerCache.evaluate({3.0 + i, 0.0, 0.0});
+    }
+    ASSERT_LE(largerCache.size(), 40);
+
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_EQ(cache.misses(), 0);
+}
+
+TEST_F(SpatialResultCacheTest, ConcurrentAccess) {
+    using namespace polyhedralGravity;
+    SpatialResultCache cache{_cube, _density, 1000};
+    const auto expected = GravityModel::evaluate(_cube, _density, {4.0, 1.0, 0.0});
+    std::vector<std::thread> threads{};
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, &expected]() {
+            for (int i = 0; i < 50; ++i) {
+                const auto actual = cache.evaluate({4.0, 1.0, 0.0});
+                EXPECT_EQ(actual.acceleration, expected.acceleration);
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    ASSERT_EQ(cache.hits() + cache.misses(), 200);
+    ASSERT_EQ(cache.size(), 1);
+}
+
+TEST_F(SpatialResultCacheTest, NonFinitePoints) {
+    using namespace polyhedralGravity;
+    for (const double tolerance: {0.0, 1e-3}) {
+        SpatialResultCache cache{_cube, _density, 100, tolerance};
+        ASSERT_THROW(cache.evaluate({std::nan(""), 0.0, 0.0}), std::invalid_argument);
+        ASSERT_THROW(cache.evaluate({0.0, std::numeric_limits<double>::infinity(), 0.0}), std::invalid_argument);
+        ASSERT_EQ(cache.size(), 0);
+        //Coordinates beyond the range of the cell index are clamped instead of overflowing
+        cache.evaluate({1e17, 0.0, 0.0});
+        cache.evaluate({1e17, 0.0, 0.0});
+        ASSERT_EQ(cache.hits(), 1);
+        ASSERT_EQ(cache.size(), 1);
+    }
+}
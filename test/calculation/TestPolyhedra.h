@@ -0,0 +1,36 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "polyhedralGravity/model/GravityModelData.h"
+
+/**
+ * Contains the small polyhedra shared by the tests, constructed from their vertices and faces.
+ */
+namespace polyhedralGravity::TestPolyhedra {
+
+    /**
+     * Creates an axis-aligned box centered at the origin. The vertices of the faces are ordered counterclockwise
+     * seen from outside, i.e. the normals point outwards.
+     * @param halfExtents - half the edge lengths along x, y and z
+     * @return the box with 8 vertices and 12 triangular faces
+     */
+    inline Polyhedron createBox(const Array3 &halfExtents) {
+        const auto [x, y, z] = halfExtents;
+        return {{{-x, -y, -z}, {x, -y, -z}, {x, y, -z}, {-x, y, -z},
+                 {-x, -y, z}, {x, -y, z}, {x, y, z}, {-x, y, z}},
+                {{1, 3, 2}, {0, 3, 1}, {0, 1, 5}, {0, 5, 4}, {0, 7, 3}, {0, 4, 7},
+                 {1, 2, 6}, {1, 6, 5}, {2, 3, 6}, {3, 7, 6}, {4, 5, 6}, {4, 6, 7}}};
+    }
+
+    /**
+     * Creates a cube centered at the origin like createBox(..).
+     * @param halfEdge - half the edge length, the default gives the cube with the vertices (+-1, +-1, +-1)
+     * @return the cube with 8 vertices and 12 triangular faces
+     */
+    inline Polyhedron createCube(double halfEdge = 1.0) {
+        return createBox({halfEdge, halfEdge, halfEdge});
+    }
+
+}
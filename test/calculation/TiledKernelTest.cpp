@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include "polyhedralGravity/input/TetgenAdapter.h"
+#include "polyhedralGravity/calculation/TiledKernel.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+
+/**
+ * Contains Tests for the cache-blocked evaluation of many computation points
+ */
+class TiledKernelTest : public ::testing::Test {
+
+protected:
+
+    //The Eros mesh with 14744 faces
+    const polyhedralGravity::Polyhedron _polyhedron{
+            polyhedralGravity::TetgenAdapter{
+                    {"resources/GravityModelBigTest.node", "resources/GravityModelBigTest.face"}}.getPolyhedron()};
+
+    const double _density = 2670.0;
+
+    //Points inside, on the bounding box's scale and outside of the polyhedron
+    const std::vector<std::array<double, 3>> _points = [] {
+        std::vector<std::array<double, 3>> points{};
+        for (int i = 0; i < 21; ++i) {
+            points.push_back({-1.5 + 0.15 * i, 0.1 * std::sin(i), 0.05 * i - 0.5});
+        }
+        return points;
+    }();
+
+    void TearDown() override {
+        polyhedralGravity::EvaluationSettings::setKernelVariant(polyhedralGravity::KernelVariant::AUTO);
+        polyhedralGravity::EvaluationSettings::setMathBackend(polyhedralGravity::MathBackend::ACCURATE);
+        polyhedralGravity::EvaluationSettings::setFarFieldAccuracy(0.0);
+    }
+
+    static void expectNear(const std::vector<polyhedralGravity::GravityModelResult> &actual,
+                           const std::vector<polyhedralGravity::GravityModelResult> &expected) {
+        using namespace polyhedralGravity;
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_NEAR(actual[i].gravitationalPotential, expected[i].gravitationalPotential,
+                        1e-12 * std::abs(expected[i].gravitationalPotential));
+            const double accelerationNorm = util::euclideanNorm(expected[i].acceleration);
+            for (size_t j = 0; j < 3; ++j) {
+                EXPECT_NEAR(actual[i].acceleration[j], expected[i].acceleration[j], 1e-11 * accelerationNorm);
+            }
+            for (size_t j = 0; j < 6; ++j) {
+                EXPECT_NEAR(actual[i].gradiometricTensor[j], expected[i].gradiometricTensor[j], 1e-11 * accelerationNorm);
+            }
+        }
+    }
+
+};
+
+TEST_F(TiledKernelTest, MatchesPointwiseEvaluation) {
+    using namespace polyhedralGravity;
+    EvaluationSettings::setKernelVariant(KernelVariant::POINTWISE);
+    const auto expected = GravityModel::evaluate(_polyhedron, _density, _points);
+    //Block sizes which do not divide the number of points and faces, and a single block
+    expectNear(TiledKernel::evaluate(_polyhedron, _density, _points, 4, 1000), expected);
+    expectNear(TiledKernel::evaluate(_polyhedron, _density, _points, 64, 20000), expected);
+}
+
+TEST_F(TiledKernelTest, SelectedByEvaluationSettings) {
+    using namespace polyhedralGravity;
+    const std::vector<Array3> points{_points.begin(), _points.begin() + 5};
+    EvaluationSettings::setKernelVariant(KernelVariant::TILED);
+    const auto actual = GravityModel::evaluate(_polyhedron, _density, points);
+    const auto expected = TiledKernel::evaluate(_polyhedron, _density, points);
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+        EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+        EXPECT_EQ(actual[i].gradiometricTensor, expected[i].gradiometricTensor);
+    }
+    ASSERT_EQ(EvaluationSettings::parseKernelVariant("TILED"), KernelVariant::TILED);
+    ASSERT_THROW(EvaluationSettings::parseKernelVariant("BLOCKED"), std::invalid_argument);
+}
+
+TEST_F(TiledKernelTest, ExplicitApproximations) {
+    using namespace polyhedralGravity;
+    const FaceApproximations approximations{MathBackend::FAST, 1e-6};
+    EvaluationSettings::setMathBackend(approximations.mathBackend);
+    EvaluationSettings::setFarFieldAccuracy(approximations.farFieldAccuracy);
+    const auto expected = TiledKernel::evaluate(_polyhedron, _density, _points);
+    EvaluationSettings::setMathBackend(MathBackend::ACCURATE);
+    EvaluationSettings::setFarFieldAccuracy(0.0);
+    //The passed approximations replace the ones of the EvaluationSettings, which stay untouched
+    const auto actual = TiledKernel::evaluate(_polyhedron, _density, _points, TiledKernel::DEFAULT_POINT_BLOCK_SIZE,
+                                              TiledKernel::DEFAULT_FACE_BLOCK_SIZE, approximations);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+        EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+    }
+    EXPECT_EQ(EvaluationSettings::getMathBackend(), MathBackend::ACCURATE);
+    EXPECT_EQ(EvaluationSettings::getFarFieldAccuracy(), 0.0);
+}
+
+TEST_F(TiledKernelTest, InvalidBlockSize) {
+    using namespace polyhedralGravity;
+    ASSERT_THROW(static_cast<void>(TiledKernel::evaluate(_polyhedron, _density, _points, 0, 512)),
+                 std::invalid_argument);
+    ASSERT_THROW(static_cast<void>(TiledKernel::evaluate(_polyhedron, _density, _points, 16, 0)),
+                 std::invalid_argument);
+}
@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include "polyhedralGravity/calculation/TrajectoryEvaluator.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "TestPolyhedra.h"
+
+/**
+ * Contains Tests for the Taylor steps along a trajectory
+ */
+class TrajectoryEvaluatorTest : public ::testing::Test {
+
+protected:
+
+    //A cube with edge length two centered at the origin
+    const polyhedralGravity::Polyhedron _cube{polyhedralGravity::TestPolyhedra::createCube()};
+
+    const double _density = 1.0;
+
+    /**
+     * Creates the points of an inclined circular orbit around the cube.
+     * @param radius - the radius of the orbit
+     * @param steps - the number of points per revolution
+     * @return the points of one revolution
+     */
+    static std::vector<std::array<double, 3>> orbit(double radius, size_t steps) {
+        std::vector<std::array<double, 3>> points{};
+        for (size_t i = 0; i < steps; ++i) {
+            const double angle = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(steps);
+            points.push_back({radius * std::cos(angle), radius * std::sin(angle) * 0.8,
+                              radius * std::sin(angle) * 0.6});
+        }
+        return points;
+    }
+
+};
+
+TEST_F(TrajectoryEvaluatorTest, PredictionsWithinTolerance) {
+    using namespace polyhedralGravity;
+    using namespace polyhedralGravity::util;
+    const double tolerance = 1e-5;
+    for (const TaylorOrder order: {TaylorOrder::FIRST, TaylorOrder::SECOND}) {
+        TrajectoryEvaluator evaluator{_cube, _density, tolerance, std::numeric_limits<double>::infinity(), order};
+        const std::vector<Array3> points = orbit(3.0, 20000);
+        for (const Array3 &point: points) {
+            const auto actual = evaluator.evaluate(point);
+            const auto expected = GravityModel::evaluate(_cube, _density, point);
+            //The estimate is a heuristic, the actual error may exceed it by a small factor
+            EXPECT_LT(euclideanNorm(actual.acceleration - expected.acceleration),
+                      4.0 * tolerance * euclideanNorm(expected.acceleration));
+            EXPECT_NEAR(actual.gravitationalPotential, expected.gravitationalPotential,
+                        4.0 * tolerance * expected.gravitationalPotential);
+        }
+        EXPECT_EQ(evaluator.countExactEvaluations() + evaluator.countPredictions(), points.size());
+        EXPECT_LT(evaluator.getMaxErrorRatio(), 4.0);
+        if (order == TaylorOrder::SECOND) {
+            //The tensor step saves most of the exact evaluations
+            EXPECT_LT(evaluator.countExactEvaluations() * 4, points.size());
+        }
+    }
+}
+
+TEST_F(TrajectoryEvaluatorTest, TaylorStep) {
+    using namespace polyhedralGravity;
+    TrajectoryEvaluator evaluator{_cube, _density, 1e-3};
+    const Array3 anchor{3.0, 1.0, -0.5};
+    EXPECT_TRUE(std::isinf(evaluator.estimateError(anchor)));
+    const auto exact = evaluator.evaluate(anchor);
+    EXPECT_EQ(exact.acceleration, GravityModel::evaluate(_cube, _density, anchor).acceleration);
+    EXPECT_EQ(evaluator.estimateError(anchor), 0.0);
+
+    //The change of acceleration is -T * d, the change of the potential -a * d + d^T * T * d / 2
+    const Array3 point{3.0, 1.0 + 1e-3, -0.5};
+    const auto predicted = evaluator.evaluate(point);
+    ASSERT_EQ(evaluator.countPredictions(), 1);
+    const auto &t = exact.gradiometricTensor;
+    EXPECT_DOUBLE_EQ(predicted.acceleration[0], exact.acceleration[0] - t[3] * 1e-3);
+    EXPECT_DOUBLE_EQ(predicted.acceleration[1], exact.acceleration[1] - t[1] * 1e-3);
+    EXPECT_DOUBLE_EQ(predicted.acceleration[2], exact.acceleration[2] - t[5] * 1e-3);
+    EXPECT_DOUBLE_EQ(predicted.gravitationalPotential,
+                     exact.gravitationalPotential - exact.acceleration[1] * 1e-3 + t[1] * 1e-6 / 2.0);
+    EXPECT_EQ(predicted.gradiometricTensor, exact.gradiometricTensor);
+}
+
+TEST_F(TrajectoryEvaluatorTest, DisplacementThresholdAndReset) {
+    using namespace polyhedralGravity;
+    //A large tolerance, so only the displacement triggers the exact evaluations
+    TrajectoryEvaluator evaluator{_cube, _density, 0.5, 0.105};
+    for (size_t i = 0; i < 100; ++i) {
+        static_cast<void>(evaluator.evaluate({5.0, 0.01 * static_cast<double>(i), 0.0}));
+    }
+    //The anchors are at 0.0, 0.11, 0.22, ..., 0.99
+    EXPECT_EQ(evaluator.countExactEvaluations(), 10);
+    EXPECT_EQ(evaluator.countPredictions(), 90);
+
+    evaluator.reset();
+    EXPECT_EQ(evaluator.countExactEvaluations(), 0);
+    EXPECT_EQ(evaluator.countPredictions(), 0);
+    static_cast<void>(evaluator.evaluate({5.0, 0.0, 0.0}));
+    EXPECT_EQ(evaluator.countExactEvaluations(), 1);
+
+    ASSERT_THROW(TrajectoryEvaluator(_cube, _density, 0.0), std::invalid_argument);
+    ASSERT_THROW(TrajectoryEvaluator(_cube, _density, 1e-6, -1.0), std::invalid_argument);
+}
@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+#include "polyhedralGravity/calculation/TricubicSurrogate.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "TestPolyhedra.h"
+
+/**
+ * Contains Tests for the tricubic Hermite surrogate of the gravity model
+ */
+class TricubicSurrogateTest : public ::testing::Test {
+
+protected:
+
+    const polyhedralGravity::Polyhedron _cube{polyhedralGravity::TestPolyhedra::createCube()};
+
+    const double _density = 2670.0;
+
+    //A region next to the cube, which does not intersect its surface
+    const polyhedralGravity::TricubicSurrogate _surrogate{_cube, _density, {2.0, -2.0, -2.0}, {6.0, 2.0, 2.0},
+                                                          {17, 17, 17}};
+
+    const std::vector<std::array<double, 3>> _points{
+            {2.0, -2.0, -2.0},
+            {2.25, 0.0, 0.0},
+            {3.1, 0.37, -0.81},
+            {4.77, -1.33, 1.91},
+            {5.93, 1.2, 0.05},
+            {6.0, 2.0, 2.0}
+    };
+
+};
+
+TEST_F(TricubicSurrogateTest, ExactAtNodes) {
+    using namespace polyhedralGravity;
+    const auto expected = GravityModel::evaluate(_cube, _density, std::array<double, 3>{2.25, 0.0, 0.0});
+    const auto actual = _surrogate.evaluate({2.25, 0.0, 0.0});
+    EXPECT_DOUBLE_EQ(actual.gravitationalPotential, expected.gravitationalPotential);
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_NEAR(actual.acceleration[i], expected.acceleration[i], 1e-20);
+    }
+    for (size_t i = 3; i < 6; ++i) {
+        EXPECT_NEAR(actual.gradiometricTensor[i], expected.gradiometricTensor[i], 1e-20);
+    }
+}
+
+TEST_F(TricubicSurrogateTest, InterpolationError) {
+    using namespace polyhedralGravity;
+    for (const auto &point: _points) {
+        const auto expected = GravityModel::evaluate(_cube, _density, point);
+        const auto actual = _surrogate.evaluate(point);
+        const double accelerationNorm = util::euclideanNorm(expected.acceleration);
+        EXPECT_NEAR(actual.gravitationalPotential, expected.gravitationalPotential,
+                    1e-5 * std::abs(expected.gravitationalPotential));
+        for (size_t i = 0; i < 3; ++i) {
+            EXPECT_NEAR(actual.acceleration[i], expected.acceleration[i], 1e-4 * accelerationNorm);
+        }
+        for (size_t i = 0; i < 6; ++i) {
+            EXPECT_NEAR(actual.gradiometricTensor[i], expected.gradiometricTensor[i], 1e-2 * accelerationNorm);
+        }
+    }
+}
+
+TEST_F(TricubicSurrogateTest, StoreAndLoad) {
+    using namespace polyhedralGravity;
+    const std::string filename{"TricubicSurrogateTest.bin"};
+    _surrogate.save(filename);
+    const auto loaded = TricubicSurrogate::load(filename);
+    std::remove(filename.c_str());
+
+    ASSERT_EQ(loaded.getResolution(), _surrogate.getResolution());
+    ASSERT_EQ(loaded.getLowerCorner(), _surrogate.getLowerCorner());
+    const auto expected = _surrogate.evaluate(_points);
+    const auto actual = loaded.evaluate(_points);
+    for (size_t i = 0; i < _points.size(); ++i) {
+        EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+        EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+        EXPECT_EQ(actual[i].gradiometricTensor, expected[i].gradiometricTensor);
+    }
+
+    ASSERT_THROW(TricubicSurrogate::load("nonExistingFile.bin"), std::runtime_error);
+}
+
+TEST_F(TricubicSurrogateTest, LoadCorruptedResolution) {
+    using namespace polyhedralGravity;
+    const std::string filename{"TricubicSurrogateCorruptedTest.bin"};
+    //The resolution follows the 8 bytes of the magic, the version and the two corners
+    constexpr std::streamoff resolutionOffset = 8 + sizeof(std::uint32_t) + 6 * sizeof(double);
+    const auto writeResolution = [&](const std::array<std::uint64_t, 3> &resolution) {
+        _surrogate.save(filename);
+        std::fstream file{filename, std::ios::binary | std::ios::in | std::ios::out};
+        file.seekp(resolutionOffset);
+        file.write(reinterpret_cast<const char *>(resolution.data()), sizeof(resolution));
+    };
+
+    writeResolution({1, 4, 4});
+    EXPECT_THROW(TricubicSurrogate::load(filename), std::runtime_error);
+    //The product overflows to a small number of nodes
+    writeResolution({std::uint64_t{1} << 32, std::uint64_t{1} << 32, 2});
+    EXPECT_THROW(TricubicSurrogate::load(filename), std::runtime_error);
+    writeResolution({1000, 1000, 1000});
+    EXPECT_THROW(TricubicSurrogate::load(filename), std::runtime_error);
+    std::remove(filename.c_str());
+}
+
+TEST_F(TricubicSurrogateTest, InvalidArguments) {
+    using namespace polyhedralGravity;
+    ASSERT_FALSE(_surrogate.contains({0.0, 0.0, 0.0}));
+    ASSERT_THROW(static_cast<void>(_surrogate.evaluate({0.0, 0.0, 0.0})), std::out_of_range);
+    ASSERT_THROW(TricubicSurrogate(_cube, _density, {0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}, {1, 2, 2}),
+                 std::invalid_argument);
+    ASSERT_THROW(TricubicSurrogate(_cube, _density, {0.0, 0.0, 0.0}, {1.0, 0.0, 1.0}, {2, 2, 2}),
+                 std::invalid_argument);
+}
@@ -0,0 +1,194 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cmath>
+#include <limits>
+#include "polyhedralGravity/calculation/WorkStealingScheduler.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/TiledKernel.h"
+#include "polyhedralGravity/input/TetgenAdapter.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "TestPolyhedra.h"
+
+/**
+ * Contains Tests for the work stealing distribution of the blocks of computation points
+ */
+class WorkStealingSchedulerTest : public ::testing::Test {
+
+protected:
+
+    //The Eros mesh with 14744 faces
+    const polyhedralGravity::Polyhedron _polyhedron{
+            polyhedralGravity::TetgenAdapter{
+                    {"resources/GravityModelBigTest.node", "resources/GravityModelBigTest.face"}}.getPolyhedron()};
+
+    void TearDown() override {
+        polyhedralGravity::EvaluationSettings::setSchedulingMode(polyhedralGravity::SchedulingMode::STATIC);
+        polyhedralGravity::EvaluationSettings::setFarFieldAccuracy(0.0);
+        polyhedralGravity::EvaluationSettings::setParallelBackend(polyhedralGravity::ParallelBackend::DEFAULT);
+    }
+
+};
+
+TEST_F(WorkStealingSchedulerTest, EveryTaskOnce) {
+    using namespace polyhedralGravity;
+    std::vector<double> costs(1000);
+    for (size_t i = 0; i < costs.size(); ++i) {
+        costs[i] = static_cast<double>(i % 17);
+    }
+    std::vector<std::atomic<size_t>> executions(costs.size());
+    const SchedulerStatistics statistics = WorkStealingScheduler::run(costs, [&executions](size_t task) {
+        ++executions[task];
+    }, 4);
+    for (const auto &execution: executions) {
+        ASSERT_EQ(execution.load(), 1);
+    }
+    ASSERT_EQ(statistics.threadCount, 4);
+    ASSERT_EQ(statistics.tasksPerThread.size(), 4);
+    EXPECT_EQ(std::accumulate(statistics.tasksPerThread.begin(), statistics.tasksPerThread.end(), size_t{0}),
+              costs.size());
+
+    //Never more threads than tasks, and nothing to do without tasks
+    EXPECT_EQ(WorkStealingScheduler::run({1.0, 2.0}, [](size_t) {}, 8).threadCount, 2);
+    EXPECT_EQ(WorkStealingScheduler::run({}, [](size_t) {}).threadCount, 0);
+}
+
+TEST_F(WorkStealingSchedulerTest, StealsFromSlowThreads) {
+    using namespace polyhedralGravity;
+    //All tasks are estimated equal, but the ones of the first deque take much longer
+    const std::vector<double> costs(100, 1.0);
+    const SchedulerStatistics statistics = WorkStealingScheduler::run(costs, [](size_t task) {
+        if (task % 4 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }, 4);
+    EXPECT_GT(statistics.steals, 0);
+    EXPECT_LT(statistics.tasksPerThread[0], 25);
+}
+
+TEST_F(WorkStealingSchedulerTest, ExceptionsAreRethrown) {
+    using namespace polyhedralGravity;
+    const std::vector<double> costs(64, 1.0);
+    std::atomic<size_t> executed{0};
+    ASSERT_THROW(WorkStealingScheduler::run(costs, [&executed](size_t task) {
+        ++executed;
+        if (task == 10) {
+            throw std::runtime_error{"Failed task"};
+        }
+    }, 3), std::runtime_error);
+    EXPECT_LE(executed.load(), costs.size());
+}
+
+TEST_F(WorkStealingSchedulerTest, HelperThreadsAreReused) {
+    using namespace polyhedralGravity;
+    const std::thread::id caller = std::this_thread::get_id();
+    std::atomic<size_t> maxRunsPerHelper{0};
+    for (size_t run = 0; run < 20; ++run) {
+        WorkStealingScheduler::run(std::vector<double>(8, 1.0), [&](size_t) {
+            thread_local size_t lastRun = std::numeric_limits<size_t>::max();
+            thread_local size_t runs = 0;
+            if (std::this_thread::get_id() != caller && lastRun != run) {
+                lastRun = run;
+                ++runs;
+                size_t expected = maxRunsPerHelper.load();
+                while (expected < runs && !maxRunsPerHelper.compare_exchange_weak(expected, runs)) {}
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }, 4);
+    }
+    EXPECT_GT(maxRunsPerHelper.load(), 1);
+}
+
+TEST_F(WorkStealingSchedulerTest, NestedRunsExecuteInline) {
+    using namespace polyhedralGravity;
+    const std::vector<double> costs(16, 1.0);
+    std::atomic<size_t> executed{0};
+    std::atomic<bool> onCallingThread{true};
+    WorkStealingScheduler::run(costs, [&](size_t) {
+        const std::thread::id outer = std::this_thread::get_id();
+        const SchedulerStatistics nested = WorkStealingScheduler::run(costs, [&](size_t) {
+            ++executed;
+            if (std::this_thread::get_id() != outer) {
+                onCallingThread = false;
+            }
+        }, 4);
+        if (nested.threadCount != 1) {
+            onCallingThread = false;
+        }
+    }, 4);
+    EXPECT_EQ(executed.load(), costs.size() * costs.size());
+    EXPECT_TRUE(onCallingThread.load());
+}
+
+TEST_F(WorkStealingSchedulerTest, CoherentBatches) {
+    using namespace polyhedralGravity;
+    const std::vector<double> costs{1.0, 5.0, 1.0, 5.0, 3.0, 5.0, 1.0};
+    const auto batches = WorkStealingScheduler::createBatches(costs, 3);
+    ASSERT_EQ(batches.size(), 3);
+    EXPECT_THAT(batches[0], ::testing::ElementsAre(1, 3, 5));
+    EXPECT_THAT(batches[1], ::testing::ElementsAre(4, 0, 2));
+    EXPECT_THAT(batches[2], ::testing::ElementsAre(6));
+    ASSERT_THROW(WorkStealingScheduler::createBatches(costs, 0), std::invalid_argument);
+}
+
+TEST_F(WorkStealingSchedulerTest, TiledKernelMatchesStaticScheduling) {
+    using namespace polyhedralGravity;
+    //Points just outside the surface and far away, whose faces are mostly approximated by the far-field expansion
+    std::vector<Array3> points{};
+    for (size_t i = 0; i < 48; ++i) {
+        if (i % 2 == 0) {
+            const Array3 &vertex = _polyhedron.getVertex(i * 97);
+            points.push_back({1.01 * vertex[0], 1.01 * vertex[1], 1.01 * vertex[2]});
+        } else {
+            const double angle = 0.7 * static_cast<double>(i);
+            points.push_back({500.0 * std::cos(angle), 500.0 * std::sin(angle), 0.1 * static_cast<double>(i % 5)});
+        }
+    }
+    const auto faces = TiledKernel::prepareFaces(_polyhedron);
+    const auto exactCosts = TiledKernel::estimateCosts(faces, points, 0.0);
+    EXPECT_EQ(exactCosts[0], static_cast<double>(faces.size()));
+    EXPECT_EQ(exactCosts[1], static_cast<double>(faces.size()));
+    const auto costs = TiledKernel::estimateCosts(faces, points, 1e-2);
+    EXPECT_GT(costs[0], costs[1]);
+    EXPECT_NEAR(costs[1], TiledKernel::FAR_FIELD_FACE_COST * static_cast<double>(faces.size()), 1e-9);
+
+    EvaluationSettings::setFarFieldAccuracy(1e-2);
+    const auto expected = TiledKernel::evaluateGeometricSums(faces, points);
+    EvaluationSettings::setSchedulingMode(SchedulingMode::WORK_STEALING);
+    const auto actual = TiledKernel::evaluateGeometricSums(faces, points);
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+        EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+        EXPECT_EQ(actual[i].gradiometricTensor, expected[i].gradiometricTensor);
+    }
+
+    EXPECT_EQ(EvaluationSettings::parseSchedulingMode("STATIC"), SchedulingMode::STATIC);
+    EXPECT_EQ(EvaluationSettings::parseSchedulingMode("WORK_STEALING"), SchedulingMode::WORK_STEALING);
+    ASSERT_THROW(EvaluationSettings::parseSchedulingMode("DYNAMIC"), std::invalid_argument);
+}
+
+TEST_F(WorkStealingSchedulerTest, SurfacePointsAndSerialBackend) {
+    using namespace polyhedralGravity;
+    const Polyhedron cube = TestPolyhedra::createCube();
+    const auto faces = TiledKernel::prepareFaces(cube);
+    //The point on the bottom face takes the cheaper singular cases of the faces in that plane
+    const std::vector<Array3> points{{0.3, -0.3, -1.0}, {0.3, -0.3, -0.5}, {0.3, -0.3, 3.0}, {5.0, 0.0, 0.0}};
+    const auto costs = TiledKernel::estimateCosts(faces, points, 0.0);
+    EXPECT_DOUBLE_EQ(costs[0], 10.0 + 2.0 * TiledKernel::SINGULAR_FACE_COST);
+    EXPECT_DOUBLE_EQ(costs[1], 12.0);
+    EXPECT_DOUBLE_EQ(costs[2], 12.0);
+
+    EvaluationSettings::setSchedulingMode(SchedulingMode::WORK_STEALING);
+    const auto expected = TiledKernel::evaluateGeometricSums(faces, points, 1);
+    EvaluationSettings::setParallelBackend(ParallelBackend::SERIAL);
+    const auto actual = TiledKernel::evaluateGeometricSums(faces, points, 1);
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential);
+        EXPECT_EQ(actual[i].acceleration, expected[i].acceleration);
+    }
+}
@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include <stdexcept>
+#include "polyhedralGravity/mpi/MpiEvaluation.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "../calculation/TestPolyhedra.h"
+
+/**
+ * Contains Tests for the distributed evaluation with MPI, run by mpiexec with multiple ranks
+ */
+class MpiEvaluationTest : public ::testing::Test {
+
+protected:
+
+    const polyhedralGravity::Polyhedron _cube{polyhedralGravity::TestPolyhedra::createCube()};
+
+    const double _density = 2670.0;
+
+    //Points inside and outside of the cube
+    const std::vector<polyhedralGravity::Array3> _points = [] {
+        std::vector<polyhedralGravity::Array3> points{};
+        for (int i = 0; i < 301; ++i) {
+            points.push_back({-3.0 + 0.02 * i, 0.5 - 0.01 * i, 0.013 * i - 1.7});
+        }
+        return points;
+    }();
+
+    int _rank = 0;
+
+    void SetUp() override {
+        MPI_Comm_rank(MPI_COMM_WORLD, &_rank);
+    }
+
+    //The chunks may be evaluated by different kernels, so the tolerance is relative to the largest component
+    template<typename Container>
+    static void expectNear(const Container &actual, const Container &expected) {
+        double scale = 0.0;
+        for (const double value: expected) {
+            scale = std::max(scale, std::abs(value));
+        }
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_NEAR(actual[i], expected[i], 1e-12 * scale);
+        }
+    }
+
+    void expectMatchesGravityModel(const std::vector<polyhedralGravity::GravityModelResult> &actual) const {
+        using namespace polyhedralGravity;
+        const auto expected = GravityModel::evaluate(_cube, _density, _points);
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_NEAR(actual[i].gravitationalPotential, expected[i].gravitationalPotential,
+                        1e-12 * std::abs(expected[i].gravitationalPotential));
+            expectNear(actual[i].acceleration, expected[i].acceleration);
+            expectNear(actual[i].gradiometricTensor, expected[i].gradiometricTensor);
+        }
+    }
+
+};
+
+TEST_F(MpiEvaluationTest, BroadcastPolyhedron) {
+    using namespace polyhedralGravity;
+    const Polyhedron polyhedron = MpiEvaluation::broadcastPolyhedron(_rank == 0 ? _cube : Polyhedron{},
+                                                                     MPI_COMM_WORLD);
+    EXPECT_EQ(polyhedron.getVertices(), _cube.getVertices());
+    EXPECT_EQ(polyhedron.getFaces(), _cube.getFaces());
+}
+
+TEST_F(MpiEvaluationTest, GatherOnRoot) {
+    using namespace polyhedralGravity;
+    //The points are only given on the root, chunks of one point leave more chunks than ranks
+    for (const size_t chunkSize: {1, 64, 1000}) {
+        SCOPED_TRACE(chunkSize);
+        const auto actual = MpiEvaluation::evaluate(_cube, _rank == 0 ? _density : 0.0,
+                                                    _rank == 0 ? _points : std::vector<Array3>{},
+                                                    MPI_COMM_WORLD, chunkSize);
+        if (_rank == 0) {
+            expectMatchesGravityModel(actual);
+        } else {
+            EXPECT_TRUE(actual.empty());
+        }
+    }
+    ASSERT_THROW(MpiEvaluation::evaluate(_cube, _density, _points, MPI_COMM_WORLD, 0), std::invalid_argument);
+}
+
+TEST_F(MpiEvaluationTest, WriteInParallel) {
+    using namespace polyhedralGravity;
+    const std::string fileName{"MpiEvaluationTest.bin"};
+    MpiEvaluation::evaluateToFile(_cube, _density, _rank == 0 ? _points : std::vector<Array3>{}, fileName,
+                                  MPI_COMM_WORLD, 16);
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (_rank == 0) {
+        std::vector<Array3> points{};
+        const auto actual = MpiEvaluation::readResultFile(fileName, points);
+        EXPECT_EQ(points, _points);
+        expectMatchesGravityModel(actual);
+        std::remove(fileName.c_str());
+    }
+}
+
+int main(int argc, char *argv[]) {
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleTest(&argc, argv);
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    //Only the root reports, but a failure on any rank fails the test
+    if (rank != 0) {
+        delete ::testing::UnitTest::GetInstance()->listeners().Release(
+                ::testing::UnitTest::GetInstance()->listeners().default_result_printer());
+    }
+    int failed = RUN_ALL_TESTS();
+    MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Finalize();
+    return failed;
+}
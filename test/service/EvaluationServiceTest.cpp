@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include "polyhedralGravity/service/EvaluationServer.h"
+#include "polyhedralGravity/service/EvaluationClient.h"
+#include "polyhedralGravity/service/ServiceProtocol.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+#include "../calculation/TestPolyhedra.h"
+
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/**
+ * Contains Tests for the evaluation daemon and its client talking over a Unix domain socket
+ */
+class EvaluationServiceTest : public ::testing::Test {
+
+protected:
+
+    //A cube with the edge length 2 centered at the origin
+    const polyhedralGravity::Polyhedron _cube{polyhedralGravity::TestPolyhedra::createCube()};
+
+    const double _density = 1.0;
+
+    const std::vector<polyhedralGravity::Array3> _points = [] {
+        std::vector<polyhedralGravity::Array3> points{};
+        for (int i = 0; i < 21; ++i) {
+            points.push_back({-3.0 + 0.3 * i, 0.5 - 0.1 * i, 2.0 - 0.2 * i});
+        }
+        return points;
+    }();
+
+    //Unique per process, so that tests running in parallel do not share the socket
+    const std::string _socketPath = "/tmp/polyhedralGravity_test_" + std::to_string(::getpid()) + ".sock";
+
+    polyhedralGravity::EvaluationServer _server{_socketPath};
+
+    void SetUp() override {
+        _server.start();
+    }
+
+    /**
+     * Connects a plain socket to a path.
+     * @param path - the socket path
+     * @return the file descriptor of the connected socket, -1 if the connection failed
+     */
+    static int connectTo(const std::string &path) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::copy(path.cbegin(), path.cend(), address.sun_path);
+        const int socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (::connect(socket, reinterpret_cast<const sockaddr *>(&address), sizeof(sockaddr_un)) != 0) {
+            ::close(socket);
+            return -1;
+        }
+        return socket;
+    }
+
+    static void expectEqual(const std::vector<polyhedralGravity::GravityModelResult> &actual,
+                            const std::vector<polyhedralGravity::GravityModelResult> &expected) {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < actual.size(); ++i) {
+            EXPECT_EQ(actual[i].gravitationalPotential, expected[i].gravitationalPotential) << "Point " << i;
+            EXPECT_EQ(actual[i].acceleration, expected[i].acceleration) << "Point " << i;
+            EXPECT_EQ(actual[i].gradiometricTensor, expected[i].gradiometricTensor) << "Point " << i;
+        }
+    }
+
+};
+
+TEST_F(EvaluationServiceTest, InlineAndSharedMemory) {
+    using namespace polyhedralGravity;
+    const auto expected = GravityModel::evaluate(_cube, _density, _points);
+
+    //Everything above 8 points is exchanged via shared memory
+    EvaluationClient client{_socketPath, 8};
+    client.ping();
+    const uint64_t id = client.loadPolyhedron(_cube);
+    EXPECT_EQ(_server.countPolyhedra(), 1);
+
+    expectEqual(client.evaluate(id, _density, _points), expected);
+    expectEqual(client.evaluate(id, _density, std::vector<Array3>(_points.cbegin(), _points.cbegin() + 5)),
+                std::vector<GravityModelResult>(expected.cbegin(), expected.cbegin() + 5));
+    expectEqual({client.evaluate(id, _density, _points.back())}, {expected.back()});
+    EXPECT_TRUE(client.evaluate(id, _density, std::vector<Array3>{}).empty());
+}
+
+TEST_F(EvaluationServiceTest, MeshFilesAndMultipleClients) {
+    using namespace polyhedralGravity;
+    const auto eros = TetgenAdapter{
+            {"resources/GravityModelBigTest.node", "resources/GravityModelBigTest.face"}}.getPolyhedron();
+    const auto expected = GravityModel::evaluate(eros, 2670.0, _points);
+
+    EvaluationClient first{_socketPath};
+    EvaluationClient second{_socketPath, 1};
+    const uint64_t id = first.loadPolyhedron(
+            std::vector<std::string>{"resources/GravityModelBigTest.node", "resources/GravityModelBigTest.face"});
+    expectEqual(first.evaluate(id, 2670.0, _points), expected);
+    expectEqual(second.evaluate(id, 2670.0, _points), expected);
+}
+
+TEST_F(EvaluationServiceTest, Errors) {
+    using namespace polyhedralGravity;
+    EvaluationClient client{_socketPath};
+    const uint64_t id = client.loadPolyhedron(_cube);
+    client.unloadPolyhedron(id);
+    EXPECT_EQ(_server.countPolyhedra(), 0);
+
+    //The connection stays usable after a failed request
+    ASSERT_THROW(client.evaluate(id, _density, _points), std::runtime_error);
+    ASSERT_THROW(client.unloadPolyhedron(id), std::runtime_error);
+    ASSERT_THROW(client.loadPolyhedron(Polyhedron{{{0.0, 0.0, 0.0}}, {{0, 1, 2}}}), std::runtime_error);
+    ASSERT_THROW(client.loadPolyhedron(std::vector<std::string>{"resources/missing.node"}), std::runtime_error);
+    client.ping();
+
+    ASSERT_THROW(EvaluationClient{"/tmp/polyhedralGravity_test_missing.sock"}, std::runtime_error);
+    _server.stop();
+    EXPECT_FALSE(_server.isRunning());
+    ASSERT_THROW(client.ping(), std::runtime_error);
+}
+
+TEST_F(EvaluationServiceTest, EmptySharedMemoryBatch) {
+    using namespace polyhedralGravity;
+    using namespace polyhedralGravity::ServiceProtocol;
+    EvaluationClient client{_socketPath};
+    const uint64_t id = client.loadPolyhedron(_cube);
+    //The segment of an empty batch is never opened, so it does not even need to exist
+    const int socket = connectTo(_socketPath);
+    ASSERT_GE(socket, 0);
+    PayloadWriter writer{};
+    writer.put(id);
+    writer.put(_density);
+    writer.put<uint64_t>(0);
+    writer.putString("/polyhedralGravity_test_missing");
+    sendMessage(socket, static_cast<uint16_t>(MessageType::EVALUATE_SHARED), writer.getBuffer());
+    Header header{};
+    std::vector<char> response{};
+    ASSERT_TRUE(receiveMessage(socket, header, response));
+    EXPECT_EQ(static_cast<Status>(header.code), Status::OK);
+    ::close(socket);
+}
+
+TEST_F(EvaluationServiceTest, SocketFileOfRunningAndStaleServer) {
+    using namespace polyhedralGravity;
+    //The socket file of the running server is kept, the server stays reachable
+    EvaluationServer second{_socketPath};
+    ASSERT_THROW(second.start(), std::runtime_error);
+    EvaluationClient{_socketPath}.ping();
+
+    //A socket file without a listening server is replaced
+    const std::string stalePath = _socketPath + ".stale";
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::copy(stalePath.cbegin(), stalePath.cend(), address.sun_path);
+    const int socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_EQ(::bind(socket, reinterpret_cast<const sockaddr *>(&address), sizeof(sockaddr_un)), 0);
+    ::close(socket);
+    ASSERT_EQ(connectTo(stalePath), -1);
+    EvaluationServer third{stalePath};
+    third.start();
+    EvaluationClient{stalePath}.ping();
+}
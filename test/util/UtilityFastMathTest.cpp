@@ -0,0 +1,165 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <limits>
+#include "polyhedralGravity/util/UtilityFastMath.h"
+#include "polyhedralGravity/input/TetgenAdapter.h"
+#include "polyhedralGravity/calculation/EvaluationSettings.h"
+#include "polyhedralGravity/calculation/GravityModel.h"
+#include "polyhedralGravity/model/Polyhedron.h"
+
+/**
+ * Contains Tests for the approximations of MathBackend::FAST, the model's values are compared with the ones of the
+ * Tsoulis reference implementation in FORTRAN saved in test/resources.
+ */
+class UtilityFastMathTest : public ::testing::Test {
+
+protected:
+
+    //The Eros mesh with 14744 faces
+    const polyhedralGravity::Polyhedron _polyhedron{
+            polyhedralGravity::TetgenAdapter{
+                    {"resources/GravityModelBigTest.node", "resources/GravityModelBigTest.face"}}.getPolyhedron()};
+
+    //Logarithmically spaced arguments from 1e-300 to 1e300 and arguments close to one
+    const std::vector<double> _arguments = [] {
+        std::vector<double> arguments{};
+        for (int i = -300000; i <= 300000; ++i) {
+            arguments.push_back(std::pow(10.0, i * 1e-3 + 1e-4 * std::sin(i)));
+        }
+        for (int i = 1; i <= 100000; ++i) {
+            arguments.push_back(1.0 + i * 1e-9);
+            arguments.push_back(1.0 - i * 1e-9);
+        }
+        return arguments;
+    }();
+
+    /**
+     * Computes LN_pq and AN_pq of a face for the computation point at the origin like
+     * GravityModel::detail::evaluateFace(..) with the currently selected MathBackend.
+     * @param face - the vertices of the face
+     * @return LN_pq and AN_pq foreach segment
+     */
+    static std::array<polyhedralGravity::TranscendentalExpression, 3>
+    computeTranscendentalExpressions(const polyhedralGravity::Array3Triplet &face) {
+        using namespace polyhedralGravity;
+        using namespace polyhedralGravity::GravityModel::detail;
+        const PreparedFace preparedFace = prepareFace(face);
+        const HessianPlane hessianPlane = computeHessianPlane(face[0], face[1], face[2]);
+        const double planeDistance = distanceBetweenOriginAndPlane(hessianPlane);
+        const Array3 projectionOnPlane =
+                projectPointOrthogonallyOntoPlane(preparedFace.planeUnitNormal, planeDistance, hessianPlane);
+        const Array3 segmentNormalOrientations =
+                computeUnitNormalOfSegmentsDirections(face, projectionOnPlane, preparedFace.segmentUnitNormals);
+        const Array3Triplet projectionsOnSegments =
+                projectPointOrthogonallyOntoSegments(projectionOnPlane, segmentNormalOrientations, face);
+        return GravityModel::detail::computeTranscendentalExpressions(
+                distancesToSegmentEndpoints(preparedFace.segmentVectors, projectionsOnSegments, face),
+                planeDistance,
+                distancesBetweenProjectionPoints(projectionOnPlane, projectionsOnSegments),
+                segmentNormalOrientations,
+                computeNormsOfProjectionPointAndVertices(projectionOnPlane, face));
+    }
+
+    void TearDown() override {
+        polyhedralGravity::EvaluationSettings::setMathBackend(polyhedralGravity::MathBackend::ACCURATE);
+    }
+
+};
+
+TEST_F(UtilityFastMathTest, LogWithinErrorBound) {
+    using namespace polyhedralGravity::util;
+    double maximumError = 0.0;
+    for (const double x: _arguments) {
+        const double expected = std::log(x);
+        if (expected != 0.0) {
+            maximumError = std::max(maximumError, std::abs((fastLog(x) - expected) / expected));
+        }
+    }
+    EXPECT_LT(maximumError, FAST_MATH_MAX_RELATIVE_ERROR);
+    EXPECT_EQ(fastLog(1.0), 0.0);
+    EXPECT_EQ(fastLog(0.0), -std::numeric_limits<double>::infinity());
+    EXPECT_EQ(fastLog(std::numeric_limits<double>::infinity()), std::numeric_limits<double>::infinity());
+    EXPECT_TRUE(std::isnan(fastLog(-1.0)));
+}
+
+TEST_F(UtilityFastMathTest, AtanWithinErrorBound) {
+    using namespace polyhedralGravity::util;
+    double maximumError = 0.0;
+    for (const double x: _arguments) {
+        for (const double signedX: {x, -x}) {
+            const double expected = std::atan(signedX);
+            maximumError = std::max(maximumError, std::abs((fastAtan(signedX) - expected) / expected));
+        }
+    }
+    EXPECT_LT(maximumError, FAST_MATH_MAX_RELATIVE_ERROR);
+    EXPECT_EQ(fastAtan(0.0), 0.0);
+    EXPECT_DOUBLE_EQ(fastAtan(std::numeric_limits<double>::infinity()), PI_2);
+    EXPECT_DOUBLE_EQ(fastAtan(-std::numeric_limits<double>::infinity()), -PI_2);
+}
+
+TEST_F(UtilityFastMathTest, TranscendentalExpressionsMatchReference) {
+    using namespace polyhedralGravity;
+    std::ifstream infile("resources/GravityModelBigTestExpectedTranscendentalExpressions.txt");
+    std::string line;
+    size_t i = 0;
+    std::array<TranscendentalExpression, 3> accurate{};
+    std::array<TranscendentalExpression, 3> fast{};
+    while (std::getline(infile, line)) {
+        std::istringstream linestream(line);
+        double ln, an;
+        if (!(linestream >> ln >> an)) {
+            break;
+        }
+        const size_t face = i / 3;
+        const size_t segment = i % 3;
+        if (segment == 0) {
+            const auto &indices = _polyhedron.getFaces()[face];
+            const Array3Triplet vertices{_polyhedron.getVertex(indices[0]), _polyhedron.getVertex(indices[1]),
+                                         _polyhedron.getVertex(indices[2])};
+            EvaluationSettings::setMathBackend(MathBackend::ACCURATE);
+            accurate = computeTranscendentalExpressions(vertices);
+            EvaluationSettings::setMathBackend(MathBackend::FAST);
+            fast = computeTranscendentalExpressions(vertices);
+        }
+        //Same deviation from the reference as the accurate backend (see GravityModelBigTest)...
+        ASSERT_NEAR(fast[segment].ln, ln, 1e-6) << "The LN value differed for (i,j) = (" << face << ',' << segment << ')';
+        ASSERT_NEAR(fast[segment].an, an, 1e-6) << "The AN value differed for (i,j) = (" << face << ',' << segment << ')';
+        //...and a deviation from the accurate backend within the bound
+        ASSERT_NEAR(fast[segment].ln, accurate[segment].ln,
+                    util::FAST_MATH_MAX_RELATIVE_ERROR * std::abs(accurate[segment].ln));
+        ASSERT_NEAR(fast[segment].an, accurate[segment].an, 4.0 * util::FAST_MATH_MAX_RELATIVE_ERROR);
+        ++i;
+    }
+    ASSERT_EQ(i, 3 * _polyhedron.countFaces());
+}
+
+TEST_F(UtilityFastMathTest, ModelWithinErrorBudget) {
+    using namespace polyhedralGravity;
+    const std::vector<Array3> points{{0.0, 0.0, 0.0}, {1.0, -0.5, 0.3}, {-2.0, 1.0, 0.5}, {5.0, 7.0, -3.0},
+                                     {40.0, -25.0, 10.0}};
+    EvaluationSettings::setMathBackend(MathBackend::ACCURATE);
+    const auto expected = GravityModel::evaluate(_polyhedron, 2670.0, points);
+    EvaluationSettings::setMathBackend(MathBackend::FAST);
+    const auto actual = GravityModel::evaluate(_polyhedron, 2670.0, points);
+    for (size_t i = 0; i < points.size(); ++i) {
+        //The accepted budget of the fast backend is a relative error of 1e-10. Far away from the polyhedron, the
+        //contributions of the faces cancel out and already the accurate backend is only accurate to about 1e-8
+        const double tolerance = i == 4 ? 1e-7 : 1e-10;
+        EXPECT_NEAR(actual[i].gravitationalPotential, expected[i].gravitationalPotential,
+                    tolerance * std::abs(expected[i].gravitationalPotential));
+        const double accelerationNorm = util::euclideanNorm(expected[i].acceleration);
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_NEAR(actual[i].acceleration[j], expected[i].acceleration[j], tolerance * accelerationNorm);
+        }
+        for (size_t j = 0; j < 6; ++j) {
+            EXPECT_NEAR(actual[i].gradiometricTensor[j], expected[i].gradiometricTensor[j],
+                        100.0 * tolerance * accelerationNorm);
+        }
+    }
+}